@@ -0,0 +1,163 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_CORE_MEMORY_MANAGER_HPP
+#define INCLUDE_CORE_MEMORY_MANAGER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mindquantum::memory {
+enum class Category : uint8_t {
+    StateVector,
+    DensityMatrix,
+    Sparse,
+    Device,  //!< GPU memory, tracked but not counted in the budget.
+    Mapped,  //!< Memory mapped files, paged by the OS and not counted in the budget.
+};
+
+constexpr size_t n_category = 5;
+
+std::string_view CategoryName(Category category);
+
+//! Raised before an allocation that would exceed the memory budget.
+class MemoryBudgetError : public std::runtime_error {
+ public:
+    using std::runtime_error::runtime_error;
+};
+
+struct Usage {
+    size_t current = 0;
+    size_t peak = 0;
+};
+
+/**
+ * Accounting of the large buffers (quantum states, sparse matrices) of a module.
+ *
+ * Every buffer allocated through the manager is recorded with its size, so the current and peak usage are known per
+ * category. When a budget is set, an allocation that would exceed it throws MemoryBudgetError instead of allocating,
+ * and FitConcurrency lets the multi-threaded entry points run fewer tasks at once to stay within the budget.
+ *
+ * A buffer can be shared by several owners (copy on write states), it is released by the Free of its last owner.
+ * Released state vectors and density matrices are kept in a pool keyed by their size, up to the pool limit, and
+ * handed out again by the next Allocate of the same size. This saves the page faults of a fresh allocation when the
+ * same states are created over and over, e.g. one copy per shot in sampling.
+ */
+class MemoryManager {
+ public:
+    static constexpr size_t default_pool_limit = 1UL << 28;
+
+    static MemoryManager& Instance();
+
+    //! Allocate host memory, throws MemoryBudgetError if it does not fit in the budget.
+    void* Allocate(size_t bytes, Category category, bool zero = false);
+
+    /*!
+     * \brief Map a zero filled temporary file of \c bytes in directory \c dir.
+     *
+     * The file is unlinked right away, its storage is released when the memory is freed. Pages are loaded on first
+     * access and written back by the OS, so the mapping can be much larger than the RAM.
+     */
+    void* AllocateMapped(size_t bytes, const std::string& dir);
+
+    //! Free memory from Allocate or AllocateMapped, untracked pointers are released with std::free.
+    void Free(void* ptr);
+
+    //! Add an owner to a tracked buffer, returns false if ptr is not tracked.
+    bool Share(void* ptr);
+
+    //! Whether the buffer has more than one owner.
+    bool IsShared(const void* ptr) const;
+
+    //! Largest number of bytes kept in the pool, a smaller limit releases the excess right away.
+    void SetPoolLimit(size_t bytes);
+    size_t PoolLimit() const;
+
+    //! Bytes currently kept in the pool, peak since the last ResetPeak.
+    Usage Pooled() const;
+
+    //! Return all pooled buffers to the OS.
+    void ReleasePool();
+
+    //! Account for memory allocated elsewhere, e.g. on the device.
+    void Track(void* ptr, size_t bytes, Category category);
+    void Untrack(void* ptr);
+
+    //! Budget of host memory in bytes, zero for no budget.
+    void SetBudget(size_t bytes);
+    size_t Budget() const;
+
+    //! Bytes that can still be allocated within the budget.
+    size_t Available() const;
+
+    //! Usage of the host categories.
+    Usage Total() const;
+    Usage Get(Category category) const;
+
+    //! Set the peaks to the current usage.
+    void ResetPeak();
+
+ private:
+    // Callers hold mutex_.
+    void Add(void* ptr, size_t bytes, Category category);
+    std::optional<std::pair<size_t, Category>> Remove(void* ptr);
+    void* TakePooled(size_t bytes);
+    std::vector<void*> TrimPool(size_t limit);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<void*, std::pair<size_t, Category>> blocks_;
+    std::unordered_map<const void*, size_t> extra_owners_;
+    std::unordered_map<size_t, std::vector<void*>> pool_;
+    Usage pooled_{};
+    size_t pool_limit_ = default_pool_limit;
+    std::array<Usage, n_category> usage_{};
+    Usage total_{};
+    size_t reserved_ = 0;
+    size_t budget_ = 0;
+};
+
+inline void* Allocate(size_t bytes, Category category, bool zero = false) {
+    return MemoryManager::Instance().Allocate(bytes, category, zero);
+}
+
+inline void Free(void* ptr) {
+    MemoryManager::Instance().Free(ptr);
+}
+
+//! Ask the OS to read the pages of a mapped range in the background.
+void Prefetch(const void* ptr, size_t bytes);
+
+/**
+ * Largest number of concurrent tasks, at most n_task, such that fixed_bytes plus the tasks fit in the budget.
+ *
+ * Throws MemoryBudgetError if not even one task fits.
+ */
+size_t FitConcurrency(size_t n_task, size_t bytes_per_task, size_t fixed_bytes = 0);
+
+//! Like FitConcurrency but keeps at least one batch, which then shrinks its own tasks or fails.
+size_t FitBatches(size_t n_batch, size_t bytes_per_batch);
+}  // namespace mindquantum::memory
+
+#endif
@@ -20,9 +20,11 @@
 
 #include "config/openmp.h"
 #include "config/type_promotion.h"
+#include "core/memory_manager.h"
 #include "core/sparse/csrhdmatrix.h"
 #include "core/sparse/paulimat.h"
 #include "core/sparse/sparse_utils.h"
+#include "core/trace.h"
 #include "core/utils.h"
 
 namespace mindquantum::sparse {
@@ -33,9 +35,9 @@ std::shared_ptr<CsrHdMatrix<T>> TransposeCsrHdMatrix(std::shared_ptr<CsrHdMatrix
     auto &a_indices = a->indices_;
     auto &a_indptr = a->indptr_;
     auto &a_data = a->data_;
-    auto *indices = reinterpret_cast<Index *>(malloc(sizeof(Index) * nnz));
-    auto *indptr = reinterpret_cast<Index *>(malloc(sizeof(Index) * (dim + 1)));
-    auto data = reinterpret_cast<CTP<T>>(malloc(sizeof(CT<T>) * nnz));
+    auto *indices = reinterpret_cast<Index *>(memory::Allocate(sizeof(Index) * nnz, memory::Category::Sparse));
+    auto *indptr = reinterpret_cast<Index *>(memory::Allocate(sizeof(Index) * (dim + 1), memory::Category::Sparse));
+    auto data = reinterpret_cast<CTP<T>>(memory::Allocate(sizeof(CT<T>) * nnz, memory::Category::Sparse));
     std::fill(indptr, indptr + dim, 0);
     for (Index n = 0; n < nnz; n++) {
         indptr[a_indices[n]]++;
@@ -78,9 +80,9 @@ std::shared_ptr<CsrHdMatrix<T>> PauliMatToCsrHdMatrix(std::shared_ptr<PauliMat<T
                              nnz++;
                          }
                      })
-    Index *indptr = reinterpret_cast<Index *>(malloc(sizeof(Index) * (dim + 1)));
-    Index *indices = reinterpret_cast<Index *>(malloc(sizeof(Index) * nnz));
-    CTP<T> data = reinterpret_cast<CTP<T>>(malloc(sizeof(CT<T>) * nnz));
+    Index *indptr = reinterpret_cast<Index *>(memory::Allocate(sizeof(Index) * (dim + 1), memory::Category::Sparse));
+    Index *indices = reinterpret_cast<Index *>(memory::Allocate(sizeof(Index) * nnz, memory::Category::Sparse));
+    CTP<T> data = reinterpret_cast<CTP<T>>(memory::Allocate(sizeof(CT<T>) * nnz, memory::Category::Sparse));
     indptr[0] = 0;
     for (Index i = 0, j = 0; i < dim; i++) {
         if (i <= col[i]) {
@@ -112,9 +114,9 @@ std::shared_ptr<CsrHdMatrix<T>> Csr_Plus_Csr(std::shared_ptr<CsrHdMatrix<T>> a,
     auto b_nnz = b->nnz_;
     auto dim = a->dim_;
     auto maxnnz = a_nnz + b_nnz;
-    CTP<T> data = reinterpret_cast<CTP<T>>(malloc(sizeof(CT<T>) * maxnnz));
-    Index *indices = reinterpret_cast<Index *>(malloc(sizeof(Index) * maxnnz));
-    Index *indptr = reinterpret_cast<Index *>(malloc(sizeof(Index) * (dim + 1)));
+    CTP<T> data = reinterpret_cast<CTP<T>>(memory::Allocate(sizeof(CT<T>) * maxnnz, memory::Category::Sparse));
+    Index *indices = reinterpret_cast<Index *>(memory::Allocate(sizeof(Index) * maxnnz, memory::Category::Sparse));
+    Index *indptr = reinterpret_cast<Index *>(memory::Allocate(sizeof(Index) * (dim + 1), memory::Category::Sparse));
     csr_plus_csr(dim, a->indptr_, a->indices_, a->data_, b->indptr_, b->indices_, b->data_, indptr, indices, data);
     auto nnz = indptr[dim];
 
@@ -124,6 +126,7 @@ std::shared_ptr<CsrHdMatrix<T>> Csr_Plus_Csr(std::shared_ptr<CsrHdMatrix<T>> a,
 
 template <typename T>
 std::shared_ptr<CsrHdMatrix<T>> SparseHamiltonian(const VT<PauliTerm<T>> &hams, Index n_qubits) {
+    MQ_TRACE_SCOPE("SparseHamiltonian", "sparse");
     VT<std::shared_ptr<CsrHdMatrix<T>>> sp_hams(hams.size());
 
     THRESHOLD_OMP_FOR(
@@ -150,7 +153,7 @@ template <typename T, typename T2>
 T2 *Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, T2 *vec) {
     auto dim = a->dim_;
     auto c_vec = reinterpret_cast<CTP<T2>>(vec);
-    auto new_vec = reinterpret_cast<CTP<T2>>(malloc(sizeof(CT<T2>) * dim));
+    auto new_vec = reinterpret_cast<CTP<T2>>(memory::Allocate(sizeof(CT<T2>) * dim, memory::Category::StateVector));
     auto data = a->data_;
     auto indptr = a->indptr_;
     auto indices = a->indices_;
@@ -192,7 +195,7 @@ template <typename T, typename T2>
 T2 *Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, std::shared_ptr<CsrHdMatrix<T>> b, T2 *vec) {
     auto dim = a->dim_;
     auto c_vec = reinterpret_cast<CTP<T2>>(vec);
-    auto new_vec = reinterpret_cast<CTP<T2>>(malloc(sizeof(CT<T2>) * dim));
+    auto new_vec = reinterpret_cast<CTP<T2>>(memory::Allocate(sizeof(CT<T2>) * dim, memory::Category::StateVector));
     auto data = a->data_;
     auto indptr = a->indptr_;
     auto indices = a->indices_;
@@ -16,6 +16,7 @@
 #ifndef MINDQUANTUM_SPARSE_CSR_HD_MATRIX_H_
 #define MINDQUANTUM_SPARSE_CSR_HD_MATRIX_H_
 
+#include "core/memory_manager.h"
 #include "core/utils.h"
 
 namespace mindquantum::sparse {
@@ -29,13 +30,13 @@ struct CsrHdMatrix {
 
     void FreeMemory() {
         if (indptr_ != nullptr) {
-            free(indptr_);
+            memory::Free(indptr_);
         }
         if (indices_ != nullptr) {
-            free(indices_);
+            memory::Free(indices_);
         }
         if (data_ != nullptr) {
-            free(data_);
+            memory::Free(data_);
         }
         indptr_ = nullptr;
         indices_ = nullptr;
@@ -16,6 +16,7 @@
 #ifndef MINDQUANTUM_SPARSE_PAULI_MAT_H_
 #define MINDQUANTUM_SPARSE_PAULI_MAT_H_
 
+#include "core/memory_manager.h"
 #include "core/utils.h"
 
 namespace mindquantum {
@@ -30,10 +31,10 @@ struct PauliMat {
 
     inline void FreeMemory() {
         if (coeff_ != nullptr) {
-            free(coeff_);
+            memory::Free(coeff_);
         }
         if (col_ != nullptr) {
-            free(col_);
+            memory::Free(col_);
         }
     }
     void Reset() {
@@ -48,8 +49,8 @@ struct PauliMat {
     }
     PauliMat(const PauliTerm<T> pt, Index n_qubits) : n_qubits_(n_qubits), p_(pt.second) {
         dim_ = (1UL << n_qubits_);
-        coeff_ = reinterpret_cast<char *>(malloc(sizeof(char) * dim_));
-        col_ = reinterpret_cast<Index *>(malloc(sizeof(Index) * dim_));
+        coeff_ = reinterpret_cast<char *>(memory::Allocate(sizeof(char) * dim_, memory::Category::Sparse));
+        col_ = reinterpret_cast<Index *>(memory::Allocate(sizeof(Index) * dim_, memory::Category::Sparse));
         auto mask = GetPauliMask(pt.first);
         auto mask_f = mask.mask_x | mask.mask_y;
         THRESHOLD_OMP_FOR(
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_CORE_TRACE_HPP
+#define INCLUDE_CORE_TRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mindquantum::trace {
+//! A complete event ("ph": "X") of the Chrome trace event format.
+struct Event {
+    const char* name = nullptr;  //!< Must be a string literal, only the pointer is stored.
+    const char* category = nullptr;
+    uint64_t tid = 0;
+    uint64_t start_ns = 0;
+    uint64_t dur_ns = 0;
+};
+
+//! Nanoseconds of the monotonic clock, same origin as time.monotonic_ns() in python.
+uint64_t Now();
+
+//! Native id of the calling thread, same value as threading.get_native_id() in python.
+uint64_t ThreadId();
+
+/**
+ * Process wide recorder of trace events.
+ *
+ * Recording is off by default and costs a single relaxed atomic load per scope. Once started, every thread writes in
+ * its own ring buffer, so recording does not contend with other threads; when a buffer is full the oldest events are
+ * overwritten. The buffers are collected when the trace is dumped. A thread returns its buffer when it exits and the
+ * next new thread reuses it, so there are at most as many buffers as threads alive at once.
+ */
+class Recorder {
+ public:
+    static constexpr size_t default_capacity = 1UL << 16;
+
+    static Recorder& Instance();
+
+    //! Clear the buffers and start recording with the given per-thread capacity.
+    void Start(size_t capacity = default_capacity);
+    void Stop();
+    bool Recording() const {
+        return recording_.load(std::memory_order_relaxed);
+    }
+
+    void Add(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns);
+
+    //! Events of all threads, sorted by start time.
+    std::vector<Event> Events() const;
+
+    //! Chrome/Perfetto JSON of the recorded events.
+    std::string ChromeJson() const;
+    void DumpChromeJson(const std::string& filename) const;
+
+    //! Drop the recorded events and free the buffers, the buffers of exited threads are released.
+    void Clear();
+
+ private:
+    struct RingBuffer {
+        std::mutex mutex;
+        uint64_t tid = 0;
+        bool in_use = false;
+        std::vector<Event> events;
+        size_t head = 0;
+        size_t size = 0;
+    };
+
+    //! Thread local owner of a ring buffer, gives it back to the recorder when the thread exits.
+    struct LocalBuffer {
+        explicit LocalBuffer(Recorder* recorder);
+        ~LocalBuffer();
+        LocalBuffer(const LocalBuffer&) = delete;
+        LocalBuffer& operator=(const LocalBuffer&) = delete;
+
+        std::shared_ptr<RingBuffer> buffer;
+    };
+
+    RingBuffer& Local();
+
+    std::atomic<bool> recording_{false};
+    std::atomic<size_t> capacity_{default_capacity};
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<RingBuffer>> buffers_;
+};
+
+//! Record the lifetime of the scope as a trace event.
+class TraceScope {
+ public:
+    TraceScope(const char* name, const char* category)
+        : name_(name), category_(category), active_(Recorder::Instance().Recording()) {
+        if (active_) {
+            start_ = Now();
+        }
+    }
+    ~TraceScope() {
+        if (active_) {
+            Recorder::Instance().Add(name_, category_, start_, Now());
+        }
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+    const char* name_;
+    const char* category_;
+    bool active_;
+    uint64_t start_ = 0;
+};
+}  // namespace mindquantum::trace
+
+#define MQ_TRACE_CONCAT_IMPL(a, b) a##b
+#define MQ_TRACE_CONCAT(a, b)      MQ_TRACE_CONCAT_IMPL(a, b)
+
+//! Trace the enclosing scope, name and category must be string literals.
+#define MQ_TRACE_SCOPE(name, category)                                                                                 \
+    ::mindquantum::trace::TraceScope MQ_TRACE_CONCAT(mq_trace_scope_, __LINE__)(name, category)
+
+#endif
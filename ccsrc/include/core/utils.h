@@ -112,6 +112,11 @@ inline uint32_t CountLeadingZero(int32_t n) {
 inline uint64_t CountLeadingZero(int64_t n) {
     return __lzcnt64(uint64_t(n));
 }
+inline uint64_t CountTrailingZero(uint64_t n) {
+    unsigned long index;
+    _BitScanForward64(&index, n);
+    return index;
+}
 #else
 
 inline uint32_t CountOne(uint32_t n) {
@@ -119,7 +124,7 @@ inline uint32_t CountOne(uint32_t n) {
 }
 
 inline uint64_t CountOne(uint64_t n) {
-    return __builtin_popcount(n);
+    return __builtin_popcountll(n);
 }
 inline uint32_t CountLeadingZero(uint32_t n) {
     return __builtin_clzll(n);
@@ -133,6 +138,9 @@ inline uint32_t CountLeadingZero(int32_t n) {
 inline uint64_t CountLeadingZero(int64_t n) {
     return __builtin_clzll(uint64_t(n));
 }
+inline uint64_t CountTrailingZero(uint64_t n) {
+    return __builtin_ctzll(n);
+}
 #endif  // _MSC_VER
 
 template <typename T>
@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_IO_QASM_OPENQASM_HPP
+#define INCLUDE_IO_QASM_OPENQASM_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "ops/basic_gate.h"
+
+namespace mindquantum::io::qasm {
+//! Circuit and register layout produced by the OpenQASM parser.
+struct QasmProgram {
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    //! Version string given in the `OPENQASM` header, e.g. "2.0" or "3".
+    std::string version;
+    //! Total number of qubits of all quantum registers.
+    qbit_t n_qubits = 0;
+    //! Measure key of every classical bit, in declaration order.
+    VT<std::string> clbit_keys;
+    //! Name of every parameter declared with `input`, in declaration order.
+    VT<std::string> parameters;
+    //! Flattened circuit, user defined gates are inlined.
+    circuit_t circuit;
+
+    //! Map from measure key to classical bit index, as used by the Sampling API.
+    MST<size_t> KeyMap() const;
+};
+
+/**
+ * Parse an OpenQASM 2.0 or 3 program.
+ *
+ * The standard libraries "qelib1.inc" and "stdgates.inc" are built-in, any other included file is searched in the
+ * directory of the including file first and then in \c include_dirs. Parse errors are reported with
+ * std::runtime_error, the message starts with "<source_name>:<line>:".
+ */
+QasmProgram ParseOpenQASM(const std::string& source, const VT<std::string>& include_dirs = {},
+                          const std::string& source_name = "<string>");
+
+//! Parse an OpenQASM program stored in a file.
+QasmProgram ParseOpenQASMFile(const std::string& file_name, const VT<std::string>& include_dirs = {});
+}  // namespace mindquantum::io::qasm
+#endif
@@ -23,6 +23,7 @@
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
@@ -185,6 +186,42 @@ struct RyzGate : public Parameterizable {
         : Parameterizable(GateID::Ryz, {pr}, obj_qubits, ctrl_qubits) {
     }
 };
+//! exp(-i theta / 2 P) for the Pauli string P, paulis_[j] acting on obj_qubits_[j].
+struct RotPauliStringGate : public Parameterizable {
+    std::string paulis_;
+    RotPauliStringGate(const std::string& paulis, const parameter::ParameterResolver pr, const qbits_t& obj_qubits,
+                       const qbits_t& ctrl_qubits = {})
+        : Parameterizable(GateID::RPS, {pr}, obj_qubits, ctrl_qubits), paulis_(paulis) {
+        if (paulis_.size() != obj_qubits.size()) {
+            throw std::invalid_argument("Pauli string and object qubits of RPS gate should have the same size.");
+        }
+        for (auto p : paulis_) {
+            if (p != 'X' && p != 'Y' && p != 'Z') {
+                throw std::invalid_argument("Pauli string of RPS gate should only contain X, Y and Z.");
+            }
+        }
+    }
+};
+//! exp(theta (T - T^dagger)) with T = a_p^dagger a_q, obj_qubits_ being {p, q} under the Jordan-Wigner mapping.
+struct SingleExcitationGate : public Parameterizable {
+    SingleExcitationGate(const parameter::ParameterResolver pr, const qbits_t& obj_qubits,
+                         const qbits_t& ctrl_qubits = {})
+        : Parameterizable(GateID::SE, {pr}, obj_qubits, ctrl_qubits) {
+        if (obj_qubits.size() != 2) {
+            throw std::invalid_argument("Single excitation gate acts on two modes.");
+        }
+    }
+};
+//! exp(theta (T - T^dagger)) with T = a_p^dagger a_q^dagger a_r a_s, obj_qubits_ being {p, q, r, s}.
+struct DoubleExcitationGate : public Parameterizable {
+    DoubleExcitationGate(const parameter::ParameterResolver pr, const qbits_t& obj_qubits,
+                         const qbits_t& ctrl_qubits = {})
+        : Parameterizable(GateID::DE, {pr}, obj_qubits, ctrl_qubits) {
+        if (obj_qubits.size() != 4) {
+            throw std::invalid_argument("Double excitation gate acts on four modes.");
+        }
+    }
+};
 struct GPGate : public Parameterizable {
     GPGate(const parameter::ParameterResolver pr, const qbits_t& obj_qubits, const qbits_t& ctrl_qubits = {})
         : Parameterizable(GateID::GP, {pr}, obj_qubits, ctrl_qubits) {
@@ -56,6 +56,9 @@ enum class GateID : uint8_t {
     PD,     // phase damping channel
     KRAUS,
     CUSTOM,
+    RPS,     // rotation of a Pauli string
+    SE,      // fermionic single excitation
+    DE,      // fermionic double excitation
     HOLDER,  // for extended gate id.
 };
 
@@ -70,7 +73,8 @@ NLOHMANN_JSON_SERIALIZE_ENUM(GateID, {{GateID::I, "I"},         {GateID::X, "X"}
                                       {GateID::CZ, "CZ"},       {GateID::GP, "GP"},       {GateID::PS, "PS"},
                                       {GateID::U3, "U3"},       {GateID::FSim, "FSim"},   {GateID::M, "M"},
                                       {GateID::PL, "PL"},       {GateID::DEP, "DEP"},     {GateID::AD, "AD"},
-                                      {GateID::PD, "PD"},       {GateID::KRAUS, "KRAUS"}, {GateID::CUSTOM, "CUSTOM"}});
+                                      {GateID::PD, "PD"},       {GateID::KRAUS, "KRAUS"}, {GateID::CUSTOM, "CUSTOM"},
+                                      {GateID::RPS, "RPS"},     {GateID::SE, "SE"},       {GateID::DE, "DE"}});
 }  // namespace mindquantum
 template <typename char_t>
 struct fmt::formatter<mindquantum::GateID, char_t> {
@@ -137,6 +141,12 @@ struct fmt::formatter<mindquantum::GateID, char_t> {
                 return fmt::format_to(ctx.out(), "Rxz");
             case mindquantum::GateID::Ryz:
                 return fmt::format_to(ctx.out(), "Ryz");
+            case mindquantum::GateID::RPS:
+                return fmt::format_to(ctx.out(), "RPS");
+            case mindquantum::GateID::SE:
+                return fmt::format_to(ctx.out(), "SE");
+            case mindquantum::GateID::DE:
+                return fmt::format_to(ctx.out(), "DE");
             default:
                 return format_two(value, ctx);
         }
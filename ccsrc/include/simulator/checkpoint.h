@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_CHECKPOINT_HPP
+#define INCLUDE_SIMULATOR_CHECKPOINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "core/mq_base_types.h"
+#include "math/tensor/traits.h"
+
+/**
+ * Checkpoint files of the simulator states.
+ *
+ * A checkpoint holds the raw buffer of a state policy with the metadata needed to restore it: the kind of state, the
+ * dtype and element size of the buffer, the number of qubits, the seed and the state of the random engine. Layout,
+ * in native byte order:
+ *
+ *   - fixed header (Header below), starting with the magic "MQSTATE" and the format version,
+ *   - rng_bytes of the random engine state, as written by operator<<,
+ *   - the payload: n_elements elements for the dense encoding, n_stored (uint64 index, element) records for the
+ *     sparse one.
+ *
+ * The file is written to a temporary name next to the target, synced and renamed over it, then the directory is
+ * synced, so a crash while saving leaves the previous checkpoint intact.
+ */
+namespace mindquantum::sim::checkpoint {
+constexpr uint32_t version = 1;
+
+enum class Kind : uint32_t {
+    Vector,
+    DensityMatrix,
+};
+
+enum class Encoding : uint32_t {
+    Dense,
+    Sparse,  //!< Only the elements larger than the drop threshold, with their index.
+};
+
+struct Info {
+    Kind kind = Kind::Vector;
+    tensor::TDtype dtype = tensor::TDtype::Complex128;
+    qbit_t n_qubits = 0;
+    unsigned seed = 0;
+    uint64_t n_elements = 0;     //!< Elements of the buffer.
+    uint64_t element_bytes = 0;  //!< Size of one complex element, 8 or 16.
+    Encoding encoding = Encoding::Dense;
+    uint64_t n_stored = 0;  //!< Elements in the payload.
+    std::string rng_state;
+};
+
+/*!
+ * \brief Write a host buffer of info.n_elements complex elements to filename.
+ *
+ * If drop_below is not negative, elements with a modulus not larger than it are dropped and the sparse encoding is
+ * used when it is smaller than the dense one. The default of zero only drops exact zeros, which is lossless.
+ * The encoding and n_stored fields of info are set here.
+ */
+void Save(const std::string& filename, Info info, const void* data, double drop_below = 0);
+
+//! Read the metadata of a checkpoint.
+Info ReadInfo(const std::string& filename);
+
+/*!
+ * \brief Read the buffer of a checkpoint into data, which holds info.n_elements elements, and return its metadata.
+ *
+ * Throws std::invalid_argument if the kind, dtype or size of the checkpoint do not match info. Elements missing from
+ * a sparse checkpoint are set to zero.
+ */
+Info Load(const std::string& filename, const Info& info, void* data);
+}  // namespace mindquantum::sim::checkpoint
+
+#endif
@@ -39,6 +39,7 @@
 #include "ops/basic_gate.h"
 #include "ops/gates.h"
 #include "ops/hamiltonian.h"
+#include "simulator/checkpoint.h"
 #include "simulator/timer.h"
 #include "simulator/utils.h"
 
@@ -93,6 +94,12 @@ class DensityMatrixState {
     virtual void SetDM(const matrix_t& qs_out);
     virtual void CopyQS(const qs_data_p_t& qs_src);
 
+    //! Save the density matrix and the random engine to a checkpoint file, see simulator/checkpoint.h.
+    void Save(const std::string& filename, double drop_below = 0) const;
+
+    //! Restore a checkpoint saved by a simulator of the same type and number of qubits.
+    void Load(const std::string& filename);
+
     //! Judge whether the density matrix is pure
     virtual bool IsPure() const;
 
@@ -173,6 +180,23 @@ class DensityMatrixState {
     }
 
  protected:
+    //! Metadata of a checkpoint of this state, without the random engine.
+    checkpoint::Info CheckpointInfo() const {
+        checkpoint::Info info;
+        info.kind = checkpoint::Kind::DensityMatrix;
+        info.dtype = tensor::to_dtype_v<py_qs_data_t>;
+        info.n_qubits = n_qubits;
+        info.seed = seed;
+        info.n_elements = (dim * dim + dim) / 2;
+        info.element_bytes = sizeof(qs_data_t);
+        return info;
+    }
+
+    //! Bytes of one allocated density matrix, only the lower triangle is stored.
+    size_t StateBytes() const {
+        return sizeof(qs_data_t) * (dim * dim + dim) / 2;
+    }
+
     qs_data_p_t qs = nullptr;
     qbit_t n_qubits = 0;
     index_t dim = 0;
@@ -29,6 +29,7 @@
 #include <memory>
 #include <mutex>
 #include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -36,7 +37,9 @@
 #include <utility>
 #include <vector>
 
+#include "core/memory_manager.h"
 #include "core/mq_base_types.h"
+#include "core/trace.h"
 #include "math/pr/parameter_resolver.h"
 #include "math/tensor/matrix.h"
 #include "math/tensor/ops/basic_math.h"
@@ -44,6 +47,7 @@
 #include "ops/basic_gate.h"
 #include "ops/gates.h"
 #include "ops/hamiltonian.h"
+#include "simulator/profiler.h"
 #include "simulator/densitymatrix/densitymatrix_state.h"
 
 namespace mindquantum::sim::densitymatrix::detail {
@@ -122,6 +126,50 @@ void DensityMatrixState<qs_policy_t_>::Reset() {
     qs_policy_t::Reset(&qs);
 }
 
+template <typename qs_policy_t_>
+void DensityMatrixState<qs_policy_t_>::Save(const std::string& filename, double drop_below) const {
+    MQ_TRACE_SCOPE("SaveState", "simulator");
+    auto info = CheckpointInfo();
+    std::ostringstream rng;
+    rng << rnd_eng_;
+    info.rng_state = rng.str();
+    if (qs != nullptr) {
+        checkpoint::Save(filename, info, qs, drop_below);
+        return;
+    }
+    auto zero_state = qs_policy_t::InitState(dim);
+    try {
+        checkpoint::Save(filename, info, zero_state, drop_below);
+    } catch (...) {
+        qs_policy_t::FreeState(&zero_state);
+        throw;
+    }
+    qs_policy_t::FreeState(&zero_state);
+}
+
+template <typename qs_policy_t_>
+void DensityMatrixState<qs_policy_t_>::Load(const std::string& filename) {
+    MQ_TRACE_SCOPE("LoadState", "simulator");
+    auto buffer = qs_policy_t::InitState(dim, false);
+    checkpoint::Info saved;
+    try {
+        saved = checkpoint::Load(filename, CheckpointInfo(), buffer);
+    } catch (...) {
+        qs_policy_t::FreeState(&buffer);
+        throw;
+    }
+    RndEngine engine;
+    std::istringstream rng(saved.rng_state);
+    if (!(rng >> engine)) {
+        qs_policy_t::FreeState(&buffer);
+        throw std::runtime_error(fmt::format("Corrupted random engine state in checkpoint {}.", filename));
+    }
+    qs_policy_t::FreeState(&qs);
+    qs = buffer;
+    seed = saved.seed;
+    rnd_eng_ = engine;
+}
+
 template <typename qs_policy_t_>
 void DensityMatrixState<qs_policy_t_>::Display(qbit_t qubits_limit) const {
     qs_policy_t::Display(qs, n_qubits, qubits_limit);
@@ -161,6 +209,7 @@ template <typename qs_policy_t_>
 index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& gate,
                                                     const parameter::ParameterResolver& pr, bool diff) {
     auto id = gate->id_;
+    MQ_PROFILE_SCOPE(ApplyGate, id, n_qubits, (dim * dim + dim) * sizeof(qs_data_t));
     switch (id) {
         case GateID::I:
             break;
@@ -200,7 +249,8 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
             qs_policy_t::ApplyRX(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::RY: {
@@ -208,7 +258,8 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
             qs_policy_t::ApplyRY(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::RZ: {
@@ -216,7 +267,8 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
             qs_policy_t::ApplyRZ(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::Rxx: {
@@ -224,7 +276,8 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
             qs_policy_t::ApplyRxx(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::Ryy: {
@@ -232,7 +285,8 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
             qs_policy_t::ApplyRyy(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::Rzz: {
@@ -240,7 +294,8 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
             qs_policy_t::ApplyRzz(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::PS: {
@@ -248,7 +303,8 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
             qs_policy_t::ApplyPS(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         // case GateID::GP: {
@@ -295,35 +351,21 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
         case GateID::M:
             return this->ApplyMeasure(gate);
         case GateID::PL:
-            qs_policy_t::ApplyPauli(&qs, gate->obj_qubits_, static_cast<PauliChannel*>(gate.get())->probs_, dim);
-            break;
         case GateID::DEP:
-            qs_policy_t::ApplyDepolarizing(&qs, gate->obj_qubits_, static_cast<DepolarizingChannel*>(gate.get())->prob_,
-                                           dim);
-            break;
         case GateID::AD:
-            qs_policy_t::ApplyAmplitudeDamping(&qs, gate->obj_qubits_,
-                                               static_cast<AmplitudeDampingChannel*>(gate.get())->damping_coeff_,
-                                               static_cast<AmplitudeDampingChannel*>(gate.get())->daggered_, dim);
-            break;
         case GateID::PD:
-            qs_policy_t::ApplyPhaseDamping(&qs, gate->obj_qubits_,
-                                           static_cast<PhaseDampingChannel*>(gate.get())->damping_coeff_, dim);
+        case GateID::KRAUS:
+            this->ApplyChannel(gate);
             break;
-        case GateID::KRAUS: {
-            auto& k_set = static_cast<KrausChannel*>(gate.get())->kraus_operator_set_;
-            VT<matrix_t> k_mat;
-            std::transform(k_set.begin(), k_set.end(), std::back_inserter(k_mat),
-                           [&](auto& k) { return tensor::ops::cpu::to_vector<py_qs_data_t>(k); });
-            qs_policy_t::ApplyKraus(&qs, gate->obj_qubits_, k_mat, dim);
-        } break;
         case GateID::CUSTOM: {
             auto g = static_cast<CustomGate*>(gate.get());
             tensor::Matrix mat;
             if (!g->Parameterized()) {
                 mat = g->base_matrix_;
             } else {
-                calc_type val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+                calc_type val = tensor::ops::cpu::to_vector<calc_type>(
+                    MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0,
+                                    g->prs_[0].Combination(pr).const_value))[0];
                 if (!diff) {
                     mat = g->numba_param_matrix_(val);
                 } else {
@@ -334,6 +376,10 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
                                          tensor::ops::cpu::to_vector<py_qs_data_t>(mat), dim);
             break;
         }
+        case GateID::SE:
+        case GateID::DE:
+            throw std::invalid_argument(
+                fmt::format("Fermionic excitation gate {} is not supported by the density matrix simulator.", id));
         default:
             throw std::invalid_argument(fmt::format("Apply of gate {} not implement.", id));
     }
@@ -342,6 +388,7 @@ index_t DensityMatrixState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicG
 
 template <typename qs_policy_t_>
 void DensityMatrixState<qs_policy_t_>::ApplyChannel(const std::shared_ptr<BasicGate>& gate) {
+    MQ_PROFILE_SCOPE(ApplyChannel, gate->id_, n_qubits, (dim * dim + dim) * sizeof(qs_data_t));
     auto id = gate->id_;
     switch (id) {
         case GateID::DEP:
@@ -392,6 +439,7 @@ auto DensityMatrixState<qs_policy_t_>::ExpectDiffGate(const qs_data_p_t& dens_ma
                                                       const std::shared_ptr<BasicGate>& gate,
                                                       const parameter::ParameterResolver& pr, index_t dim) const
     -> tensor::Matrix {
+    MQ_PROFILE_SCOPE(Gradient, gate->id_, n_qubits, (dim * dim + dim) * sizeof(qs_data_t));
     auto id = gate->id_;
     VT<py_qs_data_t> grad = {0};
     switch (id) {
@@ -421,7 +469,8 @@ auto DensityMatrixState<qs_policy_t_>::ExpectDiffGate(const qs_data_p_t& dens_ma
         //     return tensor::Matrix({grad});
         case GateID::CUSTOM: {
             auto g = static_cast<CustomGate*>(gate.get());
-            auto val = tensor::ops::cpu::to_vector<double>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = tensor::ops::cpu::to_vector<double>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
             tensor::Matrix gate_m = g->numba_param_matrix_(val);
             tensor::Matrix diff_m = g->numba_param_diff_matrix_(val);
             grad[0] = qs_policy_t::ExpectDiffMatrixGate(dens_matrix, ham_matrix, gate->obj_qubits_, gate->ctrl_qubits_,
@@ -433,6 +482,10 @@ auto DensityMatrixState<qs_policy_t_>::ExpectDiffGate(const qs_data_p_t& dens_ma
             return ExpectDiffU3(dens_matrix, ham_matrix, gate, pr, dim);
         case GateID::FSim:
             return ExpectDiffFSim(dens_matrix, ham_matrix, gate, pr, dim);
+        case GateID::SE:
+        case GateID::DE:
+            throw std::invalid_argument(
+                fmt::format("Fermionic excitation gate {} is not supported by the density matrix simulator.", id));
         default:
             throw std::invalid_argument(fmt::format("Expectation of gate {} not implement.", id));
     }
@@ -443,6 +496,7 @@ auto DensityMatrixState<qs_policy_t_>::ExpectDiffU3(const qs_data_p_t& dens_matr
                                                     const std::shared_ptr<BasicGate>& gate,
                                                     const parameter::ParameterResolver& pr, index_t dim) const
     -> tensor::Matrix {
+    MQ_PROFILE_SCOPE(Gradient, gate->id_, n_qubits, (dim * dim + dim) * sizeof(qs_data_t));
     py_qs_datas_t grad = {0, 0, 0};
     auto u3 = static_cast<U3*>(gate.get());
     if (u3->parameterized_) {
@@ -473,6 +527,7 @@ auto DensityMatrixState<qs_policy_t_>::ExpectDiffFSim(const qs_data_p_t& dens_ma
                                                       const std::shared_ptr<BasicGate>& gate,
                                                       const parameter::ParameterResolver& pr, index_t dim) const
     -> tensor::Matrix {
+    MQ_PROFILE_SCOPE(Gradient, gate->id_, n_qubits, (dim * dim + dim) * sizeof(qs_data_t));
     py_qs_datas_t grad = {0, 0};
     auto fsim = static_cast<FSim*>(gate.get());
     if (fsim->parameterized_) {
@@ -491,6 +546,7 @@ auto DensityMatrixState<qs_policy_t_>::ExpectDiffFSim(const qs_data_p_t& dens_ma
 template <typename qs_policy_t_>
 std::map<std::string, int> DensityMatrixState<qs_policy_t_>::ApplyCircuit(const circuit_t& circ,
                                                                           const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("ApplyCircuit", "simulator");
     std::map<std::string, int> result;
     for (auto& g : circ) {
         if (g->id_ == GateID::M) {
@@ -505,6 +561,7 @@ std::map<std::string, int> DensityMatrixState<qs_policy_t_>::ApplyCircuit(const
 template <typename qs_policy_t_>
 auto DensityMatrixState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham, const circuit_t& circ,
                                                       const parameter::ParameterResolver& pr) const -> py_qs_data_t {
+    MQ_PROFILE_SCOPE(Expectation, GateID::null, n_qubits, 0);
     auto rho = *this;
     rho.ApplyCircuit(circ, pr);
     return qs_policy_t::GetExpectation(rho.qs, ham.ham_, dim);
@@ -514,6 +571,7 @@ template <typename qs_policy_t_>
 auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneOne(
     const Hamiltonian<calc_type>& ham, const circuit_t& circ, const circuit_t& herm_circ,
     const parameter::ParameterResolver& pr, const MST<size_t>& p_map, int n_thread) const -> py_qs_datas_t {
+    MQ_TRACE_SCOPE("GetExpectationWithReversibleGradOneOne", "gradient");
     if (circ.size() != herm_circ.size()) {
         std::runtime_error("In density matrix mode, circ and herm_circ must be the same size.");
     }
@@ -531,7 +589,8 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneOne(
             const auto& [title, jac] = p_gate->jacobi;
             if (title.size() != 0) {
                 auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_ham.qs, circ[n], pr, dim);
-                auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
+                auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(
+                    MQ_PROFILE_EXPR(Jacobian, p_gate->id_, n_qubits, 0, tensor::ops::MatMul(intrin_grad, jac)));
                 for (const auto& [name, idx] : title) {
                     f_and_g[1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
                 }
@@ -547,6 +606,7 @@ template <typename qs_policy_t_>
 auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneMulti(
     const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ, const circuit_t& herm_circ,
     const parameter::ParameterResolver& pr, const MST<size_t>& p_map, int n_thread) const -> VT<py_qs_datas_t> {
+    MQ_TRACE_SCOPE("GetExpectationWithReversibleGradOneMulti", "gradient");
     auto n_hams = hams.size();
     int max_thread = 15;
     if (circ.size() != herm_circ.size()) {
@@ -561,6 +621,8 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneMulti(
     if (n_thread > static_cast<int>(n_hams)) {
         n_thread = n_hams;
     }
+    // sim_qs and a workspace for channels, plus one Hamiltonian matrix per Hamiltonian of a group.
+    n_thread = static_cast<int>(memory::FitConcurrency(n_thread, StateBytes(), 2 * StateBytes()));
     VT<py_qs_datas_t> f_and_g(n_hams, py_qs_datas_t((1 + p_map.size()), 0));
     derived_t sim_qs = *this;
     sim_qs.ApplyCircuit(circ, pr);
@@ -589,7 +651,8 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneMulti(
                 if (title.size() != 0) {
                     for (int j = start; j < end; j++) {
                         auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_hams[j - start].qs, circ[n], pr, dim);
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
+                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(
+                            MQ_PROFILE_EXPR(Jacobian, p_gate->id_, n_qubits, 0, tensor::ops::MatMul(intrin_grad, jac)));
                         for (const auto& [name, idx] : title) {
                             f_and_g[j][1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
                         }
@@ -610,6 +673,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradMultiMult
     const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ, const circuit_t& herm_circ,
     const VVT<calc_type>& enc_data, const VT<calc_type>& ans_data, const VS& enc_name, const VS& ans_name,
     size_t batch_threads, size_t mea_threads) const -> VT<VT<py_qs_datas_t>> {
+    MQ_TRACE_SCOPE("GetExpectationWithReversibleGradMultiMulti", "gradient");
     auto n_hams = hams.size();
     auto n_prs = enc_data.size();
     auto n_params = enc_name.size() + ans_name.size();
@@ -639,6 +703,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradMultiMult
         if (batch_threads == 0) {
             throw std::runtime_error("batch_thread cannot be zero.");
         }
+        batch_threads = memory::FitBatches(batch_threads, (2 + std::min(mea_threads, n_hams)) * StateBytes());
         std::vector<std::thread> tasks;
         tasks.reserve(batch_threads);
         size_t end = 0;
@@ -651,6 +716,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradMultiMult
                 end += 1;
             }
             auto task = [&, start, end]() {
+                MQ_TRACE_SCOPE("GradBatch", "gradient");
                 for (size_t n = start; n < end; n++) {
                     parameter::ParameterResolver pr = parameter::ParameterResolver();
                     pr.SetItems(enc_name, enc_data[n]);
@@ -675,6 +741,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradOneOne(const H
                                                                          const parameter::ParameterResolver& pr,
                                                                          const MST<size_t>& p_map) const
     -> py_qs_datas_t {
+    MQ_TRACE_SCOPE("GetExpectationWithNoiseGradOneOne", "gradient");
     if (circ.size() != herm_circ.size()) {
         std::runtime_error("In density matrix mode, circ and herm_circ must be the same size.");
     }
@@ -696,7 +763,8 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradOneOne(const H
                     sim_qs.ApplyGate(circ[a], pr);
                 }
                 auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_ham.qs, circ[n], pr, dim);
-                auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
+                auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(
+                    MQ_PROFILE_EXPR(Jacobian, p_gate->id_, n_qubits, 0, tensor::ops::MatMul(intrin_grad, jac)));
                 for (const auto& [name, idx] : title) {
                     f_and_g[1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
                 }
@@ -712,6 +780,7 @@ template <typename qs_policy_t_>
 auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradOneMulti(
     const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ, const circuit_t& herm_circ,
     const parameter::ParameterResolver& pr, const MST<size_t>& p_map, int n_thread) const -> VT<py_qs_datas_t> {
+    MQ_TRACE_SCOPE("GetExpectationWithNoiseGradOneMulti", "gradient");
     if (circ.size() != herm_circ.size()) {
         std::runtime_error("In density matrix mode, circ and herm_circ must be the same size.");
     }
@@ -726,6 +795,8 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradOneMulti(
     if (n_thread > static_cast<int>(n_hams)) {
         n_thread = n_hams;
     }
+    // sim_qs and a workspace for channels, plus one Hamiltonian matrix per Hamiltonian of a group.
+    n_thread = static_cast<int>(memory::FitConcurrency(n_thread, StateBytes(), 2 * StateBytes()));
     VT<py_qs_datas_t> f_and_g(n_hams, py_qs_datas_t((1 + p_map.size()), 0));
     derived_t sim_qs = *this;
     sim_qs.ApplyCircuit(circ, pr);
@@ -758,7 +829,8 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradOneMulti(
                     }
                     for (int j = start; j < end; j++) {
                         auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_hams[j - start].qs, circ[n], pr, dim);
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
+                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(
+                            MQ_PROFILE_EXPR(Jacobian, p_gate->id_, n_qubits, 0, tensor::ops::MatMul(intrin_grad, jac)));
                         for (const auto& [name, idx] : title) {
                             f_and_g[j][1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
                         }
@@ -779,6 +851,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradMultiMulti(
     const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ, const circuit_t& herm_circ,
     const VVT<calc_type>& enc_data, const VT<calc_type>& ans_data, const VS& enc_name, const VS& ans_name,
     size_t batch_threads, size_t mea_threads) const -> VT<VT<py_qs_datas_t>> {
+    MQ_TRACE_SCOPE("GetExpectationWithNoiseGradMultiMulti", "gradient");
     auto n_hams = hams.size();
     auto n_prs = enc_data.size();
     auto n_params = enc_name.size() + ans_name.size();
@@ -808,6 +881,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradMultiMulti(
         if (batch_threads == 0) {
             throw std::runtime_error("batch_threads cannot be zero.");
         }
+        batch_threads = memory::FitBatches(batch_threads, (2 + std::min(mea_threads, n_hams)) * StateBytes());
         std::vector<std::thread> tasks;
         tasks.reserve(batch_threads);
         size_t end = 0;
@@ -820,6 +894,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradMultiMulti(
                 end += 1;
             }
             auto task = [&, start, end]() {
+                MQ_TRACE_SCOPE("GradBatch", "gradient");
                 for (size_t n = start; n < end; n++) {
                     parameter::ParameterResolver pr = parameter::ParameterResolver();
                     pr.SetItems(enc_name, enc_data[n]);
@@ -841,6 +916,7 @@ template <typename qs_policy_t_>
 VT<unsigned> DensityMatrixState<qs_policy_t_>::Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr,
                                                         size_t shots, const MST<size_t>& key_map,
                                                         unsigned int seed) const {
+    MQ_TRACE_SCOPE("Sampling", "simulator");
     auto key_size = key_map.size();
     VT<unsigned> res(shots * key_size);
     RndEngine rnd_eng = RndEngine(seed);
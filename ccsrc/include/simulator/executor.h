@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_EXECUTOR_HPP
+#define INCLUDE_SIMULATOR_EXECUTOR_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mindquantum::sim {
+enum class TaskState {
+    Pending,
+    Running,
+    Finished,
+    Cancelled,
+};
+
+//! Unit of work submitted to an Executor.
+class TaskBase {
+ public:
+    virtual ~TaskBase() = default;
+
+    TaskState State() const;
+
+    //! Whether the task is finished or cancelled.
+    bool Done() const;
+
+    //! Cancel the task if it has not started yet, return whether it is cancelled.
+    bool Cancel();
+
+    //! Block until the task is done.
+    void Wait() const;
+
+    //! Block until the task is done, throw the exception raised by the task or a cancellation error.
+    void Get() const;
+
+    //! Call fn once the task is done, on the thread that finishes or cancels it, or right away if it is done.
+    void AddDoneCallback(std::function<void()> fn);
+
+ protected:
+    virtual void Execute() = 0;
+
+ private:
+    friend class Executor;
+    //! Run the task on the current thread, do nothing if it was cancelled.
+    void Run();
+    void Finish(TaskState state, std::exception_ptr error);
+    //! Notify the waiters and run the done callbacks, called with the state set and the mutex released.
+    void NotifyDone();
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cv_;
+    TaskState state_ = TaskState::Pending;
+    std::exception_ptr error_;
+    std::vector<std::function<void()>> callbacks_;
+};
+
+template <typename R>
+class Task : public TaskBase {
+ public:
+    explicit Task(std::function<R()> fn) : fn_(std::move(fn)) {
+    }
+
+    //! Block until the task is done and return its result.
+    const R& Result() const {
+        Get();
+        return result_;
+    }
+
+ protected:
+    void Execute() override {
+        result_ = fn_();
+        fn_ = nullptr;
+    }
+
+ private:
+    std::function<R()> fn_;
+    R result_{};
+};
+
+/**
+ * Fixed size thread pool with a bounded queue of pending tasks.
+ *
+ * Submit blocks while the queue is full, so producers can not run arbitrarily far ahead of the workers. OpenMP
+ * parallel regions inside a task are limited to an equal share of the available threads between the tasks in
+ * flight (running or queued) when it starts, so a lone task keeps all the threads and several tasks running at the
+ * same time do not oversubscribe the cores.
+ */
+class Executor {
+ public:
+    Executor(size_t n_workers, size_t max_queue);
+    ~Executor();
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    //! Process wide executor, created with one worker per hardware thread on first use.
+    static Executor& Global();
+
+    //! Enqueue a task, block while the queue is full.
+    void Submit(const std::shared_ptr<TaskBase>& task);
+
+    //! Wrap a callable into a Task and submit it.
+    template <typename F>
+    auto Async(F&& fn) {
+        using result_t = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<Task<result_t>>(std::forward<F>(fn));
+        Submit(task);
+        return task;
+    }
+
+    size_t Workers() const;
+    size_t MaxQueue() const;
+    //! Number of tasks waiting for a worker.
+    size_t Pending() const;
+
+ private:
+    void WorkerLoop();
+
+    size_t n_workers_;
+    size_t max_queue_;
+    int omp_threads_ = 1;
+    size_t running_ = 0;
+    bool stop_ = false;
+    std::deque<std::shared_ptr<TaskBase>> queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::vector<std::thread> workers_;
+};
+}  // namespace mindquantum::sim
+#endif
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_MPS_MPS_STATE_HPP
+#define INCLUDE_SIMULATOR_MPS_MPS_STATE_HPP
+
+#include <array>
+#include <complex>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "ops/hamiltonian.h"
+
+namespace mindquantum::sim::mps {
+/**
+ * Matrix product state of n qubits, in mixed canonical form.
+ *
+ * Site i holds two matrices A_i[0], A_i[1] of size chi_{i-1} x chi_i, the amplitude of |s_0 ... s_{n-1}> (s_i the
+ * bit of qubit i) being A_0[s_0] ... A_{n-1}[s_{n-1}]. Sites left of the orthogonality center are left isometries,
+ * sites right of it are right isometries, so the norm of the state is the norm of the center site.
+ *
+ * Single qubit gates act on one site. A gate on k > 1 qubits (controls included) first moves its qubits next to
+ * each other with SWAP gates, contracts the k sites, applies the gate matrix and splits the block back with SVDs,
+ * keeping at most max_bond singular values and dropping the smallest ones whose squared sum stays within the
+ * truncation error. The SWAP gates are undone afterwards.
+ */
+class MPSState {
+ public:
+    using calc_type = double;
+    using py_qs_data_t = std::complex<double>;
+    using matrix_t = Eigen::MatrixXcd;
+    using site_t = std::array<matrix_t, 2>;
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    static constexpr index_t default_max_bond = 256;
+    static constexpr double default_truncation_error = 1e-14;
+
+    explicit MPSState(qbit_t n_qubits, unsigned seed = 42);
+
+    qbit_t GetQubits() const {
+        return n_qubits_;
+    }
+
+    //! Reset to the zero state, with bond dimension 1.
+    void Reset();
+
+    //! Apply a gate or a measurement, return the measurement result.
+    index_t ApplyGate(const std::shared_ptr<BasicGate>& gate,
+                      const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    std::map<std::string, int> ApplyCircuit(const circuit_t& circ,
+                                            const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    //! Same layout as VectorState::Sampling.
+    VT<unsigned> Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr, size_t shots,
+                          const MST<size_t>& key_map, unsigned seed) const;
+
+    //! Expectation of a Hamiltonian given as Pauli terms, each term only contracts the sites between its support and
+    //! the orthogonality center.
+    py_qs_data_t GetExpectation(const Hamiltonian<calc_type>& ham) const;
+
+    //! Amplitude of a basis state, bits[i] is the bit of qubit i.
+    py_qs_data_t GetAmplitude(const VT<uint8_t>& bits) const;
+
+    //! Full state vector, for states of at most 30 qubits.
+    VT<py_qs_data_t> GetQS() const;
+
+    //! Dimension of the n - 1 bonds, bond i links qubit i and i + 1.
+    VT<index_t> GetBondDims() const;
+
+    //! Sum of the squared singular values dropped so far, relative to the norm of the split block.
+    double GetTruncationError() const {
+        return discarded_;
+    }
+
+    void SetMaxBond(index_t max_bond);
+    index_t GetMaxBond() const {
+        return max_bond_;
+    }
+
+    //! Relative squared weight of the singular values that may be dropped at each split.
+    void SetTruncationThreshold(double threshold);
+    double GetTruncationThreshold() const {
+        return truncation_;
+    }
+
+    //! Matrix of a gate without its controls, bit j of the local index is obj_qubits_[j].
+    //! The backend name is only used in the error message of unsupported gates.
+    static matrix_t GateMatrix(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr,
+                               const std::string& backend = "MPS");
+
+ private:
+    //! Apply a matrix of 2^k x 2^k on qubits, qubits[0] is the lowest bit of the local index.
+    void ApplyMatrix(const qbits_t& qubits, const matrix_t& m);
+
+    //! Apply a matrix on the sites first .. first + k - 1, site first is the lowest bit of the local index.
+    void ApplyBlock(qbit_t first, qbit_t k, const matrix_t& m);
+
+    void SwapSites(qbit_t site);
+    void MoveCenter(qbit_t site);
+    index_t Measure(qbit_t qubit);
+
+    std::vector<site_t> sites_;
+    qbit_t n_qubits_;
+    qbit_t center_ = 0;
+    unsigned seed_;
+    std::mt19937 rnd_eng_;
+    index_t max_bond_ = default_max_bond;
+    double truncation_ = default_truncation_error;
+    double discarded_ = 0;
+};
+}  // namespace mindquantum::sim::mps
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_PROFILER_HPP
+#define INCLUDE_SIMULATOR_PROFILER_HPP
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "ops/gate_id.h"
+#include "simulator/timer.h"
+
+namespace mindquantum::profiler {
+//! Simulator phases tracked by the profiler. Phases nest, e.g. ParameterResolve is also counted in ApplyGate.
+enum class Phase : uint8_t {
+    ApplyGate,
+    ApplyChannel,
+    Expectation,
+    Gradient,
+    ParameterResolve,
+    Jacobian,
+};
+
+std::string_view PhaseName(Phase phase);
+
+struct Stat {
+    uint64_t calls = 0;
+    uint64_t time_ns = 0;
+    uint64_t bytes = 0;
+};
+
+struct Entry {
+    Phase phase;
+    GateID gate;
+    qbit_t n_qubits;
+    Stat stat;
+};
+
+/**
+ * Process wide accumulator of the time spent per phase, gate and qubit number.
+ *
+ * Every thread writes in its own table, so recording does not contend with other threads. The tables are merged when
+ * a report is requested.
+ */
+class Profiler {
+ public:
+    static Profiler& Instance();
+
+    //! Whether the simulators are compiled with profiling (ENABLE_PROFILING).
+    static constexpr bool Enabled() {
+#ifdef ENABLE_PROFILING
+        return true;
+#else
+        return false;
+#endif  // ENABLE_PROFILING
+    }
+
+    void Add(Phase phase, GateID gate, qbit_t n_qubits, uint64_t time_ns, uint64_t bytes);
+
+    //! Merge the tables of all threads.
+    std::vector<Entry> Report() const;
+
+    void Reset();
+
+ private:
+    using key_t = std::tuple<Phase, GateID, qbit_t>;
+    struct LocalTable {
+        std::mutex mutex;
+        std::map<key_t, Stat> data;
+    };
+
+    LocalTable& Local();
+
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<LocalTable>> tables_;
+};
+
+//! Record the lifetime of the scope in the profiler.
+class ProfileScope {
+ public:
+    ProfileScope(Phase phase, GateID gate, qbit_t n_qubits, uint64_t bytes)
+        : phase_(phase), gate_(gate), n_qubits_(n_qubits), bytes_(bytes), start_(timer::NOW()) {
+    }
+    ~ProfileScope();
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+ private:
+    Phase phase_;
+    GateID gate_;
+    qbit_t n_qubits_;
+    uint64_t bytes_;
+    timer::TimePoint start_;
+};
+}  // namespace mindquantum::profiler
+
+#define MQ_PROFILE_CONCAT_IMPL(a, b) a##b
+#define MQ_PROFILE_CONCAT(a, b)      MQ_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_PROFILING
+//! Profile the enclosing scope.
+#    define MQ_PROFILE_SCOPE(phase, gate, n_qubits, bytes)                                                             \
+        ::mindquantum::profiler::ProfileScope MQ_PROFILE_CONCAT(mq_profile_scope_, __LINE__)(                          \
+            ::mindquantum::profiler::Phase::phase, gate, n_qubits, bytes)
+//! Profile the evaluation of an expression and return its value.
+#    define MQ_PROFILE_EXPR(phase, gate, n_qubits, bytes, ...)                                                         \
+        ([&]() {                                                                                                       \
+            MQ_PROFILE_SCOPE(phase, gate, n_qubits, bytes);                                                            \
+            return __VA_ARGS__;                                                                                        \
+        }())
+#else
+#    define MQ_PROFILE_SCOPE(phase, gate, n_qubits, bytes)                                                             \
+        do {                                                                                                           \
+        } while (0)
+#    define MQ_PROFILE_EXPR(phase, gate, n_qubits, bytes, ...) (__VA_ARGS__)
+#endif  // ENABLE_PROFILING
+
+#endif
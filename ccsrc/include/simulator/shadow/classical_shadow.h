@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_SHADOW_CLASSICAL_SHADOW_HPP
+#define INCLUDE_SIMULATOR_SHADOW_CLASSICAL_SHADOW_HPP
+
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "ops/hamiltonian.h"
+#include "simulator/stabilizer/tableau.h"
+
+namespace mindquantum::sim::shadow {
+using amp_t = std::complex<double>;
+using stabilizer::word_t;
+
+/**
+ * Classical shadow of a state from random local Pauli measurements.
+ *
+ * Each snapshot measures every qubit in a uniformly random basis X, Y or Z. Random local Clifford measurements give
+ * the same outcomes up to a relabeling, so they share this estimator. Snapshots are stored bit packed, the basis as
+ * the x and z bits of a Pauli string and the outcomes as one bit per qubit.
+ *
+ * The outcomes are sampled qubit by qubit from the state. The snapshots are grouped by their basis on the current
+ * qubit, the probability of each outcome is computed once per group, and each snapshot draws its outcome. Then the
+ * state is projected on that outcome, which halves it for the next qubit. Snapshots sharing the first k bases and
+ * outcomes share the work on the first k qubits, so a batch costs far less than one rotated copy of the state per
+ * snapshot.
+ *
+ * A Pauli string P of weight w is estimated by 3^w (-1)^(sum of outcomes on its support) on the snapshots whose
+ * bases match P on its support, and 0 on the others. The mean over groups of snapshots is combined by a median.
+ */
+class ClassicalShadow {
+ public:
+    explicit ClassicalShadow(qbit_t n_qubits, unsigned seed = 42);
+
+    qbit_t GetQubits() const {
+        return n_qubits_;
+    }
+
+    index_t GetSnapshotCount() const {
+        return n_snapshots_;
+    }
+
+    //! Add n_snapshots snapshots of the state given by its 2^n amplitudes, which need not be normalized.
+    void Sample(const VT<amp_t>& qs, index_t n_snapshots);
+
+    //! Remove all snapshots.
+    void Clear();
+
+    //! Basis of every snapshot on each qubit, 0, 1 and 2 for X, Y and Z.
+    VVT<uint8_t> GetBases() const;
+
+    //! Outcome of every snapshot on each qubit.
+    VVT<uint8_t> GetOutcomes() const;
+
+    //! Median of means estimate of the coefficient times the expectation of each term of a hamiltonian.
+    VT<double> EstimateTerms(const Hamiltonian<double>& ham, index_t n_groups) const;
+
+    //! Median of means estimate of the expectation of a hamiltonian, the terms summed per snapshot.
+    double EstimateExpectation(const Hamiltonian<double>& ham, index_t n_groups) const;
+
+ private:
+    //! Sample the snapshots ids[begin:end) on the qubits from qubit, whose state for the bases and outcomes drawn so
+    //! far is amp, qubit being its lowest bit.
+    void SampleNode(const VT<amp_t>& amp, qbit_t qubit, index_t* begin, index_t* end);
+
+    //! Per group mean of each term, as n_groups rows of n_terms values.
+    VT<double> GroupMeans(const Hamiltonian<double>& ham, index_t n_groups) const;
+
+    bool Bit(const VT<word_t>& bits, index_t snapshot, qbit_t q) const {
+        return (bits[snapshot * n_words_ + q / stabilizer::word_bits] >> (q % stabilizer::word_bits)) & 1;
+    }
+
+    qbit_t n_qubits_;
+    index_t n_words_;
+    index_t n_snapshots_ = 0;
+    VT<word_t> basis_x_;
+    VT<word_t> basis_z_;
+    VT<word_t> outcomes_;
+    std::mt19937 rnd_eng_;
+};
+}  // namespace mindquantum::sim::shadow
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_STABILIZER_NEAR_CLIFFORD_STATE_HPP
+#define INCLUDE_SIMULATOR_STABILIZER_NEAR_CLIFFORD_STATE_HPP
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "ops/hamiltonian.h"
+#include "simulator/stabilizer/tableau.h"
+
+namespace mindquantum::sim::stabilizer {
+/**
+ * Simulator of Clifford circuits with a few non-Clifford Pauli rotations.
+ *
+ * The state is a weighted sum of stabilizer states sharing one tableau |phi>:
+ *
+ * |psi> = sum_b a_b D_b |phi>,
+ *
+ * where D_b is the product of the destabilizers selected by the bit string b. These states are orthonormal, so the
+ * sum is a sparse vector in the basis of |phi>. Clifford gates only update the tableau and leave the amplitudes
+ * unchanged. A rotation exp(-i theta / 2 P) of a Pauli string P, like T, RZ, RX or Rzz, maps P D_b |phi> to
+ * +/- w D_(b ^ f) |phi>, with f the stabilizers anticommuting with P, so each branch splits in at most two and
+ * branches landing on the same b merge. At most 2^t branches are kept after t rotations, far less for circuits whose
+ * rotations act on the same stabilizers, and branches whose weight is below the truncation threshold are dropped.
+ */
+class NearCliffordState {
+ public:
+    using calc_type = double;
+    using amp_t = std::complex<double>;
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    explicit NearCliffordState(qbit_t n_qubits, unsigned seed = 42);
+
+    qbit_t GetQubits() const {
+        return tableau_.NQubits();
+    }
+
+    void Reset();
+
+    //! Apply a gate or a measurement, return the measurement result.
+    index_t ApplyGate(const std::shared_ptr<BasicGate>& gate,
+                      const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    std::map<std::string, int> ApplyCircuit(const circuit_t& circ,
+                                            const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    //! Same layout as VectorState::Sampling.
+    VT<unsigned> Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr, size_t shots,
+                          const MST<size_t>& key_map, unsigned seed) const;
+
+    //! Expectation of a Hamiltonian given as Pauli terms.
+    std::complex<double> GetExpectation(const Hamiltonian<calc_type>& ham) const;
+
+    //! Number of stabilizer states in the sum.
+    index_t GetBranchCount() const {
+        return branches_.size();
+    }
+
+    //! Sum of the weights of the dropped branches, one minus it estimates the fidelity with the exact state.
+    double GetTruncationError() const {
+        return truncation_error_;
+    }
+
+    //! Branches whose weight is below threshold are dropped after each rotation.
+    void SetTruncationThreshold(double threshold);
+    double GetTruncationThreshold() const {
+        return threshold_;
+    }
+
+ private:
+    using key_t = std::vector<word_t>;
+    struct KeyHash {
+        size_t operator()(const key_t& key) const;
+    };
+    using branches_t = std::unordered_map<key_t, amp_t, KeyHash>;
+
+    //! P |phi> = omega D_flip |phi>, and P anticommutes with the destabilizers in anti.
+    struct PauliAction {
+        key_t flip;
+        key_t anti;
+        amp_t omega;
+    };
+
+    PauliAction Act(const PauliBits& pauli) const;
+
+    //! <psi|P|psi>.
+    amp_t Expectation(const PauliBits& pauli) const;
+
+    //! |psi> <- c0 |psi> + c1 P |psi>.
+    void Combine(const PauliBits& pauli, amp_t c0, amp_t c1);
+
+    //! Drop the branches below the threshold and renormalize.
+    void Truncate();
+
+    //! Pauli string and angle of a gate that is a rotation exp(-i theta / 2 P) up to a global phase.
+    bool RotationOf(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr, PauliBits* pauli,
+                    double* theta) const;
+
+    index_t Measure(qbit_t q);
+
+    Tableau tableau_;
+    branches_t branches_;
+    double threshold_ = 1e-14;
+    double truncation_error_ = 0;
+    unsigned seed_;
+    std::mt19937 rnd_eng_;
+};
+}  // namespace mindquantum::sim::stabilizer
+
+#endif
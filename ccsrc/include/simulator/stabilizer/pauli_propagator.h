@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_STABILIZER_PAULI_PROPAGATOR_HPP
+#define INCLUDE_SIMULATOR_STABILIZER_PAULI_PROPAGATOR_HPP
+
+#include <memory>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "ops/hamiltonian.h"
+#include "simulator/stabilizer/tableau.h"
+
+namespace mindquantum::sim::stabilizer {
+/**
+ * Expectation engine in the Heisenberg picture.
+ *
+ * The observable is a weighted sum of bit packed Pauli strings and is propagated backwards through the circuit,
+ * O <- G^dagger O G. Clifford gates map each string to one string, a rotation exp(-i theta / 2 Q) keeps the strings
+ * commuting with Q and splits the others in cos(theta) P + i sin(theta) Q P, equal strings being merged. Gates
+ * outside the support of a string leave it unchanged, so only the backward light cone of the observable is ever
+ * touched. Strings whose coefficient is below the threshold or whose weight is above the maximum weight are dropped,
+ * the sum of their absolute coefficients bounds the error of the result. The propagated strings are finally evaluated
+ * on a product state, where only the qubits in their support matter.
+ */
+class PauliPropagator {
+ public:
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    explicit PauliPropagator(qbit_t n_qubits);
+
+    qbit_t GetQubits() const {
+        return n_qubits_;
+    }
+
+    void SetCoefficientThreshold(double threshold);
+    double GetCoefficientThreshold() const {
+        return threshold_;
+    }
+
+    //! Strings acting on more qubits than max_weight are dropped.
+    void SetMaxWeight(qbit_t max_weight);
+    qbit_t GetMaxWeight() const {
+        return max_weight_;
+    }
+
+    //! Initial product state, given as the Bloch vector (x, y, z) of each qubit. Default is |0...0>.
+    void SetProductState(const VT<VT<double>>& bloch);
+
+    //! <psi0| U^dagger H U |psi0> for the circuit U, which may hold Clifford gates and Pauli rotations.
+    double GetExpectation(const Hamiltonian<double>& ham, const circuit_t& circ,
+                          const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    //! Largest number of strings during the last propagation.
+    index_t GetMaxTermCount() const {
+        return max_term_count_;
+    }
+
+    //! Sum of the absolute coefficients dropped during the last propagation, a bound of its error.
+    double GetTruncatedWeight() const {
+        return truncated_weight_;
+    }
+
+ private:
+    struct Term {
+        PauliBits pauli;
+        double coeff;
+    };
+
+    //! Conjugate the strings by a gate.
+    void Conjugate(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr,
+                   std::vector<Term>* terms);
+
+    //! Conjugate the strings by exp(-i theta / 2 Q).
+    void Rotate(const PauliBits& q, double theta, std::vector<Term>* terms);
+
+    //! Merge equal strings and drop the small and heavy ones.
+    void Compress(std::vector<Term>* terms);
+
+    double Evaluate(const Term& term) const;
+
+    qbit_t n_qubits_;
+    double threshold_ = 1e-12;
+    qbit_t max_weight_;
+    VT<VT<double>> bloch_;
+    bool zero_state_ = true;
+    index_t max_term_count_ = 0;
+    double truncated_weight_ = 0;
+};
+}  // namespace mindquantum::sim::stabilizer
+
+#endif
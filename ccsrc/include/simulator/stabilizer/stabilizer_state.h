@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_STABILIZER_STABILIZER_STATE_HPP
+#define INCLUDE_SIMULATOR_STABILIZER_STABILIZER_STATE_HPP
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "ops/hamiltonian.h"
+#include "simulator/stabilizer/tableau.h"
+
+namespace mindquantum::sim::stabilizer {
+/**
+ * Stabilizer state simulator of Clifford circuits.
+ *
+ * Supports I, X, Y, Z, H, S, Sdag, SWAP, X, Y and Z with one control (CNOT, CY, CZ) and measurements, any other gate
+ * throws std::invalid_argument. Sampling runs the circuit once on the tableau for a reference sample, then propagates
+ * bit packed Pauli frames for 64 shots per word operation.
+ */
+class StabilizerState {
+ public:
+    using calc_type = double;
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    explicit StabilizerState(qbit_t n_qubits, unsigned seed = 42);
+
+    qbit_t GetQubits() const {
+        return tableau_.NQubits();
+    }
+
+    void Reset();
+
+    //! Apply a gate or a measurement, return the measurement result.
+    index_t ApplyGate(const std::shared_ptr<BasicGate>& gate,
+                      const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    std::map<std::string, int> ApplyCircuit(const circuit_t& circ,
+                                            const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    //! Same layout as VectorState::Sampling.
+    VT<unsigned> Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr, size_t shots,
+                          const MST<size_t>& key_map, unsigned seed) const;
+
+    //! Expectation of a Hamiltonian given as Pauli terms.
+    std::complex<double> GetExpectation(const Hamiltonian<calc_type>& ham) const;
+
+    //! Stabilizer generators like "+XZI", qubit 0 first.
+    VT<std::string> GetStabilizers() const;
+
+    const Tableau& GetTableau() const {
+        return tableau_;
+    }
+
+    //! Whether the gate is a Clifford gate or a measurement supported by the tableau.
+    static bool IsSupported(const std::shared_ptr<BasicGate>& gate);
+
+    //! Throw if the gate is not supported by the tableau.
+    static void CheckGate(const std::shared_ptr<BasicGate>& gate);
+
+    //! Apply a Clifford gate on a tableau.
+    static void ApplyClifford(Tableau* tableau, const std::shared_ptr<BasicGate>& gate);
+
+ private:
+    Tableau tableau_;
+    unsigned seed_;
+    std::mt19937 rnd_eng_;
+};
+}  // namespace mindquantum::sim::stabilizer
+
+#endif
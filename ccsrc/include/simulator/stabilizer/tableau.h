@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_STABILIZER_TABLEAU_HPP
+#define INCLUDE_SIMULATOR_STABILIZER_TABLEAU_HPP
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/mq_base_types.h"
+
+namespace mindquantum::sim::stabilizer {
+using word_t = uint64_t;
+constexpr qbit_t word_bits = 64;
+
+//! Number of words holding n bits.
+inline index_t NWords(qbit_t n) {
+    return static_cast<index_t>((n + word_bits - 1) / word_bits);
+}
+
+//! Pauli string without phase, bit q of x and z set for X (x), Z (z) or Y (both) on qubit q.
+struct PauliBits {
+    std::vector<word_t> x;
+    std::vector<word_t> z;
+
+    explicit PauliBits(qbit_t n_qubits = 0) : x(NWords(n_qubits), 0), z(NWords(n_qubits), 0) {
+    }
+
+    //! Set qubit q to the Pauli 'I', 'X', 'Y' or 'Z'.
+    void Set(qbit_t q, char pauli);
+};
+
+/*!
+ * \brief (xh, zh) <- (xi, zi) * (xh, zh) for Pauli strings of n_words words.
+ *
+ * \return The power of i, modulo 4, of the product relative to the Hermitian Pauli string left in (xh, zh).
+ */
+int MultiplyPauli(word_t* xh, word_t* zh, const word_t* xi, const word_t* zi, index_t n_words);
+
+//! Whether two Pauli strings anticommute.
+bool AntiCommute(const word_t* x1, const word_t* z1, const word_t* x2, const word_t* z2, index_t n_words);
+
+/**
+ * Stabilizer tableau of Aaronson and Gottesman (CHP).
+ *
+ * Rows 0 .. n-1 are the destabilizers, rows n .. 2n-1 the stabilizer generators and row 2n is scratch space. Each row
+ * is a Pauli string with a sign, stored as bit packed x and z words, so multiplying two rows (RowSum) handles 64
+ * qubits per word operation. Gates update one or two columns of every row.
+ */
+class Tableau {
+ public:
+    explicit Tableau(qbit_t n_qubits);
+
+    qbit_t NQubits() const {
+        return n_qubits_;
+    }
+
+    void H(qbit_t q);
+    void S(qbit_t q);
+    void Sdag(qbit_t q);
+    void X(qbit_t q);
+    void Y(qbit_t q);
+    void Z(qbit_t q);
+    void CNOT(qbit_t ctrl, qbit_t obj);
+    void CZ(qbit_t q0, qbit_t q1);
+    void SWAP(qbit_t q0, qbit_t q1);
+
+    //! Whether measuring qubit q in the Z basis has a random outcome.
+    bool IsRandom(qbit_t q) const;
+
+    //! Measure qubit q in the Z basis and collapse, random outcomes are drawn from rng.
+    index_t Measure(qbit_t q, std::mt19937* rng);
+
+    //! Collapse a random Z measurement of qubit q to the given outcome, the stabilizer replaced by +/- Z_q is returned.
+    index_t Collapse(qbit_t q, index_t outcome);
+
+    /*!
+     * \brief Expectation of a Pauli string: 0 if it anticommutes with a stabilizer, else +1 or -1.
+     *
+     * A commuting Pauli string is, up to sign, the product of the stabilizers whose destabilizer it anticommutes
+     * with, the sign comes from multiplying them.
+     */
+    int Expectation(const PauliBits& pauli) const;
+
+    //! Stabilizer generator i as a string like "+XZI", qubit 0 first.
+    std::string Stabilizer(qbit_t i) const;
+
+    //! Bits of row i, for the Pauli frame sampler.
+    const word_t* RowX(index_t row) const {
+        return &x_[row * n_words_];
+    }
+    const word_t* RowZ(index_t row) const {
+        return &z_[row * n_words_];
+    }
+    bool RowSign(index_t row) const {
+        return r_[row] != 0;
+    }
+
+ private:
+    bool GetX(index_t row, qbit_t q) const {
+        return (x_[row * n_words_ + q / word_bits] >> (q % word_bits)) & 1;
+    }
+    bool GetZ(index_t row, qbit_t q) const {
+        return (z_[row * n_words_ + q / word_bits] >> (q % word_bits)) & 1;
+    }
+
+    //! (xh, zh, rh) <- (xi, zi, ri) * (xh, zh, rh), the sign bit r is set for a -1 phase.
+    void Multiply(word_t* xh, word_t* zh, uint8_t* rh, const word_t* xi, const word_t* zi, uint8_t ri) const;
+
+    //! Row h <- row i * row h.
+    void RowSum(index_t h, index_t i) {
+        Multiply(&x_[h * n_words_], &z_[h * n_words_], &r_[h], RowX(i), RowZ(i), r_[i]);
+    }
+    void RowCopy(index_t dst, index_t src);
+    void RowClear(index_t row);
+
+    //! Call f(x, z, r) on the words holding column q of every row, with the bit mask of q in its word.
+    template <typename F>
+    void ForColumn(qbit_t q, const F& f);
+
+    qbit_t n_qubits_;
+    index_t n_words_;
+    std::vector<word_t> x_;
+    std::vector<word_t> z_;
+    std::vector<uint8_t> r_;
+};
+}  // namespace mindquantum::sim::stabilizer
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_SUBSPACE_PARTICLE_STATE_HPP
+#define INCLUDE_SIMULATOR_SUBSPACE_PARTICLE_STATE_HPP
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "ops/hamiltonian.h"
+
+namespace mindquantum::sim::subspace {
+/**
+ * State of n qubits restricted to the basis states with N qubits set, a space of dimension C(n, N).
+ *
+ * The basis states are stored in increasing order, which for a fixed popcount is the colexicographic order of the
+ * combinations: the state with set bits p_1 < ... < p_N has rank C(p_1, 1) + C(p_2, 2) + ... + C(p_N, N). A gate on
+ * k qubits (controls included) must conserve the number of set bits, its matrix is then block diagonal in the
+ * popcount of the local index and each block mixes the basis states that only differ on the gate qubits. Such gates
+ * are the diagonal ones (Z, S, T, PS, RZ, Rzz, GP and their controlled forms), SWAP, ISWAP, FSim and number
+ * conserving custom matrices, like Givens rotations. The fermionic excitations SE and DE are applied on pairs of
+ * basis states, with their Jordan-Wigner sign.
+ *
+ * The initial state has the N lowest qubits set, the Hartree-Fock state of a Jordan-Wigner encoded molecule.
+ */
+class ParticleState {
+ public:
+    using py_qs_data_t = std::complex<double>;
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    ParticleState(qbit_t n_qubits, qbit_t n_particles);
+
+    qbit_t GetQubits() const {
+        return n_qubits_;
+    }
+    qbit_t GetParticles() const {
+        return n_particles_;
+    }
+    //! Dimension C(n, N) of the subspace.
+    index_t GetDim() const {
+        return dim_;
+    }
+
+    //! Reset to the state with the N lowest qubits set.
+    void Reset();
+
+    //! Rank of a basis state with N bits set.
+    index_t Rank(uint64_t state) const;
+
+    //! Basis state of a rank.
+    uint64_t Unrank(index_t rank) const;
+
+    void ApplyGate(const std::shared_ptr<BasicGate>& gate,
+                   const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+    void ApplyCircuit(const circuit_t& circ, const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    //! Replace the state by P H P |psi>, P the projector on the subspace.
+    void ApplyHamiltonian(const Hamiltonian<double>& ham);
+
+    //! Expectation of a Hamiltonian given as Pauli terms, terms changing the number of set bits give zero.
+    py_qs_data_t GetExpectation(const Hamiltonian<double>& ham) const;
+
+    //! Amplitude of a basis state, bits[i] is the bit of qubit i.
+    py_qs_data_t GetAmplitude(const VT<uint8_t>& bits) const;
+
+    //! Amplitudes of the subspace, in rank order.
+    const VT<py_qs_data_t>& GetSubspaceQS() const {
+        return qs_;
+    }
+    void SetSubspaceQS(const VT<py_qs_data_t>& qs);
+
+    //! Full state vector, for states of at most 30 qubits.
+    VT<py_qs_data_t> GetQS() const;
+
+ private:
+    //! Call f(rank, state) on the ranks [begin, end), following the basis states with Gosper's hack.
+    template <typename F>
+    void ForRange(index_t begin, index_t end, F&& f) const;
+
+    //! Call f(chunk, begin, end) on chunks of ranks, in parallel for large subspaces.
+    template <typename F>
+    void ForChunks(F&& f) const;
+
+    index_t NumChunks() const;
+
+    //! Fermionic single or double excitation, applied natively since its Jordan-Wigner sign depends on the modes
+    //! between the object qubits.
+    void ApplyExcitation(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr);
+
+    qbit_t n_qubits_;
+    qbit_t n_particles_;
+    index_t dim_;
+    //! binom_[p][k] = C(p, k) for p <= n and k <= N.
+    VT<VT<index_t>> binom_;
+    VT<py_qs_data_t> qs_;
+};
+}  // namespace mindquantum::sim::subspace
+
+#endif
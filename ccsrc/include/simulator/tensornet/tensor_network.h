@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_TENSORNET_TENSOR_NETWORK_HPP
+#define INCLUDE_SIMULATOR_TENSORNET_TENSOR_NETWORK_HPP
+
+#include <complex>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "ops/hamiltonian.h"
+
+namespace mindquantum::sim::tensornet {
+using amp_t = std::complex<double>;
+
+//! Dense tensor whose indices all have dimension 2, bit j of the element index is edges[j].
+struct Tensor {
+    std::vector<index_t> edges;
+    std::vector<amp_t> data;
+};
+
+//! Contraction order of a network: steps[i] merges two tensors into a new one appended at the end.
+struct ContractionPath {
+    std::vector<std::pair<size_t, size_t>> steps;
+    //! Edges fixed to 0 and 1 in turn, the slices being summed.
+    std::vector<index_t> sliced;
+    //! Number of multiply-adds of one slice.
+    double flops = 0;
+    //! Largest log2 size of an intermediate tensor of one slice.
+    qbit_t max_rank = 0;
+};
+
+/**
+ * Tensor network contraction of circuits, for amplitudes and local expectations of shallow circuits on many qubits.
+ *
+ * Each gate becomes a tensor with one input and one output edge per qubit (controls included). The contraction order
+ * comes from a greedy search, merging at each step the pair of tensors that shrinks the network most, repeated with
+ * randomly perturbed costs to keep the cheapest order. Edges are then sliced until every intermediate tensor has at
+ * most 2^max_rank elements, bounding the memory. Two tensors are contracted as a matrix product, after permuting their
+ * shared edges to the inner dimension.
+ *
+ * For an expectation <psi|P|psi>, only the gates in the backward light cone of P are kept, the others cancel with their
+ * adjoint in U^dagger P U.
+ */
+class TensorNetwork {
+ public:
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    explicit TensorNetwork(qbit_t n_qubits, unsigned seed = 42);
+
+    qbit_t GetQubits() const {
+        return n_qubits_;
+    }
+
+    //! Largest log2 size of the intermediate tensors, edges are sliced to fit.
+    void SetMaxRank(qbit_t max_rank);
+    qbit_t GetMaxRank() const {
+        return max_rank_;
+    }
+
+    //! Number of greedy searches, the first one without random perturbation.
+    void SetOrderTrials(index_t trials);
+    index_t GetOrderTrials() const {
+        return trials_;
+    }
+
+    //! Amplitudes <x|U|0...0>, bits[k][q] being the bit of qubit q in the k-th basis state.
+    VT<amp_t> GetAmplitudes(const circuit_t& circ, const VT<VT<uint8_t>>& bits,
+                            const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    //! <0...0|U^dagger H U|0...0>, each Pauli term contracted on its own light cone.
+    amp_t GetExpectation(const Hamiltonian<double>& ham, const circuit_t& circ,
+                         const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    //! Contraction path of the last network.
+    const ContractionPath& GetLastPath() const {
+        return last_path_;
+    }
+
+    //! Find a contraction path of a network.
+    ContractionPath FindPath(const std::vector<Tensor>& network);
+
+    //! Contract a network into a scalar along a path.
+    static amp_t Contract(const std::vector<Tensor>& network, const ContractionPath& path);
+
+    //! Contract two tensors over their shared edges, the result has the free edges of a then those of b.
+    static Tensor ContractPair(const Tensor& a, const Tensor& b);
+
+ private:
+    qbit_t n_qubits_;
+    qbit_t max_rank_ = 26;
+    index_t trials_ = 16;
+    std::mt19937 rnd_eng_;
+    ContractionPath last_path_;
+};
+}  // namespace mindquantum::sim::tensornet
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_SIMULATOR_TRANSPORT_HPP
+#define INCLUDE_SIMULATOR_TRANSPORT_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mindquantum::sim {
+/**
+ * Communication between the ranks of a distributed simulator.
+ *
+ * All operations are collective: every rank calls them in the same order with the same sizes.
+ */
+class Transport {
+ public:
+    virtual ~Transport() = default;
+
+    virtual int Rank() const = 0;
+    virtual int Size() const = 0;
+
+    //! Send \c bytes from \c send to \c peer and receive as many bytes from it in \c recv.
+    virtual void SendRecv(const void* send, void* recv, size_t bytes, int peer) = 0;
+
+    //! Gather \c bytes of every rank in \c recv, ordered by rank.
+    virtual void AllGather(const void* send, void* recv, size_t bytes) = 0;
+
+    //! Element wise sum of \c data over all ranks, in place.
+    virtual void AllReduceSum(double* data, size_t n) = 0;
+
+    virtual void Barrier() = 0;
+};
+
+/**
+ * Transport between processes of one machine through a POSIX shared memory segment.
+ *
+ * Every rank opens the segment with the same name, which should be unique for each run; the segment is unlinked
+ * once all ranks attached, so it is released when the processes exit. Each rank owns a mailbox of \c buffer_bytes,
+ * larger messages are split. Ranks should be pinned to their NUMA node by the launcher, e.g. numactl.
+ */
+class ShmTransport : public Transport {
+ public:
+    static constexpr size_t default_buffer_bytes = 1UL << 22;
+
+    ShmTransport(const std::string& name, int rank, int size, size_t buffer_bytes = default_buffer_bytes);
+    ~ShmTransport() override;
+    ShmTransport(const ShmTransport&) = delete;
+    ShmTransport& operator=(const ShmTransport&) = delete;
+
+    int Rank() const override {
+        return rank_;
+    }
+    int Size() const override {
+        return size_;
+    }
+    void SendRecv(const void* send, void* recv, size_t bytes, int peer) override;
+    void AllGather(const void* send, void* recv, size_t bytes) override;
+    void AllReduceSum(double* data, size_t n) override;
+    void Barrier() override;
+
+ private:
+    struct Header {
+        std::atomic<uint32_t> count;
+        std::atomic<uint32_t> sense;
+    };
+
+    char* Mailbox(int rank) const;
+
+    int rank_;
+    int size_;
+    size_t buffer_bytes_;
+    size_t segment_bytes_ = 0;
+    void* segment_ = nullptr;
+    Header* header_ = nullptr;
+    uint32_t local_sense_ = 0;
+};
+
+#ifdef ENABLE_MPI
+//! Transport over MPI_COMM_WORLD, MPI must be initialized by the caller.
+class MpiTransport : public Transport {
+ public:
+    MpiTransport();
+
+    int Rank() const override {
+        return rank_;
+    }
+    int Size() const override {
+        return size_;
+    }
+    void SendRecv(const void* send, void* recv, size_t bytes, int peer) override;
+    void AllGather(const void* send, void* recv, size_t bytes) override;
+    void AllReduceSum(double* data, size_t n) override;
+    void Barrier() override;
+
+ private:
+    int rank_ = 0;
+    int size_ = 1;
+};
+#endif  // ENABLE_MPI
+}  // namespace mindquantum::sim
+
+#endif
@@ -18,6 +18,7 @@
 #define INCLUDE_QUANTUMSTATE_UTILS_HPP
 
 #include <cassert>
+#include <string>
 #include <vector>
 
 #include "core/mq_base_types.h"
@@ -25,6 +26,8 @@
 namespace mindquantum::sim {
 index_t QIndexToMask(qbits_t objs);
 PauliMask GenPauliMask(const std::vector<PauliWord>& pws);
+//! Mask of a Pauli string, paulis[j] acting on objs[j].
+PauliMask GenPauliMask(const qbits_t& objs, const std::string& paulis);
 struct SingleQubitGateMask {
     qbit_t q0 = 0;
     qbits_t ctrl_qubits{};
@@ -51,6 +54,33 @@ struct DoubleQubitGateMask {
     DoubleQubitGateMask(const qbits_t& obj_qubits, const qbits_t& ctrl_qubits);
 };
 
+//! Masks of a fermionic excitation exp(theta (T - T^dagger)) on Jordan-Wigner encoded modes. The first half of the
+//! object qubits are created and the second half annihilated by T.
+struct ExcitationMask {
+    //! Object qubits in increasing order.
+    qbit_t sorted_qubits[4] = {0, 0, 0, 0};
+    qbit_t n_modes = 0;
+    index_t create_mask = 0UL;
+    index_t annihilate_mask = 0UL;
+    index_t obj_mask = 0UL;
+    index_t ctrl_mask = 0UL;
+    //! T|i> carries the sign (-1)^(popcount(i & parity_mask) + sign_bit) for i in the annihilated half.
+    index_t parity_mask = 0UL;
+    index_t sign_bit = 0UL;
+
+    ExcitationMask(const qbits_t& obj_qubits, const qbits_t& ctrl_qubits);
+};
+
+//! Insert a zero bit at each of the n sorted qubits of ori.
+#define SHIFT_BIT_N(sorted_qubits, n, ori, des)                                                                        \
+    do {                                                                                                               \
+        (des) = (ori);                                                                                                 \
+        for (qbit_t _k = 0; _k < (n); _k++) {                                                                          \
+            index_t _low = (index_t(1) << (sorted_qubits)[_k]) - 1;                                                    \
+            (des) = (((des) & ~_low) << 1) + ((des) & _low);                                                           \
+        }                                                                                                              \
+    } while (0)
+
 #define SHIFT_BIT_TWO(obj_low_mask, obj_rev_low_mask, obj_high_mask, obj_rev_high_mask, ori, des)                      \
     do {                                                                                                               \
         (des) = (((ori) & (obj_rev_low_mask)) << 1) + ((ori) & (obj_low_mask));                                        \
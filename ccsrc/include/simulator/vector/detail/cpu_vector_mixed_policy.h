@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INCLUDE_VECTOR_DETAIL_CPU_VECTOR_MIXED_POLICY_HPP
+#define INCLUDE_VECTOR_DETAIL_CPU_VECTOR_MIXED_POLICY_HPP
+#include <complex>
+#include <vector>
+
+#include "simulator/vector/detail/cpu_vector_policy.h"
+
+namespace mindquantum::sim::vector::detail {
+/**
+ * Mixed precision policy, amplitudes are stored as complex64 but computed in double.
+ *
+ * The state takes the memory of a complex64 state. Reductions (Vdot, ExpectationOfTerms, ExpectDiff*) accumulate in
+ * double through acc_type. The matrix, rotation, phase, excitation and ExpectDiff* kernels compute their coefficients
+ * in double through acc_data_t, convert the amplitudes to double at load and round them once at store. Permutation
+ * kernels are shared with the float policy, they do not add rounding errors.
+ */
+struct CPUVectorPolicyMixed : public CPUVectorPolicyBase<CPUVectorPolicyMixed, float> {
+    static void ApplySingleQubitMatrix(const qs_data_p_t& src, qs_data_p_t* des_p, qbit_t obj_qubit,
+                                       const qbits_t& ctrls, const std::vector<std::vector<acc_data_t>>& m,
+                                       index_t dim);
+    static void ApplySingleQubitMatrix(const qs_data_p_t& src, qs_data_p_t* des_p, qbit_t obj_qubit,
+                                       const qbits_t& ctrls, const std::vector<std::vector<py_qs_data_t>>& m,
+                                       index_t dim);
+    static void ApplyTwoQubitsMatrix(const qs_data_p_t& src, qs_data_p_t* des_p, const qbits_t& objs,
+                                     const qbits_t& ctrls, const std::vector<std::vector<acc_data_t>>& m,
+                                     index_t dim);
+    static void ApplyTwoQubitsMatrix(const qs_data_p_t& src, qs_data_p_t* des_p, const qbits_t& objs,
+                                     const qbits_t& ctrls, const std::vector<std::vector<py_qs_data_t>>& m,
+                                     index_t dim);
+};
+}  // namespace mindquantum::sim::vector::detail
+#endif
@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INCLUDE_VECTOR_DETAIL_CPU_VECTOR_OUT_OF_CORE_POLICY_HPP
+#define INCLUDE_VECTOR_DETAIL_CPU_VECTOR_OUT_OF_CORE_POLICY_HPP
+#include <string>
+
+#include "simulator/vector/detail/cpu_vector_policy.h"
+
+namespace mindquantum::sim::vector::detail {
+/**
+ * Double precision policy whose states live in memory mapped files.
+ *
+ * The file is created in the storage directory, which should be on a local NVMe drive. The OS pages the state in
+ * and out, so the state can be larger than the RAM as long as the kernels touch it in a cache friendly order, see
+ * OutOfCoreVectorState. All kernels are the generic ones of CPUVectorPolicyBase.
+ */
+struct CPUVectorPolicyOutOfCore : public CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double> {
+    static qs_data_p_t InitState(index_t dim, bool zero_state = true);
+
+    //! Directory of the state files, default to $MQ_OUT_OF_CORE_DIR, then $TMPDIR, then /tmp.
+    static void SetStorageDir(const std::string& dir);
+    static std::string StorageDir();
+};
+}  // namespace mindquantum::sim::vector::detail
+#endif
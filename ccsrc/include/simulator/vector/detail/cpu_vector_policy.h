@@ -22,6 +22,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -35,11 +36,26 @@
 namespace mindquantum::sim::vector::detail {
 struct CPUVectorPolicyAvxFloat;
 struct CPUVectorPolicyAvxDouble;
+struct CPUVectorPolicyMixed;
+
+//! Type used to accumulate reductions (inner products, expectations) of a policy.
+template <typename derived_, typename calc_type_>
+struct AccumulateType {
+    using type = calc_type_;
+};
+
+//! The mixed precision policy stores complex64 amplitudes but accumulates in double.
+template <>
+struct AccumulateType<CPUVectorPolicyMixed, float> {
+    using type = double;
+};
 
 template <typename derived_, typename calc_type_>
 struct CPUVectorPolicyBase {
     using derived = derived_;
     using calc_type = calc_type_;
+    using acc_type = typename AccumulateType<derived_, calc_type_>::type;
+    using acc_data_t = std::complex<acc_type>;
     using qs_data_t = std::complex<calc_type>;
     using qs_data_p_t = qs_data_t*;
     using py_qs_data_t = std::complex<calc_type>;
@@ -75,10 +91,15 @@ struct CPUVectorPolicyBase {
     static qs_data_t ConditionalCollect(const qs_data_p_t& qs, index_t mask, index_t condi, bool abs, index_t dim);
     static VT<py_qs_data_t> GetQS(const qs_data_p_t& qs, index_t dim);
     static void SetQS(qs_data_p_t* qs, const VT<qs_data_t>& qs_out, index_t dim);
+    static void SetQSFromBuffer(qs_data_p_t* qs_p, const py_qs_data_t* qs_out, index_t size, index_t dim);
     static qs_data_p_t ApplyTerms(qs_data_p_t* qs_p, const std::vector<PauliTerm<calc_type>>& ham, index_t dim);
     static py_qs_data_t ExpectationOfTerms(const qs_data_p_t& bra, const qs_data_p_t& ket,
                                            const std::vector<PauliTerm<calc_type>>& ham, index_t dim);
     static qs_data_p_t Copy(const qs_data_p_t& qs, index_t dim);
+    //! New owner of the buffer of qs, owners copy a shared buffer before writing it (copy on write).
+    static qs_data_p_t Share(const qs_data_p_t& qs, index_t dim);
+    //! Whether the buffer of qs has other owners.
+    static bool IsShared(const qs_data_p_t& qs);
     template <index_t mask, index_t condi>
     static py_qs_data_t ConditionVdot(const qs_data_p_t& bra, const qs_data_p_t& ket_p, index_t dim);
     static py_qs_data_t OneStateVdot(const qs_data_p_t& bra, const qs_data_p_t& ket, qbit_t obj_qubit, index_t dim);
@@ -105,7 +126,7 @@ struct CPUVectorPolicyBase {
     // Z like operator
     // ========================================================================================================
 
-    static void ApplyZLike(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls, qs_data_t val, index_t dim);
+    static void ApplyZLike(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls, acc_data_t val, index_t dim);
     static void ApplyZ(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls, index_t dim);
     // The crazy code spell check in CI do not allow apply s to name following API, even I set the filter file.
     static void ApplySGate(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls, index_t dim);
@@ -152,6 +173,12 @@ struct CPUVectorPolicyBase {
                          bool diff = false);
     static void ApplyRyz(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls, calc_type val, index_t dim,
                          bool diff = false);
+    //! exp(-i val / 2 P) for the Pauli string P, paulis[j] acting on objs[j], in one sweep over the state.
+    static void ApplyRPS(qs_data_p_t* qs_p, const qbits_t& objs, const std::string& paulis, const qbits_t& ctrls,
+                         calc_type val, index_t dim, bool diff = false);
+    //! Fermionic single or double excitation, objs holding the created then the annihilated modes.
+    static void ApplyExcitation(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls, calc_type val,
+                                index_t dim, bool diff = false);
 
     // gate_expectation
     // ========================================================================================================
@@ -181,6 +208,10 @@ struct CPUVectorPolicyBase {
                                    const qbits_t& ctrls, calc_type val, index_t dim);
     static qs_data_t ExpectDiffRyz(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
                                    const qbits_t& ctrls, calc_type val, index_t dim);
+    static qs_data_t ExpectDiffRPS(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
+                                   const std::string& paulis, const qbits_t& ctrls, calc_type val, index_t dim);
+    static qs_data_t ExpectDiffExcitation(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
+                                          const qbits_t& ctrls, calc_type val, index_t dim);
     static qs_data_t ExpectDiffPS(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
                                   const qbits_t& ctrls, calc_type val, index_t dim);
     static qs_data_t ExpectDiffGP(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
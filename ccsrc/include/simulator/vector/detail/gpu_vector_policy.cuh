@@ -21,6 +21,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <thrust/transform_reduce.h>
@@ -70,6 +71,10 @@ struct GPUVectorPolicyBase {
     static py_qs_data_t ExpectationOfTerms(const qs_data_p_t& bra, const qs_data_p_t& ket,
                                            const std::vector<PauliTerm<calc_type>>& ham, index_t dim);
     static qs_data_p_t Copy(const qs_data_p_t& qs, index_t dim);
+    //! New owner of the buffer of qs, owners copy a shared buffer before writing it (copy on write).
+    static qs_data_p_t Share(const qs_data_p_t& qs, index_t dim);
+    //! Whether the buffer of qs has other owners.
+    static bool IsShared(const qs_data_p_t& qs);
     template <index_t mask, index_t condi>
     static py_qs_data_t ConditionVdot(const qs_data_p_t& bra, const qs_data_p_t& ket, index_t dim);
     static py_qs_data_t OneStateVdot(const qs_data_p_t& bra, const qs_data_p_t& ket, qbit_t obj_qubit, index_t dim);
@@ -142,6 +147,12 @@ struct GPUVectorPolicyBase {
                          bool diff = false);
     static void ApplyRyz(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls, calc_type val, index_t dim,
                          bool diff = false);
+    //! exp(-i val / 2 P) for the Pauli string P, paulis[j] acting on objs[j], in one sweep over the state.
+    static void ApplyRPS(qs_data_p_t* qs_p, const qbits_t& objs, const std::string& paulis, const qbits_t& ctrls,
+                         calc_type val, index_t dim, bool diff = false);
+    //! Fermionic single or double excitation, objs holding the created then the annihilated modes.
+    static void ApplyExcitation(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls, calc_type val,
+                                index_t dim, bool diff = false);
 
     // gate_expec
     // ========================================================================================================
@@ -172,6 +183,10 @@ struct GPUVectorPolicyBase {
                                    const qbits_t& ctrls, calc_type val, index_t dim);
     static qs_data_t ExpectDiffRyz(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
                                    const qbits_t& ctrls, calc_type val, index_t dim);
+    static qs_data_t ExpectDiffRPS(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
+                                   const std::string& paulis, const qbits_t& ctrls, calc_type val, index_t dim);
+    static qs_data_t ExpectDiffExcitation(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
+                                          const qbits_t& ctrls, calc_type val, index_t dim);
     static qs_data_t ExpectDiffPS(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
                                   const qbits_t& ctrls, calc_type val, index_t dim);
     static qs_data_t ExpectDiffGP(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_VECTOR_DISTRIBUTED_STATE_HPP
+#define INCLUDE_VECTOR_DISTRIBUTED_STATE_HPP
+
+#include <map>
+#include <random>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "ops/hamiltonian.h"
+#include "simulator/transport.h"
+#include "simulator/vector/qubit_layout.h"
+#include "simulator/vector/vector_state.h"
+
+namespace mindquantum::sim::vector::detail {
+/**
+ * State vector partitioned over the ranks of a Transport.
+ *
+ * With 2^g ranks, the g highest physical qubits are global: they select the rank, the other qubits index the local
+ * part of 2^(n-g) amplitudes. Gates acting on local qubits run on every rank without communication, controls on
+ * global qubits are resolved from the rank. A gate acting on a global qubit first swaps it with the local qubit whose
+ * next use is the farthest, by exchanging half of the local part with the peer rank, and the mapping between logical
+ * and physical qubits is kept until a measurement or the end of the circuit. All methods are collective.
+ */
+template <typename qs_policy_t_>
+class DistributedVectorState {
+ public:
+    using qs_policy_t = qs_policy_t_;
+    using calc_type = typename qs_policy_t::calc_type;
+    using qs_data_t = typename qs_policy_t::qs_data_t;
+    using qs_data_p_t = typename qs_policy_t::qs_data_p_t;
+    using py_qs_data_t = typename qs_policy_t::py_qs_data_t;
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    //! Amplitudes exchanged at once when swapping a global qubit.
+    static constexpr index_t exchange_block = 1UL << 18;
+
+    DistributedVectorState(qbit_t n_qubits, std::shared_ptr<Transport> transport, unsigned seed = 42);
+
+    int Rank() const {
+        return transport_->Rank();
+    }
+    int Size() const {
+        return transport_->Size();
+    }
+    qbit_t LocalQubits() const {
+        return n_local_;
+    }
+
+    //! Reset to the zero state.
+    void Reset();
+
+    //! Apply a gate or a measurement, return the measurement result.
+    index_t ApplyGate(const std::shared_ptr<BasicGate>& gate,
+                      const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    std::map<std::string, int> ApplyCircuit(const circuit_t& circ,
+                                            const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    //! Amplitudes held by this rank, the global index is (rank << LocalQubits()) + local index.
+    VT<py_qs_data_t> GetLocalQS() const;
+
+    //! Full state gathered on every rank.
+    VT<py_qs_data_t> GetQS() const;
+
+    //! Expectation of a Hamiltonian given as Pauli terms.
+    py_qs_data_t GetExpectation(const Hamiltonian<calc_type>& ham) const;
+
+ private:
+    //! Local part, gives access to the gate dispatch of VectorState.
+    class LocalState : public VectorState<qs_policy_t> {
+     public:
+        using VectorState<qs_policy_t>::VectorState;
+        using VectorState<qs_policy_t>::ApplyGateOn;
+        qs_data_p_t Data() const {
+            return this->qs;
+        }
+    };
+
+    struct PhysicalGate {
+        std::shared_ptr<BasicGate> gate;
+        qbits_t objs;
+        qbits_t ctrls;
+    };
+
+    //! Zero state: the amplitude of index 0 is on rank 0.
+    void InitLocal();
+
+    //! Apply a gate whose objects are local, with qubits in the physical order.
+    void ApplyLocal(const PhysicalGate& gate, const parameter::ParameterResolver& pr);
+
+    //! Measure a physical qubit, every rank draws the same random number.
+    index_t Measure(qbit_t qubit);
+
+    //! Swap a global and a local physical qubit.
+    void SwapGlobal(qbit_t global, qbit_t local);
+    void SwapLocal(qbit_t lhs, qbit_t rhs);
+
+    //! Undo all swaps so that the physical order is the logical order.
+    void RestoreLayout();
+
+    std::shared_ptr<Transport> transport_;
+    qbit_t n_qubits_;
+    qbit_t n_local_;
+    index_t local_dim_;
+    unsigned seed_;
+    std::unique_ptr<LocalState> local_;
+    QubitLayout layout_;
+    std::mt19937 rnd_eng_;
+};
+}  // namespace mindquantum::sim::vector::detail
+
+#include "simulator/vector/distributed_state.tpp"  // NOLINT
+
+#endif
@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_VECTOR_DISTRIBUTED_STATE_TPP
+#define INCLUDE_VECTOR_DISTRIBUTED_STATE_TPP
+
+#include <cmath>
+
+#include <algorithm>
+#include <complex>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "config/details/macros.h"
+#include "config/openmp.h"
+#include "core/trace.h"
+#include "core/utils.h"
+#include "ops/gate_id.h"
+#include "ops/gates.h"
+#include "simulator/utils.h"
+#include "simulator/vector/distributed_state.h"
+
+namespace mindquantum::sim::vector::detail {
+template <typename qs_policy_t_>
+DistributedVectorState<qs_policy_t_>::DistributedVectorState(qbit_t n_qubits, std::shared_ptr<Transport> transport,
+                                                             unsigned seed)
+    : transport_(std::move(transport)), n_qubits_(n_qubits), seed_(seed), rnd_eng_(seed) {
+    if (transport_ == nullptr) {
+        throw std::invalid_argument("Distributed simulator needs a transport.");
+    }
+    auto size = Size();
+    if ((size & (size - 1)) != 0) {
+        throw std::invalid_argument(fmt::format("Number of ranks should be a power of two, but get {}.", size));
+    }
+    qbit_t n_global = 0;
+    while ((1 << n_global) < size) {
+        n_global += 1;
+    }
+    if (n_qubits - n_global < 2) {
+        throw std::invalid_argument(
+            fmt::format("Cannot distribute {} qubits over {} ranks, each rank needs at least 2 qubits.", n_qubits, size));
+    }
+    n_local_ = n_qubits - n_global;
+    local_dim_ = index_t(1) << n_local_;
+    InitLocal();
+    layout_.Reset(n_qubits);
+}
+
+template <typename qs_policy_t_>
+void DistributedVectorState<qs_policy_t_>::InitLocal() {
+    local_.reset();
+    local_ = std::make_unique<LocalState>(qs_policy_t::InitState(local_dim_, Rank() == 0), n_local_, seed_);
+}
+
+template <typename qs_policy_t_>
+void DistributedVectorState<qs_policy_t_>::Reset() {
+    InitLocal();
+    layout_.Reset(n_qubits_);
+    rnd_eng_.seed(seed_);
+}
+
+template <typename qs_policy_t_>
+index_t DistributedVectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& gate,
+                                                        const parameter::ParameterResolver& pr) {
+    if (gate->id_ == GateID::M) {
+        return Measure(gate->obj_qubits_[0]);
+    }
+    ApplyCircuit({gate}, pr);
+    return 2;
+}
+
+template <typename qs_policy_t_>
+std::map<std::string, int> DistributedVectorState<qs_policy_t_>::ApplyCircuit(const circuit_t& circ,
+                                                                              const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("DistributedApplyCircuit", "simulator");
+    std::map<std::string, int> result;
+    for (size_t pos = 0; pos < circ.size(); ++pos) {
+        auto& gate = circ[pos];
+        if (gate->id_ == GateID::M) {
+            result[static_cast<MeasureGate*>(gate.get())->name_] = Measure(layout_.Physical(gate->obj_qubits_[0]));
+            continue;
+        }
+        if (!IsPartitionable(gate->id_)) {
+            throw std::invalid_argument(fmt::format("Gate {} is not supported by the distributed simulator.", gate->id_));
+        }
+        if (static_cast<qbit_t>(gate->obj_qubits_.size()) > n_local_) {
+            throw std::invalid_argument(
+                fmt::format("Gate acts on {} qubits, but each rank only holds {}.", gate->obj_qubits_.size(), n_local_));
+        }
+        for (auto obj : gate->obj_qubits_) {
+            if (layout_.Physical(obj) >= n_local_) {
+                SwapGlobal(layout_.Physical(obj), layout_.Victim(circ, pos, n_local_, gate->obj_qubits_));
+            }
+        }
+        ApplyLocal({gate, layout_.Physical(gate->obj_qubits_), layout_.Physical(gate->ctrl_qubits_)}, pr);
+    }
+    RestoreLayout();
+    return result;
+}
+
+template <typename qs_policy_t_>
+void DistributedVectorState<qs_policy_t_>::ApplyLocal(const PhysicalGate& gate,
+                                                      const parameter::ParameterResolver& pr) {
+    // Controls on global qubits are fixed for the whole rank.
+    qbits_t ctrls;
+    for (auto ctrl : gate.ctrls) {
+        if (ctrl < n_local_) {
+            ctrls.push_back(ctrl);
+        } else if (((Rank() >> (ctrl - n_local_)) & 1) == 0) {
+            return;
+        }
+    }
+    local_->ApplyGateOn(gate.gate, gate.objs, ctrls, pr, false);
+}
+
+template <typename qs_policy_t_>
+index_t DistributedVectorState<qs_policy_t_>::Measure(qbit_t qubit) {
+    auto qs = local_->Data();
+    double one_amp = 0;
+    bool global = qubit >= n_local_;
+    index_t rank_bit = global ? (static_cast<index_t>(Rank()) >> (qubit - n_local_)) & 1 : 0;
+    if (!global) {
+        index_t mask = index_t(1) << qubit;
+        one_amp = std::real(qs_policy_t::ConditionalCollect(qs, mask, mask, true, local_dim_));
+    } else if (rank_bit == 1) {
+        one_amp = std::real(qs_policy_t::Vdot(qs, qs, local_dim_));
+    }
+    transport_->AllReduceSum(&one_amp, 1);
+    std::uniform_real_distribution<double> dist(0., 1.);
+    index_t result = dist(rnd_eng_) < one_amp ? 1 : 0;
+    calc_type norm_fact = result == 1 ? 1 / std::sqrt(one_amp) : 1 / std::sqrt(1 - one_amp);
+    if (!global) {
+        index_t mask = index_t(1) << qubit;
+        qs_policy_t::ConditionalMul(qs, &qs, mask, result << qubit, norm_fact, 0.0, local_dim_);
+    } else {
+        qs_policy_t::QSMulValue(qs, &qs, rank_bit == result ? norm_fact : 0, local_dim_);
+    }
+    return result;
+}
+
+template <typename qs_policy_t_>
+void DistributedVectorState<qs_policy_t_>::SwapGlobal(qbit_t global, qbit_t local) {
+    MQ_TRACE_SCOPE("DistributedSwap", "simulator");
+    // Amplitudes whose local bit differs from the rank bit move to the peer, which sends back its own such half in
+    // the same order.
+    auto qs = local_->Data();
+    index_t rank_bit = (static_cast<index_t>(Rank()) >> (global - n_local_)) & 1;
+    int peer = Rank() ^ (1 << (global - n_local_));
+    index_t low_mask = (index_t(1) << local) - 1;
+    index_t send_bit = (1 - rank_bit) << local;
+    index_t half = local_dim_ / 2;
+    auto block = std::min(half, exchange_block);
+    std::vector<qs_data_t> send(block);
+    std::vector<qs_data_t> recv(block);
+    for (index_t start = 0; start < half; start += block) {
+        auto n = std::min(block, half - start);
+        THRESHOLD_OMP_FOR(
+            n, qs_policy_t::DimTh, for (omp::idx_t k = 0; k < static_cast<omp::idx_t>(n); k++) {
+                index_t idx = start + k;
+                send[k] = qs[((idx & ~low_mask) << 1) | (idx & low_mask) | send_bit];
+            })
+        transport_->SendRecv(send.data(), recv.data(), n * sizeof(qs_data_t), peer);
+        THRESHOLD_OMP_FOR(
+            n, qs_policy_t::DimTh, for (omp::idx_t k = 0; k < static_cast<omp::idx_t>(n); k++) {
+                index_t idx = start + k;
+                qs[((idx & ~low_mask) << 1) | (idx & low_mask) | send_bit] = recv[k];
+            })
+    }
+    layout_.Swap(global, local);
+}
+
+template <typename qs_policy_t_>
+void DistributedVectorState<qs_policy_t_>::SwapLocal(qbit_t lhs, qbit_t rhs) {
+    auto qs = local_->Data();
+    qs_policy_t::ApplySWAP(&qs, {std::min(lhs, rhs), std::max(lhs, rhs)}, {}, local_dim_);
+    layout_.Swap(lhs, rhs);
+}
+
+template <typename qs_policy_t_>
+void DistributedVectorState<qs_policy_t_>::RestoreLayout() {
+    // Global qubits first, a global qubit held by another global position goes through local qubit 0.
+    for (qbit_t phys = n_local_; phys < n_qubits_; ++phys) {
+        auto current = layout_.Physical(phys);
+        if (current == phys) {
+            continue;
+        }
+        if (current >= n_local_) {
+            SwapGlobal(current, 0);
+            current = 0;
+        }
+        SwapGlobal(phys, current);
+    }
+    for (qbit_t phys = 0; phys < n_local_; ++phys) {
+        while (layout_.Logical(phys) != phys) {
+            SwapLocal(phys, layout_.Logical(phys));
+        }
+    }
+}
+
+template <typename qs_policy_t_>
+auto DistributedVectorState<qs_policy_t_>::GetLocalQS() const -> VT<py_qs_data_t> {
+    return qs_policy_t::GetQS(local_->Data(), local_dim_);
+}
+
+template <typename qs_policy_t_>
+auto DistributedVectorState<qs_policy_t_>::GetQS() const -> VT<py_qs_data_t> {
+    VT<qs_data_t> all(local_dim_ * static_cast<index_t>(Size()));
+    transport_->AllGather(local_->Data(), all.data(), local_dim_ * sizeof(qs_data_t));
+    return VT<py_qs_data_t>(all.begin(), all.end());
+}
+
+template <typename qs_policy_t_>
+auto DistributedVectorState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham) const -> py_qs_data_t {
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("Distributed simulator needs a Hamiltonian given as Pauli terms.");
+    }
+    auto qs = local_->Data();
+    index_t local_mask = local_dim_ - 1;
+    index_t rank_offset = static_cast<index_t>(Rank()) << n_local_;
+    // Terms are grouped by the global part of their flip mask, each group exchanges the local part with one peer.
+    std::map<index_t, std::vector<std::pair<PauliMask, calc_type>>> groups;
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        auto mask = GenPauliMask(pauli_string);
+        groups[(mask.mask_x | mask.mask_y) >> n_local_].emplace_back(mask, coeff);
+    }
+    std::vector<qs_data_t> peer_qs;
+    double out[2] = {0, 0};
+    for (const auto& [global_flip, terms] : groups) {
+        const qs_data_t* partner = qs;
+        if (global_flip != 0) {
+            peer_qs.resize(local_dim_);
+            transport_->SendRecv(qs, peer_qs.data(), local_dim_ * sizeof(qs_data_t),
+                                 Rank() ^ static_cast<int>(global_flip));
+            partner = peer_qs.data();
+        }
+        for (const auto& [mask, coeff] : terms) {
+            auto local_flip = (mask.mask_x | mask.mask_y) & local_mask;
+            double res_real = 0, res_imag = 0;
+            // clang-format off
+            THRESHOLD_OMP(
+                MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), local_dim_,
+                    qs_policy_t::DimTh,
+                    for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(local_dim_); l++) {
+                        index_t i = rank_offset | l;
+                        auto c = POLAR[static_cast<char>(
+                            (mask.num_y + 2 * CountOne(i & mask.mask_y) + 2 * CountOne(i & mask.mask_z)) & 3)];
+                        auto tmp = std::conj(std::complex<double>(partner[l ^ local_flip])) *
+                                   std::complex<double>(qs[l]) * c * static_cast<double>(coeff);
+                        res_real += std::real(tmp);
+                        res_imag += std::imag(tmp);
+                    })
+            // clang-format on
+            out[0] += res_real;
+            out[1] += res_imag;
+        }
+    }
+    transport_->AllReduceSum(out, 2);
+    return {out[0], out[1]};
+}
+}  // namespace mindquantum::sim::vector::detail
+
+#endif
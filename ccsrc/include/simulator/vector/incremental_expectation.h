@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_VECTOR_INCREMENTAL_EXPECTATION_HPP
+#define INCLUDE_VECTOR_INCREMENTAL_EXPECTATION_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "ops/hamiltonian.h"
+#include "simulator/vector/vector_state.h"
+
+namespace mindquantum::sim::vector::detail {
+/**
+ * Expectation of a hamiltonian under one parameter updates, for coordinate wise optimizers like Rotosolve.
+ *
+ * The state before the first gate depending on a parameter is cached, so that a new value of this parameter only
+ * costs the gates from there to the end of the circuit. The cached prefix is advanced gate by gate and stays valid as
+ * long as the updated parameters only act after it, so a sweep over the parameters in circuit order applies every
+ * prefix gate once.
+ *
+ * When a parameter x enters a single gate exp(-i (a x + b) / 2 P) with P^2 = 1 (an uncontrolled rotation or Pauli
+ * string rotation) or a phase shift, the expectation is A cos(omega x - B) + C with omega = |a|. The three
+ * coefficients are reconstructed from the cached current expectation and two segment evaluations at x +- pi / (2
+ * omega), which also gives the exact minimum along x.
+ */
+template <typename qs_policy_t_>
+class IncrementalExpectation {
+ public:
+    using qs_policy_t = qs_policy_t_;
+    using calc_type = typename qs_policy_t::calc_type;
+    using sim_t = VectorState<qs_policy_t>;
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    //! Start from the state of init, which is copied.
+    IncrementalExpectation(const sim_t& init, const Hamiltonian<calc_type>& ham, const circuit_t& circ,
+                           const parameter::ParameterResolver& pr);
+
+    //! Expectation at the current parameters.
+    calc_type GetExpectation();
+
+    //! Expectations with the parameter set to each value, the current parameters are unchanged.
+    VT<calc_type> Evaluate(const std::string& name, const VT<calc_type>& values);
+
+    //! Coefficients {A, B, C, omega} of E(x) = A cos(omega x - B) + C with A >= 0.
+    VT<calc_type> Reconstruct(const std::string& name);
+
+    //! Set the parameter to the minimum of its reconstruction and return the new expectation.
+    calc_type Minimize(const std::string& name);
+
+    //! Update the current value of a parameter.
+    void SetParameter(const std::string& name, calc_type value);
+    calc_type GetParameter(const std::string& name) const;
+
+    //! Parameters sorted by their first gate, the order in which a sweep reuses the prefix best.
+    VT<std::string> ParameterOrder() const;
+
+    //! Number of gates applied so far, prefix and segments included.
+    index_t GetAppliedGates() const {
+        return applied_gates_;
+    }
+
+ private:
+    //! Move the cached prefix to the state before gate pos.
+    void AdvancePrefix(index_t pos);
+
+    const VT<index_t>& GatesOf(const std::string& name) const;
+
+    //! Expectation of the state before gate first after the rest of the circuit.
+    calc_type SegmentExpectation(index_t first, const parameter::ParameterResolver& pr);
+
+    sim_t init_;
+    sim_t prefix_;
+    index_t prefix_pos_ = 0;
+    Hamiltonian<calc_type> ham_;
+    circuit_t circ_;
+    parameter::ParameterResolver pr_;
+    MST<VT<index_t>> gates_of_;
+    calc_type expectation_ = 0;
+    bool expectation_valid_ = false;
+    index_t applied_gates_ = 0;
+};
+}  // namespace mindquantum::sim::vector::detail
+
+#include "simulator/vector/incremental_expectation.tpp"  // NOLINT
+
+#endif
@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_VECTOR_INCREMENTAL_EXPECTATION_TPP
+#define INCLUDE_VECTOR_INCREMENTAL_EXPECTATION_TPP
+
+#include <cmath>
+
+#include <algorithm>
+#include <complex>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "math/tensor/ops_cpu/memory_operator.h"
+#include "ops/gate_id.h"
+#include "simulator/vector/incremental_expectation.h"
+
+namespace mindquantum::sim::vector::detail {
+template <typename qs_policy_t_>
+IncrementalExpectation<qs_policy_t_>::IncrementalExpectation(const sim_t& init, const Hamiltonian<calc_type>& ham,
+                                                             const circuit_t& circ,
+                                                             const parameter::ParameterResolver& pr)
+    : init_(init), prefix_(init), ham_(ham), circ_(circ), pr_(pr) {
+    for (index_t i = 0; i < circ_.size(); ++i) {
+        if (!circ_[i]->Parameterized()) {
+            continue;
+        }
+        auto p_gate = static_cast<Parameterizable*>(circ_[i].get());
+        for (const auto& gate_pr : p_gate->prs_) {
+            for (const auto& [name, coeff] : gate_pr.data_) {
+                auto& gates = gates_of_[name];
+                if (gates.empty() || gates.back() != i) {
+                    gates.push_back(i);
+                }
+            }
+        }
+    }
+    for (const auto& [name, gates] : gates_of_) {
+        if (!pr_.Contains(name)) {
+            throw std::invalid_argument("Parameter " + name + " of the circuit is not given.");
+        }
+    }
+}
+
+template <typename qs_policy_t_>
+auto IncrementalExpectation<qs_policy_t_>::GatesOf(const std::string& name) const -> const VT<index_t>& {
+    static const VT<index_t> no_gates;
+    if (!pr_.Contains(name)) {
+        throw std::invalid_argument("Unknown parameter " + name + ".");
+    }
+    auto it = gates_of_.find(name);
+    return it == gates_of_.end() ? no_gates : it->second;
+}
+
+template <typename qs_policy_t_>
+void IncrementalExpectation<qs_policy_t_>::AdvancePrefix(index_t pos) {
+    if (pos < prefix_pos_) {
+        prefix_ = init_;
+        prefix_pos_ = 0;
+    }
+    for (; prefix_pos_ < pos; ++prefix_pos_) {
+        prefix_.ApplyGate(circ_[prefix_pos_], pr_);
+        applied_gates_++;
+    }
+}
+
+template <typename qs_policy_t_>
+auto IncrementalExpectation<qs_policy_t_>::SegmentExpectation(index_t first, const parameter::ParameterResolver& pr)
+    -> calc_type {
+    AdvancePrefix(first);
+    circuit_t segment(circ_.begin() + first, circ_.end());
+    applied_gates_ += segment.size();
+    return std::real(prefix_.GetExpectation(ham_, segment, pr));
+}
+
+template <typename qs_policy_t_>
+auto IncrementalExpectation<qs_policy_t_>::GetExpectation() -> calc_type {
+    if (!expectation_valid_) {
+        expectation_ = SegmentExpectation(prefix_pos_, pr_);
+        expectation_valid_ = true;
+    }
+    return expectation_;
+}
+
+template <typename qs_policy_t_>
+auto IncrementalExpectation<qs_policy_t_>::Evaluate(const std::string& name, const VT<calc_type>& values)
+    -> VT<calc_type> {
+    const auto& gates = GatesOf(name);
+    if (gates.empty()) {
+        return VT<calc_type>(values.size(), GetExpectation());
+    }
+    VT<calc_type> out;
+    out.reserve(values.size());
+    auto pr = pr_;
+    for (auto value : values) {
+        pr.SetItem(name, static_cast<double>(value));
+        out.push_back(SegmentExpectation(gates[0], pr));
+    }
+    return out;
+}
+
+template <typename qs_policy_t_>
+auto IncrementalExpectation<qs_policy_t_>::Reconstruct(const std::string& name) -> VT<calc_type> {
+    const auto& gates = GatesOf(name);
+    if (gates.empty()) {
+        return {0, 0, GetExpectation(), 0};
+    }
+    if (gates.size() != 1) {
+        throw std::runtime_error("Parameter " + name + " acts on " + std::to_string(gates.size())
+                                 + " gates, the reconstruction needs a single one.");
+    }
+    auto gate = circ_[gates[0]];
+    switch (gate->id_) {
+        case GateID::RX:
+        case GateID::RY:
+        case GateID::RZ:
+        case GateID::Rxx:
+        case GateID::Ryy:
+        case GateID::Rzz:
+        case GateID::Rxy:
+        case GateID::Rxz:
+        case GateID::Ryz:
+        case GateID::RPS:
+            if (!gate->ctrl_qubits_.empty()) {
+                throw std::runtime_error("Controlled rotation of " + name
+                                         + " has two frequencies, can not reconstruct.");
+            }
+            break;
+        case GateID::PS:
+        case GateID::GP:
+            break;
+        default:
+            throw std::runtime_error(fmt::format("Can not reconstruct the expectation along {} from gate {}.", name,
+                                                 gate->id_));
+    }
+    auto omega = std::abs(static_cast<calc_type>(tensor::ops::cpu::to_vector<double>(
+        static_cast<Parameterizable*>(gate.get())->prs_[0].GetItem(name))[0]));
+    auto x0 = GetParameter(name);
+    if (omega == 0) {
+        return {0, 0, GetExpectation(), 0};
+    }
+    auto e0 = GetExpectation();
+    auto shift = static_cast<calc_type>(M_PI_2) / omega;
+    auto e_pm = Evaluate(name, {x0 + shift, x0 - shift});
+    // E(x0 +- shift) = C -+ A sin(omega x0 - B) and E(x0) = A cos(omega x0 - B) + C.
+    auto c = (e_pm[0] + e_pm[1]) / 2;
+    auto sin_part = (e_pm[1] - e_pm[0]) / 2;
+    auto cos_part = e0 - c;
+    auto a = std::hypot(sin_part, cos_part);
+    auto b = omega * x0 - std::atan2(sin_part, cos_part);
+    return {a, b, c, omega};
+}
+
+template <typename qs_policy_t_>
+auto IncrementalExpectation<qs_policy_t_>::Minimize(const std::string& name) -> calc_type {
+    auto coeff = Reconstruct(name);
+    auto a = coeff[0];
+    auto b = coeff[1];
+    auto c = coeff[2];
+    auto omega = coeff[3];
+    if (omega == 0 || a == 0) {
+        return GetExpectation();
+    }
+    // Minimum at omega x = B + pi, taken in the period closest to the current value.
+    auto x0 = GetParameter(name);
+    auto delta = std::remainder(b + static_cast<calc_type>(M_PI) - omega * x0, static_cast<calc_type>(2 * M_PI));
+    SetParameter(name, x0 + delta / omega);
+    expectation_ = c - a;
+    expectation_valid_ = true;
+    return expectation_;
+}
+
+template <typename qs_policy_t_>
+void IncrementalExpectation<qs_policy_t_>::SetParameter(const std::string& name, calc_type value) {
+    const auto& gates = GatesOf(name);
+    pr_.SetItem(name, static_cast<double>(value));
+    if (gates.empty()) {
+        return;
+    }
+    if (gates[0] < prefix_pos_) {
+        prefix_ = init_;
+        prefix_pos_ = 0;
+    }
+    expectation_valid_ = false;
+}
+
+template <typename qs_policy_t_>
+auto IncrementalExpectation<qs_policy_t_>::GetParameter(const std::string& name) const -> calc_type {
+    if (!pr_.Contains(name)) {
+        throw std::invalid_argument("Unknown parameter " + name + ".");
+    }
+    return static_cast<calc_type>(tensor::ops::cpu::to_vector<double>(pr_.GetItem(name))[0]);
+}
+
+template <typename qs_policy_t_>
+auto IncrementalExpectation<qs_policy_t_>::ParameterOrder() const -> VT<std::string> {
+    VT<std::string> names;
+    for (const auto& [name, gates] : gates_of_) {
+        names.push_back(name);
+    }
+    std::stable_sort(names.begin(), names.end(), [&](const auto& lhs, const auto& rhs) {
+        return gates_of_.at(lhs)[0] < gates_of_.at(rhs)[0];
+    });
+    return names;
+}
+}  // namespace mindquantum::sim::vector::detail
+
+#endif
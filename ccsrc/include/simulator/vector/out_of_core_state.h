@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef INCLUDE_VECTOR_OUT_OF_CORE_STATE_HPP
+#define INCLUDE_VECTOR_OUT_OF_CORE_STATE_HPP
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
+#include "simulator/vector/qubit_layout.h"
+#include "simulator/vector/vector_state.h"
+
+namespace mindquantum::sim::vector::detail {
+/**
+ * Vector state stored in a memory mapped file, for states larger than the RAM.
+ *
+ * The state is split in chunks of 2^chunk_qubits amplitudes, the lower physical qubits are local to a chunk and the
+ * higher ones select the chunk. ApplyCircuit runs the consecutive gates that only act on local qubits chunk by chunk,
+ * so every chunk is read and written once per run instead of once per gate, and the next chunk is prefetched while
+ * the current one is processed. A gate acting on a global qubit first swaps that qubit with the local qubit whose next
+ * use is the farthest, the mapping between logical and physical qubits is tracked and restored at the end of the
+ * circuit. Measurements, noise channels and the other methods work on the full state in logical order.
+ */
+class OutOfCoreVectorState : public VectorState<CPUVectorPolicyOutOfCore> {
+ public:
+    using base_t = VectorState<CPUVectorPolicyOutOfCore>;
+    static constexpr qbit_t default_chunk_qubits = 24;
+
+    explicit OutOfCoreVectorState(qbit_t n_qubits, unsigned seed = 42);
+    explicit OutOfCoreVectorState(base_t&& sim);
+    OutOfCoreVectorState(const OutOfCoreVectorState&) = default;
+    OutOfCoreVectorState(OutOfCoreVectorState&&) = default;
+    OutOfCoreVectorState& operator=(const OutOfCoreVectorState&) = default;
+    OutOfCoreVectorState& operator=(OutOfCoreVectorState&&) = default;
+    ~OutOfCoreVectorState() override;
+
+    //! Number of qubits local to a chunk, a chunk takes 16 * 2^chunk_qubits bytes.
+    void SetChunkQubits(qbit_t chunk_qubits);
+    qbit_t GetChunkQubits() const {
+        return chunk_qubits_;
+    }
+
+    std::map<std::string, int> ApplyCircuit(const circuit_t& circ, const parameter::ParameterResolver& pr
+                                                                   = parameter::ParameterResolver()) override;
+
+ private:
+    //! A gate of a run, with its qubits in the physical order.
+    struct PhysicalGate {
+        std::shared_ptr<BasicGate> gate;
+        qbits_t objs;
+        qbits_t ctrls;
+    };
+
+    //! View on one chunk of another state, does not own the buffer.
+    OutOfCoreVectorState(qs_data_p_t chunk, qbit_t n_qubits);
+
+    //! Apply a run of local gates chunk by chunk.
+    void FlushRun(std::vector<PhysicalGate>* run, const parameter::ParameterResolver& pr);
+
+    //! Swap two physical qubits of the full state and update the layout.
+    void SwapPhysical(qbit_t lhs, qbit_t rhs);
+
+    //! Undo all swaps so that the physical order is the logical order.
+    void RestoreLayout();
+
+    qbit_t chunk_qubits_ = default_chunk_qubits;
+    bool is_view_ = false;
+    QubitLayout layout_;
+};
+}  // namespace mindquantum::sim::vector::detail
+#endif
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_VECTOR_QUBIT_LAYOUT_HPP
+#define INCLUDE_VECTOR_QUBIT_LAYOUT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "ops/basic_gate.h"
+#include "ops/gate_id.h"
+
+namespace mindquantum::sim::vector::detail {
+//! Whether the kernel of gate \c id only mixes amplitudes that differ in its qubits, so it can run on a part of the
+//! state given the values of the other qubits.
+inline bool IsPartitionable(GateID id) {
+    switch (id) {
+        case GateID::I:
+        case GateID::X:
+        case GateID::Y:
+        case GateID::Z:
+        case GateID::H:
+        case GateID::S:
+        case GateID::Sdag:
+        case GateID::T:
+        case GateID::Tdag:
+        case GateID::SWAP:
+        case GateID::ISWAP:
+        case GateID::RX:
+        case GateID::RY:
+        case GateID::RZ:
+        case GateID::Rxx:
+        case GateID::Ryy:
+        case GateID::Rzz:
+        case GateID::Rxy:
+        case GateID::Rxz:
+        case GateID::Ryz:
+        case GateID::RPS:
+        case GateID::PS:
+        case GateID::GP:
+        case GateID::U3:
+        case GateID::FSim:
+        case GateID::CUSTOM:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Mapping between logical qubits and physical bit positions of a partitioned state.
+ *
+ * The low \c n_local physical qubits index amplitudes within a part (chunk or rank), the others select the part.
+ */
+class QubitLayout {
+ public:
+    void Reset(qbit_t n_qubits) {
+        physical_.resize(n_qubits);
+        logical_.resize(n_qubits);
+        std::iota(physical_.begin(), physical_.end(), 0);
+        std::iota(logical_.begin(), logical_.end(), 0);
+    }
+
+    qbit_t Physical(qbit_t logical) const {
+        return physical_[logical];
+    }
+    qbit_t Logical(qbit_t physical) const {
+        return logical_[physical];
+    }
+    qbits_t Physical(const qbits_t& logical) const {
+        qbits_t out;
+        out.reserve(logical.size());
+        for (auto qubit : logical) {
+            out.push_back(physical_[qubit]);
+        }
+        return out;
+    }
+
+    bool IsIdentity() const {
+        for (size_t i = 0; i < logical_.size(); ++i) {
+            if (logical_[i] != static_cast<qbit_t>(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Record that the physical qubits \c lhs and \c rhs were swapped.
+    void Swap(qbit_t lhs, qbit_t rhs) {
+        std::swap(logical_[lhs], logical_[rhs]);
+        physical_[logical_[lhs]] = lhs;
+        physical_[logical_[rhs]] = rhs;
+    }
+
+    /*!
+     * \brief Local physical qubit to move out of the part so that a global qubit can come in.
+     *
+     * As in Belady's caching, the qubit whose next use as a gate object after \c pos is the farthest is chosen,
+     * looking at most \c look_ahead gates ahead. Logical qubits in \c keep are not chosen.
+     */
+    template <typename circuit_t>
+    qbit_t Victim(const circuit_t& circ, size_t pos, qbit_t n_local, const qbits_t& keep,
+                  size_t look_ahead = 1024) const {
+        std::vector<size_t> next_use(logical_.size(), std::numeric_limits<size_t>::max());
+        auto end = std::min(circ.size(), pos + 1 + look_ahead);
+        for (auto i = end; i > pos + 1; --i) {
+            for (auto obj : circ[i - 1]->obj_qubits_) {
+                next_use[obj] = i - 1;
+            }
+        }
+        qbit_t victim = n_local;
+        for (qbit_t phys = 0; phys < n_local; ++phys) {
+            auto candidate = logical_[phys];
+            if (std::find(keep.begin(), keep.end(), candidate) != keep.end()) {
+                continue;
+            }
+            if (victim == n_local || next_use[candidate] > next_use[logical_[victim]]) {
+                victim = phys;
+            }
+        }
+        return victim;
+    }
+
+ private:
+    std::vector<qbit_t> physical_;  // Physical position of each logical qubit.
+    std::vector<qbit_t> logical_;   // Logical qubit at each physical position.
+};
+}  // namespace mindquantum::sim::vector::detail
+
+#endif
@@ -32,5 +32,6 @@
 namespace mindquantum::sim::rt {
 int cmd(const std::vector<std::string>& args);
 int cmd_file(const char* filename);
+int qasm(const std::vector<std::string>& args);
 }  // namespace mindquantum::sim::rt
 #endif
@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_VECTOR_SPARSE_AMPLITUDES_HPP
+#define INCLUDE_VECTOR_SPARSE_AMPLITUDES_HPP
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "core/mq_base_types.h"
+
+namespace mindquantum::sim::vector::detail {
+/**
+ * Map from basis index to amplitude with open addressing and linear probing.
+ *
+ * Keys and values are kept in two flat arrays of a power of two capacity, at most half full, so a lookup touches one
+ * or two cache lines. There is no erase: the gates build a new map, and pruning filters into a new one.
+ */
+class SparseAmplitudes {
+ public:
+    using key_t = index_t;
+    using value_t = std::complex<double>;
+
+    //! Marks a free slot, never a basis index since the states have at most 63 qubits.
+    static constexpr key_t empty = ~key_t(0);
+
+    explicit SparseAmplitudes(size_t n_expected = 0) {
+        Reserve(n_expected);
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    //! Make room for n entries without rehashing.
+    void Reserve(size_t n) {
+        size_t capacity = 16;
+        while (capacity < 2 * n) {
+            capacity <<= 1;
+        }
+        if (capacity > keys_.size()) {
+            Rehash(capacity);
+        }
+    }
+
+    void Clear() {
+        std::fill(keys_.begin(), keys_.end(), empty);
+        size_ = 0;
+    }
+
+    //! Amplitude of key, zero if not stored.
+    value_t Get(key_t key) const {
+        auto slot = Find(key);
+        return keys_[slot] == key ? values_[slot] : value_t(0);
+    }
+
+    //! Accumulate value on key.
+    void Add(key_t key, value_t value) {
+        auto slot = Find(key);
+        if (keys_[slot] == key) {
+            values_[slot] += value;
+            return;
+        }
+        if (2 * (size_ + 1) > keys_.size()) {
+            Rehash(2 * keys_.size());
+            slot = Find(key);
+        }
+        keys_[slot] = key;
+        values_[slot] = value;
+        size_ += 1;
+    }
+
+    //! Call f(key, value) on every entry, in no particular order.
+    template <typename F>
+    void ForEach(const F& f) const {
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (keys_[i] != empty) {
+                f(keys_[i], values_[i]);
+            }
+        }
+    }
+
+    //! Call f(key, value&) on every entry, the value may be modified in place.
+    template <typename F>
+    void Update(const F& f) {
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (keys_[i] != empty) {
+                f(keys_[i], values_[i]);
+            }
+        }
+    }
+
+    //! Keep the entries for which pred(key, value) is true.
+    template <typename F>
+    void Filter(const F& pred) {
+        SparseAmplitudes out(size_);
+        ForEach([&](key_t key, const value_t& value) {
+            if (pred(key, value)) {
+                out.Add(key, value);
+            }
+        });
+        *this = std::move(out);
+    }
+
+ private:
+    size_t Find(key_t key) const {
+        // Fibonacci hashing spreads the low bits of neighbouring indices over the whole table.
+        auto mask = keys_.size() - 1;
+        auto slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift_) & mask;
+        while (keys_[slot] != key && keys_[slot] != empty) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void Rehash(size_t capacity) {
+        std::vector<key_t> keys(capacity, empty);
+        std::vector<value_t> values(capacity);
+        std::swap(keys, keys_);
+        std::swap(values, values_);
+        shift_ = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) {
+            shift_ -= 1;
+        }
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] != empty) {
+                auto slot = Find(keys[i]);
+                keys_[slot] = keys[i];
+                values_[slot] = values[i];
+            }
+        }
+    }
+
+    std::vector<key_t> keys_;
+    std::vector<value_t> values_;
+    size_t size_ = 0;
+    unsigned shift_ = 64;
+};
+}  // namespace mindquantum::sim::vector::detail
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_VECTOR_SPARSE_STATE_HPP
+#define INCLUDE_VECTOR_SPARSE_STATE_HPP
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+#include "ops/hamiltonian.h"
+#include "simulator/vector/sparse_amplitudes.h"
+#include "simulator/vector/vector_state.h"
+
+namespace mindquantum::sim::vector::detail {
+/**
+ * State vector that only stores the nonzero amplitudes, for circuits that keep the state on few basis states
+ * (arithmetic, reversible oracles, QRAM loading) on up to 63 qubits.
+ *
+ * Permutation gates (X, CNOT, Toffoli, SWAP) move the keys, diagonal gates scale the amplitudes in place, and gates
+ * that create superpositions split every key in two. Amplitudes not larger than the prune threshold are dropped after
+ * a gate. When the number of stored amplitudes reaches the dense fraction of 2^n, and the state has few enough qubits,
+ * it is converted to a VectorState of policy qs_policy_t, which runs the rest of the work.
+ */
+template <typename qs_policy_t_>
+class SparseVectorState {
+ public:
+    using qs_policy_t = qs_policy_t_;
+    using dense_t = VectorState<qs_policy_t>;
+    using calc_type = double;
+    using py_qs_data_t = std::complex<double>;
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    static constexpr qbit_t max_qubits = 63;
+    static constexpr double default_prune_threshold = 1e-12;
+    static constexpr double default_dense_fraction = 1.0 / 32;
+    static constexpr qbit_t default_max_dense_qubits = 28;
+
+    explicit SparseVectorState(qbit_t n_qubits, unsigned seed = 42);
+    SparseVectorState(const SparseVectorState& other);
+    SparseVectorState& operator=(const SparseVectorState& other);
+    SparseVectorState(SparseVectorState&&) = default;
+    SparseVectorState& operator=(SparseVectorState&&) = default;
+
+    qbit_t GetQubits() const {
+        return n_qubits_;
+    }
+
+    //! Reset to the zero state, in sparse form.
+    void Reset();
+
+    //! Apply a gate or a measurement, return the measurement result.
+    index_t ApplyGate(const std::shared_ptr<BasicGate>& gate,
+                      const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    std::map<std::string, int> ApplyCircuit(const circuit_t& circ,
+                                            const parameter::ParameterResolver& pr = parameter::ParameterResolver());
+
+    //! Same layout as VectorState::Sampling.
+    VT<unsigned> Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr, size_t shots,
+                          const MST<size_t>& key_map, unsigned seed) const;
+
+    //! Expectation of a Hamiltonian given as Pauli terms.
+    py_qs_data_t GetExpectation(const Hamiltonian<calc_type>& ham) const;
+
+    py_qs_data_t GetAmplitude(index_t idx) const;
+
+    //! Stored amplitudes sorted by index, every amplitude once the state is dense.
+    std::vector<std::pair<index_t, py_qs_data_t>> GetAmplitudes() const;
+
+    //! Full state vector, for states of at most 30 qubits.
+    VT<py_qs_data_t> GetQS() const;
+
+    //! Number of stored amplitudes, 2^n once dense.
+    index_t Size() const;
+
+    bool IsDense() const {
+        return dense_ != nullptr;
+    }
+
+    //! Drop amplitudes with a modulus not larger than threshold after each gate.
+    void SetPruneThreshold(double threshold);
+    double GetPruneThreshold() const {
+        return prune_threshold_;
+    }
+
+    //! Convert to dense when Size() reaches fraction * 2^n, only for states of at most max_qubits qubits.
+    void SetDenseThreshold(double fraction, qbit_t max_qubits);
+
+ private:
+    //! Apply a Pauli string: |k> -> id_coeff |k> + pauli_coeff P|k>, on the keys whose controls are set.
+    void ApplyPauli(index_t ctrl_mask, const PauliMask& mask, py_qs_data_t id_coeff, py_qs_data_t pauli_coeff);
+
+    //! Multiply the amplitude of the controlled keys by phase(key).
+    template <typename F>
+    void ApplyDiagonal(index_t ctrl_mask, const F& phase);
+
+    //! Move the controlled keys to perm(key), with a factor phase(key).
+    template <typename F>
+    void ApplyPermutation(index_t ctrl_mask, const F& perm);
+
+    //! Apply a matrix of 2^k x 2^k on the object qubits, objs[0] is the lowest bit of the local index.
+    void ApplyMatrix(const qbits_t& objs, index_t ctrl_mask, const VVT<py_qs_data_t>& m);
+
+    index_t Measure(qbit_t qubit);
+    void Prune();
+    void DensifyIfNeeded();
+
+    static index_t Mask(const qbits_t& qubits);
+    static double Angle(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr);
+    static VVT<py_qs_data_t> GateMatrix(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr);
+
+    SparseAmplitudes amps_;
+    std::unique_ptr<dense_t> dense_;
+    qbit_t n_qubits_;
+    unsigned seed_;
+    std::mt19937 rnd_eng_;
+    double prune_threshold_ = default_prune_threshold;
+    double dense_fraction_ = default_dense_fraction;
+    qbit_t max_dense_qubits_ = default_max_dense_qubits;
+};
+}  // namespace mindquantum::sim::vector::detail
+
+#include "simulator/vector/sparse_state.tpp"  // NOLINT
+
+#endif
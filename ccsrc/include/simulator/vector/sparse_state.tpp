@@ -0,0 +1,528 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_VECTOR_SPARSE_STATE_TPP
+#define INCLUDE_VECTOR_SPARSE_STATE_TPP
+
+#include <cmath>
+
+#include <algorithm>
+#include <complex>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "core/trace.h"
+#include "core/utils.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+#include "ops/gate_id.h"
+#include "ops/gates.h"
+#include "simulator/utils.h"
+#include "simulator/vector/sparse_state.h"
+
+namespace mindquantum::sim::vector::detail {
+template <typename qs_policy_t_>
+SparseVectorState<qs_policy_t_>::SparseVectorState(qbit_t n_qubits, unsigned seed)
+    : n_qubits_(n_qubits), seed_(seed), rnd_eng_(seed) {
+    if (n_qubits > max_qubits) {
+        throw std::invalid_argument(
+            fmt::format("Sparse simulator supports at most {} qubits, but get {}.", max_qubits, n_qubits));
+    }
+    amps_.Add(0, 1);
+}
+
+template <typename qs_policy_t_>
+SparseVectorState<qs_policy_t_>::SparseVectorState(const SparseVectorState& other)
+    : amps_(other.amps_)
+    , dense_(other.dense_ == nullptr ? nullptr : std::make_unique<dense_t>(*other.dense_))
+    , n_qubits_(other.n_qubits_)
+    , seed_(other.seed_)
+    , rnd_eng_(other.rnd_eng_)
+    , prune_threshold_(other.prune_threshold_)
+    , dense_fraction_(other.dense_fraction_)
+    , max_dense_qubits_(other.max_dense_qubits_) {
+}
+
+template <typename qs_policy_t_>
+auto SparseVectorState<qs_policy_t_>::operator=(const SparseVectorState& other) -> SparseVectorState& {
+    if (this != &other) {
+        *this = SparseVectorState(other);
+    }
+    return *this;
+}
+
+template <typename qs_policy_t_>
+void SparseVectorState<qs_policy_t_>::Reset() {
+    dense_.reset();
+    amps_ = SparseAmplitudes();
+    amps_.Add(0, 1);
+    rnd_eng_.seed(seed_);
+}
+
+template <typename qs_policy_t_>
+void SparseVectorState<qs_policy_t_>::SetPruneThreshold(double threshold) {
+    if (threshold < 0) {
+        throw std::invalid_argument(fmt::format("Prune threshold should not be negative, but get {}.", threshold));
+    }
+    prune_threshold_ = threshold;
+}
+
+template <typename qs_policy_t_>
+void SparseVectorState<qs_policy_t_>::SetDenseThreshold(double fraction, qbit_t max_qubits) {
+    if (fraction <= 0) {
+        throw std::invalid_argument(fmt::format("Dense fraction should be positive, but get {}.", fraction));
+    }
+    dense_fraction_ = fraction;
+    max_dense_qubits_ = max_qubits;
+}
+
+template <typename qs_policy_t_>
+index_t SparseVectorState<qs_policy_t_>::Size() const {
+    return IsDense() ? (index_t(1) << n_qubits_) : amps_.Size();
+}
+
+template <typename qs_policy_t_>
+index_t SparseVectorState<qs_policy_t_>::Mask(const qbits_t& qubits) {
+    index_t mask = 0;
+    for (auto q : qubits) {
+        mask |= index_t(1) << q;
+    }
+    return mask;
+}
+
+template <typename qs_policy_t_>
+double SparseVectorState<qs_policy_t_>::Angle(const std::shared_ptr<BasicGate>& gate,
+                                              const parameter::ParameterResolver& pr) {
+    auto g = static_cast<Parameterizable*>(gate.get());
+    return tensor::ops::cpu::to_vector<double>(g->prs_[0].Combination(pr).const_value)[0];
+}
+
+template <typename qs_policy_t_>
+auto SparseVectorState<qs_policy_t_>::GateMatrix(const std::shared_ptr<BasicGate>& gate,
+                                                 const parameter::ParameterResolver& pr) -> VVT<py_qs_data_t> {
+    tensor::Matrix m;
+    switch (gate->id_) {
+        case GateID::H: {
+            auto h = 1 / std::sqrt(2.0);
+            return {{h, h}, {h, -h}};
+        }
+        case GateID::U3: {
+            auto u3 = static_cast<U3*>(gate.get());
+            if (!u3->Parameterized()) {
+                m = u3->base_matrix_;
+            } else {
+                m = U3Matrix(u3->theta.Combination(pr).const_value, u3->phi.Combination(pr).const_value,
+                             u3->lambda.Combination(pr).const_value);
+            }
+        } break;
+        case GateID::FSim: {
+            auto fsim = static_cast<FSim*>(gate.get());
+            if (!fsim->Parameterized()) {
+                m = fsim->base_matrix_;
+            } else {
+                m = FSimMatrix(fsim->theta.Combination(pr).const_value, fsim->phi.Combination(pr).const_value);
+            }
+        } break;
+        case GateID::CUSTOM: {
+            auto g = static_cast<CustomGate*>(gate.get());
+            m = g->Parameterized() ? g->numba_param_matrix_(Angle(gate, pr)) : g->base_matrix_;
+        } break;
+        default:
+            throw std::invalid_argument(fmt::format("Gate {} has no matrix form in sparse simulator.", gate->id_));
+    }
+    return tensor::ops::cpu::to_vector<py_qs_data_t>(m);
+}
+
+template <typename qs_policy_t_>
+index_t SparseVectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& gate,
+                                                   const parameter::ParameterResolver& pr) {
+    if (IsDense()) {
+        return dense_->ApplyGate(gate, pr);
+    }
+    auto id = gate->id_;
+    const auto& objs = gate->obj_qubits_;
+    auto ctrl_mask = Mask(gate->ctrl_qubits_);
+    auto obj_mask = Mask(objs);
+    bool branching = false;
+    // Pauli rotations exp(-i theta/2 P) on the object qubits. As in the dense kernels, the first Pauli of Rxy, Rxz and
+    // Ryz acts on the lower of the two qubits.
+    auto rotation = [&](index_t x, index_t y, index_t z) {
+        PauliMask mask;
+        mask.mask_x = x;
+        mask.mask_y = y;
+        mask.mask_z = z;
+        mask.num_y = CountOne(y);
+        auto theta = Angle(gate, pr);
+        ApplyPauli(ctrl_mask, mask, std::cos(theta / 2), py_qs_data_t(0, -std::sin(theta / 2)));
+        branching = (x | y) != 0;
+    };
+    auto pauli = [&](index_t x, index_t y, index_t z) {
+        PauliMask mask;
+        mask.mask_x = x;
+        mask.mask_y = y;
+        mask.mask_z = z;
+        mask.num_y = CountOne(y);
+        ApplyPauli(ctrl_mask, mask, 0, 1);
+    };
+    auto bit = [&](size_t i) { return index_t(1) << objs[i]; };
+    auto low = obj_mask & (~obj_mask + 1);
+    switch (id) {
+        case GateID::I:
+            break;
+        case GateID::X:
+            pauli(obj_mask, 0, 0);
+            break;
+        case GateID::Y:
+            pauli(0, obj_mask, 0);
+            break;
+        case GateID::Z:
+            pauli(0, 0, obj_mask);
+            break;
+        case GateID::S:
+        case GateID::Sdag:
+        case GateID::T:
+        case GateID::Tdag: {
+            auto phase = id == GateID::S      ? py_qs_data_t(0, 1)
+                         : id == GateID::Sdag ? py_qs_data_t(0, -1)
+                         : id == GateID::T    ? std::polar(1.0, M_PI / 4)
+                                              : std::polar(1.0, -M_PI / 4);
+            ApplyDiagonal(ctrl_mask, [&](index_t k) { return (k & obj_mask) != 0 ? phase : py_qs_data_t(1); });
+        } break;
+        case GateID::PS: {
+            auto phase = std::polar(1.0, Angle(gate, pr));
+            ApplyDiagonal(ctrl_mask, [&](index_t k) { return (k & obj_mask) != 0 ? phase : py_qs_data_t(1); });
+        } break;
+        case GateID::GP: {
+            auto phase = std::polar(1.0, -Angle(gate, pr));
+            ApplyDiagonal(ctrl_mask, [&](index_t) { return phase; });
+        } break;
+        case GateID::SWAP:
+        case GateID::ISWAP: {
+            py_qs_data_t phase = 1;
+            if (id == GateID::ISWAP) {
+                phase = static_cast<ISWAPGate*>(gate.get())->daggered_ ? py_qs_data_t(0, -1) : py_qs_data_t(0, 1);
+            }
+            ApplyPermutation(ctrl_mask, [&](index_t k) {
+                if (((k & bit(0)) == 0) == ((k & bit(1)) == 0)) {
+                    return std::make_pair(k, py_qs_data_t(1));
+                }
+                return std::make_pair(k ^ obj_mask, phase);
+            });
+        } break;
+        case GateID::RX:
+            rotation(obj_mask, 0, 0);
+            break;
+        case GateID::RY:
+            rotation(0, obj_mask, 0);
+            break;
+        case GateID::RZ:
+            rotation(0, 0, obj_mask);
+            break;
+        case GateID::Rxx:
+            rotation(obj_mask, 0, 0);
+            break;
+        case GateID::Ryy:
+            rotation(0, obj_mask, 0);
+            break;
+        case GateID::Rzz:
+            rotation(0, 0, obj_mask);
+            break;
+        case GateID::Rxy:
+            rotation(low, obj_mask ^ low, 0);
+            break;
+        case GateID::Rxz:
+            rotation(low, 0, obj_mask ^ low);
+            break;
+        case GateID::Ryz:
+            rotation(0, low, obj_mask ^ low);
+            break;
+        case GateID::RPS: {
+            auto mask = GenPauliMask(objs, static_cast<RotPauliStringGate*>(gate.get())->paulis_);
+            rotation(mask.mask_x, mask.mask_y, mask.mask_z);
+        } break;
+        case GateID::H:
+        case GateID::U3:
+        case GateID::FSim:
+        case GateID::CUSTOM:
+            ApplyMatrix(objs, ctrl_mask, GateMatrix(gate, pr));
+            branching = true;
+            break;
+        case GateID::M:
+            return Measure(objs[0]);
+        default:
+            throw std::invalid_argument(fmt::format("Gate {} is not supported by the sparse simulator.", id));
+    }
+    if (branching) {
+        Prune();
+        DensifyIfNeeded();
+    }
+    return 2;
+}
+
+template <typename qs_policy_t_>
+std::map<std::string, int> SparseVectorState<qs_policy_t_>::ApplyCircuit(const circuit_t& circ,
+                                                                         const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("SparseApplyCircuit", "simulator");
+    std::map<std::string, int> result;
+    for (size_t pos = 0; pos < circ.size(); ++pos) {
+        if (IsDense()) {
+            auto rest = dense_->ApplyCircuit(circuit_t(circ.begin() + pos, circ.end()), pr);
+            result.insert(rest.begin(), rest.end());
+            break;
+        }
+        auto& gate = circ[pos];
+        if (gate->id_ == GateID::M) {
+            result[static_cast<MeasureGate*>(gate.get())->name_] = Measure(gate->obj_qubits_[0]);
+        } else {
+            ApplyGate(gate, pr);
+        }
+    }
+    return result;
+}
+
+template <typename qs_policy_t_>
+void SparseVectorState<qs_policy_t_>::ApplyPauli(index_t ctrl_mask, const PauliMask& mask, py_qs_data_t id_coeff,
+                                                  py_qs_data_t pauli_coeff) {
+    auto flip = mask.mask_x | mask.mask_y;
+    auto phase = [&](index_t k) {
+        return POLAR[static_cast<char>(
+            (mask.num_y + 2 * CountOne(k & mask.mask_y)
+             + 2 * CountOne(k & mask.mask_z))
+            & 3)];
+    };
+    if (flip == 0) {
+        ApplyDiagonal(ctrl_mask, [&](index_t k) { return id_coeff + pauli_coeff * phase(k); });
+        return;
+    }
+    if (id_coeff == py_qs_data_t(0)) {
+        ApplyPermutation(ctrl_mask, [&](index_t k) { return std::make_pair(k ^ flip, pauli_coeff * phase(k)); });
+        return;
+    }
+    SparseAmplitudes out(2 * amps_.Size());
+    amps_.ForEach([&](index_t k, const py_qs_data_t& v) {
+        if ((k & ctrl_mask) != ctrl_mask) {
+            out.Add(k, v);
+            return;
+        }
+        out.Add(k, id_coeff * v);
+        out.Add(k ^ flip, pauli_coeff * phase(k) * v);
+    });
+    amps_ = std::move(out);
+}
+
+template <typename qs_policy_t_>
+template <typename F>
+void SparseVectorState<qs_policy_t_>::ApplyDiagonal(index_t ctrl_mask, const F& phase) {
+    amps_.Update([&](index_t k, py_qs_data_t& v) {
+        if ((k & ctrl_mask) == ctrl_mask) {
+            v *= phase(k);
+        }
+    });
+}
+
+template <typename qs_policy_t_>
+template <typename F>
+void SparseVectorState<qs_policy_t_>::ApplyPermutation(index_t ctrl_mask, const F& perm) {
+    SparseAmplitudes out(amps_.Size());
+    amps_.ForEach([&](index_t k, const py_qs_data_t& v) {
+        if ((k & ctrl_mask) != ctrl_mask) {
+            out.Add(k, v);
+            return;
+        }
+        auto [target, factor] = perm(k);
+        out.Add(target, factor * v);
+    });
+    amps_ = std::move(out);
+}
+
+template <typename qs_policy_t_>
+void SparseVectorState<qs_policy_t_>::ApplyMatrix(const qbits_t& objs, index_t ctrl_mask,
+                                                  const VVT<py_qs_data_t>& m) {
+    auto obj_mask = Mask(objs);
+    auto n_local = index_t(1) << objs.size();
+    // Offset of each local index in the full index.
+    std::vector<index_t> offset(n_local, 0);
+    for (index_t l = 0; l < n_local; ++l) {
+        for (size_t j = 0; j < objs.size(); ++j) {
+            if ((l >> j) & 1) {
+                offset[l] |= index_t(1) << objs[j];
+            }
+        }
+    }
+    SparseAmplitudes out(amps_.Size() * 2);
+    amps_.ForEach([&](index_t k, const py_qs_data_t& v) {
+        if ((k & ctrl_mask) != ctrl_mask) {
+            out.Add(k, v);
+            return;
+        }
+        auto col = static_cast<index_t>(std::find(offset.begin(), offset.end(), k & obj_mask) - offset.begin());
+        auto base = k & ~obj_mask;
+        for (index_t row = 0; row < n_local; ++row) {
+            if (m[row][col] != py_qs_data_t(0)) {
+                out.Add(base | offset[row], m[row][col] * v);
+            }
+        }
+    });
+    amps_ = std::move(out);
+}
+
+template <typename qs_policy_t_>
+index_t SparseVectorState<qs_policy_t_>::Measure(qbit_t qubit) {
+    if (IsDense()) {
+        return dense_->ApplyMeasure(std::make_shared<MeasureGate>("", qbits_t{qubit}));
+    }
+    index_t mask = index_t(1) << qubit;
+    double one_amp = 0;
+    double total = 0;
+    amps_.ForEach([&](index_t k, const py_qs_data_t& v) {
+        total += std::norm(v);
+        if ((k & mask) != 0) {
+            one_amp += std::norm(v);
+        }
+    });
+    std::uniform_real_distribution<double> dist(0., 1.);
+    index_t result = dist(rnd_eng_) * total < one_amp ? 1 : 0;
+    double norm_fact = 1 / std::sqrt(result == 1 ? one_amp : total - one_amp);
+    amps_.Filter([&](index_t k, const py_qs_data_t&) { return ((k & mask) != 0) == (result == 1); });
+    amps_.Update([&](index_t, py_qs_data_t& v) { v *= norm_fact; });
+    return result;
+}
+
+template <typename qs_policy_t_>
+void SparseVectorState<qs_policy_t_>::Prune() {
+    auto threshold = prune_threshold_ * prune_threshold_;
+    amps_.Filter([&](index_t, const py_qs_data_t& v) { return std::norm(v) > threshold; });
+}
+
+template <typename qs_policy_t_>
+void SparseVectorState<qs_policy_t_>::DensifyIfNeeded() {
+    if (n_qubits_ > max_dense_qubits_) {
+        return;
+    }
+    auto dim = index_t(1) << n_qubits_;
+    if (static_cast<double>(amps_.Size()) < dense_fraction_ * static_cast<double>(dim)) {
+        return;
+    }
+    MQ_TRACE_SCOPE("SparseToDense", "simulator");
+    using qs_data_t = typename qs_policy_t::qs_data_t;
+    auto qs = qs_policy_t::InitState(dim, false);
+    amps_.ForEach([&](index_t k, const py_qs_data_t& v) { qs[k] = static_cast<qs_data_t>(v); });
+    dense_ = std::make_unique<dense_t>(qs, n_qubits_, static_cast<unsigned>(rnd_eng_()));
+    amps_ = SparseAmplitudes();
+}
+
+template <typename qs_policy_t_>
+auto SparseVectorState<qs_policy_t_>::GetAmplitude(index_t idx) const -> py_qs_data_t {
+    if (idx >> n_qubits_ != 0) {
+        throw std::out_of_range(fmt::format("Index {} out of range for {} qubits.", idx, n_qubits_));
+    }
+    if (IsDense()) {
+        return static_cast<py_qs_data_t>(dense_->GetQS()[idx]);
+    }
+    return amps_.Get(idx);
+}
+
+template <typename qs_policy_t_>
+auto SparseVectorState<qs_policy_t_>::GetAmplitudes() const -> std::vector<std::pair<index_t, py_qs_data_t>> {
+    std::vector<std::pair<index_t, py_qs_data_t>> out;
+    if (IsDense()) {
+        auto qs = dense_->GetQS();
+        out.reserve(qs.size());
+        for (size_t i = 0; i < qs.size(); ++i) {
+            out.emplace_back(i, static_cast<py_qs_data_t>(qs[i]));
+        }
+        return out;
+    }
+    out.reserve(amps_.Size());
+    amps_.ForEach([&](index_t k, const py_qs_data_t& v) { out.emplace_back(k, v); });
+    std::sort(out.begin(), out.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    return out;
+}
+
+template <typename qs_policy_t_>
+auto SparseVectorState<qs_policy_t_>::GetQS() const -> VT<py_qs_data_t> {
+    if (IsDense()) {
+        auto qs = dense_->GetQS();
+        return VT<py_qs_data_t>(qs.begin(), qs.end());
+    }
+    if (n_qubits_ > 30) {
+        throw std::runtime_error(
+            fmt::format("Cannot get full state of {} qubits, use the stored amplitudes instead.", n_qubits_));
+    }
+    VT<py_qs_data_t> out(index_t(1) << n_qubits_);
+    amps_.ForEach([&](index_t k, const py_qs_data_t& v) { out[k] = v; });
+    return out;
+}
+
+template <typename qs_policy_t_>
+auto SparseVectorState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham) const -> py_qs_data_t {
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("Sparse simulator needs a Hamiltonian given as Pauli terms.");
+    }
+    if (IsDense()) {
+        return static_cast<py_qs_data_t>(dense_->GetExpectation(ham, {}, parameter::ParameterResolver()));
+    }
+    py_qs_data_t out = 0;
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        auto mask = GenPauliMask(pauli_string);
+        auto flip = mask.mask_x | mask.mask_y;
+        amps_.ForEach([&](index_t k, const py_qs_data_t& v) {
+            auto partner = flip == 0 ? v : amps_.Get(k ^ flip);
+            if (partner == py_qs_data_t(0)) {
+                return;
+            }
+            auto c = POLAR[static_cast<char>((mask.num_y + 2 * CountOne(k & mask.mask_y)
+                                              + 2 * CountOne(k & mask.mask_z))
+                                             & 3)];
+            out += std::conj(partner) * v * c * static_cast<double>(coeff);
+        });
+    }
+    return out;
+}
+
+template <typename qs_policy_t_>
+VT<unsigned> SparseVectorState<qs_policy_t_>::Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr,
+                                                       size_t shots, const MST<size_t>& key_map,
+                                                       unsigned seed) const {
+    if (IsDense()) {
+        return dense_->Sampling(circ, pr, shots, key_map, seed);
+    }
+    MQ_TRACE_SCOPE("SparseSampling", "simulator");
+    auto key_size = key_map.size();
+    VT<unsigned> res(shots * key_size);
+    std::mt19937 rnd_eng(seed);
+    std::uniform_real_distribution<double> dist(1.0, (1 << 20) * 1.0);
+    std::function<double()> rng = std::bind(dist, std::ref(rnd_eng));
+    for (size_t i = 0; i < shots; i++) {
+        auto sim = *this;
+        sim.rnd_eng_.seed(static_cast<unsigned>(rng()));
+        auto res0 = sim.ApplyCircuit(circ, pr);
+        for (const auto& [name, val] : key_map) {
+            res[i * key_size + val] = res0[name];
+        }
+    }
+    return res;
+}
+}  // namespace mindquantum::sim::vector::detail
+
+#endif
@@ -41,6 +41,7 @@
 #include "ops/basic_gate.h"
 #include "ops/gates.h"
 #include "ops/hamiltonian.h"
+#include "simulator/checkpoint.h"
 #include "simulator/timer.h"
 #include "simulator/utils.h"
 
@@ -65,7 +66,9 @@ class VectorState {
     //! ctor
     VectorState() = default;
     explicit VectorState(qbit_t n_qubits, unsigned seed = 42);
+    //! State initialized with a copy of the buffer vec, which stays owned by the caller.
     VectorState(qbit_t n_qubits, unsigned seed, qs_data_p_t vec);
+    //! State adopting the buffer qs (nullptr for zero state), which is freed with the state.
     VectorState(qs_data_p_t qs, qbit_t n_qubits, unsigned seed = 42);
 
     VectorState(const VectorState<qs_policy_t>& sim);
@@ -92,6 +95,37 @@ class VectorState {
     //! Set the quantum state value
     virtual void SetQS(const VT<py_qs_data_t>& qs_out);
 
+    //! Set the quantum state value from a contiguous buffer with \c size amplitudes, without temporary copy.
+    void SetQSFromBuffer(const py_qs_data_t* qs_out, index_t size);
+
+    //! Save the quantum state and the random engine to a checkpoint file, see simulator/checkpoint.h.
+    void Save(const std::string& filename, double drop_below = 0) const;
+
+    //! Restore a checkpoint saved by a simulator of the same type and number of qubits.
+    void Load(const std::string& filename);
+
+    //! Dimension of the state vector.
+    index_t GetDim() const {
+        return dim;
+    }
+
+    //! Whether the state is the zero state whose buffer is not allocated yet.
+    bool IsZeroState() const {
+        return qs == nullptr;
+    }
+
+    /*!
+     * \brief Get the address of the quantum state buffer, zero state is allocated if needed.
+     *
+     * The address stays valid until the matching ReleaseQSView(): as long as a view is alive, operations that would
+     * allocate a new buffer write their result back into the viewed one instead, and copies of this state do not
+     * share the buffer.
+     */
+    qs_data_p_t AcquireQSView();
+
+    //! Release an address obtained with AcquireQSView().
+    void ReleaseQSView();
+
     /*!
      * \brief Apply a quantum gate on this quantum state, quantum gate can be
      * normal quantum gate, measurement gate and noise channel
@@ -100,6 +134,17 @@ class VectorState {
                               const parameter::ParameterResolver& pr = parameter::ParameterResolver(),
                               bool diff = false);
 
+    /*!
+     * \brief Restore the norm of the quantum state every \c interval gates, zero to disable.
+     *
+     * The norm is measured after the first gate following a non unitary operation and restored each \c interval
+     * gates after, so rounding errors of low precision states do not accumulate in the norm over deep circuits.
+     */
+    void SetRenormalization(index_t interval);
+    index_t GetRenormalization() const {
+        return renorm_interval_;
+    }
+
     //! Apply a measurement gate on this quantum state, return the collapsed qubit state
     virtual index_t ApplyMeasure(const std::shared_ptr<BasicGate>& gate);
 
@@ -214,12 +259,61 @@ class VectorState {
     VectorState<policy_des> astype(unsigned seed) const;
 
  protected:
+    //! Replace the quantum state buffer by new_qs (nullptr for zero state) and take its ownership.
+    void ReplaceQS(qs_data_p_t new_qs);
+
+    //! Buffer for a copy of this state: shared until one of them writes, copied right away while views are alive.
+    qs_data_p_t ShareQS() const;
+
+    //! Copy the buffer if it is shared, before an in place write. The content is not copied if keep_content is false.
+    void Unshare(bool keep_content = true);
+
+    /*!
+     * \brief Apply gate on the given qubits instead of its own, used by simulators that relabel the qubits.
+     *
+     * Measurements and channels always act on the qubits of the gate.
+     */
+    index_t ApplyGateOn(const std::shared_ptr<BasicGate>& gate, const qbits_t& objs, const qbits_t& ctrls,
+                        const parameter::ParameterResolver& pr, bool diff);
+
+    //! Count a norm preserving gate and renormalize when the interval is reached.
+    void TrackNorm();
+
+    //! Forget the reference norm after the state changed by other means than a unitary gate.
+    void ResetNormTracking() {
+        ref_norm_ = -1;
+        n_tracked_gates_ = 0;
+    }
+
+    //! Metadata of a checkpoint of this state, without the random engine.
+    checkpoint::Info CheckpointInfo() const {
+        checkpoint::Info info;
+        info.kind = checkpoint::Kind::Vector;
+        info.dtype = tensor::to_dtype_v<py_qs_data_t>;
+        info.n_qubits = n_qubits;
+        info.seed = seed;
+        info.n_elements = dim;
+        info.element_bytes = sizeof(qs_data_t);
+        return info;
+    }
+
+    //! Bytes of one allocated quantum state.
+    size_t StateBytes() const {
+        return sizeof(qs_data_t) * dim;
+    }
+
     qs_data_p_t qs = nullptr;  // nullptr represent zero state.
     qbit_t n_qubits = 0;
     index_t dim = 0;
     unsigned seed = 0;
     RndEngine rnd_eng_;
     std::function<double()> rng_;
+    // Number of alive views on qs, see AcquireQSView. Views may be released from another thread while this simulator
+    // runs without the GIL, so the counter is atomic.
+    std::atomic<index_t> n_views_ = 0;
+    index_t renorm_interval_ = 0;
+    index_t n_tracked_gates_ = 0;
+    double ref_norm_ = -1;  // Squared norm to restore, negative if not measured yet.
 };
 }  // namespace mindquantum::sim::vector::detail
 
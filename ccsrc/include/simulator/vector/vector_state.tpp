@@ -30,6 +30,7 @@
 #include <mutex>
 #include <optional>
 #include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -37,7 +38,9 @@
 #include <type_traits>
 #include <vector>
 
+#include "core/memory_manager.h"
 #include "core/mq_base_types.h"
+#include "core/trace.h"
 #include "math/pr/parameter_resolver.h"
 #include "math/tensor/matrix.h"
 #include "math/tensor/ops/basic_math.h"
@@ -46,6 +49,7 @@
 #include "ops/gate_id.h"
 #include "ops/gates.h"
 #include "ops/hamiltonian.h"
+#include "simulator/profiler.h"
 #include "simulator/vector/vector_state.h"
 
 namespace mindquantum::sim::vector::detail {
@@ -74,10 +78,11 @@ VectorState<qs_policy_t_>::VectorState(qs_data_p_t qs, qbit_t n_qubits, unsigned
 
 template <typename qs_policy_t_>
 VectorState<qs_policy_t_>::VectorState(const VectorState<qs_policy_t>& sim) {
-    this->qs = qs_policy_t::Copy(sim.qs, sim.dim);
+    this->qs = sim.ShareQS();
     this->dim = sim.dim;
     this->n_qubits = sim.n_qubits;
     this->seed = sim.seed;
+    this->renorm_interval_ = sim.renorm_interval_;
     this->rnd_eng_ = RndEngine(seed);
     std::uniform_real_distribution<double> dist(0., 1.);
     this->rng_ = std::bind(dist, std::ref(this->rnd_eng_));
@@ -85,11 +90,17 @@ VectorState<qs_policy_t_>::VectorState(const VectorState<qs_policy_t>& sim) {
 
 template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::operator=(const VectorState<qs_policy_t>& sim) -> derived_t& {
-    qs_policy_t::FreeState(&(this->qs));
-    this->qs = qs_policy_t::Copy(sim.qs, sim.dim);
+    if (this == &sim) {
+        return *this;
+    }
+    if (n_views_ != 0 && dim != sim.dim) {
+        throw std::runtime_error("Cannot assign a state with different size while its buffer is viewed.");
+    }
+    ReplaceQS(sim.ShareQS());
     this->dim = sim.dim;
     this->n_qubits = sim.n_qubits;
     this->seed = sim.seed;
+    this->renorm_interval_ = sim.renorm_interval_;
     this->rnd_eng_ = RndEngine(seed);
     std::uniform_real_distribution<double> dist(0., 1.);
     this->rng_ = std::bind(dist, std::ref(this->rnd_eng_));
@@ -102,6 +113,7 @@ VectorState<qs_policy_t_>::VectorState(VectorState<qs_policy_t>&& sim) {
     this->dim = sim.dim;
     this->n_qubits = sim.n_qubits;
     this->seed = sim.seed;
+    this->renorm_interval_ = sim.renorm_interval_;
     sim.qs = nullptr;
     this->rnd_eng_ = RndEngine(seed);
     std::uniform_real_distribution<double> dist(0., 1.);
@@ -110,11 +122,17 @@ VectorState<qs_policy_t_>::VectorState(VectorState<qs_policy_t>&& sim) {
 
 template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::operator=(VectorState<qs_policy_t>&& sim) -> derived_t& {
-    qs_policy_t::FreeState(&(this->qs));
-    this->qs = sim.qs;
+    if (this == &sim) {
+        return *this;
+    }
+    if (n_views_ != 0 && dim != sim.dim) {
+        throw std::runtime_error("Cannot assign a state with different size while its buffer is viewed.");
+    }
+    ReplaceQS(sim.qs);
     this->dim = sim.dim;
     this->n_qubits = sim.n_qubits;
     this->seed = sim.seed;
+    this->renorm_interval_ = sim.renorm_interval_;
     sim.qs = nullptr;
     this->rnd_eng_ = RndEngine(seed);
     std::uniform_real_distribution<double> dist(0., 1.);
@@ -129,9 +147,120 @@ tensor::TDtype VectorState<qs_policy_t_>::DType() {
 
 template <typename qs_policy_t_>
 void VectorState<qs_policy_t_>::Reset() {
+    ResetNormTracking();
+    if (n_views_ != 0) {
+        ReplaceQS(nullptr);
+        return;
+    }
     qs_policy_t::Reset(&qs);
 }
 
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::ReplaceQS(qs_data_p_t new_qs) {
+    ResetNormTracking();
+    if (n_views_ == 0 || qs == nullptr) {
+        qs_policy_t::FreeState(&qs);
+        qs = new_qs;
+        return;
+    }
+    if (new_qs == nullptr) {
+        new_qs = qs_policy_t::InitState(dim);
+    }
+    qs_policy_t::QSMulValue(new_qs, &qs, 1, dim);
+    qs_policy_t::FreeState(&new_qs);
+}
+
+template <typename qs_policy_t_>
+auto VectorState<qs_policy_t_>::ShareQS() const -> qs_data_p_t {
+    if (n_views_ != 0) {
+        return qs_policy_t::Copy(qs, dim);
+    }
+    return qs_policy_t::Share(qs, dim);
+}
+
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::Unshare(bool keep_content) {
+    if (!qs_policy_t::IsShared(qs)) {
+        return;
+    }
+    auto out = keep_content ? qs_policy_t::Copy(qs, dim) : nullptr;
+    qs_policy_t::FreeState(&qs);
+    qs = out;
+}
+
+template <typename qs_policy_t_>
+auto VectorState<qs_policy_t_>::AcquireQSView() -> qs_data_p_t {
+    ResetNormTracking();
+    if (qs == nullptr) {
+        qs = qs_policy_t::InitState(dim);
+    }
+    Unshare();
+    n_views_ += 1;
+    return qs;
+}
+
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::ReleaseQSView() {
+    auto n_views = n_views_.load();
+    do {
+        if (n_views == 0) {
+            throw std::runtime_error("No quantum state view to release.");
+        }
+    } while (!n_views_.compare_exchange_weak(n_views, n_views - 1));
+}
+
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::SetQSFromBuffer(const py_qs_data_t* qs_out, index_t size) {
+    ResetNormTracking();
+    if (size == dim) {
+        Unshare(false);
+    }
+    qs_policy_t::SetQSFromBuffer(&qs, qs_out, size, dim);
+}
+
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::Save(const std::string& filename, double drop_below) const {
+    MQ_TRACE_SCOPE("SaveState", "simulator");
+    auto info = CheckpointInfo();
+    std::ostringstream rng;
+    rng << rnd_eng_;
+    info.rng_state = rng.str();
+    if (qs != nullptr) {
+        checkpoint::Save(filename, info, qs, drop_below);
+        return;
+    }
+    auto zero_state = qs_policy_t::InitState(dim);
+    try {
+        checkpoint::Save(filename, info, zero_state, drop_below);
+    } catch (...) {
+        qs_policy_t::FreeState(&zero_state);
+        throw;
+    }
+    qs_policy_t::FreeState(&zero_state);
+}
+
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::Load(const std::string& filename) {
+    MQ_TRACE_SCOPE("LoadState", "simulator");
+    auto buffer = qs_policy_t::InitState(dim, false);
+    checkpoint::Info saved;
+    try {
+        saved = checkpoint::Load(filename, CheckpointInfo(), buffer);
+    } catch (...) {
+        qs_policy_t::FreeState(&buffer);
+        throw;
+    }
+    RndEngine engine;
+    std::istringstream rng(saved.rng_state);
+    if (!(rng >> engine)) {
+        qs_policy_t::FreeState(&buffer);
+        throw std::runtime_error(fmt::format("Corrupted random engine state in checkpoint {}.", filename));
+    }
+    ReplaceQS(buffer);
+    seed = saved.seed;
+    rnd_eng_ = engine;
+}
+
 template <typename qs_policy_t_>
 void VectorState<qs_policy_t_>::Display(qbit_t qubits_limit) const {
     qs_policy_t::Display(qs, n_qubits, qubits_limit);
@@ -144,134 +273,177 @@ auto VectorState<qs_policy_t_>::GetQS() const -> VT<py_qs_data_t> {
 
 template <typename qs_policy_t_>
 void VectorState<qs_policy_t_>::SetQS(const VT<py_qs_data_t>& qs_out) {
+    ResetNormTracking();
+    if (qs_out.size() == dim) {
+        Unshare(false);
+    }
     qs_policy_t::SetQS(&qs, qs_out, dim);
 }
 
 template <typename qs_policy_t_>
 index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& gate,
                                              const parameter::ParameterResolver& pr, bool diff) {
+    return ApplyGateOn(gate, gate->obj_qubits_, gate->ctrl_qubits_, pr, diff);
+}
+
+template <typename qs_policy_t_>
+index_t VectorState<qs_policy_t_>::ApplyGateOn(const std::shared_ptr<BasicGate>& gate, const qbits_t& objs,
+                                               const qbits_t& ctrls, const parameter::ParameterResolver& pr,
+                                               bool diff) {
     auto id = gate->id_;
+    MQ_PROFILE_SCOPE(ApplyGate, id, n_qubits, 2 * dim * sizeof(qs_data_t));
+    Unshare();
     switch (id) {
         case GateID::I:
             break;
         case GateID::X:
-            qs_policy_t::ApplyX(&qs, gate->obj_qubits_, gate->ctrl_qubits_, dim);
+            qs_policy_t::ApplyX(&qs, objs, ctrls, dim);
             break;
         case GateID::Y:
-            qs_policy_t::ApplyY(&qs, gate->obj_qubits_, gate->ctrl_qubits_, dim);
+            qs_policy_t::ApplyY(&qs, objs, ctrls, dim);
             break;
         case GateID::Z:
-            qs_policy_t::ApplyZ(&qs, gate->obj_qubits_, gate->ctrl_qubits_, dim);
+            qs_policy_t::ApplyZ(&qs, objs, ctrls, dim);
             break;
         case GateID::H:
-            qs_policy_t::ApplyH(&qs, gate->obj_qubits_, gate->ctrl_qubits_, dim);
+            qs_policy_t::ApplyH(&qs, objs, ctrls, dim);
             break;
         case GateID::S:
-            qs_policy_t::ApplySGate(&qs, gate->obj_qubits_, gate->ctrl_qubits_, dim);
+            qs_policy_t::ApplySGate(&qs, objs, ctrls, dim);
             break;
         case GateID::Sdag:
-            qs_policy_t::ApplySdag(&qs, gate->obj_qubits_, gate->ctrl_qubits_, dim);
+            qs_policy_t::ApplySdag(&qs, objs, ctrls, dim);
             break;
         case GateID::T:
-            qs_policy_t::ApplyT(&qs, gate->obj_qubits_, gate->ctrl_qubits_, dim);
+            qs_policy_t::ApplyT(&qs, objs, ctrls, dim);
             break;
         case GateID::Tdag:
-            qs_policy_t::ApplyTdag(&qs, gate->obj_qubits_, gate->ctrl_qubits_, dim);
+            qs_policy_t::ApplyTdag(&qs, objs, ctrls, dim);
             break;
         case GateID::SWAP:
-            qs_policy_t::ApplySWAP(&qs, gate->obj_qubits_, gate->ctrl_qubits_, dim);
+            qs_policy_t::ApplySWAP(&qs, objs, ctrls, dim);
             break;
         case GateID::ISWAP: {
             bool daggered = static_cast<ISWAPGate*>(gate.get())->daggered_;
-            qs_policy_t::ApplyISWAP(&qs, gate->obj_qubits_, gate->ctrl_qubits_, daggered, dim);
+            qs_policy_t::ApplyISWAP(&qs, objs, ctrls, daggered, dim);
         } break;
         case GateID::RX: {
             auto g = static_cast<RXGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyRX(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRX(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::RY: {
             auto g = static_cast<RYGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyRY(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRY(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::RZ: {
             auto g = static_cast<RZGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyRZ(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRZ(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::Rxx: {
             auto g = static_cast<RxxGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyRxx(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRxx(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::Ryy: {
             auto g = static_cast<RyyGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyRyy(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRyy(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::Rzz: {
             auto g = static_cast<RzzGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyRzz(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRzz(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::Rxy: {
             auto g = static_cast<RxyGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyRxy(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRxy(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::Rxz: {
             auto g = static_cast<RxzGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyRxz(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRxz(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::Ryz: {
             auto g = static_cast<RyzGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyRyz(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRyz(&qs, objs, ctrls, val, dim, diff);
+        } break;
+        case GateID::RPS: {
+            auto g = static_cast<RotPauliStringGate*>(gate.get());
+            if (!g->GradRequired()) {
+                diff = false;
+            }
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyRPS(&qs, objs, g->paulis_, ctrls, val, dim, diff);
+        } break;
+        case GateID::SE:
+        case GateID::DE: {
+            auto g = static_cast<Parameterizable*>(gate.get());
+            if (!g->GradRequired()) {
+                diff = false;
+            }
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyExcitation(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::PS: {
             auto g = static_cast<PSGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyPS(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyPS(&qs, objs, ctrls, val, dim, diff);
         } break;
         case GateID::GP: {
             auto g = static_cast<GPGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-            qs_policy_t::ApplyGP(&qs, gate->obj_qubits_[0], gate->ctrl_qubits_, val, dim, diff);
+            auto val = tensor::ops::cpu::to_vector<calc_type>(
+                MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
+            qs_policy_t::ApplyGP(&qs, objs[0], ctrls, val, dim, diff);
         } break;
         case GateID::U3: {
             if (diff) {
@@ -287,7 +459,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
                 auto lambda = u3->lambda.Combination(pr).const_value;
                 m = U3Matrix(theta, phi, lambda);
             }
-            qs_policy_t::ApplySingleQubitMatrix(qs, &qs, gate->obj_qubits_[0], gate->ctrl_qubits_,
+            qs_policy_t::ApplySingleQubitMatrix(qs, &qs, objs[0], ctrls,
                                                 tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         } break;
         case GateID::FSim: {
@@ -303,7 +475,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
                 auto phi = fsim->phi.Combination(pr).const_value;
                 m = FSimMatrix(theta, phi);
             }
-            qs_policy_t::ApplyTwoQubitsMatrix(qs, &qs, gate->obj_qubits_, gate->ctrl_qubits_,
+            qs_policy_t::ApplyTwoQubitsMatrix(qs, &qs, objs, ctrls,
                                               tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         } break;
         case GateID::M:
@@ -327,25 +499,60 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->Parameterized()) {
                 mat = g->base_matrix_;
             } else {
-                double val = tensor::ops::cpu::to_vector<double>(g->prs_[0].Combination(pr).const_value)[0];
+                double val = tensor::ops::cpu::to_vector<double>(
+                    MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0,
+                                    g->prs_[0].Combination(pr).const_value))[0];
                 if (!diff) {
                     mat = g->numba_param_matrix_(val);
                 } else {
                     mat = g->numba_param_diff_matrix_(val);
                 }
             }
-            qs_policy_t::ApplyMatrixGate(qs, &qs, gate->obj_qubits_, gate->ctrl_qubits_,
+            qs_policy_t::ApplyMatrixGate(qs, &qs, objs, ctrls,
                                          tensor::ops::cpu::to_vector<py_qs_data_t>(mat), dim);
             break;
         }
         default:
             throw std::invalid_argument(fmt::format("Apply of gate {} not implement.", id));
     }
+    if (diff) {
+        ResetNormTracking();
+    } else {
+        TrackNorm();
+    }
     return 2;
 }
 
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::SetRenormalization(index_t interval) {
+    renorm_interval_ = interval;
+    ResetNormTracking();
+}
+
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::TrackNorm() {
+    if (renorm_interval_ == 0 || qs == nullptr) {
+        return;
+    }
+    if (ref_norm_ < 0) {
+        ref_norm_ = std::real(qs_policy_t::Vdot(qs, qs, dim));
+        return;
+    }
+    n_tracked_gates_ += 1;
+    if (n_tracked_gates_ < renorm_interval_) {
+        return;
+    }
+    n_tracked_gates_ = 0;
+    double norm = std::real(qs_policy_t::Vdot(qs, qs, dim));
+    if (norm > 0) {
+        qs_policy_t::QSMulValue(qs, &qs, static_cast<calc_type>(std::sqrt(ref_norm_ / norm)), dim);
+    }
+}
+
 template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::ApplyMeasure(const std::shared_ptr<BasicGate>& gate) -> index_t {
+    ResetNormTracking();
+    Unshare();
     index_t one_mask = (1UL << gate->obj_qubits_[0]);
     auto one_amp = qs_policy_t::ConditionalCollect(qs, one_mask, one_mask, true, dim).real();
     index_t collapse_mask = (static_cast<index_t>(rng_() < one_amp) << gate->obj_qubits_[0]);
@@ -356,6 +563,7 @@ auto VectorState<qs_policy_t_>::ApplyMeasure(const std::shared_ptr<BasicGate>& g
 
 template <typename qs_policy_t_>
 void VectorState<qs_policy_t_>::ApplyChannel(const std::shared_ptr<BasicGate>& gate) {
+    Unshare();
     auto id = gate->id_;
     switch (id) {
         case GateID::PL:
@@ -378,6 +586,7 @@ void VectorState<qs_policy_t_>::ApplyChannel(const std::shared_ptr<BasicGate>& g
 
 template <typename qs_policy_t_>
 void VectorState<qs_policy_t_>::ApplyPauliChannel(const std::shared_ptr<BasicGate>& gate) {
+    MQ_PROFILE_SCOPE(ApplyChannel, gate->id_, n_qubits, 2 * dim * sizeof(qs_data_t));
     double r = static_cast<double>(rng_());
     auto g = static_cast<PauliChannel*>(gate.get());
     auto it = std::lower_bound(g->cumulative_probs_.begin(), g->cumulative_probs_.end(), r);
@@ -398,6 +607,7 @@ void VectorState<qs_policy_t_>::ApplyPauliChannel(const std::shared_ptr<BasicGat
 
 template <typename qs_policy_t_>
 void VectorState<qs_policy_t_>::ApplyDepolarizingChannel(const std::shared_ptr<BasicGate>& gate) {
+    MQ_PROFILE_SCOPE(ApplyChannel, gate->id_, n_qubits, 2 * dim * sizeof(qs_data_t));
     double r = static_cast<double>(rng_());
     auto g = static_cast<DepolarizingChannel*>(gate.get());
     double p = g->prob_;
@@ -430,6 +640,7 @@ void VectorState<qs_policy_t_>::ApplyDepolarizingChannel(const std::shared_ptr<B
 
 template <typename qs_policy_t_>
 void VectorState<qs_policy_t_>::ApplyKrausChannel(const std::shared_ptr<BasicGate>& gate) {
+    MQ_PROFILE_SCOPE(ApplyChannel, gate->id_, n_qubits, 2 * dim * sizeof(qs_data_t));
     auto tmp_qs = qs_policy_t::InitState(dim);
     calc_type prob = 0;
     auto g = static_cast<KrausChannel*>(gate.get());
@@ -442,8 +653,7 @@ void VectorState<qs_policy_t_>::ApplyKrausChannel(const std::shared_ptr<BasicGat
         calc_type renormal_factor = 1 / std::sqrt(renormal_factor_square);
         if (static_cast<calc_type>(rng_()) <= prob) {
             qs_policy_t::QSMulValue(tmp_qs, &tmp_qs, renormal_factor, dim);
-            qs_policy_t::FreeState(&qs);
-            qs = tmp_qs;
+            ReplaceQS(tmp_qs);
             tmp_qs = nullptr;
             break;
         }
@@ -453,6 +663,7 @@ void VectorState<qs_policy_t_>::ApplyKrausChannel(const std::shared_ptr<BasicGat
 
 template <typename qs_policy_t_>
 void VectorState<qs_policy_t_>::ApplyDampingChannel(const std::shared_ptr<BasicGate>& gate) {
+    MQ_PROFILE_SCOPE(ApplyChannel, gate->id_, n_qubits, 2 * dim * sizeof(qs_data_t));
     calc_type reduced_factor_b_square = qs_policy_t::OneStateVdot(qs, qs, gate->obj_qubits_[0], dim).real();
     calc_type reduced_factor_b = std::sqrt(reduced_factor_b_square);
     if (reduced_factor_b < 1e-8) {
@@ -475,9 +686,7 @@ void VectorState<qs_policy_t_>::ApplyDampingChannel(const std::shared_ptr<BasicG
             qs_policy_t::ConditionalMul(qs, &tmp_qs, (1UL << gate->obj_qubits_[0]), (1UL << gate->obj_qubits_[0]),
                                         1 / reduced_factor_b, 0, dim);
         }
-        qs = tmp_qs;
-        tmp_qs = nullptr;
-        qs_policy_t::FreeState(&tmp_qs);
+        ReplaceQS(tmp_qs);
     } else {
         calc_type coeff_a = 1 / std::sqrt(1 - prob);
         calc_type coeff_b = std::sqrt(1 - damping_coeff) / std::sqrt(1 - prob);
@@ -488,9 +697,10 @@ void VectorState<qs_policy_t_>::ApplyDampingChannel(const std::shared_ptr<BasicG
 template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham, const circuit_t& circ,
                                                const parameter::ParameterResolver& pr) const -> py_qs_data_t {
+    MQ_PROFILE_SCOPE(Expectation, GateID::null, n_qubits, 0);
     py_qs_data_t out;
     auto sub_seed = static_cast<unsigned int>(static_cast<calc_type>(rng_()) * (1 << 20));
-    auto ket = derived_t(n_qubits, sub_seed, qs);
+    auto ket = derived_t(ShareQS(), n_qubits, sub_seed);
     ket.ApplyCircuit(circ, pr);
     if (ham.how_to_ == ORIGIN) {
         out = qs_policy_t::ExpectationOfTerms(ket.qs, ket.qs, ham.ham_, dim);
@@ -506,11 +716,12 @@ template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham, const circuit_t& circ_right,
                                                const circuit_t& circ_left, const parameter::ParameterResolver& pr) const
     -> py_qs_data_t {
+    MQ_PROFILE_SCOPE(Expectation, GateID::null, n_qubits, 0);
     py_qs_data_t out;
     auto sub_seed_bra = static_cast<unsigned int>(static_cast<calc_type>(rng_()) * (1 << 20));
     auto sub_seed_ket = static_cast<unsigned int>(static_cast<calc_type>(rng_()) * (1 << 20));
-    auto ket = derived_t(n_qubits, sub_seed_ket, qs);
-    auto bra = derived_t(n_qubits, sub_seed_bra, qs);
+    auto ket = derived_t(ShareQS(), n_qubits, sub_seed_ket);
+    auto bra = derived_t(ShareQS(), n_qubits, sub_seed_bra);
     ket.ApplyCircuit(circ_right, pr);
     bra.ApplyCircuit(circ_left, pr);
     if (ham.how_to_ == ORIGIN) {
@@ -527,10 +738,11 @@ template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham, const circuit_t& circ_right,
                                                const circuit_t& circ_left, const derived_t& simulator_left,
                                                const parameter::ParameterResolver& pr) const -> py_qs_data_t {
+    MQ_PROFILE_SCOPE(Expectation, GateID::null, n_qubits, 0);
     auto sub_seed_bra = static_cast<unsigned int>(static_cast<calc_type>(simulator_left.rng_()) * (1 << 20));
     auto sub_seed_ket = static_cast<unsigned int>(static_cast<calc_type>(rng_()) * (1 << 20));
-    auto ket = derived_t(n_qubits, sub_seed_ket, qs);
-    auto bra = derived_t(n_qubits, sub_seed_bra, simulator_left.qs);
+    auto ket = derived_t(ShareQS(), n_qubits, sub_seed_ket);
+    auto bra = derived_t(simulator_left.ShareQS(), n_qubits, sub_seed_bra);
     ket.ApplyCircuit(circ_right, pr);
     bra.ApplyCircuit(circ_left, pr);
     py_qs_data_t out;
@@ -556,9 +768,11 @@ auto VectorState<qs_policy_t_>::ExpectDiffGate(const qs_data_p_t& bra, const qs_
                                                const std::shared_ptr<BasicGate>& gate,
                                                const parameter::ParameterResolver& pr, index_t dim) const
     -> tensor::Matrix {
+    MQ_PROFILE_SCOPE(Gradient, gate->id_, n_qubits, 2 * dim * sizeof(qs_data_t));
     auto id = gate->id_;
     auto g = static_cast<Parameterizable*>(gate.get());
-    auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+    auto val = tensor::ops::cpu::to_vector<calc_type>(
+        MQ_PROFILE_EXPR(ParameterResolve, gate->id_, n_qubits, 0, g->prs_[0].Combination(pr).const_value))[0];
     VT<py_qs_data_t> grad = {0};
     switch (id) {
         case GateID::RX:
@@ -588,6 +802,15 @@ auto VectorState<qs_policy_t_>::ExpectDiffGate(const qs_data_p_t& bra, const qs_
         case GateID::Ryz:
             grad[0] = qs_policy_t::ExpectDiffRyz(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
             return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+        case GateID::RPS:
+            grad[0] = qs_policy_t::ExpectDiffRPS(bra, ket, gate->obj_qubits_,
+                                                 static_cast<RotPauliStringGate*>(gate.get())->paulis_,
+                                                 gate->ctrl_qubits_, val, dim);
+            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+        case GateID::SE:
+        case GateID::DE:
+            grad[0] = qs_policy_t::ExpectDiffExcitation(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
+            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
         case GateID::PS:
             grad[0] = qs_policy_t::ExpectDiffPS(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
             return tensor::Matrix(VVT<py_qs_data_t>({grad}));
@@ -615,6 +838,7 @@ auto VectorState<qs_policy_t_>::ExpectDiffU3(const qs_data_p_t& bra, const qs_da
                                              const std::shared_ptr<BasicGate>& gate,
                                              const parameter::ParameterResolver& pr, index_t dim) const
     -> tensor::Matrix {
+    MQ_PROFILE_SCOPE(Gradient, gate->id_, n_qubits, 2 * dim * sizeof(qs_data_t));
     VT<py_qs_data_t> grad = {0, 0, 0};
     auto u3 = static_cast<U3*>(gate.get());
     if (u3->parameterized_) {
@@ -646,6 +870,7 @@ auto VectorState<qs_policy_t_>::ExpectDiffFSim(const qs_data_p_t& bra, const qs_
                                                const std::shared_ptr<BasicGate>& gate,
                                                const parameter::ParameterResolver& pr, index_t dim) const
     -> tensor::Matrix {
+    MQ_PROFILE_SCOPE(Gradient, gate->id_, n_qubits, 2 * dim * sizeof(qs_data_t));
     VT<py_qs_data_t> grad = {0, 0};
     auto fsim = static_cast<FSim*>(gate.get());
     if (fsim->parameterized_) {
@@ -669,6 +894,7 @@ auto VectorState<qs_policy_t_>::ExpectDiffFSim(const qs_data_p_t& bra, const qs_
 template <typename qs_policy_t_>
 std::map<std::string, int> VectorState<qs_policy_t_>::ApplyCircuit(const circuit_t& circ,
                                                                    const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("ApplyCircuit", "simulator");
     std::map<std::string, int> result;
     for (auto& g : circ) {
         if (g->id_ == GateID::M) {
@@ -690,8 +916,7 @@ void VectorState<qs_policy_t_>::ApplyHamiltonian(const Hamiltonian<calc_type>& h
     } else {
         new_qs = qs_policy_t::CsrDotVec(ham.ham_sparse_main_, qs, dim);
     }
-    qs_policy_t::FreeState(&qs);
-    qs = new_qs;
+    ReplaceQS(new_qs);
 }
 
 template <typename qs_policy_t_>
@@ -719,6 +944,7 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradOneOne(const Hamiltonian<c
                                                              const circuit_t& herm_circ,
                                                              const parameter::ParameterResolver& pr,
                                                              const MST<size_t>& p_map) const -> VT<py_qs_data_t> {
+    MQ_TRACE_SCOPE("GetExpectationWithGradOneOne", "gradient");
     // auto timer = Timer();
     // timer.Start("First part");
     VT<py_qs_data_t> f_and_g(1 + p_map.size(), 0);
@@ -734,7 +960,8 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradOneOne(const Hamiltonian<c
             auto p_gate = static_cast<Parameterizable*>(g.get());
             if (const auto& [title, jac] = p_gate->jacobi; title.size() != 0) {
                 auto intrin_grad = ExpectDiffGate(sim_l.qs, sim_r.qs, g, pr, dim);
-                auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
+                auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(
+                    MQ_PROFILE_EXPR(Jacobian, p_gate->id_, n_qubits, 0, tensor::ops::MatMul(intrin_grad, jac)));
                 for (const auto& [name, idx] : title) {
                     f_and_g[1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
                 }
@@ -777,6 +1004,7 @@ auto VectorState<qs_policy_t_>::LeftSizeGradOneMulti(const std::vector<std::shar
                                                      const parameter::ParameterResolver& pr, const MST<size_t>& p_map,
                                                      int n_thread, const derived_t& simulator_left,
                                                      const derived_t& simulator_right) const -> VVT<py_qs_data_t> {
+    MQ_TRACE_SCOPE("LeftSizeGradOneMulti", "gradient");
     auto n_hams = hams.size();
     int max_thread = 15;
     if (n_thread == 0) {
@@ -790,6 +1018,8 @@ auto VectorState<qs_policy_t_>::LeftSizeGradOneMulti(const std::vector<std::shar
     if (n_thread > static_cast<int>(n_hams)) {
         n_thread = n_hams;
     }
+    // sim_l and the buffer of ApplyHamiltonian, plus one state per Hamiltonian of a group.
+    n_thread = static_cast<int>(memory::FitConcurrency(n_thread, StateBytes(), 2 * StateBytes()));
 
     VVT<py_qs_data_t> f_and_g(n_hams, VT<py_qs_data_t>((1 + p_map.size()), 0));
 
@@ -817,7 +1047,8 @@ auto VectorState<qs_policy_t_>::LeftSizeGradOneMulti(const std::vector<std::shar
                 if (const auto& [title, jac] = p_gate->jacobi; title.size() != 0) {
                     for (int j = start; j < end; j++) {
                         auto intrin_grad = ExpectDiffGate(sim_l.qs, sim_rs[j - start].qs, g, pr, dim);
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
+                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(
+                            MQ_PROFILE_EXPR(Jacobian, p_gate->id_, n_qubits, 0, tensor::ops::MatMul(intrin_grad, jac)));
                         for (const auto& [name, idx] : title) {
                             f_and_g[j][1 + p_map.at(name)] += p_grad[0][idx];
                         }
@@ -836,6 +1067,7 @@ template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::GetExpectationWithGradOneMulti(
     const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ, const circuit_t& herm_circ,
     const parameter::ParameterResolver& pr, const MST<size_t>& p_map, int n_thread) const -> VVT<py_qs_data_t> {
+    MQ_TRACE_SCOPE("GetExpectationWithGradOneMulti", "gradient");
     auto n_hams = hams.size();
     int max_thread = 15;
     if (n_thread == 0) {
@@ -847,6 +1079,9 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradOneMulti(
     if (n_thread > static_cast<int>(n_hams)) {
         n_thread = n_hams;
     }
+    // sim, sim_l and the buffer of ApplyHamiltonian, plus one state per Hamiltonian of a group. Smaller groups
+    // recompute sim_l more often but hold fewer states.
+    n_thread = static_cast<int>(memory::FitConcurrency(n_thread, StateBytes(), 3 * StateBytes()));
     VVT<py_qs_data_t> f_and_g(n_hams, VT<py_qs_data_t>((1 + p_map.size()), 0));
     VectorState<qs_policy_t> sim = *this;
     sim.ApplyCircuit(circ, pr);
@@ -874,7 +1109,8 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradOneMulti(
                 if (const auto& [title, jac] = p_gate->jacobi; title.size() != 0) {
                     for (int j = start; j < end; j++) {
                         auto intrin_grad = ExpectDiffGate(sim_l.qs, sim_rs[j - start].qs, g, pr, dim);
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
+                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(
+                            MQ_PROFILE_EXPR(Jacobian, p_gate->id_, n_qubits, 0, tensor::ops::MatMul(intrin_grad, jac)));
                         for (const auto& [name, idx] : title) {
                             f_and_g[j][1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
                         }
@@ -926,6 +1162,7 @@ auto VectorState<qs_policy_t_>::GetExpectationNonHermitianWithGradMultiMulti(
         if (batch_threads == 0) {
             throw std::runtime_error("batch_threads cannot be zero.");
         }
+        batch_threads = memory::FitBatches(batch_threads, (4 + std::min(mea_threads, n_hams)) * StateBytes());
         std::vector<std::thread> tasks;
         tasks.reserve(batch_threads);
         size_t end = 0;
@@ -938,6 +1175,7 @@ auto VectorState<qs_policy_t_>::GetExpectationNonHermitianWithGradMultiMulti(
                 end += 1;
             }
             auto task = [&, start, end]() {
+                MQ_TRACE_SCOPE("GradBatch", "gradient");
                 for (size_t n = start; n < end; n++) {
                     parameter::ParameterResolver pr = parameter::ParameterResolver();
                     pr.SetItems(enc_name, enc_data[n]);
@@ -988,6 +1226,7 @@ auto VectorState<qs_policy_t_>::QramExpectationWithGrad(
         if (batch_threads == 0) {
             throw std::runtime_error("batch_threads cannot be zero.");
         }
+        batch_threads = memory::FitBatches(batch_threads, (4 + std::min(mea_threads, n_hams)) * StateBytes());
         std::vector<std::thread> tasks;
         tasks.reserve(batch_threads);
         size_t end = 0;
@@ -1000,6 +1239,7 @@ auto VectorState<qs_policy_t_>::QramExpectationWithGrad(
                 end += 1;
             }
             auto task = [&, start, end]() {
+                MQ_TRACE_SCOPE("GradBatch", "gradient");
                 auto sim = VectorState<qs_policy_t_>(this->n_qubits, this->seed);
                 for (size_t n = start; n < end; n++) {
                     parameter::ParameterResolver pr = parameter::ParameterResolver();
@@ -1023,6 +1263,7 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradMultiMulti(
     const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ, const circuit_t& herm_circ,
     const VVT<calc_type>& enc_data, const VT<calc_type>& ans_data, const VS& enc_name, const VS& ans_name,
     size_t batch_threads, size_t mea_threads) const -> VT<VVT<py_qs_data_t>> {
+    MQ_TRACE_SCOPE("GetExpectationWithGradMultiMulti", "gradient");
     auto n_hams = hams.size();
     auto n_prs = enc_data.size();
     auto n_params = enc_name.size() + ans_name.size();
@@ -1052,6 +1293,7 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradMultiMulti(
         if (batch_threads == 0) {
             throw std::runtime_error("batch_threads cannot be zero.");
         }
+        batch_threads = memory::FitBatches(batch_threads, (3 + std::min(mea_threads, n_hams)) * StateBytes());
         std::vector<std::thread> tasks;
         tasks.reserve(batch_threads);
         size_t end = 0;
@@ -1064,6 +1306,7 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradMultiMulti(
                 end += 1;
             }
             auto task = [&, start, end]() {
+                MQ_TRACE_SCOPE("GradBatch", "gradient");
                 for (size_t n = start; n < end; n++) {
                     parameter::ParameterResolver pr = parameter::ParameterResolver();
                     pr.SetItems(enc_name, enc_data[n]);
@@ -1085,6 +1328,7 @@ template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftOneMulti(
     const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ,
     const parameter::ParameterResolver& pr, const MST<size_t>& p_map, int n_thread) -> VVT<py_qs_data_t> {
+    MQ_TRACE_SCOPE("GetExpectationWithGradParameterShiftOneMulti", "gradient");
     auto n_hams = hams.size();
     int max_thread = 15;
     if (n_thread == 0) {
@@ -1096,6 +1340,8 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftOneMulti(
     if (n_thread > static_cast<int>(n_hams)) {
         n_thread = n_hams;
     }
+    // sim, sim_l and the buffer of ApplyHamiltonian, plus one state per Hamiltonian of a group.
+    n_thread = static_cast<int>(memory::FitConcurrency(n_thread, StateBytes(), 3 * StateBytes()));
     VVT<py_qs_data_t> f_and_g(n_hams, VT<py_qs_data_t>((1 + p_map.size()), 0));
     VectorState<qs_policy_t> sim = *this;
     sim.ApplyCircuit(circ, pr);
@@ -1143,7 +1389,8 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftOneMulti(
                         p_gate->prs_[0] += -pr_shift;
                         auto intrin_grad = tensor::Matrix(
                             VVT<py_qs_data_t>({{{coeff * std::real(expect1 - expect0), 0}}}));
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
+                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(
+                            MQ_PROFILE_EXPR(Jacobian, p_gate->id_, n_qubits, 0, tensor::ops::MatMul(intrin_grad, jac)));
                         for (const auto& [name, idx] : title) {
                             f_and_g[j][1 + p_map.at(name)] += p_grad[0][idx];
                         }
@@ -1160,6 +1407,7 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftMultiMulti(
     const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ,
     const VVT<calc_type>& enc_data, const VT<calc_type>& ans_data, const VS& enc_name, const VS& ans_name,
     size_t batch_threads, size_t mea_threads) -> VT<VVT<py_qs_data_t>> {
+    MQ_TRACE_SCOPE("GetExpectationWithGradParameterShiftMultiMulti", "gradient");
     auto n_hams = hams.size();
     auto n_prs = enc_data.size();
     auto n_params = enc_name.size() + ans_name.size();
@@ -1189,6 +1437,7 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftMultiMulti(
         if (batch_threads == 0) {
             throw std::runtime_error("batch_threads cannot be zero.");
         }
+        batch_threads = memory::FitBatches(batch_threads, (3 + std::min(mea_threads, n_hams)) * StateBytes());
         std::vector<std::thread> tasks;
         tasks.reserve(batch_threads);
         size_t end = 0;
@@ -1201,6 +1450,7 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftMultiMulti(
                 end += 1;
             }
             auto task = [&, start, end]() {
+                MQ_TRACE_SCOPE("GradBatch", "gradient");
                 for (size_t n = start; n < end; n++) {
                     parameter::ParameterResolver pr = parameter::ParameterResolver();
                     pr.SetItems(enc_name, enc_data[n]);
@@ -1221,13 +1471,14 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftMultiMulti(
 template <typename qs_policy_t_>
 VT<unsigned> VectorState<qs_policy_t_>::Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr,
                                                  size_t shots, const MST<size_t>& key_map, unsigned int seed) const {
+    MQ_TRACE_SCOPE("Sampling", "simulator");
     auto key_size = key_map.size();
     VT<unsigned> res(shots * key_size);
     RndEngine rnd_eng = RndEngine(seed);
     std::uniform_real_distribution<double> dist(1.0, (1 << 20) * 1.0);
     std::function<double()> rng = std::bind(dist, std::ref(rnd_eng));
     for (size_t i = 0; i < shots; i++) {
-        auto sim = derived_t(n_qubits, static_cast<unsigned>(rng()), qs);
+        auto sim = derived_t(ShareQS(), n_qubits, static_cast<unsigned>(rng()));
         auto res0 = sim.ApplyCircuit(circ, pr);
         VT<unsigned> res1(key_map.size());
         for (const auto& [name, val] : key_map) {
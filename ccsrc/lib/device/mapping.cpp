@@ -25,6 +25,7 @@
 #include <fmt/core.h>
 
 #include "core/mq_base_types.h"
+#include "core/trace.h"
 #include "device/topology.h"
 #include "ops/basic_gate.h"
 #include "ops/gate_id.h"
@@ -295,6 +296,7 @@ void SABRE::IterOneTurn(VT<int>& pi) {
 }
 
 std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>> SABRE::Solve(int iter_num, double W, double delta1, double delta2) {
+    MQ_TRACE_SCOPE("SABRE::Solve", "device");
     this->SetParameters(W, delta1, delta2);
 
     // generate random initial mapping
@@ -0,0 +1,1286 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io/qasm/openqasm.h"
+
+#include <cctype>
+#include <cmath>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "math/pr/parameter_resolver.h"
+#include "ops/gates.h"
+
+namespace mindquantum::io::qasm {
+namespace {
+constexpr int MAX_INCLUDE_DEPTH = 32;
+constexpr int MAX_GATE_DEPTH = 256;
+
+// -----------------------------------------------------------------------------
+// Lexer
+
+enum class TokKind { Ident, Number, String, Symbol, End };
+
+struct Token {
+    TokKind kind = TokKind::End;
+    std::string text;
+    double number = 0;
+    bool is_int = false;
+    int line = 0;
+};
+
+VT<Token> Tokenize(const std::string& src, const std::string& source_name) {
+    VT<Token> out;
+    size_t pos = 0;
+    int line = 1;
+    auto error = [&](const std::string& msg) {
+        throw std::runtime_error(fmt::format("{}:{}: {}", source_name, line, msg));
+    };
+    while (pos < src.size()) {
+        char c = src[pos];
+        if (c == '\n') {
+            line += 1;
+            pos += 1;
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pos += 1;
+            continue;
+        }
+        if (c == '/' && pos + 1 < src.size() && src[pos + 1] == '/') {
+            while (pos < src.size() && src[pos] != '\n') {
+                pos += 1;
+            }
+            continue;
+        }
+        if (c == '/' && pos + 1 < src.size() && src[pos + 1] == '*') {
+            pos += 2;
+            while (pos + 1 < src.size() && !(src[pos] == '*' && src[pos + 1] == '/')) {
+                if (src[pos] == '\n') {
+                    line += 1;
+                }
+                pos += 1;
+            }
+            if (pos + 1 >= src.size()) {
+                error("unterminated block comment.");
+            }
+            pos += 2;
+            continue;
+        }
+        Token tok;
+        tok.line = line;
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            size_t start = pos;
+            while (pos < src.size() && (std::isalnum(static_cast<unsigned char>(src[pos])) || src[pos] == '_')) {
+                pos += 1;
+            }
+            tok.kind = TokKind::Ident;
+            tok.text = src.substr(start, pos - start);
+        } else if (std::isdigit(static_cast<unsigned char>(c))
+                   || (c == '.' && pos + 1 < src.size() && std::isdigit(static_cast<unsigned char>(src[pos + 1])))) {
+            size_t start = pos;
+            bool is_int = true;
+            while (pos < src.size() && std::isdigit(static_cast<unsigned char>(src[pos]))) {
+                pos += 1;
+            }
+            if (pos < src.size() && src[pos] == '.') {
+                is_int = false;
+                pos += 1;
+                while (pos < src.size() && std::isdigit(static_cast<unsigned char>(src[pos]))) {
+                    pos += 1;
+                }
+            }
+            if (pos < src.size() && (src[pos] == 'e' || src[pos] == 'E')) {
+                is_int = false;
+                pos += 1;
+                if (pos < src.size() && (src[pos] == '+' || src[pos] == '-')) {
+                    pos += 1;
+                }
+                if (pos >= src.size() || !std::isdigit(static_cast<unsigned char>(src[pos]))) {
+                    error("malformed exponent in number literal.");
+                }
+                while (pos < src.size() && std::isdigit(static_cast<unsigned char>(src[pos]))) {
+                    pos += 1;
+                }
+            }
+            tok.kind = TokKind::Number;
+            tok.text = src.substr(start, pos - start);
+            tok.number = std::stod(tok.text);
+            tok.is_int = is_int;
+        } else if (c == '"') {
+            size_t start = ++pos;
+            while (pos < src.size() && src[pos] != '"' && src[pos] != '\n') {
+                pos += 1;
+            }
+            if (pos >= src.size() || src[pos] != '"') {
+                error("unterminated string literal.");
+            }
+            tok.kind = TokKind::String;
+            tok.text = src.substr(start, pos - start);
+            pos += 1;
+        } else {
+            tok.kind = TokKind::Symbol;
+            if (c == '-' && pos + 1 < src.size() && src[pos + 1] == '>') {
+                tok.text = "->";
+                pos += 2;
+            } else if (c == '*' && pos + 1 < src.size() && src[pos + 1] == '*') {
+                tok.text = "**";
+                pos += 2;
+            } else if (std::string("()[]{};,=+-*/^@:").find(c) != std::string::npos) {
+                tok.text = std::string(1, c);
+                pos += 1;
+            } else {
+                error(fmt::format("unexpected character '{}'.", c));
+            }
+        }
+        out.push_back(tok);
+    }
+    Token end;
+    end.line = line;
+    out.push_back(end);
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+// Expressions. Values are affine in the declared input parameters, so that a symbolic angle can be forwarded to a
+// ParameterResolver.
+
+struct Value {
+    double c = 0;
+    std::map<std::string, double> coeff;
+
+    bool IsConst() const {
+        return coeff.empty();
+    }
+    Value Scale(double a) const {
+        Value out{c * a, coeff};
+        for (auto& [k, v] : out.coeff) {
+            v *= a;
+        }
+        return out;
+    }
+    Value Add(const Value& other, double sign) const {
+        Value out = *this;
+        out.c += sign * other.c;
+        for (auto& [k, v] : other.coeff) {
+            out.coeff[k] += sign * v;
+        }
+        return out;
+    }
+    parameter::ParameterResolver ToPR() const {
+        return parameter::ParameterResolver(c, coeff);
+    }
+};
+
+struct Expr {
+    enum class Kind { Num, Var, Neg, Bin, Call };
+    Kind kind = Kind::Num;
+    double num = 0;
+    std::string name;  // variable name, function name, or binary operator
+    std::shared_ptr<Expr> lhs;
+    std::shared_ptr<Expr> rhs;
+    int line = 0;
+};
+using ExprPtr = std::shared_ptr<Expr>;
+
+// -----------------------------------------------------------------------------
+// Gate calls and definitions.
+
+struct Operand {
+    std::string name;
+    int64_t index = -1;  // -1 for the whole register
+    int line = 0;
+};
+
+struct Modifier {
+    enum class Kind { Ctrl, NegCtrl, Inv, Pow };
+    Kind kind;
+    int64_t n = 1;
+};
+
+struct GateCall {
+    VT<Modifier> modifiers;
+    std::string name;
+    VT<ExprPtr> params;
+    VT<Operand> args;
+    int line = 0;
+};
+
+struct GateDef {
+    VS params;
+    VS qargs;
+    VT<GateCall> body;
+    bool opaque = false;
+};
+
+//! Gate after expansion, ready to be converted into a BasicGate.
+struct Op {
+    GateID id;
+    VT<Value> params;
+    qbits_t objs;
+    qbits_t ctrls;
+    bool daggered = false;
+    std::string custom;  // name of a fixed matrix gate, e.g. "SX"
+};
+
+struct Builtin {
+    GateID id;
+    int n_params;
+    int n_ctrls;
+    int n_objs;
+    std::string custom;
+};
+
+const std::map<std::string, Builtin>& Builtins() {
+    static const std::map<std::string, Builtin> builtins = {
+        {"id", {GateID::I, 0, 0, 1, ""}},       {"x", {GateID::X, 0, 0, 1, ""}},
+        {"y", {GateID::Y, 0, 0, 1, ""}},        {"z", {GateID::Z, 0, 0, 1, ""}},
+        {"h", {GateID::H, 0, 0, 1, ""}},        {"s", {GateID::S, 0, 0, 1, ""}},
+        {"sdg", {GateID::Sdag, 0, 0, 1, ""}},   {"t", {GateID::T, 0, 0, 1, ""}},
+        {"tdg", {GateID::Tdag, 0, 0, 1, ""}},   {"sx", {GateID::CUSTOM, 0, 0, 1, "SX"}},
+        {"sxdg", {GateID::CUSTOM, 0, 0, 1, "SXdg"}},
+        {"rx", {GateID::RX, 1, 0, 1, ""}},      {"ry", {GateID::RY, 1, 0, 1, ""}},
+        {"rz", {GateID::RZ, 1, 0, 1, ""}},      {"p", {GateID::PS, 1, 0, 1, ""}},
+        {"phase", {GateID::PS, 1, 0, 1, ""}},   {"u1", {GateID::PS, 1, 0, 1, ""}},
+        {"u2", {GateID::U3, 2, 0, 1, ""}},      {"u3", {GateID::U3, 3, 0, 1, ""}},
+        {"u", {GateID::U3, 3, 0, 1, ""}},       {"U", {GateID::U3, 3, 0, 1, ""}},
+        {"CX", {GateID::X, 0, 1, 1, ""}},       {"cx", {GateID::X, 0, 1, 1, ""}},
+        {"cnot", {GateID::X, 0, 1, 1, ""}},     {"cy", {GateID::Y, 0, 1, 1, ""}},
+        {"cz", {GateID::Z, 0, 1, 1, ""}},       {"ch", {GateID::H, 0, 1, 1, ""}},
+        {"csx", {GateID::CUSTOM, 0, 1, 1, "SX"}},
+        {"ccx", {GateID::X, 0, 2, 1, ""}},      {"toffoli", {GateID::X, 0, 2, 1, ""}},
+        {"c3x", {GateID::X, 0, 3, 1, ""}},      {"c4x", {GateID::X, 0, 4, 1, ""}},
+        {"crx", {GateID::RX, 1, 1, 1, ""}},     {"cry", {GateID::RY, 1, 1, 1, ""}},
+        {"crz", {GateID::RZ, 1, 1, 1, ""}},     {"cp", {GateID::PS, 1, 1, 1, ""}},
+        {"cphase", {GateID::PS, 1, 1, 1, ""}},  {"cu1", {GateID::PS, 1, 1, 1, ""}},
+        {"cu3", {GateID::U3, 3, 1, 1, ""}},     {"cu", {GateID::U3, 4, 1, 1, ""}},
+        {"swap", {GateID::SWAP, 0, 0, 2, ""}},  {"cswap", {GateID::SWAP, 0, 1, 2, ""}},
+        {"fredkin", {GateID::SWAP, 0, 1, 2, ""}},
+        {"iswap", {GateID::ISWAP, 0, 0, 2, ""}},
+        {"rxx", {GateID::Rxx, 1, 0, 2, ""}},    {"ryy", {GateID::Ryy, 1, 0, 2, ""}},
+        {"rzz", {GateID::Rzz, 1, 0, 2, ""}},    {"gphase", {GateID::GP, 1, 0, 0, ""}},
+    };
+    return builtins;
+}
+
+tensor::Matrix SXMatrix(bool daggered) {
+    double sign = daggered ? -1.0 : 1.0;
+    return tensor::Matrix(VVT<CT<double>>{{{0.5, 0.5 * sign}, {0.5, -0.5 * sign}},
+                                          {{0.5, -0.5 * sign}, {0.5, 0.5 * sign}}});
+}
+
+// -----------------------------------------------------------------------------
+
+struct Register {
+    index_t offset;
+    index_t size;
+};
+
+class Parser {
+ public:
+    explicit Parser(VS include_dirs) : include_dirs_(std::move(include_dirs)) {
+    }
+
+    QasmProgram Run(const std::string& source, const std::string& source_name, const std::string& base_dir) {
+        ParseSource(source, source_name, base_dir, 0);
+        QasmProgram prog;
+        prog.version = version_;
+        prog.n_qubits = static_cast<qbit_t>(n_qubits_);
+        prog.clbit_keys = clbit_keys_;
+        prog.parameters = parameters_;
+        for (auto& op : ops_) {
+            prog.circuit.push_back(ToGate(op));
+        }
+        return prog;
+    }
+
+ private:
+    // ---------------------------------------------------------------------------
+    // token helpers
+
+    [[noreturn]] void Error(int line, const std::string& msg) const {
+        throw std::runtime_error(fmt::format("{}:{}: {}", source_name_, line, msg));
+    }
+
+    const Token& Peek(size_t ahead = 0) const {
+        return (*toks_)[std::min(pos_ + ahead, toks_->size() - 1)];
+    }
+
+    const Token& Next() {
+        const Token& tok = Peek();
+        if (tok.kind != TokKind::End) {
+            pos_ += 1;
+        }
+        return tok;
+    }
+
+    bool IsSymbol(const std::string& s, size_t ahead = 0) const {
+        return Peek(ahead).kind == TokKind::Symbol && Peek(ahead).text == s;
+    }
+
+    bool IsIdent(const std::string& s, size_t ahead = 0) const {
+        return Peek(ahead).kind == TokKind::Ident && Peek(ahead).text == s;
+    }
+
+    void Expect(const std::string& s) {
+        const Token& tok = Next();
+        if (tok.kind != TokKind::Symbol || tok.text != s) {
+            Error(tok.line, fmt::format("expected '{}' but got '{}'.", s, Describe(tok)));
+        }
+    }
+
+    std::string ExpectIdent() {
+        const Token& tok = Next();
+        if (tok.kind != TokKind::Ident) {
+            Error(tok.line, fmt::format("expected an identifier but got '{}'.", Describe(tok)));
+        }
+        return tok.text;
+    }
+
+    int64_t ExpectInt() {
+        const Token& tok = Next();
+        if (tok.kind != TokKind::Number || !tok.is_int) {
+            Error(tok.line, fmt::format("expected an integer but got '{}'.", Describe(tok)));
+        }
+        return static_cast<int64_t>(tok.number);
+    }
+
+    static std::string Describe(const Token& tok) {
+        return tok.kind == TokKind::End ? std::string("end of file") : tok.text;
+    }
+
+    // ---------------------------------------------------------------------------
+    // program level
+
+    void ParseSource(const std::string& source, const std::string& source_name, const std::string& base_dir,
+                     int depth) {
+        auto toks = Tokenize(source, source_name);
+        auto saved_toks = toks_;
+        auto saved_pos = pos_;
+        auto saved_name = source_name_;
+        auto saved_dir = base_dir_;
+        toks_ = &toks;
+        pos_ = 0;
+        source_name_ = source_name;
+        base_dir_ = base_dir;
+        if (depth == 0) {
+            ParseHeader();
+        }
+        while (Peek().kind != TokKind::End) {
+            ParseStatement(depth);
+        }
+        toks_ = saved_toks;
+        pos_ = saved_pos;
+        source_name_ = saved_name;
+        base_dir_ = saved_dir;
+    }
+
+    void ParseHeader() {
+        if (!IsIdent("OPENQASM")) {
+            Error(Peek().line, "program should start with 'OPENQASM <version>;'.");
+        }
+        Next();
+        const Token& tok = Next();
+        if (tok.kind != TokKind::Number) {
+            Error(tok.line, fmt::format("invalid OpenQASM version '{}'.", Describe(tok)));
+        }
+        version_ = tok.text;
+        auto major = static_cast<int>(tok.number);
+        if (major != 2 && major != 3) {
+            Error(tok.line, fmt::format("OpenQASM version {} is not supported.", version_));
+        }
+        Expect(";");
+    }
+
+    void ParseStatement(int depth) {
+        const Token& tok = Peek();
+        int line = tok.line;
+        if (tok.kind != TokKind::Ident) {
+            Error(line, fmt::format("unexpected '{}'.", Describe(tok)));
+        }
+        const std::string& kw = tok.text;
+        if (kw == "OPENQASM") {
+            Error(line, "the OPENQASM header can only appear once at the beginning of the program.");
+        }
+        if (kw == "include") {
+            Next();
+            const Token& file = Next();
+            if (file.kind != TokKind::String) {
+                Error(file.line, "include requires a file name string.");
+            }
+            Expect(";");
+            Include(file.text, line, depth);
+            return;
+        }
+        if (kw == "qreg" || kw == "creg") {
+            Next();
+            auto name = ExpectIdent();
+            Expect("[");
+            auto size = ExpectInt();
+            Expect("]");
+            Expect(";");
+            Declare(kw == "qreg", name, size, line);
+            return;
+        }
+        if (kw == "qubit" || kw == "bit") {
+            Next();
+            int64_t size = -1;
+            if (IsSymbol("[")) {
+                Next();
+                size = ExpectInt();
+                Expect("]");
+            }
+            auto name = ExpectIdent();
+            if (IsSymbol("=")) {
+                Error(line, "initialization of classical bits is not supported.");
+            }
+            Expect(";");
+            Declare(kw == "qubit", name, size < 0 ? 1 : size, line, size < 0);
+            return;
+        }
+        if (kw == "input") {
+            Next();
+            auto type = ExpectIdent();
+            if (type != "float" && type != "angle") {
+                Error(line, fmt::format("input of type '{}' is not supported, use float or angle.", type));
+            }
+            if (IsSymbol("[")) {
+                Next();
+                ExpectInt();
+                Expect("]");
+            }
+            auto name = ExpectIdent();
+            Expect(";");
+            if (Builtins().count(name) != 0 || gates_.count(name) != 0 || IsConstantName(name)) {
+                Error(line, fmt::format("parameter name '{}' conflicts with an existing name.", name));
+            }
+            if (std::find(parameters_.begin(), parameters_.end(), name) != parameters_.end()) {
+                Error(line, fmt::format("parameter '{}' is already declared.", name));
+            }
+            parameters_.push_back(name);
+            return;
+        }
+        if (kw == "gate" || kw == "opaque") {
+            ParseGateDef();
+            return;
+        }
+        if (kw == "measure") {
+            Next();
+            auto qargs = ParseOperand();
+            if (IsSymbol("->")) {
+                Next();
+                auto cargs = ParseOperand();
+                Expect(";");
+                Measure(qargs, cargs, line);
+            } else {
+                Expect(";");
+                Measure(qargs, {}, line);
+            }
+            return;
+        }
+        if (kw == "barrier") {
+            Next();
+            while (!IsSymbol(";")) {
+                if (Peek().kind == TokKind::End) {
+                    Error(line, "expected ';' after barrier.");
+                }
+                Next();
+            }
+            Next();
+            return;
+        }
+        if (kw == "reset" || kw == "if" || kw == "for" || kw == "while" || kw == "def" || kw == "let"
+            || kw == "const" || kw == "output" || kw == "delay" || kw == "box") {
+            Error(line, fmt::format("'{}' statement is not supported.", kw));
+        }
+        if (IsSymbol("=", 1) || (IsSymbol("[", 1) && IsSymbol("=", 4))) {
+            // OpenQASM 3 style: c[i] = measure q[j];
+            auto cargs = ParseOperand();
+            Expect("=");
+            if (!IsIdent("measure")) {
+                Error(line, "only measurement results can be assigned to classical bits.");
+            }
+            Next();
+            auto qargs = ParseOperand();
+            Expect(";");
+            Measure(qargs, cargs, line);
+            return;
+        }
+        auto call = ParseGateCall(false);
+        Apply(call, line);
+    }
+
+    void Include(const std::string& file, int line, int depth) {
+        if (file == "qelib1.inc" || file == "stdgates.inc") {
+            return;
+        }
+        if (depth >= MAX_INCLUDE_DEPTH) {
+            Error(line, fmt::format("include depth exceeds {}, recursive include of '{}'?", MAX_INCLUDE_DEPTH, file));
+        }
+        VS candidates;
+        if (!file.empty() && file[0] == '/') {
+            candidates.push_back(file);
+        } else {
+            candidates.push_back(base_dir_.empty() ? file : base_dir_ + "/" + file);
+            for (auto& dir : include_dirs_) {
+                candidates.push_back(dir + "/" + file);
+            }
+        }
+        for (auto& path : candidates) {
+            std::ifstream fin(path);
+            if (!fin.is_open()) {
+                continue;
+            }
+            std::stringstream buffer;
+            buffer << fin.rdbuf();
+            ParseSource(buffer.str(), path, DirName(path), depth + 1);
+            return;
+        }
+        Error(line, fmt::format("cannot find include file '{}'.", file));
+    }
+
+    void Declare(bool quantum, const std::string& name, int64_t size, int line, bool scalar = false) {
+        if (size <= 0) {
+            Error(line, fmt::format("register '{}' should have a positive size.", name));
+        }
+        if (qregs_.count(name) != 0 || cregs_.count(name) != 0) {
+            Error(line, fmt::format("register '{}' is already declared.", name));
+        }
+        if (quantum) {
+            qregs_[name] = {n_qubits_, static_cast<index_t>(size)};
+            n_qubits_ += size;
+        } else {
+            cregs_[name] = {clbit_keys_.size(), static_cast<index_t>(size)};
+            for (int64_t i = 0; i < size; i++) {
+                clbit_keys_.push_back(scalar ? name : fmt::format("{}[{}]", name, i));
+            }
+        }
+    }
+
+    void ParseGateDef() {
+        bool opaque = Next().text == "opaque";
+        int line = Peek().line;
+        auto name = ExpectIdent();
+        if (Builtins().count(name) != 0 || gates_.count(name) != 0) {
+            Error(line, fmt::format("gate '{}' is already defined.", name));
+        }
+        GateDef def;
+        def.opaque = opaque;
+        if (IsSymbol("(")) {
+            Next();
+            if (!IsSymbol(")")) {
+                def.params.push_back(ExpectIdent());
+                while (IsSymbol(",")) {
+                    Next();
+                    def.params.push_back(ExpectIdent());
+                }
+            }
+            Expect(")");
+        }
+        def.qargs.push_back(ExpectIdent());
+        while (IsSymbol(",")) {
+            Next();
+            def.qargs.push_back(ExpectIdent());
+        }
+        if (opaque) {
+            Expect(";");
+            gates_[name] = def;
+            return;
+        }
+        Expect("{");
+        while (!IsSymbol("}")) {
+            if (Peek().kind == TokKind::End) {
+                Error(line, fmt::format("missing '}}' for gate '{}'.", name));
+            }
+            if (IsIdent("barrier")) {
+                auto barrier_line = Next().line;
+                while (!IsSymbol(";")) {
+                    if (Peek().kind == TokKind::End) {
+                        Error(barrier_line, "expected ';' after barrier.");
+                    }
+                    Next();
+                }
+                Next();
+                continue;
+            }
+            auto call = ParseGateCall(true);
+            for (auto& arg : call.args) {
+                if (std::find(def.qargs.begin(), def.qargs.end(), arg.name) == def.qargs.end()) {
+                    Error(arg.line, fmt::format("unknown qubit '{}' in definition of gate '{}'.", arg.name, name));
+                }
+            }
+            if (Builtins().count(call.name) == 0 && gates_.count(call.name) == 0) {
+                Error(call.line, fmt::format("gate '{}' is not defined.", call.name));
+            }
+            def.body.push_back(std::move(call));
+        }
+        Next();
+        gates_[name] = std::move(def);
+    }
+
+    GateCall ParseGateCall(bool in_body) {
+        GateCall call;
+        call.line = Peek().line;
+        while (true) {
+            if ((IsIdent("ctrl") || IsIdent("negctrl") || IsIdent("inv") || IsIdent("pow"))
+                && (IsSymbol("@", 1) || IsSymbol("(", 1))) {
+                auto kw = Next().text;
+                Modifier mod{Modifier::Kind::Inv, 1};
+                if (kw == "ctrl" || kw == "negctrl") {
+                    mod.kind = kw == "ctrl" ? Modifier::Kind::Ctrl : Modifier::Kind::NegCtrl;
+                } else if (kw == "pow") {
+                    mod.kind = Modifier::Kind::Pow;
+                }
+                if (IsSymbol("(")) {
+                    Next();
+                    bool neg = false;
+                    if (IsSymbol("-") && mod.kind == Modifier::Kind::Pow) {
+                        Next();
+                        neg = true;
+                    }
+                    mod.n = ExpectInt();
+                    mod.n = neg ? -mod.n : mod.n;
+                    Expect(")");
+                } else if (mod.kind == Modifier::Kind::Pow) {
+                    Error(call.line, "pow modifier requires an integer exponent.");
+                }
+                if (mod.kind != Modifier::Kind::Pow && mod.n <= 0) {
+                    Error(call.line, "number of control qubits should be positive.");
+                }
+                Expect("@");
+                call.modifiers.push_back(mod);
+                continue;
+            }
+            break;
+        }
+        call.name = ExpectIdent();
+        if (IsSymbol("(")) {
+            Next();
+            if (!IsSymbol(")")) {
+                call.params.push_back(ParseExpr());
+                while (IsSymbol(",")) {
+                    Next();
+                    call.params.push_back(ParseExpr());
+                }
+            }
+            Expect(")");
+        }
+        if (!IsSymbol(";")) {
+            call.args.push_back(ParseOperand(in_body));
+            while (IsSymbol(",")) {
+                Next();
+                call.args.push_back(ParseOperand(in_body));
+            }
+        }
+        Expect(";");
+        return call;
+    }
+
+    Operand ParseOperand(bool in_body = false) {
+        Operand op;
+        op.line = Peek().line;
+        op.name = ExpectIdent();
+        if (IsSymbol("[")) {
+            if (in_body) {
+                Error(op.line, "indexing is not allowed inside a gate definition.");
+            }
+            Next();
+            op.index = ExpectInt();
+            Expect("]");
+        }
+        return op;
+    }
+
+    // ---------------------------------------------------------------------------
+    // expressions
+
+    ExprPtr MakeExpr(Expr::Kind kind, int line) {
+        auto e = std::make_shared<Expr>();
+        e->kind = kind;
+        e->line = line;
+        return e;
+    }
+
+    ExprPtr ParseExpr() {
+        auto lhs = ParseTerm();
+        while (IsSymbol("+") || IsSymbol("-")) {
+            auto e = MakeExpr(Expr::Kind::Bin, Peek().line);
+            e->name = Next().text;
+            e->lhs = lhs;
+            e->rhs = ParseTerm();
+            lhs = e;
+        }
+        return lhs;
+    }
+
+    ExprPtr ParseTerm() {
+        auto lhs = ParseUnary();
+        while (IsSymbol("*") || IsSymbol("/")) {
+            auto e = MakeExpr(Expr::Kind::Bin, Peek().line);
+            e->name = Next().text;
+            e->lhs = lhs;
+            e->rhs = ParseUnary();
+            lhs = e;
+        }
+        return lhs;
+    }
+
+    ExprPtr ParseUnary() {
+        if (IsSymbol("-")) {
+            auto e = MakeExpr(Expr::Kind::Neg, Next().line);
+            e->lhs = ParseUnary();
+            return e;
+        }
+        if (IsSymbol("+")) {
+            Next();
+            return ParseUnary();
+        }
+        return ParsePower();
+    }
+
+    ExprPtr ParsePower() {
+        auto base = ParsePrimary();
+        if (IsSymbol("^") || IsSymbol("**")) {
+            auto e = MakeExpr(Expr::Kind::Bin, Next().line);
+            e->name = "^";
+            e->lhs = base;
+            e->rhs = ParseUnary();
+            return e;
+        }
+        return base;
+    }
+
+    ExprPtr ParsePrimary() {
+        const Token& tok = Next();
+        if (tok.kind == TokKind::Number) {
+            auto e = MakeExpr(Expr::Kind::Num, tok.line);
+            e->num = tok.number;
+            return e;
+        }
+        if (tok.kind == TokKind::Ident) {
+            if (IsSymbol("(")) {
+                Next();
+                auto e = MakeExpr(Expr::Kind::Call, tok.line);
+                e->name = tok.text;
+                e->lhs = ParseExpr();
+                Expect(")");
+                return e;
+            }
+            auto e = MakeExpr(Expr::Kind::Var, tok.line);
+            e->name = tok.text;
+            return e;
+        }
+        if (tok.kind == TokKind::Symbol && tok.text == "(") {
+            auto e = ParseExpr();
+            Expect(")");
+            return e;
+        }
+        Error(tok.line, fmt::format("unexpected '{}' in expression.", Describe(tok)));
+    }
+
+    static bool IsConstantName(const std::string& name) {
+        return name == "pi" || name == "tau" || name == "euler" || name == "e";
+    }
+
+    Value Eval(const ExprPtr& e, const std::map<std::string, Value>& env) const {
+        switch (e->kind) {
+            case Expr::Kind::Num:
+                return Value{e->num, {}};
+            case Expr::Kind::Var: {
+                auto it = env.find(e->name);
+                if (it != env.end()) {
+                    return it->second;
+                }
+                if (e->name == "pi") {
+                    return Value{M_PI, {}};
+                }
+                if (e->name == "tau") {
+                    return Value{2 * M_PI, {}};
+                }
+                if (e->name == "euler" || e->name == "e") {
+                    return Value{std::exp(1.0), {}};
+                }
+                if (std::find(parameters_.begin(), parameters_.end(), e->name) != parameters_.end()) {
+                    return Value{0, {{e->name, 1.0}}};
+                }
+                Error(e->line, fmt::format("unknown identifier '{}' in expression.", e->name));
+            }
+            case Expr::Kind::Neg:
+                return Eval(e->lhs, env).Scale(-1);
+            case Expr::Kind::Bin: {
+                auto lhs = Eval(e->lhs, env);
+                auto rhs = Eval(e->rhs, env);
+                if (e->name == "+") {
+                    return lhs.Add(rhs, 1);
+                }
+                if (e->name == "-") {
+                    return lhs.Add(rhs, -1);
+                }
+                if (e->name == "*") {
+                    if (lhs.IsConst()) {
+                        return rhs.Scale(lhs.c);
+                    }
+                    if (rhs.IsConst()) {
+                        return lhs.Scale(rhs.c);
+                    }
+                    Error(e->line, "product of two parameters is not supported.");
+                }
+                if (!rhs.IsConst()) {
+                    Error(e->line, fmt::format("right operand of '{}' should not depend on parameters.", e->name));
+                }
+                if (e->name == "/") {
+                    if (rhs.c == 0) {
+                        Error(e->line, "division by zero.");
+                    }
+                    return lhs.Scale(1.0 / rhs.c);
+                }
+                if (!lhs.IsConst()) {
+                    Error(e->line, "power of a parameter is not supported.");
+                }
+                return Value{std::pow(lhs.c, rhs.c), {}};
+            }
+            case Expr::Kind::Call: {
+                auto arg = Eval(e->lhs, env);
+                if (!arg.IsConst()) {
+                    Error(e->line, fmt::format("function '{}' of a parameter is not supported.", e->name));
+                }
+                static const std::map<std::string, double (*)(double)> funcs = {
+                    {"sin", std::sin},   {"cos", std::cos}, {"tan", std::tan},   {"exp", std::exp},
+                    {"ln", std::log},    {"log", std::log}, {"sqrt", std::sqrt}, {"asin", std::asin},
+                    {"acos", std::acos}, {"atan", std::atan},
+                };
+                auto it = funcs.find(e->name);
+                if (it == funcs.end()) {
+                    Error(e->line, fmt::format("unknown function '{}'.", e->name));
+                }
+                return Value{it->second(arg.c), {}};
+            }
+        }
+        Error(e->line, "invalid expression.");
+    }
+
+    // ---------------------------------------------------------------------------
+    // expansion
+
+    qbits_t ResolveQubits(const Operand& op) const {
+        auto it = qregs_.find(op.name);
+        if (it == qregs_.end()) {
+            Error(op.line, fmt::format("unknown quantum register '{}'.", op.name));
+        }
+        auto& reg = it->second;
+        if (op.index < 0) {
+            qbits_t out;
+            for (index_t i = 0; i < reg.size; i++) {
+                out.push_back(static_cast<qbit_t>(reg.offset + i));
+            }
+            return out;
+        }
+        if (static_cast<index_t>(op.index) >= reg.size) {
+            Error(op.line, fmt::format("index {} out of range for register '{}' of size {}.", op.index, op.name,
+                                       reg.size));
+        }
+        return {static_cast<qbit_t>(reg.offset + op.index)};
+    }
+
+    VT<index_t> ResolveClbits(const Operand& op) const {
+        auto it = cregs_.find(op.name);
+        if (it == cregs_.end()) {
+            Error(op.line, fmt::format("unknown classical register '{}'.", op.name));
+        }
+        auto& reg = it->second;
+        if (op.index < 0) {
+            VT<index_t> out;
+            for (index_t i = 0; i < reg.size; i++) {
+                out.push_back(reg.offset + i);
+            }
+            return out;
+        }
+        if (static_cast<index_t>(op.index) >= reg.size) {
+            Error(op.line, fmt::format("index {} out of range for register '{}' of size {}.", op.index, op.name,
+                                       reg.size));
+        }
+        return {reg.offset + op.index};
+    }
+
+    void Measure(const Operand& qarg, const std::optional<Operand>& carg, int line) {
+        auto qubits = ResolveQubits(qarg);
+        VT<std::string> keys;
+        if (carg.has_value()) {
+            auto clbits = ResolveClbits(carg.value());
+            if (clbits.size() != qubits.size()) {
+                Error(line, fmt::format("cannot measure {} qubits into {} classical bits.", qubits.size(),
+                                        clbits.size()));
+            }
+            for (auto c : clbits) {
+                keys.push_back(clbit_keys_[c]);
+            }
+        } else {
+            for (auto q : qubits) {
+                keys.push_back(fmt::format("q{}", q));
+            }
+        }
+        for (size_t i = 0; i < qubits.size(); i++) {
+            Op op{GateID::M, {}, {qubits[i]}, {}, false, keys[i]};
+            ops_.push_back(op);
+        }
+    }
+
+    void Apply(const GateCall& call, int line) {
+        VT<qbits_t> args;
+        size_t broadcast = 1;
+        for (auto& arg : call.args) {
+            auto qubits = ResolveQubits(arg);
+            if (qubits.size() > 1) {
+                if (broadcast != 1 && broadcast != qubits.size()) {
+                    Error(line, "registers in a broadcast gate call should have the same size.");
+                }
+                broadcast = qubits.size();
+            }
+            args.push_back(std::move(qubits));
+        }
+        std::map<std::string, Value> env;
+        for (size_t b = 0; b < broadcast; b++) {
+            qbits_t qubits;
+            for (auto& arg : args) {
+                qubits.push_back(arg.size() == 1 ? arg[0] : arg[b]);
+            }
+            // A global phase of the program sits on qubit 0, a program without qubits has no phase to carry.
+            Expand(call, env, qubits, n_qubits_ == 0 ? -1 : 0, 0, &ops_);
+        }
+    }
+
+    //! Expand a gate call into ops, an uncontrolled gphase becoming a GP gate on the anchor qubit.
+    void Expand(const GateCall& call, const std::map<std::string, Value>& env, const qbits_t& qubits, qbit_t anchor,
+                int depth, VT<Op>* out) const {
+        if (depth > MAX_GATE_DEPTH) {
+            Error(call.line, fmt::format("gate '{}' is expanded recursively too many times.", call.name));
+        }
+        VT<Value> params;
+        for (auto& p : call.params) {
+            params.push_back(Eval(p, env));
+        }
+        auto sorted = qubits;
+        std::sort(sorted.begin(), sorted.end());
+        if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+            Error(call.line, fmt::format("duplicate qubit arguments for gate '{}'.", call.name));
+        }
+        ExpandModifiers(call, params, qubits, anchor, 0, depth, out);
+    }
+
+    void ExpandModifiers(const GateCall& call, const VT<Value>& params, const qbits_t& qubits, qbit_t anchor,
+                         size_t mod_idx, int depth, VT<Op>* out) const {
+        if (mod_idx == call.modifiers.size()) {
+            ExpandBare(call, params, qubits, anchor, depth, out);
+            return;
+        }
+        auto& mod = call.modifiers[mod_idx];
+        switch (mod.kind) {
+            case Modifier::Kind::Ctrl:
+            case Modifier::Kind::NegCtrl: {
+                if (qubits.size() < static_cast<size_t>(mod.n)) {
+                    Error(call.line, fmt::format("not enough qubits for control modifier of gate '{}'.", call.name));
+                }
+                qbits_t ctrls(qubits.begin(), qubits.begin() + mod.n);
+                qbits_t rest(qubits.begin() + mod.n, qubits.end());
+                VT<Op> inner;
+                ExpandModifiers(call, params, rest, anchor, mod_idx + 1, depth, &inner);
+                auto flip = [&]() {
+                    if (mod.kind == Modifier::Kind::NegCtrl) {
+                        for (auto c : ctrls) {
+                            out->push_back(Op{GateID::X, {}, {c}, {}, false, ""});
+                        }
+                    }
+                };
+                flip();
+                for (auto& op : inner) {
+                    if (op.id == GateID::M) {
+                        Error(call.line, "cannot control a measurement.");
+                    }
+                    op.ctrls.insert(op.ctrls.end(), ctrls.begin(), ctrls.end());
+                    out->push_back(ControlGlobalPhase(op));
+                }
+                flip();
+                return;
+            }
+            case Modifier::Kind::Inv: {
+                VT<Op> inner;
+                ExpandModifiers(call, params, qubits, anchor, mod_idx + 1, depth, &inner);
+                for (auto it = inner.rbegin(); it != inner.rend(); ++it) {
+                    out->push_back(Inverse(*it, call.line));
+                }
+                return;
+            }
+            case Modifier::Kind::Pow: {
+                VT<Op> inner;
+                ExpandModifiers(call, params, qubits, anchor, mod_idx + 1, depth, &inner);
+                if (mod.n < 0) {
+                    VT<Op> inv;
+                    for (auto it = inner.rbegin(); it != inner.rend(); ++it) {
+                        inv.push_back(Inverse(*it, call.line));
+                    }
+                    inner = std::move(inv);
+                }
+                for (int64_t i = 0; i < std::abs(mod.n); i++) {
+                    out->insert(out->end(), inner.begin(), inner.end());
+                }
+                return;
+            }
+        }
+    }
+
+    void ExpandBare(const GateCall& call, const VT<Value>& params, const qbits_t& qubits, qbit_t anchor, int depth,
+                    VT<Op>* out) const {
+        auto builtin = Builtins().find(call.name);
+        if (builtin != Builtins().end()) {
+            auto& b = builtin->second;
+            if (static_cast<int>(params.size()) != b.n_params) {
+                Error(call.line,
+                      fmt::format("gate '{}' requires {} parameters, but get {}.", call.name, b.n_params, params.size()));
+            }
+            if (static_cast<int>(qubits.size()) != b.n_ctrls + b.n_objs) {
+                Error(call.line, fmt::format("gate '{}' requires {} qubits, but get {}.", call.name, b.n_ctrls + b.n_objs,
+                                             qubits.size()));
+            }
+            qbits_t ctrls(qubits.begin(), qubits.begin() + b.n_ctrls);
+            qbits_t objs(qubits.begin() + b.n_ctrls, qubits.end());
+            if (b.id == GateID::GP) {
+                // gphase(a) = exp(i a) while GP(a) = exp(-i a). A global phase has no target qubit, it is put on
+                // the anchor: the first qubit of the enclosing gate, or qubit 0 at the top level.
+                if (anchor >= 0) {
+                    out->push_back(Op{GateID::GP, {params[0].Scale(-1)}, {anchor}, {}, false, ""});
+                }
+                return;
+            }
+            Op op{b.id, params, objs, ctrls, false, b.custom};
+            if (call.name == "u2") {
+                op.params = {Value{M_PI_2, {}}, params[0], params[1]};
+            }
+            if (call.name == "cu") {
+                // cu(theta, phi, lambda, gamma) = controlled (exp(i gamma) u3(theta, phi, lambda))
+                op.params.pop_back();
+                out->push_back(op);
+                out->push_back(Op{GateID::PS, {params[3]}, {ctrls[0]}, {}, false, ""});
+                return;
+            }
+            out->push_back(op);
+            return;
+        }
+        auto it = gates_.find(call.name);
+        if (it == gates_.end()) {
+            Error(call.line, fmt::format("gate '{}' is not defined.", call.name));
+        }
+        auto& def = it->second;
+        if (def.opaque) {
+            Error(call.line, fmt::format("opaque gate '{}' cannot be simulated.", call.name));
+        }
+        if (params.size() != def.params.size()) {
+            Error(call.line,
+                  fmt::format("gate '{}' requires {} parameters, but get {}.", call.name, def.params.size(), params.size()));
+        }
+        if (qubits.size() != def.qargs.size()) {
+            Error(call.line,
+                  fmt::format("gate '{}' requires {} qubits, but get {}.", call.name, def.qargs.size(), qubits.size()));
+        }
+        std::map<std::string, Value> env;
+        for (size_t i = 0; i < params.size(); i++) {
+            env[def.params[i]] = params[i];
+        }
+        for (auto& inner : def.body) {
+            qbits_t inner_qubits;
+            for (auto& arg : inner.args) {
+                auto pos = std::find(def.qargs.begin(), def.qargs.end(), arg.name) - def.qargs.begin();
+                inner_qubits.push_back(qubits[pos]);
+            }
+            Expand(inner, env, inner_qubits, qubits[0], depth + 1, out);
+        }
+    }
+
+    //! A controlled global phase is a phase shift on one of the control qubits.
+    static Op ControlGlobalPhase(Op op) {
+        if (op.id != GateID::GP || op.ctrls.empty()) {
+            return op;
+        }
+        qbit_t target = op.ctrls.back();
+        op.ctrls.pop_back();
+        return Op{GateID::PS, {op.params[0].Scale(-1)}, {target}, op.ctrls, false, ""};
+    }
+
+    Op Inverse(Op op, int line) const {
+        switch (op.id) {
+            case GateID::I:
+            case GateID::X:
+            case GateID::Y:
+            case GateID::Z:
+            case GateID::H:
+            case GateID::SWAP:
+                return op;
+            case GateID::S:
+                op.id = GateID::Sdag;
+                return op;
+            case GateID::Sdag:
+                op.id = GateID::S;
+                return op;
+            case GateID::T:
+                op.id = GateID::Tdag;
+                return op;
+            case GateID::Tdag:
+                op.id = GateID::T;
+                return op;
+            case GateID::ISWAP:
+                op.daggered = !op.daggered;
+                return op;
+            case GateID::CUSTOM:
+                op.custom = op.custom == "SX" ? "SXdg" : "SX";
+                return op;
+            case GateID::RX:
+            case GateID::RY:
+            case GateID::RZ:
+            case GateID::PS:
+            case GateID::GP:
+            case GateID::Rxx:
+            case GateID::Ryy:
+            case GateID::Rzz:
+                op.params[0] = op.params[0].Scale(-1);
+                return op;
+            case GateID::U3:
+                // u3(theta, phi, lambda)^dagger = u3(-theta, -lambda, -phi)
+                op.params = {op.params[0].Scale(-1), op.params[2].Scale(-1), op.params[1].Scale(-1)};
+                return op;
+            default:
+                Error(line, fmt::format("cannot invert gate {}.", op.id));
+        }
+    }
+
+    std::shared_ptr<BasicGate> ToGate(const Op& op) const {
+        switch (op.id) {
+            case GateID::I:
+                return std::make_shared<IGate>(op.objs, op.ctrls);
+            case GateID::X:
+                return std::make_shared<XGate>(op.objs, op.ctrls);
+            case GateID::Y:
+                return std::make_shared<YGate>(op.objs, op.ctrls);
+            case GateID::Z:
+                return std::make_shared<ZGate>(op.objs, op.ctrls);
+            case GateID::H:
+                return std::make_shared<HGate>(op.objs, op.ctrls);
+            case GateID::S:
+                return std::make_shared<SGate>(op.objs, op.ctrls);
+            case GateID::Sdag:
+                return std::make_shared<SdagGate>(op.objs, op.ctrls);
+            case GateID::T:
+                return std::make_shared<TGate>(op.objs, op.ctrls);
+            case GateID::Tdag:
+                return std::make_shared<TdagGate>(op.objs, op.ctrls);
+            case GateID::SWAP:
+                return std::make_shared<SWAPGate>(op.objs, op.ctrls);
+            case GateID::ISWAP:
+                return std::make_shared<ISWAPGate>(op.daggered, op.objs, op.ctrls);
+            case GateID::CUSTOM:
+                return std::make_shared<CustomGate>(op.custom, SXMatrix(op.custom == "SXdg"), op.objs, op.ctrls);
+            case GateID::RX:
+                return std::make_shared<RXGate>(op.params[0].ToPR(), op.objs, op.ctrls);
+            case GateID::RY:
+                return std::make_shared<RYGate>(op.params[0].ToPR(), op.objs, op.ctrls);
+            case GateID::RZ:
+                return std::make_shared<RZGate>(op.params[0].ToPR(), op.objs, op.ctrls);
+            case GateID::PS:
+                return std::make_shared<PSGate>(op.params[0].ToPR(), op.objs, op.ctrls);
+            case GateID::GP:
+                return std::make_shared<GPGate>(op.params[0].ToPR(), op.objs, op.ctrls);
+            case GateID::Rxx:
+                return std::make_shared<RxxGate>(op.params[0].ToPR(), op.objs, op.ctrls);
+            case GateID::Ryy:
+                return std::make_shared<RyyGate>(op.params[0].ToPR(), op.objs, op.ctrls);
+            case GateID::Rzz:
+                return std::make_shared<RzzGate>(op.params[0].ToPR(), op.objs, op.ctrls);
+            case GateID::U3:
+                return std::make_shared<U3>(op.params[0].ToPR(), op.params[1].ToPR(), op.params[2].ToPR(), op.objs,
+                                            op.ctrls);
+            case GateID::M:
+                return std::make_shared<MeasureGate>(op.custom, op.objs);
+            default:
+                throw std::runtime_error(fmt::format("Gate {} not implement.", op.id));
+        }
+    }
+
+    static std::string DirName(const std::string& path) {
+        auto pos = path.find_last_of('/');
+        return pos == std::string::npos ? std::string() : path.substr(0, pos);
+    }
+
+    VS include_dirs_;
+    const VT<Token>* toks_ = nullptr;
+    size_t pos_ = 0;
+    std::string source_name_;
+    std::string base_dir_;
+    std::string version_;
+    index_t n_qubits_ = 0;
+    std::map<std::string, Register> qregs_;
+    std::map<std::string, Register> cregs_;
+    VS clbit_keys_;
+    VS parameters_;
+    std::map<std::string, GateDef> gates_;
+    VT<Op> ops_;
+};
+}  // namespace
+
+MST<size_t> QasmProgram::KeyMap() const {
+    MST<size_t> key_map;
+    for (size_t i = 0; i < clbit_keys.size(); i++) {
+        key_map[clbit_keys[i]] = i;
+    }
+    for (auto& gate : circuit) {
+        if (gate->id_ == GateID::M) {
+            auto& name = static_cast<MeasureGate*>(gate.get())->name_;
+            if (key_map.count(name) == 0) {
+                auto idx = key_map.size();
+                key_map[name] = idx;
+            }
+        }
+    }
+    return key_map;
+}
+
+QasmProgram ParseOpenQASM(const std::string& source, const VT<std::string>& include_dirs,
+                          const std::string& source_name) {
+    Parser parser(include_dirs);
+    return parser.Run(source, source_name, "");
+}
+
+QasmProgram ParseOpenQASMFile(const std::string& file_name, const VT<std::string>& include_dirs) {
+    std::ifstream fin(file_name);
+    if (!fin.is_open()) {
+        throw std::runtime_error(fmt::format("Cannot open file {}", file_name));
+    }
+    std::stringstream buffer;
+    buffer << fin.rdbuf();
+    auto pos = file_name.find_last_of('/');
+    Parser parser(include_dirs);
+    return parser.Run(buffer.str(), file_name, pos == std::string::npos ? std::string() : file_name.substr(0, pos));
+}
+}  // namespace mindquantum::io::qasm
@@ -0,0 +1,347 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/memory_manager.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <vector>
+
+#if !defined(_WIN32)
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+
+namespace mindquantum::memory {
+std::string_view CategoryName(Category category) {
+    switch (category) {
+        case Category::StateVector:
+            return "state_vector";
+        case Category::DensityMatrix:
+            return "density_matrix";
+        case Category::Sparse:
+            return "sparse";
+        case Category::Device:
+            return "device";
+        case Category::Mapped:
+            return "mapped";
+    }
+    return "unknown";
+}
+
+namespace {
+//! Whether the category is held in RAM and counted in the budget.
+bool InBudget(Category category) {
+    return category != Category::Device && category != Category::Mapped;
+}
+
+//! Whether released buffers of the category are kept for reuse, only the states come back with the same sizes.
+bool IsPooled(Category category) {
+    return category == Category::StateVector || category == Category::DensityMatrix;
+}
+}  // namespace
+
+MemoryManager& MemoryManager::Instance() {
+    static MemoryManager manager;
+    return manager;
+}
+
+void* MemoryManager::Allocate(size_t bytes, Category category, bool zero) {
+    void* ptr = nullptr;
+    std::vector<void*> released;
+    {
+        // Reserve first so that concurrent allocations cannot exceed the budget together.
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (budget_ != 0 && total_.current + reserved_ + bytes > budget_) {
+            throw MemoryBudgetError(
+                fmt::format("Allocating {} bytes of {} exceeds the memory budget: {} bytes in use, budget is {} bytes.",
+                            bytes, CategoryName(category), total_.current + reserved_, budget_));
+        }
+        if (IsPooled(category)) {
+            ptr = TakePooled(bytes);
+        }
+        if (ptr != nullptr) {
+            Add(ptr, bytes, category);
+        } else {
+            // Pooled buffers hold RAM as well, shrink the pool so that the budget also bounds them.
+            auto used = total_.current + reserved_ + bytes;
+            if (budget_ != 0 && used + pooled_.current > budget_) {
+                released = TrimPool(budget_ - used);
+            }
+            reserved_ += bytes;
+        }
+    }
+    for (auto* block : released) {
+        std::free(block);
+    }
+    if (ptr != nullptr) {
+        if (zero) {
+            std::memset(ptr, 0, bytes);
+        }
+        return ptr;
+    }
+    ptr = zero ? std::calloc(bytes, 1) : std::malloc(bytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    reserved_ -= bytes;
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    Add(ptr, bytes, category);
+    return ptr;
+}
+
+void* MemoryManager::AllocateMapped(size_t bytes, const std::string& dir) {
+#if defined(_WIN32)
+    throw std::runtime_error("Memory mapped states are not supported on Windows.");
+#else
+    std::string pattern = dir + "/mindquantum-state-XXXXXX";
+    std::vector<char> path(pattern.begin(), pattern.end());
+    path.push_back('\0');
+    int fd = mkstemp(path.data());
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Cannot create a file in {}: {}", dir, std::strerror(errno)));
+    }
+    unlink(path.data());
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        auto err = errno;
+        close(fd);
+        throw std::runtime_error(fmt::format("Cannot reserve {} bytes in {}: {}", bytes, dir, std::strerror(err)));
+    }
+    void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto err = errno;
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        throw std::runtime_error(fmt::format("Cannot map {} bytes in {}: {}", bytes, dir, std::strerror(err)));
+    }
+    Track(ptr, bytes, Category::Mapped);
+    return ptr;
+#endif
+}
+
+void MemoryManager::Free(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    std::optional<std::pair<size_t, Category>> block;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto owner = extra_owners_.find(ptr); owner != extra_owners_.end()) {
+            if (--owner->second == 0) {
+                extra_owners_.erase(owner);
+            }
+            return;
+        }
+        block = Remove(ptr);
+        if (block.has_value() && IsPooled(block->second) && pooled_.current + block->first <= pool_limit_) {
+            pool_[block->first].push_back(ptr);
+            pooled_.current += block->first;
+            pooled_.peak = std::max(pooled_.peak, pooled_.current);
+            return;
+        }
+    }
+#if !defined(_WIN32)
+    if (block.has_value() && block->second == Category::Mapped) {
+        munmap(ptr, block->first);
+        return;
+    }
+#endif
+    std::free(ptr);
+}
+
+bool MemoryManager::Share(void* ptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (blocks_.find(ptr) == blocks_.end()) {
+        return false;
+    }
+    extra_owners_[ptr] += 1;
+    return true;
+}
+
+bool MemoryManager::IsShared(const void* ptr) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return extra_owners_.find(ptr) != extra_owners_.end();
+}
+
+void MemoryManager::SetPoolLimit(size_t bytes) {
+    std::vector<void*> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pool_limit_ = bytes;
+        released = TrimPool(bytes);
+    }
+    for (auto* block : released) {
+        std::free(block);
+    }
+}
+
+size_t MemoryManager::PoolLimit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pool_limit_;
+}
+
+Usage MemoryManager::Pooled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pooled_;
+}
+
+void MemoryManager::ReleasePool() {
+    std::vector<void*> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released = TrimPool(0);
+    }
+    for (auto* block : released) {
+        std::free(block);
+    }
+}
+
+void* MemoryManager::TakePooled(size_t bytes) {
+    auto it = pool_.find(bytes);
+    if (it == pool_.end()) {
+        return nullptr;
+    }
+    auto* ptr = it->second.back();
+    it->second.pop_back();
+    if (it->second.empty()) {
+        pool_.erase(it);
+    }
+    pooled_.current -= bytes;
+    return ptr;
+}
+
+std::vector<void*> MemoryManager::TrimPool(size_t limit) {
+    std::vector<void*> out;
+    for (auto it = pool_.begin(); it != pool_.end() && pooled_.current > limit;) {
+        while (!it->second.empty() && pooled_.current > limit) {
+            out.push_back(it->second.back());
+            it->second.pop_back();
+            pooled_.current -= it->first;
+        }
+        it = it->second.empty() ? pool_.erase(it) : std::next(it);
+    }
+    return out;
+}
+
+void MemoryManager::Track(void* ptr, size_t bytes, Category category) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Add(ptr, bytes, category);
+}
+
+void MemoryManager::Untrack(void* ptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Remove(ptr);
+}
+
+auto MemoryManager::Remove(void* ptr) -> std::optional<std::pair<size_t, Category>> {
+    auto it = blocks_.find(ptr);
+    if (it == blocks_.end()) {
+        return std::nullopt;
+    }
+    auto block = it->second;
+    auto [bytes, category] = block;
+    usage_[static_cast<size_t>(category)].current -= bytes;
+    if (InBudget(category)) {
+        total_.current -= bytes;
+    }
+    blocks_.erase(it);
+    return block;
+}
+
+void MemoryManager::Add(void* ptr, size_t bytes, Category category) {
+    blocks_[ptr] = {bytes, category};
+    auto& usage = usage_[static_cast<size_t>(category)];
+    usage.current += bytes;
+    usage.peak = std::max(usage.peak, usage.current);
+    if (InBudget(category)) {
+        total_.current += bytes;
+        total_.peak = std::max(total_.peak, total_.current);
+    }
+}
+
+void MemoryManager::SetBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = bytes;
+}
+
+size_t MemoryManager::Budget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_;
+}
+
+size_t MemoryManager::Available() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (budget_ == 0) {
+        return std::numeric_limits<size_t>::max();
+    }
+    auto used = total_.current + reserved_;
+    return used >= budget_ ? 0 : budget_ - used;
+}
+
+Usage MemoryManager::Total() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_;
+}
+
+Usage MemoryManager::Get(Category category) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_[static_cast<size_t>(category)];
+}
+
+void MemoryManager::ResetPeak() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& usage : usage_) {
+        usage.peak = usage.current;
+    }
+    total_.peak = total_.current;
+    pooled_.peak = pooled_.current;
+}
+
+void Prefetch(const void* ptr, size_t bytes) {
+#if !defined(_WIN32)
+    static const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto begin = reinterpret_cast<uintptr_t>(ptr) & ~(page - 1);
+    auto end = reinterpret_cast<uintptr_t>(ptr) + bytes;
+    madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+#endif
+}
+
+size_t FitConcurrency(size_t n_task, size_t bytes_per_task, size_t fixed_bytes) {
+    auto available = MemoryManager::Instance().Available();
+    if (available == std::numeric_limits<size_t>::max() || bytes_per_task == 0) {
+        return n_task;
+    }
+    if (available < fixed_bytes + bytes_per_task) {
+        throw MemoryBudgetError(fmt::format("Not enough memory budget: need at least {} bytes, {} bytes available.",
+                                            fixed_bytes + bytes_per_task, available));
+    }
+    return std::min(n_task, (available - fixed_bytes) / bytes_per_task);
+}
+
+size_t FitBatches(size_t n_batch, size_t bytes_per_batch) {
+    if (n_batch == 0 || MemoryManager::Instance().Available() < bytes_per_batch) {
+        return std::min<size_t>(n_batch, 1);
+    }
+    return FitConcurrency(n_batch, bytes_per_batch);
+}
+}  // namespace mindquantum::memory
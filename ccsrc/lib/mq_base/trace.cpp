@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#if defined(_WIN32)
+#    include <windows.h>
+#elif defined(__linux__)
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#elif defined(__APPLE__)
+#    include <pthread.h>
+#endif
+
+namespace mindquantum::trace {
+uint64_t Now() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+uint64_t ThreadId() {
+#if defined(_WIN32)
+    return static_cast<uint64_t>(GetCurrentThreadId());
+#elif defined(__linux__)
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+#elif defined(__APPLE__)
+    uint64_t tid = 0;
+    pthread_threadid_np(nullptr, &tid);
+    return tid;
+#else
+    return static_cast<uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+}
+
+Recorder& Recorder::Instance() {
+    static Recorder recorder;
+    return recorder;
+}
+
+Recorder::LocalBuffer::LocalBuffer(Recorder* recorder) {
+    std::lock_guard<std::mutex> lock(recorder->mutex_);
+    for (auto& free_buffer : recorder->buffers_) {
+        std::lock_guard<std::mutex> buffer_lock(free_buffer->mutex);
+        if (!free_buffer->in_use) {
+            free_buffer->in_use = true;
+            free_buffer->tid = ThreadId();
+            buffer = free_buffer;
+            return;
+        }
+    }
+    buffer = std::make_shared<RingBuffer>();
+    buffer->in_use = true;
+    buffer->tid = ThreadId();
+    recorder->buffers_.push_back(buffer);
+}
+
+Recorder::LocalBuffer::~LocalBuffer() {
+    // The events stay in the buffer until they are overwritten by the next owner or cleared, so the events of an
+    // exited thread still show up in the trace.
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->in_use = false;
+}
+
+auto Recorder::Local() -> RingBuffer& {
+    thread_local LocalBuffer local(this);
+    return *local.buffer;
+}
+
+void Recorder::Start(size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Capacity of the trace buffer should be positive.");
+    }
+    Clear();
+    capacity_.store(capacity, std::memory_order_relaxed);
+    recording_.store(true, std::memory_order_relaxed);
+}
+
+void Recorder::Stop() {
+    recording_.store(false, std::memory_order_relaxed);
+}
+
+void Recorder::Add(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns) {
+    auto& buffer = Local();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    auto capacity = capacity_.load(std::memory_order_relaxed);
+    if (buffer.events.size() != capacity) {
+        buffer.events.assign(capacity, Event{});
+        buffer.head = 0;
+        buffer.size = 0;
+    }
+    auto idx = (buffer.head + buffer.size) % capacity;
+    buffer.events[idx] = {name, category, buffer.tid, start_ns, end_ns - start_ns};
+    if (buffer.size < capacity) {
+        buffer.size += 1;
+    } else {
+        buffer.head = (buffer.head + 1) % capacity;
+    }
+}
+
+std::vector<Event> Recorder::Events() const {
+    std::vector<Event> out;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            for (size_t i = 0; i < buffer->size; ++i) {
+                out.push_back(buffer->events[(buffer->head + i) % buffer->events.size()]);
+            }
+        }
+    }
+    std::stable_sort(out.begin(), out.end(),
+                     [](const Event& lhs, const Event& rhs) { return lhs.start_ns < rhs.start_ns; });
+    return out;
+}
+
+std::string Recorder::ChromeJson() const {
+    auto events = nlohmann::json::array();
+    for (auto& event : Events()) {
+        // Chrome expects microseconds, the fraction keeps the nanosecond resolution.
+        events.push_back({{"name", event.name},
+                          {"cat", event.category},
+                          {"ph", "X"},
+                          {"ts", static_cast<double>(event.start_ns) / 1e3},
+                          {"dur", static_cast<double>(event.dur_ns) / 1e3},
+                          {"pid", 0},
+                          {"tid", event.tid}});
+    }
+    return nlohmann::json{{"traceEvents", events}, {"displayTimeUnit", "ns"}}.dump();
+}
+
+void Recorder::DumpChromeJson(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Cannot open trace file " + filename);
+    }
+    file << ChromeJson();
+}
+
+void Recorder::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto released = std::remove_if(buffers_.begin(), buffers_.end(), [](const std::shared_ptr<RingBuffer>& buffer) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        if (buffer->in_use) {
+            // Add allocates the events again at the next record.
+            std::vector<Event>().swap(buffer->events);
+            buffer->head = 0;
+            buffer->size = 0;
+            return false;
+        }
+        return true;
+    });
+    buffers_.erase(released, buffers_.end());
+}
+}  // namespace mindquantum::trace
@@ -0,0 +1,596 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Micro-benchmark of the static kernels of the x86_64 cpu simulator policies: the AVX float, AVX double and mixed
+// precision state vector policies and the AVX float and double density matrix policies. The ARM policies only build on
+// aarch64 and the out of core policy streams chunks from files, neither of them is covered.
+//
+// Every kernel is timed for each combination of qubit number, target position (lowest or highest qubits), control
+// number and OpenMP thread number. The effective bandwidth of a kernel is compared with a parallel memcpy of the same
+// state, which is the upper bound for these memory bound kernels.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#ifdef _OPENMP
+#    include <omp.h>
+#endif  // _OPENMP
+
+#include "config/openmp.h"
+#include "core/mq_base_types.h"
+#include "core/sparse/algo.h"
+#include "simulator/densitymatrix/detail/cpu_densitymatrix_avx_double_policy.h"
+#include "simulator/densitymatrix/detail/cpu_densitymatrix_avx_float_policy.h"
+#include "simulator/vector/detail/cpu_vector_avx_double_policy.h"
+#include "simulator/vector/detail/cpu_vector_avx_float_policy.h"
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+
+namespace {
+using mindquantum::index_t;
+using mindquantum::qbit_t;
+using mindquantum::qbits_t;
+using clock_t_ = std::chrono::steady_clock;
+
+struct Options {
+    std::vector<int> qubits{12, 16, 20, 24};
+    std::vector<int> dm_qubits{6, 8, 10, 12};
+    std::vector<int> ctrls{0, 1, 2};
+    std::vector<int> threads{};
+    std::string policy{};
+    std::string kernel{};
+    std::string json{};
+    double min_time = 0.05;
+};
+
+struct Record {
+    std::string policy;
+    std::string kernel;
+    int qubits;
+    std::string target;
+    qbits_t objs;
+    qbits_t ctrls;
+    int threads;
+    double ns_per_call;
+    double ns_per_amp;
+    double gbps;
+    double memcpy_gbps;
+};
+
+// Benchmark of one kernel. A kernel moves `passes` times the bytes of the touched part of the state per call, for
+// instance 2 for a gate that reads and writes every amplitude, 1 for a diagonal gate that only updates half of them.
+template <typename qs_data_p_t>
+struct Kernel {
+    std::string name;
+    int n_objs;
+    bool with_ctrls;
+    double passes;
+    std::function<void(qs_data_p_t*, qs_data_p_t*, const qbits_t&, const qbits_t&, index_t)> run;
+};
+
+template <typename F>
+double TimeIt(const F& fn, double min_time) {
+    fn();
+    for (size_t n_call = 1;; n_call *= 2) {
+        auto start = clock_t_::now();
+        for (size_t i = 0; i < n_call; ++i) {
+            fn();
+        }
+        double elapsed = std::chrono::duration<double>(clock_t_::now() - start).count();
+        if (elapsed >= min_time) {
+            return elapsed / n_call;
+        }
+    }
+}
+
+// Time of a memcpy of `bytes` bytes, split between the current OpenMP threads.
+double MemcpyTime(size_t bytes, double min_time) {
+    std::vector<char> src(bytes, 1);
+    std::vector<char> des(bytes, 0);
+    return TimeIt(
+        [&]() {
+#ifdef _OPENMP
+            int n_thread = omp_get_max_threads();
+#else
+            int n_thread = 1;
+#endif  // _OPENMP
+            size_t chunk = (bytes + n_thread - 1) / n_thread;
+#pragma omp parallel for schedule(static)
+            for (int i = 0; i < n_thread; ++i) {
+                size_t begin = std::min(bytes, chunk * i);
+                size_t end = std::min(bytes, begin + chunk);
+                std::memcpy(des.data() + begin, src.data() + begin, end - begin);
+            }
+        },
+        min_time);
+}
+
+template <typename qs_data_p_t>
+void FillRandom(qs_data_p_t qs, size_t n_elements) {
+    std::mt19937 rnd(42);
+    using calc_type = typename std::remove_pointer_t<qs_data_p_t>::value_type;
+    std::normal_distribution<calc_type> dist;
+    for (size_t i = 0; i < n_elements; ++i) {
+        qs[i] = {dist(rnd), dist(rnd)};
+    }
+}
+
+template <typename T>
+std::vector<std::vector<std::complex<T>>> HMatrix(int n_objs) {
+    size_t dim = size_t(1) << n_objs;
+    std::vector<std::vector<std::complex<T>>> m(dim, std::vector<std::complex<T>>(dim));
+    T norm = std::pow(std::sqrt(T(0.5)), n_objs);
+    for (size_t i = 0; i < dim; ++i) {
+        for (size_t j = 0; j < dim; ++j) {
+            m[i][j] = (__builtin_popcountll(i & j) % 2 == 0 ? norm : -norm);
+        }
+    }
+    return m;
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename policy_t>
+std::vector<Kernel<typename policy_t::qs_data_p_t>> VectorKernels() {
+    using p = policy_t;
+    using qs_p_t = typename p::qs_data_p_t;
+    using calc_type = typename p::calc_type;
+    constexpr calc_type val = 0.3;
+    auto m1 = HMatrix<calc_type>(1);
+    auto m2 = HMatrix<calc_type>(2);
+    auto terms = [](const qbits_t& objs) {
+        return std::vector<mindquantum::PauliTerm<calc_type>>{{{{objs[0], 'X'}, {objs[1], 'Z'}}, calc_type(0.5)}};
+    };
+    // Sparse hamiltonian X0 Z(n-1) of each dimension, built once outside of the timing.
+    auto csr = std::make_shared<std::map<index_t, std::shared_ptr<mindquantum::sparse::CsrHdMatrix<calc_type>>>>();
+    auto gate = [](auto fn) {
+        return [fn](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+            fn(qs, objs, ctrls, dim);
+        };
+    };
+    auto rot = [](auto fn) {
+        return [fn](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+            fn(qs, objs, ctrls, val, dim, false);
+        };
+    };
+    auto expect = [](auto fn) {
+        return [fn](qs_p_t* qs, qs_p_t* aux, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+            fn(*aux, *qs, objs, ctrls, val, dim);
+        };
+    };
+    return {
+        {"X", 1, true, 2, gate(p::ApplyX)},
+        {"Y", 1, true, 2, gate(p::ApplyY)},
+        {"Z", 1, true, 1, gate(p::ApplyZ)},
+        {"H", 1, true, 2, gate(p::ApplyH)},
+        {"S", 1, true, 1, gate(p::ApplySGate)},
+        {"Sdag", 1, true, 1, gate(p::ApplySdag)},
+        {"T", 1, true, 1, gate(p::ApplyT)},
+        {"Tdag", 1, true, 1, gate(p::ApplyTdag)},
+        {"SWAP", 2, true, 1, gate(p::ApplySWAP)},
+        {"ISWAP", 2, true, 1,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ApplyISWAP(qs, objs, ctrls, false, dim);
+         }},
+        {"PS", 1, true, 1, rot(p::ApplyPS)},
+        {"RX", 1, true, 2, rot(p::ApplyRX)},
+        {"RY", 1, true, 2, rot(p::ApplyRY)},
+        {"RZ", 1, true, 2, rot(p::ApplyRZ)},
+        {"Rxx", 2, true, 2, rot(p::ApplyRxx)},
+        {"Ryy", 2, true, 2, rot(p::ApplyRyy)},
+        {"Rzz", 2, true, 2, rot(p::ApplyRzz)},
+        {"Rxy", 2, true, 2, rot(p::ApplyRxy)},
+        {"Rxz", 2, true, 2, rot(p::ApplyRxz)},
+        {"Ryz", 2, true, 2, rot(p::ApplyRyz)},
+        {"GP", 1, true, 2,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ApplyGP(qs, objs[0], ctrls, val, dim, false);
+         }},
+        {"SingleQubitMatrix", 1, true, 2,
+         [m1](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ApplySingleQubitMatrix(*qs, qs, objs[0], ctrls, m1, dim);
+         }},
+        {"TwoQubitsMatrix", 2, true, 2,
+         [m2](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ApplyTwoQubitsMatrix(*qs, qs, objs, ctrls, m2, dim);
+         }},
+        {"NQubitsMatrix", 2, true, 2,
+         [m2](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ApplyNQubitsMatrix(*qs, qs, objs, ctrls, m2, dim);
+         }},
+        {"ExpectDiffRX", 1, true, 2, expect(p::ExpectDiffRX)},
+        {"ExpectDiffRY", 1, true, 2, expect(p::ExpectDiffRY)},
+        {"ExpectDiffRZ", 1, true, 2, expect(p::ExpectDiffRZ)},
+        {"ExpectDiffPS", 1, true, 1, expect(p::ExpectDiffPS)},
+        {"ExpectDiffGP", 1, true, 2, expect(p::ExpectDiffGP)},
+        {"ExpectDiffRxx", 2, true, 2, expect(p::ExpectDiffRxx)},
+        {"ExpectDiffRyy", 2, true, 2, expect(p::ExpectDiffRyy)},
+        {"ExpectDiffRzz", 2, true, 2, expect(p::ExpectDiffRzz)},
+        {"ExpectDiffRxy", 2, true, 2, expect(p::ExpectDiffRxy)},
+        {"ExpectDiffRxz", 2, true, 2, expect(p::ExpectDiffRxz)},
+        {"ExpectDiffRyz", 2, true, 2, expect(p::ExpectDiffRyz)},
+        {"ExpectDiffSingleQubitMatrix", 1, true, 2,
+         [m1](qs_p_t* qs, qs_p_t* aux, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ExpectDiffSingleQubitMatrix(*aux, *qs, objs, ctrls, m1, dim);
+         }},
+        {"ExpectDiffTwoQubitsMatrix", 2, true, 2,
+         [m2](qs_p_t* qs, qs_p_t* aux, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ExpectDiffTwoQubitsMatrix(*aux, *qs, objs, ctrls, m2, dim);
+         }},
+        {"Vdot", 0, false, 2,
+         [](qs_p_t* qs, qs_p_t* aux, const qbits_t&, const qbits_t&, index_t dim) { p::Vdot(*aux, *qs, dim); }},
+        {"OneStateVdot", 1, false, 1,
+         [](qs_p_t* qs, qs_p_t* aux, const qbits_t& objs, const qbits_t&, index_t dim) {
+             p::OneStateVdot(*aux, *qs, objs[0], dim);
+         }},
+        {"ExpectationOfTerms", 2, false, 2,
+         [terms](qs_p_t* qs, qs_p_t* aux, const qbits_t& objs, const qbits_t&, index_t dim) {
+             p::ExpectationOfTerms(*aux, *qs, terms(objs), dim);
+         }},
+        {"ApplyTerms", 2, false, 3,
+         [terms](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t&, index_t dim) {
+             auto out = p::ApplyTerms(qs, terms(objs), dim);
+             p::FreeState(&out);
+         }},
+        // Only the traffic of the vectors is counted, not the one of the matrix.
+        {"CsrDotVec", 0, false, 2,
+         [csr](qs_p_t* qs, qs_p_t*, const qbits_t&, const qbits_t&, index_t dim) {
+             auto& mat = (*csr)[dim];
+             if (mat == nullptr) {
+                 auto n_qubits = static_cast<qbit_t>(std::log2(static_cast<double>(dim)));
+                 std::vector<mindquantum::PauliTerm<calc_type>> ham{
+                     {{{0, 'X'}, {n_qubits - 1, 'Z'}}, calc_type(0.5)}};
+                 mat = mindquantum::sparse::SparseHamiltonian(ham, n_qubits);
+             }
+             auto out = p::CsrDotVec(mat, *qs, dim);
+             p::FreeState(&out);
+         }},
+        {"QSMulValue", 0, false, 2,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t&, const qbits_t&, index_t dim) {
+             p::QSMulValue(*qs, qs, typename p::qs_data_t(1, 0), dim);
+         }},
+        {"ConditionalCollect", 1, false, 1,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t&, index_t dim) {
+             index_t mask = index_t(1) << objs[0];
+             p::ConditionalCollect(*qs, mask, mask, true, dim);
+         }},
+        {"ConditionalMul", 1, false, 2,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t&, index_t dim) {
+             index_t mask = index_t(1) << objs[0];
+             p::ConditionalMul(*qs, qs, mask, mask, typename p::qs_data_t(1, 0), typename p::qs_data_t(1, 0), dim);
+         }},
+        {"Copy", 0, false, 2,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t&, const qbits_t&, index_t dim) {
+             auto des = p::Copy(*qs, dim);
+             p::FreeState(&des);
+         }},
+    };
+}
+
+template <typename policy_t>
+std::vector<Kernel<typename policy_t::qs_data_p_t>> DensityMatrixKernels() {
+    using p = policy_t;
+    using qs_p_t = typename p::qs_data_p_t;
+    using calc_type = typename p::calc_type;
+    constexpr calc_type val = 0.3;
+    auto m1 = HMatrix<calc_type>(1);
+    auto m2 = HMatrix<calc_type>(2);
+    std::vector<typename p::matrix_t> kraus{
+        {{std::sqrt(calc_type(0.9)), 0}, {0, std::sqrt(calc_type(0.9))}},
+        {{0, std::sqrt(calc_type(0.1))}, {std::sqrt(calc_type(0.1)), 0}},
+    };
+    auto gate = [](auto fn) {
+        return [fn](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+            fn(qs, objs, ctrls, dim);
+        };
+    };
+    auto rot = [](auto fn) {
+        return [fn](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+            fn(qs, objs, ctrls, val, dim, false);
+        };
+    };
+    auto expect = [](auto fn) {
+        return [fn](qs_p_t* qs, qs_p_t* aux, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+            fn(*qs, *aux, objs, ctrls, dim);
+        };
+    };
+    return {
+        {"X", 1, true, 2, gate(p::ApplyX)},
+        {"Y", 1, true, 2, gate(p::ApplyY)},
+        {"Z", 1, true, 2, gate(p::ApplyZ)},
+        {"H", 1, true, 2, gate(p::ApplyH)},
+        {"S", 1, true, 2, gate(p::ApplySGate)},
+        {"Sdag", 1, true, 2, gate(p::ApplySdag)},
+        {"T", 1, true, 2, gate(p::ApplyT)},
+        {"Tdag", 1, true, 2, gate(p::ApplyTdag)},
+        {"SWAP", 2, true, 2, gate(p::ApplySWAP)},
+        {"ISWAP", 2, true, 2, gate(p::ApplyISWAP)},
+        {"PS", 1, true, 2, rot(p::ApplyPS)},
+        {"RX", 1, true, 2, rot(p::ApplyRX)},
+        {"RY", 1, true, 2, rot(p::ApplyRY)},
+        {"RZ", 1, true, 2, rot(p::ApplyRZ)},
+        {"Rxx", 2, true, 2, rot(p::ApplyRxx)},
+        {"Ryy", 2, true, 2, rot(p::ApplyRyy)},
+        {"Rzz", 2, true, 2, rot(p::ApplyRzz)},
+        {"SingleQubitMatrix", 1, true, 2,
+         [m1](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ApplySingleQubitMatrix(*qs, qs, objs[0], ctrls, m1, dim);
+         }},
+        {"TwoQubitsMatrix", 2, true, 2,
+         [m2](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ApplyTwoQubitsMatrix(*qs, qs, objs, ctrls, m2, dim);
+         }},
+        {"AmplitudeDamping", 1, false, 2,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t&, index_t dim) {
+             p::ApplyAmplitudeDamping(qs, objs, val, false, dim);
+         }},
+        {"PhaseDamping", 1, false, 2,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t&, index_t dim) {
+             p::ApplyPhaseDamping(qs, objs, val, dim);
+         }},
+        {"Depolarizing", 1, false, 2,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t&, index_t dim) {
+             p::ApplyDepolarizing(qs, objs, val, dim);
+         }},
+        {"Pauli", 1, false, 2,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t&, index_t dim) {
+             p::ApplyPauli(qs, objs, {0.1, 0.1, 0.1, 0.7}, dim);
+         }},
+        {"Kraus", 1, false, 2,
+         [kraus](qs_p_t* qs, qs_p_t*, const qbits_t& objs, const qbits_t&, index_t dim) {
+             p::ApplyKraus(qs, objs, kraus, dim);
+         }},
+        {"ExpectDiffRX", 1, true, 2, expect(p::ExpectDiffRX)},
+        {"ExpectDiffRY", 1, true, 2, expect(p::ExpectDiffRY)},
+        {"ExpectDiffRZ", 1, true, 2, expect(p::ExpectDiffRZ)},
+        {"ExpectDiffPS", 1, true, 2, expect(p::ExpectDiffPS)},
+        {"ExpectDiffRxx", 2, true, 2, expect(p::ExpectDiffRxx)},
+        {"ExpectDiffRyy", 2, true, 2, expect(p::ExpectDiffRyy)},
+        {"ExpectDiffRzz", 2, true, 2, expect(p::ExpectDiffRzz)},
+        {"ExpectDiffSingleQubitMatrix", 1, true, 2,
+         [m1](qs_p_t* qs, qs_p_t* aux, const qbits_t& objs, const qbits_t& ctrls, index_t dim) {
+             p::ExpectDiffSingleQubitMatrix(*qs, *aux, objs, ctrls, m1, m1, dim);
+         }},
+        {"Purity", 0, false, 1,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t&, const qbits_t&, index_t dim) { p::Purity(*qs, dim); }},
+        {"Copy", 0, false, 2,
+         [](qs_p_t* qs, qs_p_t*, const qbits_t&, const qbits_t&, index_t dim) {
+             auto des = p::Copy(*qs, dim);
+             p::FreeState(&des);
+         }},
+    };
+}
+
+// -----------------------------------------------------------------------------
+
+// Qubits acted on for a target position, controls are taken from the middle of the register.
+void Placement(int n_qubits, int n_objs, int n_ctrls, bool high, qbits_t* objs, qbits_t* ctrls) {
+    objs->clear();
+    ctrls->clear();
+    for (int i = 0; i < n_objs; ++i) {
+        objs->push_back(high ? n_qubits - n_objs + i : i);
+    }
+    for (int q = n_qubits / 2; static_cast<int>(ctrls->size()) < n_ctrls && q < n_qubits; ++q) {
+        if (std::find(objs->begin(), objs->end(), q) == objs->end()) {
+            ctrls->push_back(q);
+        }
+    }
+}
+
+/**
+ * Run every kernel of a policy.
+ *
+ * \param n_elements Number of stored amplitudes for a given dimension.
+ * \param touched Fraction of the stored amplitudes a kernel accesses given its number of controls.
+ */
+template <typename policy_t>
+void RunPolicy(const std::string& name, const std::vector<Kernel<typename policy_t::qs_data_p_t>>& kernels,
+               const std::vector<int>& qubits, const Options& opt, const std::function<size_t(index_t)>& n_elements,
+               const std::function<double(int)>& touched, std::vector<Record>* records) {
+    if (!opt.policy.empty() && name.find(opt.policy) == std::string::npos) {
+        return;
+    }
+    using qs_p_t = typename policy_t::qs_data_p_t;
+    using qs_data_t = typename policy_t::qs_data_t;
+    for (auto n_qubits : qubits) {
+        index_t dim = index_t(1) << n_qubits;
+        size_t n_amp = n_elements(dim);
+        size_t bytes = n_amp * sizeof(qs_data_t);
+        qs_p_t qs = policy_t::InitState(dim, false);
+        qs_p_t aux = policy_t::InitState(dim, false);
+        FillRandom(qs, n_amp);
+        FillRandom(aux, n_amp);
+        for (auto n_thread : opt.threads) {
+#ifdef _OPENMP
+            omp_set_num_threads(n_thread);
+#endif  // _OPENMP
+            double memcpy_gbps = 2.0 * bytes / MemcpyTime(bytes, opt.min_time) * 1e-9;
+            for (auto& kernel : kernels) {
+                if (!opt.kernel.empty() && kernel.name.find(opt.kernel) == std::string::npos) {
+                    continue;
+                }
+                for (auto high : {false, true}) {
+                    if (kernel.n_objs == 0 && high) {
+                        continue;
+                    }
+                    for (auto n_ctrls : opt.ctrls) {
+                        if ((!kernel.with_ctrls && n_ctrls != 0) || kernel.n_objs + n_ctrls > n_qubits) {
+                            continue;
+                        }
+                        qbits_t objs;
+                        qbits_t ctrls;
+                        Placement(n_qubits, kernel.n_objs, n_ctrls, high, &objs, &ctrls);
+                        double t = TimeIt([&]() { kernel.run(&qs, &aux, objs, ctrls, dim); }, opt.min_time);
+                        double moved = kernel.passes * bytes * touched(n_ctrls);
+                        records->push_back({name, kernel.name, n_qubits, high ? "high" : "low", objs, ctrls, n_thread,
+                                            t * 1e9, t * 1e9 / n_amp, moved / t * 1e-9, memcpy_gbps});
+                        auto& r = records->back();
+                        std::cout << std::left << std::setw(26) << r.policy << std::setw(30) << r.kernel
+                                  << std::right << std::setw(4) << r.qubits << std::setw(6) << r.target
+                                  << std::setw(3) << n_ctrls << std::setw(4) << r.threads << std::fixed
+                                  << std::setprecision(3) << std::setw(14) << r.ns_per_call / 1e3 << " us"
+                                  << std::setw(10) << r.ns_per_amp << " ns/amp" << std::setw(9) << r.gbps
+                                  << " GB/s" << std::setw(7) << std::setprecision(1)
+                                  << 100 * r.gbps / r.memcpy_gbps << " %" << std::endl;
+                    }
+                }
+            }
+        }
+        policy_t::FreeState(&qs);
+        policy_t::FreeState(&aux);
+    }
+}
+
+std::vector<int> ParseList(const std::string& arg) {
+    std::vector<int> out;
+    size_t start = 0;
+    while (start <= arg.size()) {
+        auto end = arg.find(',', start);
+        if (end == std::string::npos) {
+            end = arg.size();
+        }
+        if (end > start) {
+            out.push_back(std::stoi(arg.substr(start, end - start)));
+        }
+        start = end + 1;
+    }
+    return out;
+}
+
+void Usage() {
+    std::cout << "Usage: mqbench [options]\n"
+              << "  --qubits N,N,...     qubit numbers of the state vector kernels (default 12,16,20,24)\n"
+              << "  --dm-qubits N,N,...  qubit numbers of the density matrix kernels (default 6,8,10,12)\n"
+              << "  --ctrls N,N,...      control qubit numbers (default 0,1,2)\n"
+              << "  --threads N,N,...    OpenMP thread numbers (default 1 and all threads)\n"
+              << "  --policy NAME        only run policies whose name contains NAME\n"
+              << "  --kernel NAME        only run kernels whose name contains NAME\n"
+              << "  --min-time SECONDS   minimum measuring time of each case (default 0.05)\n"
+              << "  --json FILE          write the results to FILE as json\n";
+}
+
+Options ParseOptions(int argc, char* argv[]) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string key = argv[i];
+        if (key == "-h" || key == "--help") {
+            Usage();
+            std::exit(0);
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for option " + key + ".");
+        }
+        std::string value = argv[++i];
+        if (key == "--qubits") {
+            opt.qubits = ParseList(value);
+        } else if (key == "--dm-qubits") {
+            opt.dm_qubits = ParseList(value);
+        } else if (key == "--ctrls") {
+            opt.ctrls = ParseList(value);
+        } else if (key == "--threads") {
+            opt.threads = ParseList(value);
+        } else if (key == "--policy") {
+            opt.policy = value;
+        } else if (key == "--kernel") {
+            opt.kernel = value;
+        } else if (key == "--min-time") {
+            opt.min_time = std::stod(value);
+        } else if (key == "--json") {
+            opt.json = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + key + ".");
+        }
+    }
+    if (opt.threads.empty()) {
+        opt.threads.push_back(1);
+#ifdef _OPENMP
+        if (omp_get_max_threads() > 1) {
+            opt.threads.push_back(omp_get_max_threads());
+        }
+#endif  // _OPENMP
+    }
+    return opt;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    namespace vec = mindquantum::sim::vector::detail;
+    namespace dm = mindquantum::sim::densitymatrix::detail;
+    auto opt = ParseOptions(argc, argv);
+
+    auto vec_elements = [](index_t dim) { return static_cast<size_t>(dim); };
+    auto vec_touched = [](int n_ctrls) { return std::ldexp(1.0, -n_ctrls); };
+    // Only the lower triangle is stored, a controlled gate acts on the rows and the columns whose controls are set.
+    auto dm_elements = [](index_t dim) { return static_cast<size_t>((dim * dim + dim) / 2); };
+    auto dm_touched = [](int n_ctrls) { return 1.0 - std::pow(1.0 - std::ldexp(1.0, -n_ctrls), 2); };
+
+    std::vector<Record> records;
+    RunPolicy<vec::CPUVectorPolicyAvxFloat>("vector_avx_float", VectorKernels<vec::CPUVectorPolicyAvxFloat>(),
+                                            opt.qubits, opt, vec_elements, vec_touched, &records);
+    RunPolicy<vec::CPUVectorPolicyAvxDouble>("vector_avx_double", VectorKernels<vec::CPUVectorPolicyAvxDouble>(),
+                                             opt.qubits, opt, vec_elements, vec_touched, &records);
+    RunPolicy<vec::CPUVectorPolicyMixed>("vector_mixed", VectorKernels<vec::CPUVectorPolicyMixed>(), opt.qubits, opt,
+                                         vec_elements, vec_touched, &records);
+    RunPolicy<dm::CPUDensityMatrixPolicyAvxFloat>("densitymatrix_avx_float",
+                                                  DensityMatrixKernels<dm::CPUDensityMatrixPolicyAvxFloat>(),
+                                                  opt.dm_qubits, opt, dm_elements, dm_touched, &records);
+    RunPolicy<dm::CPUDensityMatrixPolicyAvxDouble>("densitymatrix_avx_double",
+                                                   DensityMatrixKernels<dm::CPUDensityMatrixPolicyAvxDouble>(),
+                                                   opt.dm_qubits, opt, dm_elements, dm_touched, &records);
+
+    if (!opt.json.empty()) {
+        nlohmann::json out;
+        out["min_time"] = opt.min_time;
+        out["results"] = nlohmann::json::array();
+        for (auto& r : records) {
+            out["results"].push_back({
+                {"policy", r.policy},
+                {"kernel", r.kernel},
+                {"qubits", r.qubits},
+                {"target", r.target},
+                {"objs", r.objs},
+                {"ctrls", r.ctrls},
+                {"threads", r.threads},
+                {"ns_per_call", r.ns_per_call},
+                {"ns_per_amp", r.ns_per_amp},
+                {"gbps", r.gbps},
+                {"memcpy_gbps", r.memcpy_gbps},
+                {"roofline", r.gbps / r.memcpy_gbps},
+            });
+        }
+        std::ofstream file(opt.json);
+        if (!file) {
+            throw std::runtime_error("Can not open " + opt.json + " for writing.");
+        }
+        file << out.dump(2) << std::endl;
+    }
+    return 0;
+}
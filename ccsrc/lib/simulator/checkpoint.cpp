@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/checkpoint.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#    include <io.h>
+#else
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+
+namespace mindquantum::sim::checkpoint {
+namespace {
+constexpr char magic[8] = "MQSTATE";
+
+// Bytes per read or write call, large enough to stream at the disk bandwidth.
+constexpr size_t io_block = 1UL << 26;
+
+// Records per staging buffer of the sparse encoding.
+constexpr size_t sparse_block = 1UL << 20;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint32_t dtype;
+    uint32_t n_qubits;
+    uint32_t seed;
+    uint32_t encoding;
+    uint64_t n_elements;
+    uint64_t element_bytes;
+    uint64_t n_stored;
+    uint64_t rng_bytes;
+};
+static_assert(sizeof(Header) == 64);
+
+//! Unbuffered file, every read and write goes straight to the OS.
+class File {
+ public:
+    File(const std::string& filename, const char* mode) : name_(filename), file_(std::fopen(filename.c_str(), mode)) {
+        if (file_ == nullptr) {
+            throw std::runtime_error(fmt::format("Cannot open {}: {}", filename, std::strerror(errno)));
+        }
+        std::setvbuf(file_, nullptr, _IONBF, 0);
+    }
+    ~File() {
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    void Write(const void* data, size_t bytes) {
+        auto src = reinterpret_cast<const char*>(data);
+        for (size_t done = 0; done < bytes;) {
+            auto n = std::fwrite(src + done, 1, std::min(io_block, bytes - done), file_);
+            if (n == 0) {
+                throw std::runtime_error(fmt::format("Cannot write {}: {}", name_, std::strerror(errno)));
+            }
+            done += n;
+        }
+    }
+
+    void Read(void* data, size_t bytes) {
+        auto des = reinterpret_cast<char*>(data);
+        for (size_t done = 0; done < bytes;) {
+            auto n = std::fread(des + done, 1, std::min(io_block, bytes - done), file_);
+            if (n == 0) {
+                throw std::runtime_error(fmt::format("Unexpected end of checkpoint {}.", name_));
+            }
+            done += n;
+        }
+    }
+
+    void Seek(uint64_t offset) {
+#if defined(_WIN32)
+        auto failed = _fseeki64(file_, static_cast<int64_t>(offset), SEEK_SET) != 0;
+#else
+        auto failed = fseeko(file_, static_cast<off_t>(offset), SEEK_SET) != 0;
+#endif
+        if (failed) {
+            throw std::runtime_error(fmt::format("Cannot seek in {}: {}", name_, std::strerror(errno)));
+        }
+    }
+
+    //! Hint that the file is read once from start to end.
+    void AdviseSequential() {
+#if defined(__linux__)
+        posix_fadvise(fileno(file_), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+    //! Flush the data to the disk, and drop it from the page cache so that a large save does not evict the state.
+    void Sync() {
+        std::fflush(file_);
+#if defined(_WIN32)
+        auto failed = _commit(_fileno(file_)) != 0;
+#else
+        auto failed = fsync(fileno(file_)) != 0;
+#endif
+        if (failed) {
+            throw std::runtime_error(fmt::format("Cannot sync {}: {}", name_, std::strerror(errno)));
+        }
+#if defined(__linux__)
+        posix_fadvise(fileno(file_), 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    }
+
+    void Close() {
+        auto failed = std::fclose(file_) != 0;
+        file_ = nullptr;
+        if (failed) {
+            throw std::runtime_error(fmt::format("Cannot close {}: {}", name_, std::strerror(errno)));
+        }
+    }
+
+ private:
+    std::string name_;
+    std::FILE* file_;
+};
+
+//! Sync the directory of filename, so that a file renamed into it survives a crash. Windows has no directory sync.
+void SyncDirectory(const std::string& filename) {
+#if !defined(_WIN32)
+    auto dir = std::filesystem::path(filename).parent_path();
+    if (dir.empty()) {
+        dir = ".";
+    }
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Cannot open directory {}: {}", dir.string(), std::strerror(errno)));
+    }
+    auto failed = fsync(fd) != 0;
+    auto sync_errno = errno;
+    close(fd);
+    if (failed) {
+        throw std::runtime_error(fmt::format("Cannot sync directory {}: {}", dir.string(), std::strerror(sync_errno)));
+    }
+#endif
+}
+
+template <typename T>
+uint64_t CountKept(const std::complex<T>* data, uint64_t n, double drop_below) {
+    auto th = drop_below * drop_below;
+    uint64_t out = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        out += static_cast<uint64_t>(std::norm(data[i]) > th);
+    }
+    return out;
+}
+
+template <typename T>
+void WriteSparse(File* file, const std::complex<T>* data, uint64_t n, double drop_below) {
+    constexpr size_t record = sizeof(uint64_t) + sizeof(std::complex<T>);
+    auto th = drop_below * drop_below;
+    std::vector<char> staging(sparse_block * record);
+    size_t filled = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        if (std::norm(data[i]) <= th) {
+            continue;
+        }
+        auto dst = staging.data() + filled * record;
+        std::memcpy(dst, &i, sizeof(uint64_t));
+        std::memcpy(dst + sizeof(uint64_t), data + i, sizeof(std::complex<T>));
+        if (++filled == sparse_block) {
+            file->Write(staging.data(), filled * record);
+            filled = 0;
+        }
+    }
+    file->Write(staging.data(), filled * record);
+}
+
+template <typename T>
+void ReadSparse(File* file, std::complex<T>* data, uint64_t n_elements, uint64_t n_stored,
+                const std::string& filename) {
+    constexpr size_t record = sizeof(uint64_t) + sizeof(std::complex<T>);
+    std::fill(data, data + n_elements, std::complex<T>(0));
+    std::vector<char> staging(sparse_block * record);
+    for (uint64_t done = 0; done < n_stored;) {
+        auto n = std::min<uint64_t>(sparse_block, n_stored - done);
+        file->Read(staging.data(), n * record);
+        for (uint64_t k = 0; k < n; ++k) {
+            uint64_t idx;
+            std::memcpy(&idx, staging.data() + k * record, sizeof(uint64_t));
+            if (idx >= n_elements) {
+                throw std::runtime_error(fmt::format("Corrupted checkpoint {}: index {} out of range.", filename, idx));
+            }
+            std::memcpy(data + idx, staging.data() + k * record + sizeof(uint64_t), sizeof(std::complex<T>));
+        }
+        done += n;
+    }
+}
+
+uint64_t PayloadBytes(const Info& info) {
+    if (info.encoding == Encoding::Sparse) {
+        return info.n_stored * (sizeof(uint64_t) + info.element_bytes);
+    }
+    return info.n_elements * info.element_bytes;
+}
+
+void CheckElementBytes(uint64_t element_bytes) {
+    if (element_bytes != sizeof(std::complex<float>) && element_bytes != sizeof(std::complex<double>)) {
+        throw std::invalid_argument(fmt::format("Unsupported element size {} for a checkpoint.", element_bytes));
+    }
+}
+
+std::string_view KindName(Kind kind) {
+    return kind == Kind::Vector ? "state vector" : "density matrix";
+}
+}  // namespace
+
+void Save(const std::string& filename, Info info, const void* data, double drop_below) {
+    CheckElementBytes(info.element_bytes);
+    bool single = info.element_bytes == sizeof(std::complex<float>);
+    info.encoding = Encoding::Dense;
+    info.n_stored = info.n_elements;
+    if (drop_below >= 0) {
+        auto kept = single
+                        ? CountKept(reinterpret_cast<const std::complex<float>*>(data), info.n_elements, drop_below)
+                        : CountKept(reinterpret_cast<const std::complex<double>*>(data), info.n_elements, drop_below);
+        if (kept * (sizeof(uint64_t) + info.element_bytes) < info.n_elements * info.element_bytes) {
+            info.encoding = Encoding::Sparse;
+            info.n_stored = kept;
+        }
+    }
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.kind = static_cast<uint32_t>(info.kind);
+    header.dtype = static_cast<uint32_t>(info.dtype);
+    header.n_qubits = static_cast<uint32_t>(info.n_qubits);
+    header.seed = info.seed;
+    header.encoding = static_cast<uint32_t>(info.encoding);
+    header.n_elements = info.n_elements;
+    header.element_bytes = info.element_bytes;
+    header.n_stored = info.n_stored;
+    header.rng_bytes = info.rng_state.size();
+
+    auto partial = filename + ".partial";
+    try {
+        File file(partial, "wb");
+        file.Write(&header, sizeof(header));
+        file.Write(info.rng_state.data(), info.rng_state.size());
+        if (info.encoding == Encoding::Dense) {
+            file.Write(data, PayloadBytes(info));
+        } else if (single) {
+            WriteSparse(&file, reinterpret_cast<const std::complex<float>*>(data), info.n_elements, drop_below);
+        } else {
+            WriteSparse(&file, reinterpret_cast<const std::complex<double>*>(data), info.n_elements, drop_below);
+        }
+        file.Sync();
+        file.Close();
+    } catch (...) {
+        std::remove(partial.c_str());
+        throw;
+    }
+    std::error_code err;
+    std::filesystem::rename(partial, filename, err);
+    if (err) {
+        std::remove(partial.c_str());
+        throw std::runtime_error(fmt::format("Cannot replace {}: {}", filename, err.message()));
+    }
+    SyncDirectory(filename);
+}
+
+Info ReadInfo(const std::string& filename) {
+    File file(filename, "rb");
+    Header header{};
+    file.Read(&header, sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+        throw std::invalid_argument(fmt::format("{} is not a MindQuantum checkpoint.", filename));
+    }
+    if (header.version != version) {
+        throw std::invalid_argument(
+            fmt::format("Checkpoint {} has format version {}, only version {} is supported.", filename,
+                        header.version, version));
+    }
+    if (header.kind > static_cast<uint32_t>(Kind::DensityMatrix)
+        || header.encoding > static_cast<uint32_t>(Encoding::Sparse)) {
+        throw std::invalid_argument(fmt::format("Corrupted checkpoint {}: unknown kind or encoding.", filename));
+    }
+    Info info;
+    info.kind = static_cast<Kind>(header.kind);
+    info.dtype = static_cast<tensor::TDtype>(header.dtype);
+    info.n_qubits = static_cast<qbit_t>(header.n_qubits);
+    info.seed = header.seed;
+    info.encoding = static_cast<Encoding>(header.encoding);
+    info.n_elements = header.n_elements;
+    info.element_bytes = header.element_bytes;
+    info.n_stored = header.n_stored;
+    CheckElementBytes(info.element_bytes);
+    info.rng_state.resize(header.rng_bytes);
+    file.Read(info.rng_state.data(), info.rng_state.size());
+
+    // A truncated file means the checkpoint was copied or written by other means and did not complete.
+    auto expected = sizeof(header) + header.rng_bytes + PayloadBytes(info);
+    auto actual = std::filesystem::file_size(filename);
+    if (actual != expected) {
+        throw std::runtime_error(
+            fmt::format("Checkpoint {} has {} bytes, {} bytes expected.", filename, actual, expected));
+    }
+    return info;
+}
+
+Info Load(const std::string& filename, const Info& info, void* data) {
+    auto saved = ReadInfo(filename);
+    if (saved.kind != info.kind) {
+        throw std::invalid_argument(fmt::format("Checkpoint {} holds a {}, not a {}.", filename,
+                                                KindName(saved.kind), KindName(info.kind)));
+    }
+    if (saved.dtype != info.dtype || saved.element_bytes != info.element_bytes) {
+        throw std::invalid_argument(fmt::format("Checkpoint {} was saved by a simulator of another dtype.", filename));
+    }
+    if (saved.n_qubits != info.n_qubits || saved.n_elements != info.n_elements) {
+        throw std::invalid_argument(fmt::format("Checkpoint {} has {} qubits, but the simulator has {} qubits.",
+                                                filename, saved.n_qubits, info.n_qubits));
+    }
+    File file(filename, "rb");
+    file.AdviseSequential();
+    file.Seek(sizeof(Header) + saved.rng_state.size());
+    if (saved.encoding == Encoding::Dense) {
+        file.Read(data, PayloadBytes(saved));
+    } else if (saved.element_bytes == sizeof(std::complex<float>)) {
+        ReadSparse(&file, reinterpret_cast<std::complex<float>*>(data), saved.n_elements, saved.n_stored, filename);
+    } else {
+        ReadSparse(&file, reinterpret_cast<std::complex<double>*>(data), saved.n_elements, saved.n_stored, filename);
+    }
+    return saved;
+}
+}  // namespace mindquantum::sim::checkpoint
@@ -16,6 +16,7 @@
 #include <stdexcept>
 
 #include "config/openmp.h"
+#include "core/memory_manager.h"
 #include "core/utils.h"
 #include "math/pr/parameter_resolver.h"
 #include "simulator/utils.h"
@@ -32,7 +33,8 @@ namespace mindquantum::sim::densitymatrix::detail {
 template <typename derived_, typename calc_type_>
 auto CPUDensityMatrixPolicyBase<derived_, calc_type_>::InitState(index_t dim, bool zero_state) -> qs_data_p_t {
     index_t n_elements = (dim * dim + dim) / 2;
-    auto qs = reinterpret_cast<qs_data_p_t>(calloc(n_elements, sizeof(qs_data_t)));
+    auto qs = reinterpret_cast<qs_data_p_t>(
+        memory::Allocate(n_elements * sizeof(qs_data_t), memory::Category::DensityMatrix, true));
     if (zero_state) {
         qs[0] = 1;
     }
@@ -48,7 +50,7 @@ template <typename derived_, typename calc_type_>
 void CPUDensityMatrixPolicyBase<derived_, calc_type_>::FreeState(qs_data_p_t* qs_p) {
     auto& qs = (*qs_p);
     if (qs != nullptr) {
-        free(qs);
+        memory::Free(qs);
         qs = nullptr;
     }
 }
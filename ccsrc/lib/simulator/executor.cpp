@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/executor.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#    include <omp.h>
+#endif  // _OPENMP
+
+namespace mindquantum::sim {
+TaskState TaskBase::State() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+}
+
+bool TaskBase::Done() const {
+    auto state = State();
+    return state == TaskState::Finished || state == TaskState::Cancelled;
+}
+
+bool TaskBase::Cancel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state_ != TaskState::Pending) {
+            return state_ == TaskState::Cancelled;
+        }
+        state_ = TaskState::Cancelled;
+    }
+    NotifyDone();
+    return true;
+}
+
+void TaskBase::Wait() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] { return state_ == TaskState::Finished || state_ == TaskState::Cancelled; });
+}
+
+void TaskBase::Get() const {
+    Wait();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ == TaskState::Cancelled) {
+        throw std::runtime_error("Task has been cancelled.");
+    }
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void TaskBase::AddDoneCallback(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state_ != TaskState::Finished && state_ != TaskState::Cancelled) {
+            callbacks_.push_back(std::move(fn));
+            return;
+        }
+    }
+    fn();
+}
+
+void TaskBase::Run() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state_ != TaskState::Pending) {
+            return;
+        }
+        state_ = TaskState::Running;
+    }
+    std::exception_ptr error = nullptr;
+    try {
+        Execute();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    Finish(TaskState::Finished, error);
+}
+
+void TaskBase::Finish(TaskState state, std::exception_ptr error) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        state_ = state;
+        error_ = error;
+    }
+    NotifyDone();
+}
+
+void TaskBase::NotifyDone() {
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbacks.swap(callbacks_);
+    }
+    cv_.notify_all();
+    for (auto& fn : callbacks) {
+        fn();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+Executor::Executor(size_t n_workers, size_t max_queue) : n_workers_(n_workers), max_queue_(max_queue) {
+    if (n_workers == 0) {
+        throw std::invalid_argument("Executor requires at least one worker.");
+    }
+    if (max_queue == 0) {
+        throw std::invalid_argument("Executor requires a queue depth of at least one.");
+    }
+#ifdef _OPENMP
+    omp_threads_ = omp_get_max_threads();
+#endif  // _OPENMP
+    workers_.reserve(n_workers);
+    for (size_t i = 0; i < n_workers; ++i) {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+Executor::~Executor() {
+    std::deque<std::shared_ptr<TaskBase>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        pending.swap(queue_);
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+    for (auto& task : pending) {
+        task->Cancel();
+    }
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+Executor& Executor::Global() {
+    static Executor executor(std::max(1U, std::thread::hardware_concurrency()),
+                             4 * std::max(1U, std::thread::hardware_concurrency()));
+    return executor;
+}
+
+void Executor::Submit(const std::shared_ptr<TaskBase>& task) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [&] { return stop_ || queue_.size() < max_queue_; });
+    if (stop_) {
+        throw std::runtime_error("Executor has been shut down.");
+    }
+    queue_.push_back(task);
+    lock.unlock();
+    not_empty_.notify_one();
+}
+
+size_t Executor::Workers() const {
+    return n_workers_;
+}
+
+size_t Executor::MaxQueue() const {
+    return max_queue_;
+}
+
+size_t Executor::Pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void Executor::WorkerLoop() {
+    while (true) {
+        std::shared_ptr<TaskBase> task;
+        size_t in_flight = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+            if (stop_) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+            running_ += 1;
+            in_flight = std::min(n_workers_, running_ + queue_.size());
+        }
+        not_full_.notify_one();
+#ifdef _OPENMP
+        omp_set_num_threads(std::max(1, omp_threads_ / static_cast<int>(in_flight)));
+#endif  // _OPENMP
+        task->Run();
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ -= 1;
+    }
+}
+}  // namespace mindquantum::sim
@@ -0,0 +1,516 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/mps/mps_state.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include <Eigen/QR>
+#include <Eigen/SVD>
+#include <fmt/format.h>
+
+#include "core/trace.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+#include "ops/gate_id.h"
+#include "ops/gates.h"
+
+namespace mindquantum::sim::mps {
+namespace {
+using matrix_t = MPSState::matrix_t;
+using py_qs_data_t = MPSState::py_qs_data_t;
+
+//! Element <row|P|col> of a single qubit Pauli matrix.
+py_qs_data_t PauliElement(char pauli, index_t row, index_t col) {
+    switch (pauli) {
+        case 'X':
+            return row != col ? 1 : 0;
+        case 'Y':
+            return row == col ? py_qs_data_t(0) : (row == 0 ? py_qs_data_t(0, -1) : py_qs_data_t(0, 1));
+        case 'Z':
+            return row != col ? 0 : (row == 0 ? 1 : -1);
+        default:
+            return row == col ? 1 : 0;
+    }
+}
+
+//! Product of paulis[j] acting on bit j of the local index.
+matrix_t PauliMatrix(const std::vector<char>& paulis) {
+    auto dim = index_t(1) << paulis.size();
+    matrix_t out(dim, dim);
+    for (index_t row = 0; row < dim; ++row) {
+        for (index_t col = 0; col < dim; ++col) {
+            py_qs_data_t elem = 1;
+            for (size_t j = 0; j < paulis.size(); ++j) {
+                elem *= PauliElement(paulis[j], (row >> j) & 1, (col >> j) & 1);
+            }
+            out(row, col) = elem;
+        }
+    }
+    return out;
+}
+
+//! exp(-i theta/2 P).
+matrix_t PauliRotation(const std::vector<char>& paulis, double theta) {
+    auto dim = index_t(1) << paulis.size();
+    return std::cos(theta / 2) * matrix_t::Identity(dim, dim)
+           + py_qs_data_t(0, -std::sin(theta / 2)) * PauliMatrix(paulis);
+}
+
+matrix_t ToEigen(const tensor::Matrix& m) {
+    auto vec = tensor::ops::cpu::to_vector<py_qs_data_t>(m);
+    matrix_t out(vec.size(), vec.size());
+    for (size_t i = 0; i < vec.size(); ++i) {
+        for (size_t j = 0; j < vec.size(); ++j) {
+            out(i, j) = vec[i][j];
+        }
+    }
+    return out;
+}
+
+double Angle(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr) {
+    auto g = static_cast<Parameterizable*>(gate.get());
+    return tensor::ops::cpu::to_vector<double>(g->prs_[0].Combination(pr).const_value)[0];
+}
+}  // namespace
+
+MPSState::MPSState(qbit_t n_qubits, unsigned seed) : n_qubits_(n_qubits), seed_(seed), rnd_eng_(seed) {
+    if (n_qubits < 1) {
+        throw std::invalid_argument("MPS simulator needs at least one qubit.");
+    }
+    Reset();
+}
+
+void MPSState::Reset() {
+    site_t zero = {matrix_t::Ones(1, 1), matrix_t::Zero(1, 1)};
+    sites_.assign(n_qubits_, zero);
+    center_ = 0;
+    discarded_ = 0;
+    rnd_eng_.seed(seed_);
+}
+
+void MPSState::SetMaxBond(index_t max_bond) {
+    if (max_bond < 1) {
+        throw std::invalid_argument("Max bond dimension should be positive.");
+    }
+    max_bond_ = max_bond;
+}
+
+void MPSState::SetTruncationThreshold(double threshold) {
+    if (threshold < 0 || threshold >= 1) {
+        throw std::invalid_argument(fmt::format("Truncation threshold should be in [0, 1), but get {}.", threshold));
+    }
+    truncation_ = threshold;
+}
+
+auto MPSState::GateMatrix(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr,
+                          const std::string& backend) -> matrix_t {
+    const auto& objs = gate->obj_qubits_;
+    auto id = gate->id_;
+    matrix_t m;
+    switch (id) {
+        case GateID::X:
+        case GateID::Y:
+        case GateID::Z: {
+            return PauliMatrix({id == GateID::X ? 'X' : (id == GateID::Y ? 'Y' : 'Z')});
+        }
+        case GateID::H:
+            m = matrix_t::Constant(2, 2, M_SQRT1_2);
+            m(1, 1) = -M_SQRT1_2;
+            return m;
+        case GateID::S:
+        case GateID::Sdag:
+        case GateID::T:
+        case GateID::Tdag:
+        case GateID::PS: {
+            double phase = id == GateID::S      ? M_PI_2
+                           : id == GateID::Sdag ? -M_PI_2
+                           : id == GateID::T    ? M_PI / 4
+                           : id == GateID::Tdag ? -M_PI / 4
+                                                : Angle(gate, pr);
+            m = matrix_t::Identity(2, 2);
+            m(1, 1) = std::polar(1.0, phase);
+            return m;
+        }
+        case GateID::GP:
+            return std::polar(1.0, -Angle(gate, pr)) * matrix_t::Identity(2, 2);
+        case GateID::SWAP:
+        case GateID::ISWAP: {
+            py_qs_data_t phase = 1;
+            if (id == GateID::ISWAP) {
+                phase = static_cast<ISWAPGate*>(gate.get())->daggered_ ? py_qs_data_t(0, -1) : py_qs_data_t(0, 1);
+            }
+            m = matrix_t::Zero(4, 4);
+            m(0, 0) = m(3, 3) = 1;
+            m(1, 2) = m(2, 1) = phase;
+            return m;
+        }
+        case GateID::RX:
+            return PauliRotation({'X'}, Angle(gate, pr));
+        case GateID::RY:
+            return PauliRotation({'Y'}, Angle(gate, pr));
+        case GateID::RZ:
+            return PauliRotation({'Z'}, Angle(gate, pr));
+        case GateID::Rxx:
+            return PauliRotation({'X', 'X'}, Angle(gate, pr));
+        case GateID::Ryy:
+            return PauliRotation({'Y', 'Y'}, Angle(gate, pr));
+        case GateID::Rzz:
+            return PauliRotation({'Z', 'Z'}, Angle(gate, pr));
+        case GateID::Rxy:
+        case GateID::Rxz:
+        case GateID::Ryz: {
+            // As in the vector kernels, the first Pauli of the name acts on the lower qubit.
+            auto names = id == GateID::Rxy ? "XY" : (id == GateID::Rxz ? "XZ" : "YZ");
+            bool swapped = objs[0] > objs[1];
+            return PauliRotation({names[swapped ? 1 : 0], names[swapped ? 0 : 1]}, Angle(gate, pr));
+        }
+        case GateID::RPS: {
+            const auto& paulis = static_cast<RotPauliStringGate*>(gate.get())->paulis_;
+            return PauliRotation(std::vector<char>(paulis.begin(), paulis.end()), Angle(gate, pr));
+        }
+        case GateID::U3: {
+            auto u3 = static_cast<U3*>(gate.get());
+            if (!u3->Parameterized()) {
+                return ToEigen(u3->base_matrix_);
+            }
+            return ToEigen(U3Matrix(u3->theta.Combination(pr).const_value, u3->phi.Combination(pr).const_value,
+                                    u3->lambda.Combination(pr).const_value));
+        }
+        case GateID::FSim: {
+            auto fsim = static_cast<FSim*>(gate.get());
+            if (!fsim->Parameterized()) {
+                return ToEigen(fsim->base_matrix_);
+            }
+            return ToEigen(FSimMatrix(fsim->theta.Combination(pr).const_value, fsim->phi.Combination(pr).const_value));
+        }
+        case GateID::CUSTOM: {
+            auto g = static_cast<CustomGate*>(gate.get());
+            return ToEigen(g->Parameterized() ? g->numba_param_matrix_(Angle(gate, pr)) : g->base_matrix_);
+        }
+        default:
+            throw std::invalid_argument(fmt::format("Gate {} is not supported by the {} simulator.", id, backend));
+    }
+}
+
+index_t MPSState::ApplyGate(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr) {
+    for (const auto* qubits : {&gate->obj_qubits_, &gate->ctrl_qubits_}) {
+        for (auto q : *qubits) {
+            if (q >= n_qubits_) {
+                throw std::invalid_argument(fmt::format("Qubit {} out of range of {} qubits.", q, n_qubits_));
+            }
+        }
+    }
+    if (gate->id_ == GateID::M) {
+        return Measure(gate->obj_qubits_[0]);
+    }
+    if (gate->id_ == GateID::I) {
+        return 2;
+    }
+    auto m = GateMatrix(gate, pr);
+    qbits_t qubits = gate->obj_qubits_;
+    if (!gate->ctrl_qubits_.empty()) {
+        // The controls are the high bits, the gate acts when they are all set.
+        qubits.insert(qubits.end(), gate->ctrl_qubits_.begin(), gate->ctrl_qubits_.end());
+        auto dim = index_t(1) << qubits.size();
+        matrix_t full = matrix_t::Identity(dim, dim);
+        full.bottomRightCorner(m.rows(), m.cols()) = m;
+        m = std::move(full);
+    }
+    ApplyMatrix(qubits, m);
+    return 2;
+}
+
+std::map<std::string, int> MPSState::ApplyCircuit(const circuit_t& circ, const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("MPSApplyCircuit", "simulator");
+    std::map<std::string, int> result;
+    for (auto& gate : circ) {
+        if (gate->id_ == GateID::M) {
+            result[static_cast<MeasureGate*>(gate.get())->name_] = ApplyGate(gate, pr);
+        } else {
+            ApplyGate(gate, pr);
+        }
+    }
+    return result;
+}
+
+void MPSState::ApplyMatrix(const qbits_t& qubits, const matrix_t& m) {
+    auto k = static_cast<qbit_t>(qubits.size());
+    if (k == 1) {
+        auto& site = sites_[qubits[0]];
+        site_t out = {m(0, 0) * site[0] + m(0, 1) * site[1], m(1, 0) * site[0] + m(1, 1) * site[1]};
+        site = std::move(out);
+        return;
+    }
+    // Move the qubits next to the lowest one, qubit order[r] ends on site first + r.
+    auto order = qubits;
+    std::sort(order.begin(), order.end());
+    auto first = order[0];
+    std::vector<qbit_t> swaps;
+    for (qbit_t r = 1; r < k; ++r) {
+        for (auto site = order[r] - 1; site >= first + r; --site) {
+            SwapSites(site);
+            swaps.push_back(site);
+        }
+    }
+    // Bit j of the gate matrix becomes bit rank(qubits[j]) of the block.
+    std::vector<index_t> rank(k);
+    for (qbit_t j = 0; j < k; ++j) {
+        rank[j] = std::lower_bound(order.begin(), order.end(), qubits[j]) - order.begin();
+    }
+    auto dim = index_t(1) << k;
+    std::vector<index_t> to_block(dim, 0);
+    for (index_t idx = 0; idx < dim; ++idx) {
+        for (qbit_t j = 0; j < k; ++j) {
+            to_block[idx] |= ((idx >> j) & 1) << rank[j];
+        }
+    }
+    matrix_t block(dim, dim);
+    for (index_t row = 0; row < dim; ++row) {
+        for (index_t col = 0; col < dim; ++col) {
+            block(to_block[row], to_block[col]) = m(row, col);
+        }
+    }
+    ApplyBlock(first, k, block);
+    for (auto it = swaps.rbegin(); it != swaps.rend(); ++it) {
+        SwapSites(*it);
+    }
+}
+
+void MPSState::SwapSites(qbit_t site) {
+    matrix_t swap = matrix_t::Zero(4, 4);
+    swap(0, 0) = swap(1, 2) = swap(2, 1) = swap(3, 3) = 1;
+    ApplyBlock(site, 2, swap);
+}
+
+void MPSState::ApplyBlock(qbit_t first, qbit_t k, const matrix_t& m) {
+    MoveCenter(first);
+    auto dim = index_t(1) << k;
+    // Contract the sites, bit r of the index is the bit of site first + r.
+    std::vector<matrix_t> theta = {sites_[first][0], sites_[first][1]};
+    for (qbit_t r = 1; r < k; ++r) {
+        std::vector<matrix_t> next(index_t(2) << r);
+        for (index_t idx = 0; idx < theta.size(); ++idx) {
+            next[idx] = theta[idx] * sites_[first + r][0];
+            next[idx | (index_t(1) << r)] = theta[idx] * sites_[first + r][1];
+        }
+        theta = std::move(next);
+    }
+    std::vector<matrix_t> applied(dim, matrix_t::Zero(theta[0].rows(), theta[0].cols()));
+    for (index_t row = 0; row < dim; ++row) {
+        for (index_t col = 0; col < dim; ++col) {
+            if (m(row, col) != py_qs_data_t(0)) {
+                applied[row] += m(row, col) * theta[col];
+            }
+        }
+    }
+    theta = std::move(applied);
+    // Split off one site at a time from the left, the remainder carries the singular values.
+    for (qbit_t r = 0; r + 1 < k; ++r) {
+        auto chi_l = theta[0].rows();
+        auto chi_r = theta[0].cols();
+        auto n_rest = static_cast<index_t>(theta.size() / 2);
+        matrix_t mat(2 * chi_l, n_rest * chi_r);
+        for (index_t rest = 0; rest < n_rest; ++rest) {
+            for (index_t b = 0; b < 2; ++b) {
+                mat.block(b * chi_l, rest * chi_r, chi_l, chi_r) = theta[b | (rest << 1)];
+            }
+        }
+        Eigen::BDCSVD<matrix_t> svd(mat, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        const auto& sv = svd.singularValues();
+        double total = sv.squaredNorm();
+        // Keep the fewest singular values whose dropped tail is within the threshold.
+        Eigen::Index keep = sv.size();
+        double tail = 0;
+        while (keep > 1 && tail + sv(keep - 1) * sv(keep - 1) <= truncation_ * total) {
+            keep -= 1;
+            tail += sv(keep) * sv(keep);
+        }
+        while (keep > static_cast<Eigen::Index>(max_bond_)) {
+            keep -= 1;
+            tail += sv(keep) * sv(keep);
+        }
+        if (total > 0) {
+            discarded_ += tail / total;
+        }
+        double renorm = tail > 0 ? std::sqrt(total / (total - tail)) : 1;
+        matrix_t u = svd.matrixU().leftCols(keep);
+        matrix_t sv_dag = (renorm * sv.head(keep)).asDiagonal() * svd.matrixV().leftCols(keep).adjoint();
+        sites_[first + r][0] = u.topRows(chi_l);
+        sites_[first + r][1] = u.bottomRows(chi_l);
+        std::vector<matrix_t> rest(n_rest);
+        for (index_t idx = 0; idx < n_rest; ++idx) {
+            rest[idx] = sv_dag.middleCols(idx * chi_r, chi_r);
+        }
+        theta = std::move(rest);
+    }
+    sites_[first + k - 1] = {theta[0], theta[1]};
+    center_ = first + k - 1;
+}
+
+void MPSState::MoveCenter(qbit_t site) {
+    while (center_ < site) {
+        auto& a = sites_[center_];
+        auto chi_l = a[0].rows();
+        auto chi_r = a[0].cols();
+        matrix_t mat(2 * chi_l, chi_r);
+        mat << a[0], a[1];
+        Eigen::HouseholderQR<matrix_t> qr(mat);
+        auto k = std::min(2 * chi_l, chi_r);
+        matrix_t q = qr.householderQ() * matrix_t::Identity(2 * chi_l, k);
+        matrix_t r = qr.matrixQR().topRows(k).triangularView<Eigen::Upper>();
+        a[0] = q.topRows(chi_l);
+        a[1] = q.bottomRows(chi_l);
+        for (auto& next : sites_[center_ + 1]) {
+            next = r * next;
+        }
+        center_ += 1;
+    }
+    while (center_ > site) {
+        auto& a = sites_[center_];
+        auto chi_l = a[0].rows();
+        auto chi_r = a[0].cols();
+        matrix_t mat(chi_l, 2 * chi_r);
+        mat << a[0], a[1];
+        // mat = r^dagger q^dagger from the QR decomposition of its adjoint.
+        Eigen::HouseholderQR<matrix_t> qr(mat.adjoint());
+        auto k = std::min(2 * chi_r, chi_l);
+        matrix_t q = qr.householderQ() * matrix_t::Identity(2 * chi_r, k);
+        matrix_t r = qr.matrixQR().topRows(k).triangularView<Eigen::Upper>();
+        matrix_t q_dag = q.adjoint();
+        a[0] = q_dag.leftCols(chi_r);
+        a[1] = q_dag.rightCols(chi_r);
+        for (auto& prev : sites_[center_ - 1]) {
+            prev = prev * r.adjoint();
+        }
+        center_ -= 1;
+    }
+}
+
+index_t MPSState::Measure(qbit_t qubit) {
+    MoveCenter(qubit);
+    auto& site = sites_[qubit];
+    double one_amp = site[1].squaredNorm();
+    double total = one_amp + site[0].squaredNorm();
+    std::uniform_real_distribution<double> dist(0., 1.);
+    index_t result = dist(rnd_eng_) * total < one_amp ? 1 : 0;
+    double prob = result == 1 ? one_amp : total - one_amp;
+    site[1 - result].setZero();
+    site[result] /= std::sqrt(prob);
+    return result;
+}
+
+auto MPSState::GetExpectation(const Hamiltonian<calc_type>& ham) const -> py_qs_data_t {
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("MPS simulator needs a Hamiltonian given as Pauli terms.");
+    }
+    py_qs_data_t out = 0;
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        std::vector<char> paulis(n_qubits_, 'I');
+        qbit_t first = center_;
+        qbit_t last = center_;
+        for (const auto& [qubit, pauli] : pauli_string) {
+            if (qubit >= static_cast<Index>(n_qubits_)) {
+                throw std::invalid_argument(fmt::format("Hamiltonian acts on qubit {} out of range.", qubit));
+            }
+            paulis[qubit] = pauli;
+            first = std::min(first, static_cast<qbit_t>(qubit));
+            last = std::max(last, static_cast<qbit_t>(qubit));
+        }
+        // Sites left of first are left isometries and sites right of last right isometries, their environments are
+        // identities.
+        auto chi = sites_[first][0].rows();
+        matrix_t env = matrix_t::Identity(chi, chi);
+        for (auto site = first; site <= last; ++site) {
+            const auto& a = sites_[site];
+            matrix_t next = matrix_t::Zero(a[0].cols(), a[0].cols());
+            for (index_t s = 0; s < 2; ++s) {
+                for (index_t t = 0; t < 2; ++t) {
+                    auto elem = PauliElement(paulis[site], s, t);
+                    if (elem != py_qs_data_t(0)) {
+                        next += elem * a[s].adjoint() * env * a[t];
+                    }
+                }
+            }
+            env = std::move(next);
+        }
+        out += env.trace() * coeff;
+    }
+    return out;
+}
+
+auto MPSState::GetAmplitude(const VT<uint8_t>& bits) const -> py_qs_data_t {
+    if (bits.size() != static_cast<size_t>(n_qubits_)) {
+        throw std::invalid_argument(fmt::format("Need {} bits, but get {}.", n_qubits_, bits.size()));
+    }
+    matrix_t row = matrix_t::Ones(1, 1);
+    for (qbit_t i = 0; i < n_qubits_; ++i) {
+        row = row * sites_[i][bits[i] & 1];
+    }
+    return row(0, 0);
+}
+
+auto MPSState::GetQS() const -> VT<py_qs_data_t> {
+    if (n_qubits_ > 30) {
+        throw std::runtime_error(fmt::format("Cannot get full state of {} qubits.", n_qubits_));
+    }
+    std::vector<matrix_t> rows = {matrix_t::Ones(1, 1)};
+    for (qbit_t i = 0; i < n_qubits_; ++i) {
+        std::vector<matrix_t> next(rows.size() * 2);
+        for (index_t idx = 0; idx < rows.size(); ++idx) {
+            next[idx] = rows[idx] * sites_[i][0];
+            next[idx | (index_t(1) << i)] = rows[idx] * sites_[i][1];
+        }
+        rows = std::move(next);
+    }
+    VT<py_qs_data_t> out(rows.size());
+    for (index_t idx = 0; idx < rows.size(); ++idx) {
+        out[idx] = rows[idx](0, 0);
+    }
+    return out;
+}
+
+VT<index_t> MPSState::GetBondDims() const {
+    VT<index_t> out;
+    for (qbit_t i = 0; i + 1 < n_qubits_; ++i) {
+        out.push_back(sites_[i][0].cols());
+    }
+    return out;
+}
+
+VT<unsigned> MPSState::Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr, size_t shots,
+                                const MST<size_t>& key_map, unsigned seed) const {
+    MQ_TRACE_SCOPE("MPSSampling", "simulator");
+    auto key_size = key_map.size();
+    VT<unsigned> res(shots * key_size);
+    std::mt19937 rnd_eng(seed);
+    std::uniform_real_distribution<double> dist(1.0, (1 << 20) * 1.0);
+    std::function<double()> rng = std::bind(dist, std::ref(rnd_eng));
+    for (size_t i = 0; i < shots; i++) {
+        auto sim = *this;
+        sim.rnd_eng_.seed(static_cast<unsigned>(rng()));
+        auto res0 = sim.ApplyCircuit(circ, pr);
+        for (const auto& [name, val] : key_map) {
+            res[i * key_size + val] = res0[name];
+        }
+    }
+    return res;
+}
+}  // namespace mindquantum::sim::mps
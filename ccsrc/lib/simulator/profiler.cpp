@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/profiler.h"
+
+#include <chrono>
+
+namespace mindquantum::profiler {
+std::string_view PhaseName(Phase phase) {
+    switch (phase) {
+        case Phase::ApplyGate:
+            return "apply_gate";
+        case Phase::ApplyChannel:
+            return "apply_channel";
+        case Phase::Expectation:
+            return "expectation";
+        case Phase::Gradient:
+            return "gradient";
+        case Phase::ParameterResolve:
+            return "parameter_resolve";
+        case Phase::Jacobian:
+            return "jacobian";
+    }
+    return "unknown";
+}
+
+Profiler& Profiler::Instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+auto Profiler::Local() -> LocalTable& {
+    // The registry keeps the table alive after the thread exits, so its records still show up in the report.
+    thread_local std::shared_ptr<LocalTable> table = [this]() {
+        auto out = std::make_shared<LocalTable>();
+        std::lock_guard<std::mutex> lock(mutex_);
+        tables_.push_back(out);
+        return out;
+    }();
+    return *table;
+}
+
+void Profiler::Add(Phase phase, GateID gate, qbit_t n_qubits, uint64_t time_ns, uint64_t bytes) {
+    auto& table = Local();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto& stat = table.data[{phase, gate, n_qubits}];
+    stat.calls += 1;
+    stat.time_ns += time_ns;
+    stat.bytes += bytes;
+}
+
+std::vector<Entry> Profiler::Report() const {
+    std::map<key_t, Stat> merged;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& table : tables_) {
+            std::lock_guard<std::mutex> table_lock(table->mutex);
+            for (auto& [key, stat] : table->data) {
+                auto& out = merged[key];
+                out.calls += stat.calls;
+                out.time_ns += stat.time_ns;
+                out.bytes += stat.bytes;
+            }
+        }
+    }
+    std::vector<Entry> out;
+    out.reserve(merged.size());
+    for (auto& [key, stat] : merged) {
+        out.push_back({std::get<0>(key), std::get<1>(key), std::get<2>(key), stat});
+    }
+    return out;
+}
+
+void Profiler::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& table : tables_) {
+        std::lock_guard<std::mutex> table_lock(table->mutex);
+        table->data.clear();
+    }
+}
+
+ProfileScope::~ProfileScope() {
+    auto time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timer::NOW() - start_).count();
+    Profiler::Instance().Add(phase_, gate_, n_qubits_, static_cast<uint64_t>(time_ns), bytes_);
+}
+}  // namespace mindquantum::profiler
@@ -0,0 +1,278 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/shadow/classical_shadow.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <bitset>
+#include <numeric>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "config/openmp.h"
+#include "core/trace.h"
+#include "core/utils.h"
+
+namespace mindquantum::sim::shadow {
+namespace {
+constexpr uint8_t basis_x = 0;
+constexpr uint8_t basis_y = 1;
+constexpr uint8_t basis_z = 2;
+
+//! Amplitude of outcome o of the qubit measured in a basis, from its amplitudes a0 and a1 for |0> and |1>.
+inline amp_t Rotate(uint8_t basis, int o, const amp_t& a0, const amp_t& a1) {
+    constexpr double inv_sqrt2 = M_SQRT1_2;
+    switch (basis) {
+        case basis_x:
+            return (o == 0 ? a0 + a1 : a0 - a1) * inv_sqrt2;
+        case basis_y:
+            // Eigenvectors (|0> + i|1>) / sqrt(2) and (|0> - i|1>) / sqrt(2).
+            return (o == 0 ? a0 - amp_t(0, 1) * a1 : a0 + amp_t(0, 1) * a1) * inv_sqrt2;
+        default:
+            return o == 0 ? a0 : a1;
+    }
+}
+
+double Median(VT<double> values) {
+    auto mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    if (values.size() % 2 == 1) {
+        return values[mid];
+    }
+    return (values[mid] + *std::max_element(values.begin(), values.begin() + mid)) / 2;
+}
+}  // namespace
+
+ClassicalShadow::ClassicalShadow(qbit_t n_qubits, unsigned seed)
+    : n_qubits_(n_qubits), n_words_(stabilizer::NWords(n_qubits)), rnd_eng_(seed) {
+    if (n_qubits <= 0) {
+        throw std::invalid_argument("Classical shadow needs at least one qubit.");
+    }
+}
+
+void ClassicalShadow::Clear() {
+    n_snapshots_ = 0;
+    basis_x_.clear();
+    basis_z_.clear();
+    outcomes_.clear();
+}
+
+void ClassicalShadow::Sample(const VT<amp_t>& qs, index_t n_snapshots) {
+    MQ_TRACE_SCOPE("ClassicalShadowSample", "simulator");
+    if (qs.size() != (index_t(1) << n_qubits_)) {
+        throw std::invalid_argument(
+            fmt::format("State should have {} amplitudes, but get {}.", index_t(1) << n_qubits_, qs.size()));
+    }
+    auto norm = std::accumulate(qs.begin(), qs.end(), 0.0, [](double s, const amp_t& a) { return s + std::norm(a); });
+    if (norm == 0) {
+        throw std::invalid_argument("Can not sample snapshots of a zero state.");
+    }
+    auto first = n_snapshots_;
+    n_snapshots_ += n_snapshots;
+    basis_x_.resize(n_snapshots_ * n_words_, 0);
+    basis_z_.resize(n_snapshots_ * n_words_, 0);
+    outcomes_.resize(n_snapshots_ * n_words_, 0);
+    std::uniform_int_distribution<int> pick_basis(basis_x, basis_z);
+    for (index_t s = first; s < n_snapshots_; ++s) {
+        for (qbit_t q = 0; q < n_qubits_; ++q) {
+            auto basis = pick_basis(rnd_eng_);
+            auto bit = word_t(1) << (q % stabilizer::word_bits);
+            auto w = s * n_words_ + q / stabilizer::word_bits;
+            if (basis != basis_z) {
+                basis_x_[w] |= bit;
+            }
+            if (basis != basis_x) {
+                basis_z_[w] |= bit;
+            }
+        }
+    }
+    VT<index_t> ids(n_snapshots);
+    std::iota(ids.begin(), ids.end(), first);
+    SampleNode(qs, 0, ids.data(), ids.data() + ids.size());
+}
+
+void ClassicalShadow::SampleNode(const VT<amp_t>& amp, qbit_t qubit, index_t* begin, index_t* end) {
+    if (qubit == n_qubits_ || begin == end) {
+        return;
+    }
+    auto half = amp.size() / 2;
+    auto basis_of = [&](index_t s) -> uint8_t {
+        if (!Bit(basis_x_, s, qubit)) {
+            return basis_z;
+        }
+        return Bit(basis_z_, s, qubit) ? basis_y : basis_x;
+    };
+    auto z_end = std::partition(begin, end, [&](index_t s) { return basis_of(s) == basis_z; });
+    auto x_end = std::partition(z_end, end, [&](index_t s) { return basis_of(s) == basis_x; });
+    std::pair<index_t*, index_t*> groups[] = {{z_end, x_end}, {x_end, end}, {begin, z_end}};
+    std::uniform_real_distribution<double> dist(0, 1);
+    for (uint8_t basis : {basis_x, basis_y, basis_z}) {
+        auto [g_begin, g_end] = groups[basis];
+        if (g_begin == g_end) {
+            continue;
+        }
+        double p0 = 0;
+        double p1 = 0;
+        THRESHOLD_OMP(
+            MQ_DO_PRAGMA(omp parallel for reduction(+ : p0, p1) schedule(static)), half, index_t(1) << nQubitTh,
+            for (omp::idx_t k = 0; k < static_cast<omp::idx_t>(half); ++k) {
+                p0 += std::norm(Rotate(basis, 0, amp[2 * k], amp[2 * k + 1]));
+                p1 += std::norm(Rotate(basis, 1, amp[2 * k], amp[2 * k + 1]));
+            })
+        auto w = qubit / stabilizer::word_bits;
+        auto bit = word_t(1) << (qubit % stabilizer::word_bits);
+        for (auto it = g_begin; it != g_end; ++it) {
+            if (dist(rnd_eng_) * (p0 + p1) >= p0) {
+                outcomes_[*it * n_words_ + w] |= bit;
+            }
+        }
+        auto one_begin = std::partition(g_begin, g_end, [&](index_t s) { return !Bit(outcomes_, s, qubit); });
+        std::pair<index_t*, index_t*> branches[] = {{g_begin, one_begin}, {one_begin, g_end}};
+        for (int o = 0; o < 2; ++o) {
+            auto [b_begin, b_end] = branches[o];
+            if (b_begin == b_end) {
+                continue;
+            }
+            VT<amp_t> child(half);
+            THRESHOLD_OMP_FOR(
+                half, index_t(1) << nQubitTh, for (omp::idx_t k = 0; k < static_cast<omp::idx_t>(half); ++k) {
+                    child[k] = Rotate(basis, o, amp[2 * k], amp[2 * k + 1]);
+                })
+            SampleNode(child, qubit + 1, b_begin, b_end);
+        }
+    }
+}
+
+VVT<uint8_t> ClassicalShadow::GetBases() const {
+    VVT<uint8_t> out(n_snapshots_, VT<uint8_t>(n_qubits_));
+    for (index_t s = 0; s < n_snapshots_; ++s) {
+        for (qbit_t q = 0; q < n_qubits_; ++q) {
+            if (!Bit(basis_x_, s, q)) {
+                out[s][q] = basis_z;
+            } else {
+                out[s][q] = Bit(basis_z_, s, q) ? basis_y : basis_x;
+            }
+        }
+    }
+    return out;
+}
+
+VVT<uint8_t> ClassicalShadow::GetOutcomes() const {
+    VVT<uint8_t> out(n_snapshots_, VT<uint8_t>(n_qubits_));
+    for (index_t s = 0; s < n_snapshots_; ++s) {
+        for (qbit_t q = 0; q < n_qubits_; ++q) {
+            out[s][q] = Bit(outcomes_, s, q);
+        }
+    }
+    return out;
+}
+
+VT<double> ClassicalShadow::GroupMeans(const Hamiltonian<double>& ham, index_t n_groups) const {
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("Classical shadow needs a Hamiltonian given as Pauli terms.");
+    }
+    if (n_groups == 0 || n_groups > n_snapshots_) {
+        throw std::invalid_argument(
+            fmt::format("n_groups should be in [1, {}] for {} snapshots, but get {}.", n_snapshots_, n_snapshots_,
+                        n_groups));
+    }
+    // Nonzero words of each term, with the scale 3^w of its weight w times its coefficient.
+    struct TermMask {
+        VT<index_t> words;
+        VT<word_t> x;
+        VT<word_t> z;
+        double scale;
+    };
+    VT<TermMask> masks;
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        stabilizer::PauliBits pauli(n_qubits_);
+        for (const auto& [qubit, word] : pauli_string) {
+            if (static_cast<qbit_t>(qubit) >= n_qubits_) {
+                throw std::invalid_argument(fmt::format("Hamiltonian acts on qubit {} out of range.", qubit));
+            }
+            pauli.Set(static_cast<qbit_t>(qubit), word);
+        }
+        TermMask mask{{}, {}, {}, coeff};
+        for (index_t i = 0; i < n_words_; ++i) {
+            if ((pauli.x[i] | pauli.z[i]) != 0) {
+                mask.words.push_back(i);
+                mask.x.push_back(pauli.x[i]);
+                mask.z.push_back(pauli.z[i]);
+                mask.scale *= std::pow(3.0, std::bitset<64>(pauli.x[i] | pauli.z[i]).count());
+            }
+        }
+        masks.push_back(std::move(mask));
+    }
+    auto n_terms = masks.size();
+    VT<double> means(n_groups * n_terms, 0);
+    THRESHOLD_OMP_FOR(
+        n_snapshots_ * n_terms, index_t(1) << nQubitTh,
+        for (omp::idx_t g = 0; g < static_cast<omp::idx_t>(n_groups); ++g) {
+            auto s_begin = static_cast<index_t>(g) * n_snapshots_ / n_groups;
+            auto s_end = (static_cast<index_t>(g) + 1) * n_snapshots_ / n_groups;
+            for (index_t t = 0; t < n_terms; ++t) {
+                const auto& mask = masks[t];
+                double sum = 0;
+                for (auto s = s_begin; s < s_end; ++s) {
+                    bool match = true;
+                    word_t parity = 0;
+                    for (index_t j = 0; j < mask.words.size() && match; ++j) {
+                        auto w = s * n_words_ + mask.words[j];
+                        auto support = mask.x[j] | mask.z[j];
+                        match = (basis_x_[w] & support) == mask.x[j] && (basis_z_[w] & support) == mask.z[j];
+                        parity ^= outcomes_[w] & support;
+                    }
+                    if (match) {
+                        sum += std::bitset<64>(parity).count() % 2 == 0 ? 1 : -1;
+                    }
+                }
+                means[g * n_terms + t] = mask.scale * sum / static_cast<double>(s_end - s_begin);
+            }
+        })
+    return means;
+}
+
+VT<double> ClassicalShadow::EstimateTerms(const Hamiltonian<double>& ham, index_t n_groups) const {
+    MQ_TRACE_SCOPE("ClassicalShadowEstimate", "simulator");
+    auto means = GroupMeans(ham, n_groups);
+    auto n_terms = ham.ham_.size();
+    VT<double> out(n_terms);
+    for (index_t t = 0; t < n_terms; ++t) {
+        VT<double> values(n_groups);
+        for (index_t g = 0; g < n_groups; ++g) {
+            values[g] = means[g * n_terms + t];
+        }
+        out[t] = Median(std::move(values));
+    }
+    return out;
+}
+
+double ClassicalShadow::EstimateExpectation(const Hamiltonian<double>& ham, index_t n_groups) const {
+    MQ_TRACE_SCOPE("ClassicalShadowEstimate", "simulator");
+    auto means = GroupMeans(ham, n_groups);
+    auto n_terms = ham.ham_.size();
+    VT<double> totals(n_groups, 0);
+    for (index_t g = 0; g < n_groups; ++g) {
+        for (index_t t = 0; t < n_terms; ++t) {
+            totals[g] += means[g * n_terms + t];
+        }
+    }
+    return Median(std::move(totals));
+}
+}  // namespace mindquantum::sim::shadow
@@ -0,0 +1,369 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/stabilizer/near_clifford_state.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "core/trace.h"
+#include "core/utils.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+#include "ops/gate_id.h"
+#include "ops/gates.h"
+#include "simulator/stabilizer/stabilizer_state.h"
+
+namespace mindquantum::sim::stabilizer {
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+
+double Angle(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr) {
+    auto g = static_cast<Parameterizable*>(gate.get());
+    return tensor::ops::cpu::to_vector<double>(g->prs_[0].Combination(pr).const_value)[0];
+}
+
+bool Parity(const std::vector<word_t>& a, const std::vector<word_t>& b) {
+    index_t count = 0;
+    for (size_t w = 0; w < a.size(); ++w) {
+        count += CountOne(a[w] & b[w]);
+    }
+    return (count & 1) != 0;
+}
+}  // namespace
+
+size_t NearCliffordState::KeyHash::operator()(const key_t& key) const {
+    size_t h = 0;
+    for (auto w : key) {
+        h ^= std::hash<word_t>()(w) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    return h;
+}
+
+NearCliffordState::NearCliffordState(qbit_t n_qubits, unsigned seed)
+    : tableau_(n_qubits), seed_(seed), rnd_eng_(seed) {
+    branches_[key_t(NWords(n_qubits), 0)] = 1;
+}
+
+void NearCliffordState::Reset() {
+    tableau_ = Tableau(GetQubits());
+    branches_.clear();
+    branches_[key_t(NWords(GetQubits()), 0)] = 1;
+    truncation_error_ = 0;
+    rnd_eng_.seed(seed_);
+}
+
+void NearCliffordState::SetTruncationThreshold(double threshold) {
+    if (threshold < 0 || threshold >= 1) {
+        throw std::invalid_argument(fmt::format("Truncation threshold should be in [0, 1), but get {}.", threshold));
+    }
+    threshold_ = threshold;
+}
+
+NearCliffordState::PauliAction NearCliffordState::Act(const PauliBits& pauli) const {
+    auto n = static_cast<index_t>(GetQubits());
+    auto n_words = NWords(GetQubits());
+    PauliAction out{key_t(n_words, 0), key_t(n_words, 0), 0};
+    for (index_t i = 0; i < n; ++i) {
+        word_t bit = word_t(1) << (i % word_bits);
+        if (AntiCommute(tableau_.RowX(n + i), tableau_.RowZ(n + i), pauli.x.data(), pauli.z.data(), n_words)) {
+            out.flip[i / word_bits] |= bit;
+        }
+        if (AntiCommute(tableau_.RowX(i), tableau_.RowZ(i), pauli.x.data(), pauli.z.data(), n_words)) {
+            out.anti[i / word_bits] |= bit;
+        }
+    }
+    // omega = <phi| D_flip P |phi>, D_flip P commutes with all stabilizers so it is a stabilizer up to a phase.
+    PauliBits product = pauli;
+    int power = 0;
+    for (index_t i = 0; i < n; ++i) {
+        if ((out.flip[i / word_bits] >> (i % word_bits)) & 1) {
+            power += MultiplyPauli(product.x.data(), product.z.data(), tableau_.RowX(i), tableau_.RowZ(i), n_words);
+            power += tableau_.RowSign(i) ? 2 : 0;
+        }
+    }
+    static const amp_t powers_of_i[] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    out.omega = powers_of_i[power % 4] * static_cast<double>(tableau_.Expectation(product));
+    return out;
+}
+
+NearCliffordState::amp_t NearCliffordState::Expectation(const PauliBits& pauli) const {
+    auto action = Act(pauli);
+    amp_t out = 0;
+    key_t target(action.flip.size());
+    for (const auto& [key, amp] : branches_) {
+        for (size_t w = 0; w < key.size(); ++w) {
+            target[w] = key[w] ^ action.flip[w];
+        }
+        auto it = branches_.find(target);
+        if (it != branches_.end()) {
+            auto term = std::conj(it->second) * amp * action.omega;
+            out += Parity(key, action.anti) ? -term : term;
+        }
+    }
+    return out;
+}
+
+void NearCliffordState::Combine(const PauliBits& pauli, amp_t c0, amp_t c1) {
+    auto action = Act(pauli);
+    bool diagonal = std::all_of(action.flip.begin(), action.flip.end(), [](word_t w) { return w == 0; });
+    if (diagonal) {
+        for (auto& [key, amp] : branches_) {
+            amp *= c0 + (Parity(key, action.anti) ? -c1 : c1) * action.omega;
+        }
+        return;
+    }
+    branches_t out;
+    out.reserve(2 * branches_.size());
+    key_t target(action.flip.size());
+    for (const auto& [key, amp] : branches_) {
+        if (c0 != 0.0) {
+            out[key] += c0 * amp;
+        }
+        for (size_t w = 0; w < key.size(); ++w) {
+            target[w] = key[w] ^ action.flip[w];
+        }
+        auto term = c1 * action.omega * amp;
+        out[target] += Parity(key, action.anti) ? -term : term;
+    }
+    branches_ = std::move(out);
+}
+
+void NearCliffordState::Truncate() {
+    double kept = 0;
+    double dropped = 0;
+    for (auto it = branches_.begin(); it != branches_.end();) {
+        auto weight = std::norm(it->second);
+        if (weight <= threshold_ || weight < 1e-30) {
+            dropped += weight;
+            it = branches_.erase(it);
+        } else {
+            kept += weight;
+            ++it;
+        }
+    }
+    if (branches_.empty()) {
+        throw std::runtime_error("All branches of the near Clifford state are truncated, lower the threshold.");
+    }
+    truncation_error_ += dropped;
+    auto scale = 1 / std::sqrt(kept);
+    for (auto& [key, amp] : branches_) {
+        amp *= scale;
+    }
+}
+
+bool NearCliffordState::RotationOf(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr,
+                                   PauliBits* pauli, double* theta) const {
+    if (!gate->ctrl_qubits_.empty()) {
+        return false;
+    }
+    const auto& objs = gate->obj_qubits_;
+    auto set_two = [&](char low, char high) {
+        pauli->Set(std::min(objs[0], objs[1]), low);
+        pauli->Set(std::max(objs[0], objs[1]), high);
+    };
+    // T, Tdag and PS are RZ up to a global phase.
+    switch (gate->id_) {
+        case GateID::T:
+            *theta = kPi / 4;
+            pauli->Set(objs[0], 'Z');
+            return true;
+        case GateID::Tdag:
+            *theta = -kPi / 4;
+            pauli->Set(objs[0], 'Z');
+            return true;
+        case GateID::PS:
+        case GateID::RZ:
+            pauli->Set(objs[0], 'Z');
+            break;
+        case GateID::RX:
+            pauli->Set(objs[0], 'X');
+            break;
+        case GateID::RY:
+            pauli->Set(objs[0], 'Y');
+            break;
+        case GateID::Rxx:
+            set_two('X', 'X');
+            break;
+        case GateID::Ryy:
+            set_two('Y', 'Y');
+            break;
+        case GateID::Rzz:
+            set_two('Z', 'Z');
+            break;
+        case GateID::Rxy:
+            set_two('X', 'Y');
+            break;
+        case GateID::Rxz:
+            set_two('X', 'Z');
+            break;
+        case GateID::Ryz:
+            set_two('Y', 'Z');
+            break;
+        case GateID::RPS: {
+            const auto& paulis = static_cast<RotPauliStringGate*>(gate.get())->paulis_;
+            for (size_t i = 0; i < objs.size(); ++i) {
+                pauli->Set(objs[i], paulis[i]);
+            }
+        } break;
+        default:
+            return false;
+    }
+    *theta = Angle(gate, pr);
+    return true;
+}
+
+index_t NearCliffordState::Measure(qbit_t q) {
+    PauliBits z(GetQubits());
+    z.Set(q, 'Z');
+    auto p0 = std::clamp((1 + Expectation(z).real()) / 2, 0.0, 1.0);
+    index_t outcome = std::uniform_real_distribution<double>(0, 1)(rnd_eng_) < p0 ? 0 : 1;
+    auto scale = 1 / std::sqrt(outcome ? 1 - p0 : p0);
+    if (!tableau_.IsRandom(q)) {
+        // Z_q is +/- a stabilizer, the projection (1 +/- Z_q) / 2 only scales the branches.
+        Combine(z, 0.5, outcome ? -0.5 : 0.5);
+        for (auto& [key, amp] : branches_) {
+            amp *= scale;
+        }
+        Truncate();
+        return outcome;
+    }
+    // Z_q anticommutes with stabilizer p. The tableau is collapsed like a stabilizer measurement, to |phi'> =
+    // sqrt(2) Pi |phi> with Pi = (1 +/- Z_q) / 2, and Pi D_b |phi> = D_b |phi'> / sqrt(2) if D_b commutes with Z_q,
+    // else D_b S_p |phi'> / sqrt(2). Expanding these Pauli strings on the new tableau merges the branches b and
+    // b ^ f paired by Z_q, so the number of branches does not grow.
+    auto n = static_cast<index_t>(GetQubits());
+    auto n_words = NWords(GetQubits());
+    auto anti = Act(z).anti;
+    auto old = tableau_;
+    auto p = tableau_.Collapse(q, outcome);
+    scale /= std::sqrt(2.0);
+    static const amp_t powers_of_i[] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    branches_t out;
+    out.reserve(branches_.size());
+    for (const auto& [key, amp] : branches_) {
+        PauliBits pauli(GetQubits());
+        int power = 0;
+        if (Parity(key, anti)) {
+            std::copy_n(old.RowX(n + p), n_words, pauli.x.begin());
+            std::copy_n(old.RowZ(n + p), n_words, pauli.z.begin());
+            power += old.RowSign(n + p) ? 2 : 0;
+        }
+        for (index_t i = 0; i < n; ++i) {
+            if ((key[i / word_bits] >> (i % word_bits)) & 1) {
+                power += MultiplyPauli(pauli.x.data(), pauli.z.data(), old.RowX(i), old.RowZ(i), n_words);
+                power += old.RowSign(i) ? 2 : 0;
+            }
+        }
+        auto action = Act(pauli);
+        out[action.flip] += scale * powers_of_i[power % 4] * action.omega * amp;
+    }
+    branches_ = std::move(out);
+    Truncate();
+    return outcome;
+}
+
+index_t NearCliffordState::ApplyGate(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr) {
+    for (const auto* qubits : {&gate->obj_qubits_, &gate->ctrl_qubits_}) {
+        for (auto q : *qubits) {
+            if (q >= GetQubits()) {
+                throw std::invalid_argument(fmt::format("Qubit {} out of range of {} qubits.", q, GetQubits()));
+            }
+        }
+    }
+    if (gate->id_ == GateID::M) {
+        return Measure(gate->obj_qubits_[0]);
+    }
+    if (gate->id_ == GateID::GP && gate->ctrl_qubits_.empty()) {
+        return 2;
+    }
+    if (StabilizerState::IsSupported(gate)) {
+        StabilizerState::ApplyClifford(&tableau_, gate);
+        return 2;
+    }
+    PauliBits pauli(GetQubits());
+    double theta = 0;
+    if (!RotationOf(gate, pr, &pauli, &theta)) {
+        throw std::invalid_argument(
+            fmt::format("Gate {} with {} control qubits is not supported by the near Clifford simulator, which takes "
+                        "Clifford gates, T, Tdag, PS, GP and uncontrolled Pauli rotations.",
+                        gate->id_, gate->ctrl_qubits_.size()));
+    }
+    Combine(pauli, std::cos(theta / 2), amp_t(0, -std::sin(theta / 2)));
+    Truncate();
+    return 2;
+}
+
+std::map<std::string, int> NearCliffordState::ApplyCircuit(const circuit_t& circ,
+                                                           const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("NearCliffordApplyCircuit", "simulator");
+    std::map<std::string, int> result;
+    for (auto& gate : circ) {
+        auto res = ApplyGate(gate, pr);
+        if (gate->id_ == GateID::M) {
+            result[static_cast<MeasureGate*>(gate.get())->name_] = static_cast<int>(res);
+        }
+    }
+    return result;
+}
+
+VT<unsigned> NearCliffordState::Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr, size_t shots,
+                                         const MST<size_t>& key_map, unsigned seed) const {
+    MQ_TRACE_SCOPE("NearCliffordSampling", "simulator");
+    // Gates before the first measurement are the same for all shots.
+    auto first_measure = std::find_if(circ.begin(), circ.end(), [](const auto& g) { return g->id_ == GateID::M; });
+    NearCliffordState prefix(*this);
+    for (auto it = circ.begin(); it != first_measure; ++it) {
+        prefix.ApplyGate(*it, pr);
+    }
+    circuit_t rest(first_measure, circ.end());
+    auto key_size = key_map.size();
+    VT<unsigned> res(shots * key_size);
+    std::mt19937 rnd_eng(seed);
+    std::uniform_real_distribution<double> dist(1.0, (1 << 20) * 1.0);
+    for (size_t i = 0; i < shots; i++) {
+        NearCliffordState sim(prefix);
+        sim.rnd_eng_.seed(static_cast<unsigned>(dist(rnd_eng)));
+        auto res0 = sim.ApplyCircuit(rest, pr);
+        for (const auto& [name, val] : key_map) {
+            res[i * key_size + val] = res0[name];
+        }
+    }
+    return res;
+}
+
+std::complex<double> NearCliffordState::GetExpectation(const Hamiltonian<calc_type>& ham) const {
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("Near Clifford simulator needs a Hamiltonian given as Pauli terms.");
+    }
+    std::complex<double> out = 0;
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        PauliBits pauli(GetQubits());
+        for (const auto& [qubit, word] : pauli_string) {
+            if (static_cast<qbit_t>(qubit) >= GetQubits()) {
+                throw std::invalid_argument(fmt::format("Hamiltonian acts on qubit {} out of range.", qubit));
+            }
+            pauli.Set(static_cast<qbit_t>(qubit), word);
+        }
+        out += coeff * Expectation(pauli);
+    }
+    return out;
+}
+}  // namespace mindquantum::sim::stabilizer
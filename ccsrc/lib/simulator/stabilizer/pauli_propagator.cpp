@@ -0,0 +1,427 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/stabilizer/pauli_propagator.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "core/trace.h"
+#include "core/utils.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+#include "ops/gate_id.h"
+#include "ops/gates.h"
+
+namespace mindquantum::sim::stabilizer {
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+
+double Angle(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr) {
+    auto g = static_cast<Parameterizable*>(gate.get());
+    return tensor::ops::cpu::to_vector<double>(g->prs_[0].Combination(pr).const_value)[0];
+}
+
+bool Bit(const std::vector<word_t>& bits, qbit_t q) {
+    return (bits[q / word_bits] >> (q % word_bits)) & 1;
+}
+
+void Flip(std::vector<word_t>* bits, qbit_t q) {
+    (*bits)[q / word_bits] ^= word_t(1) << (q % word_bits);
+}
+
+// P <- G^dagger P G for the elementary Clifford gates, the sign of the image goes to the coefficient.
+template <typename T>
+void ConjH(T* t, qbit_t q) {
+    bool x = Bit(t->pauli.x, q);
+    bool z = Bit(t->pauli.z, q);
+    if (x && z) {
+        t->coeff = -t->coeff;
+    }
+    if (x != z) {
+        Flip(&t->pauli.x, q);
+        Flip(&t->pauli.z, q);
+    }
+}
+
+template <typename T>
+void ConjS(T* t, qbit_t q) {
+    // S^dagger X S = -Y, S^dagger Y S = X.
+    bool x = Bit(t->pauli.x, q);
+    if (x && !Bit(t->pauli.z, q)) {
+        t->coeff = -t->coeff;
+    }
+    if (x) {
+        Flip(&t->pauli.z, q);
+    }
+}
+
+template <typename T>
+void ConjSdag(T* t, qbit_t q) {
+    bool x = Bit(t->pauli.x, q);
+    if (x && Bit(t->pauli.z, q)) {
+        t->coeff = -t->coeff;
+    }
+    if (x) {
+        Flip(&t->pauli.z, q);
+    }
+}
+
+template <typename T>
+void ConjPauli(T* t, qbit_t q, char pauli) {
+    bool x = Bit(t->pauli.x, q);
+    bool z = Bit(t->pauli.z, q);
+    bool anti = pauli == 'X' ? z : (pauli == 'Z' ? x : x != z);
+    if (anti) {
+        t->coeff = -t->coeff;
+    }
+}
+
+template <typename T>
+void ConjCNOT(T* t, qbit_t ctrl, qbit_t obj) {
+    bool xc = Bit(t->pauli.x, ctrl);
+    bool zc = Bit(t->pauli.z, ctrl);
+    bool xt = Bit(t->pauli.x, obj);
+    bool zt = Bit(t->pauli.z, obj);
+    if (xc && zt && (xt == zc)) {
+        t->coeff = -t->coeff;
+    }
+    if (xc) {
+        Flip(&t->pauli.x, obj);
+    }
+    if (zt) {
+        Flip(&t->pauli.z, ctrl);
+    }
+}
+
+template <typename T>
+void ConjSWAP(T* t, qbit_t q0, qbit_t q1) {
+    for (auto* bits : {&t->pauli.x, &t->pauli.z}) {
+        if (Bit(*bits, q0) != Bit(*bits, q1)) {
+            Flip(bits, q0);
+            Flip(bits, q1);
+        }
+    }
+}
+
+struct KeyHash {
+    size_t operator()(const std::vector<word_t>& key) const {
+        size_t h = 0;
+        for (auto w : key) {
+            h ^= std::hash<word_t>()(w) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        }
+        return h;
+    }
+};
+}  // namespace
+
+PauliPropagator::PauliPropagator(qbit_t n_qubits) : n_qubits_(n_qubits), max_weight_(n_qubits) {
+    if (n_qubits < 1) {
+        throw std::invalid_argument(fmt::format("Number of qubits should be positive, but get {}.", n_qubits));
+    }
+}
+
+void PauliPropagator::SetCoefficientThreshold(double threshold) {
+    if (threshold < 0) {
+        throw std::invalid_argument(fmt::format("Coefficient threshold should not be negative, but get {}.", threshold));
+    }
+    threshold_ = threshold;
+}
+
+void PauliPropagator::SetMaxWeight(qbit_t max_weight) {
+    if (max_weight < 1) {
+        throw std::invalid_argument(fmt::format("Max weight should be positive, but get {}.", max_weight));
+    }
+    max_weight_ = max_weight;
+}
+
+void PauliPropagator::SetProductState(const VT<VT<double>>& bloch) {
+    if (bloch.size() != static_cast<size_t>(n_qubits_)) {
+        throw std::invalid_argument(
+            fmt::format("Product state needs {} Bloch vectors, but get {}.", n_qubits_, bloch.size()));
+    }
+    zero_state_ = true;
+    for (const auto& vec : bloch) {
+        if (vec.size() != 3) {
+            throw std::invalid_argument("Bloch vector should have three components.");
+        }
+        if (vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2] > 1 + 1e-9) {
+            throw std::invalid_argument("Bloch vector should have a norm not larger than 1.");
+        }
+        zero_state_ = zero_state_ && vec[0] == 0 && vec[1] == 0 && vec[2] == 1;
+    }
+    bloch_ = bloch;
+}
+
+void PauliPropagator::Rotate(const PauliBits& q, double theta, std::vector<Term>* terms) {
+    // exp(i theta / 2 Q) P exp(-i theta / 2 Q) = cos(theta) P + i sin(theta) Q P for anticommuting P and Q.
+    auto c = std::cos(theta);
+    auto s = std::sin(theta);
+    auto n_words = q.x.size();
+    auto size = terms->size();
+    for (size_t i = 0; i < size; ++i) {
+        auto& term = (*terms)[i];
+        if (!AntiCommute(term.pauli.x.data(), term.pauli.z.data(), q.x.data(), q.z.data(), n_words)) {
+            continue;
+        }
+        Term branch = term;
+        // Q P = i^k R with k odd, so i sin(theta) Q P = -/+ sin(theta) R for k = 1 / 3.
+        auto power = MultiplyPauli(branch.pauli.x.data(), branch.pauli.z.data(), q.x.data(), q.z.data(), n_words);
+        branch.coeff *= power == 1 ? -s : s;
+        term.coeff *= c;
+        terms->push_back(std::move(branch));
+    }
+    Compress(terms);
+}
+
+void PauliPropagator::Compress(std::vector<Term>* terms) {
+    std::unordered_map<std::vector<word_t>, size_t, KeyHash> index;
+    index.reserve(terms->size());
+    std::vector<Term> out;
+    out.reserve(terms->size());
+    std::vector<word_t> key;
+    for (auto& term : *terms) {
+        key = term.pauli.x;
+        key.insert(key.end(), term.pauli.z.begin(), term.pauli.z.end());
+        auto [it, inserted] = index.emplace(key, out.size());
+        if (inserted) {
+            out.push_back(std::move(term));
+        } else {
+            out[it->second].coeff += term.coeff;
+        }
+    }
+    terms->clear();
+    for (auto& term : out) {
+        index_t weight = 0;
+        for (size_t w = 0; w < term.pauli.x.size(); ++w) {
+            weight += CountOne(term.pauli.x[w] | term.pauli.z[w]);
+        }
+        if (std::abs(term.coeff) <= threshold_ || weight > static_cast<index_t>(max_weight_)) {
+            truncated_weight_ += std::abs(term.coeff);
+            continue;
+        }
+        terms->push_back(std::move(term));
+    }
+    max_term_count_ = std::max<index_t>(max_term_count_, terms->size());
+}
+
+void PauliPropagator::Conjugate(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr,
+                                std::vector<Term>* terms) {
+    const auto& objs = gate->obj_qubits_;
+    const auto& ctrls = gate->ctrl_qubits_;
+    auto id = gate->id_;
+    auto for_each = [&](const auto& f) {
+        for (auto& term : *terms) {
+            f(&term);
+        }
+    };
+    if ((id == GateID::X || id == GateID::Y || id == GateID::Z) && ctrls.size() <= 1) {
+        if (ctrls.empty()) {
+            for_each([&](Term* t) { ConjPauli(t, objs[0], id == GateID::X ? 'X' : (id == GateID::Y ? 'Y' : 'Z')); });
+        } else if (id == GateID::X) {
+            for_each([&](Term* t) { ConjCNOT(t, ctrls[0], objs[0]); });
+        } else if (id == GateID::Z) {
+            for_each([&](Term* t) {
+                ConjH(t, objs[0]);
+                ConjCNOT(t, ctrls[0], objs[0]);
+                ConjH(t, objs[0]);
+            });
+        } else {
+            // CY = S CNOT Sdag.
+            for_each([&](Term* t) {
+                ConjS(t, objs[0]);
+                ConjCNOT(t, ctrls[0], objs[0]);
+                ConjSdag(t, objs[0]);
+            });
+        }
+        return;
+    }
+    if (ctrls.empty()) {
+        switch (id) {
+            case GateID::I:
+            case GateID::GP:
+                return;
+            case GateID::H:
+                for_each([&](Term* t) { ConjH(t, objs[0]); });
+                return;
+            case GateID::S:
+                for_each([&](Term* t) { ConjS(t, objs[0]); });
+                return;
+            case GateID::Sdag:
+                for_each([&](Term* t) { ConjSdag(t, objs[0]); });
+                return;
+            case GateID::SWAP:
+                for_each([&](Term* t) { ConjSWAP(t, objs[0], objs[1]); });
+                return;
+            case GateID::ISWAP: {
+                // ISWAP = exp(i pi / 4 (XX + YY)), two commuting rotations.
+                double theta = static_cast<ISWAPGate*>(gate.get())->daggered_ ? kPi / 2 : -kPi / 2;
+                for (char p : {'X', 'Y'}) {
+                    PauliBits q(n_qubits_);
+                    q.Set(objs[0], p);
+                    q.Set(objs[1], p);
+                    Rotate(q, theta, terms);
+                }
+                return;
+            }
+            default:
+                break;
+        }
+    }
+    // Pauli rotations exp(-i theta / 2 Q), T, Tdag and PS being RZ up to a global phase.
+    PauliBits q(n_qubits_);
+    auto set_two = [&](char low, char high) {
+        q.Set(std::min(objs[0], objs[1]), low);
+        q.Set(std::max(objs[0], objs[1]), high);
+    };
+    double theta = 0;
+    switch (id) {
+        case GateID::T:
+        case GateID::Tdag:
+            theta = id == GateID::T ? kPi / 4 : -kPi / 4;
+            q.Set(objs[0], 'Z');
+            break;
+        case GateID::PS:
+        case GateID::RZ:
+            q.Set(objs[0], 'Z');
+            break;
+        case GateID::RX:
+            q.Set(objs[0], 'X');
+            break;
+        case GateID::RY:
+            q.Set(objs[0], 'Y');
+            break;
+        case GateID::Rxx:
+            set_two('X', 'X');
+            break;
+        case GateID::Ryy:
+            set_two('Y', 'Y');
+            break;
+        case GateID::Rzz:
+            set_two('Z', 'Z');
+            break;
+        case GateID::Rxy:
+            set_two('X', 'Y');
+            break;
+        case GateID::Rxz:
+            set_two('X', 'Z');
+            break;
+        case GateID::Ryz:
+            set_two('Y', 'Z');
+            break;
+        case GateID::RPS: {
+            const auto& paulis = static_cast<RotPauliStringGate*>(gate.get())->paulis_;
+            for (size_t i = 0; i < objs.size(); ++i) {
+                q.Set(objs[i], paulis[i]);
+            }
+        } break;
+        default:
+            throw std::invalid_argument(fmt::format(
+                "Gate {} is not supported by the Pauli propagator, which takes Clifford gates, ISWAP, and T, Tdag, PS "
+                "and Pauli rotations with at most one control qubit.",
+                id));
+    }
+    if (id != GateID::T && id != GateID::Tdag) {
+        theta = Angle(gate, pr);
+    }
+    if (ctrls.empty()) {
+        Rotate(q, theta, terms);
+        return;
+    }
+    if (ctrls.size() > 1) {
+        throw std::invalid_argument(
+            fmt::format("Gate {} with {} control qubits is not supported by the Pauli propagator.", id, ctrls.size()));
+    }
+    if (id == GateID::T || id == GateID::Tdag || id == GateID::PS) {
+        // Controlled phase exp(i theta |11><11|) = exp(-i theta / 4 Z_c) exp(-i theta / 4 Z_t) exp(i theta / 4 Z_c Z_t)
+        // up to a global phase.
+        Rotate(q, theta / 2, terms);
+        PauliBits zc(n_qubits_);
+        zc.Set(ctrls[0], 'Z');
+        Rotate(zc, theta / 2, terms);
+        q.Set(ctrls[0], 'Z');
+        Rotate(q, -theta / 2, terms);
+        return;
+    }
+    // Controlled exp(-i theta / 2 Q) = exp(-i theta / 4 Q) exp(i theta / 4 Z_c Q).
+    Rotate(q, theta / 2, terms);
+    q.Set(ctrls[0], 'Z');
+    Rotate(q, -theta / 2, terms);
+}
+
+double PauliPropagator::Evaluate(const Term& term) const {
+    if (zero_state_) {
+        bool diagonal = std::all_of(term.pauli.x.begin(), term.pauli.x.end(), [](word_t w) { return w == 0; });
+        return diagonal ? term.coeff : 0;
+    }
+    double out = term.coeff;
+    for (qbit_t q = 0; q < n_qubits_ && out != 0; ++q) {
+        bool x = Bit(term.pauli.x, q);
+        bool z = Bit(term.pauli.z, q);
+        if (x || z) {
+            out *= bloch_[q][x && z ? 1 : (x ? 0 : 2)];
+        }
+    }
+    return out;
+}
+
+double PauliPropagator::GetExpectation(const Hamiltonian<double>& ham, const circuit_t& circ,
+                                       const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("PauliPropagation", "simulator");
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("Pauli propagator needs a Hamiltonian given as Pauli terms.");
+    }
+    for (const auto& gate : circ) {
+        for (const auto* qubits : {&gate->obj_qubits_, &gate->ctrl_qubits_}) {
+            for (auto q : *qubits) {
+                if (q >= n_qubits_) {
+                    throw std::invalid_argument(fmt::format("Qubit {} out of range of {} qubits.", q, n_qubits_));
+                }
+            }
+        }
+        if (gate->id_ == GateID::M) {
+            throw std::invalid_argument("Pauli propagator does not support measurement.");
+        }
+    }
+    max_term_count_ = 0;
+    truncated_weight_ = 0;
+    std::vector<Term> terms;
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        Term term{PauliBits(n_qubits_), coeff};
+        for (const auto& [qubit, word] : pauli_string) {
+            if (static_cast<qbit_t>(qubit) >= n_qubits_) {
+                throw std::invalid_argument(fmt::format("Hamiltonian acts on qubit {} out of range.", qubit));
+            }
+            term.pauli.Set(static_cast<qbit_t>(qubit), word);
+        }
+        terms.push_back(std::move(term));
+    }
+    Compress(&terms);
+    for (auto it = circ.rbegin(); it != circ.rend() && !terms.empty(); ++it) {
+        Conjugate(*it, pr, &terms);
+    }
+    double out = 0;
+    for (const auto& term : terms) {
+        out += Evaluate(term);
+    }
+    return out;
+}
+}  // namespace mindquantum::sim::stabilizer
@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/stabilizer/stabilizer_state.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "core/trace.h"
+#include "ops/gate_id.h"
+
+namespace mindquantum::sim::stabilizer {
+namespace {
+/**
+ * Pauli frames of a batch of shots, bit s of word w of qubit q being shot 64 * w + s.
+ *
+ * Frames track the Pauli difference between each shot and the reference sample, so Clifford gates conjugate them
+ * without signs, and a measurement outcome is flipped by the X part of the frame.
+ */
+class PauliFrames {
+ public:
+    PauliFrames(qbit_t n_qubits, index_t n_words)
+        : n_words_(n_words), x_(n_qubits * n_words, 0), z_(n_qubits * n_words, 0) {
+    }
+
+    word_t* XBits(qbit_t q) {
+        return &x_[q * n_words_];
+    }
+    word_t* ZBits(qbit_t q) {
+        return &z_[q * n_words_];
+    }
+
+    void H(qbit_t q) {
+        std::swap_ranges(XBits(q), XBits(q) + n_words_, ZBits(q));
+    }
+    void S(qbit_t q) {
+        Xor(ZBits(q), XBits(q));
+    }
+    void Sdag(qbit_t q) {
+        Xor(ZBits(q), XBits(q));
+    }
+    void X(qbit_t) {
+    }
+    void Y(qbit_t) {
+    }
+    void Z(qbit_t) {
+    }
+    void CNOT(qbit_t ctrl, qbit_t obj) {
+        Xor(XBits(obj), XBits(ctrl));
+        Xor(ZBits(ctrl), ZBits(obj));
+    }
+    void CZ(qbit_t q0, qbit_t q1) {
+        Xor(ZBits(q0), XBits(q1));
+        Xor(ZBits(q1), XBits(q0));
+    }
+    void SWAP(qbit_t q0, qbit_t q1) {
+        std::swap_ranges(XBits(q0), XBits(q0) + n_words_, XBits(q1));
+        std::swap_ranges(ZBits(q0), ZBits(q0) + n_words_, ZBits(q1));
+    }
+
+ private:
+    void Xor(word_t* dst, const word_t* src) {
+        for (index_t w = 0; w < n_words_; ++w) {
+            dst[w] ^= src[w];
+        }
+    }
+
+    index_t n_words_;
+    std::vector<word_t> x_;
+    std::vector<word_t> z_;
+};
+
+template <typename T>
+void ApplyCliffordOn(T* state, const std::shared_ptr<BasicGate>& gate) {
+    auto obj = gate->obj_qubits_[0];
+    bool controlled = !gate->ctrl_qubits_.empty();
+    switch (gate->id_) {
+        case GateID::I:
+            break;
+        case GateID::X:
+            controlled ? state->CNOT(gate->ctrl_qubits_[0], obj) : state->X(obj);
+            break;
+        case GateID::Y:
+            if (controlled) {
+                // CY = S CNOT Sdag.
+                state->Sdag(obj);
+                state->CNOT(gate->ctrl_qubits_[0], obj);
+                state->S(obj);
+            } else {
+                state->Y(obj);
+            }
+            break;
+        case GateID::Z:
+            controlled ? state->CZ(gate->ctrl_qubits_[0], obj) : state->Z(obj);
+            break;
+        case GateID::H:
+            state->H(obj);
+            break;
+        case GateID::S:
+            state->S(obj);
+            break;
+        case GateID::Sdag:
+            state->Sdag(obj);
+            break;
+        case GateID::SWAP:
+            state->SWAP(obj, gate->obj_qubits_[1]);
+            break;
+        default:
+            break;
+    }
+}
+}  // namespace
+
+StabilizerState::StabilizerState(qbit_t n_qubits, unsigned seed)
+    : tableau_(n_qubits), seed_(seed), rnd_eng_(seed) {
+}
+
+void StabilizerState::Reset() {
+    tableau_ = Tableau(tableau_.NQubits());
+    rnd_eng_.seed(seed_);
+}
+
+bool StabilizerState::IsSupported(const std::shared_ptr<BasicGate>& gate) {
+    switch (gate->id_) {
+        case GateID::X:
+        case GateID::Y:
+        case GateID::Z:
+            return gate->ctrl_qubits_.size() <= 1;
+        case GateID::I:
+        case GateID::H:
+        case GateID::S:
+        case GateID::Sdag:
+        case GateID::SWAP:
+        case GateID::M:
+            return gate->ctrl_qubits_.empty();
+        default:
+            return false;
+    }
+}
+
+void StabilizerState::CheckGate(const std::shared_ptr<BasicGate>& gate) {
+    if (!IsSupported(gate)) {
+        throw std::invalid_argument(
+            fmt::format("Gate {} with {} control qubits is not supported by the stabilizer simulator, which takes I, X, "
+                        "Y, Z, H, S, Sdag, SWAP, CNOT, CY, CZ and measurements.",
+                        gate->id_, gate->ctrl_qubits_.size()));
+    }
+}
+
+void StabilizerState::ApplyClifford(Tableau* tableau, const std::shared_ptr<BasicGate>& gate) {
+    ApplyCliffordOn(tableau, gate);
+}
+
+index_t StabilizerState::ApplyGate(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver&) {
+    CheckGate(gate);
+    for (const auto* qubits : {&gate->obj_qubits_, &gate->ctrl_qubits_}) {
+        for (auto q : *qubits) {
+            if (q >= GetQubits()) {
+                throw std::invalid_argument(fmt::format("Qubit {} out of range of {} qubits.", q, GetQubits()));
+            }
+        }
+    }
+    if (gate->id_ == GateID::M) {
+        return tableau_.Measure(gate->obj_qubits_[0], &rnd_eng_);
+    }
+    ApplyClifford(&tableau_, gate);
+    return 2;
+}
+
+std::map<std::string, int> StabilizerState::ApplyCircuit(const circuit_t& circ,
+                                                         const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("StabilizerApplyCircuit", "simulator");
+    std::map<std::string, int> result;
+    for (auto& gate : circ) {
+        auto res = ApplyGate(gate, pr);
+        if (gate->id_ == GateID::M) {
+            result[static_cast<MeasureGate*>(gate.get())->name_] = static_cast<int>(res);
+        }
+    }
+    return result;
+}
+
+VT<unsigned> StabilizerState::Sampling(const circuit_t& circ, const parameter::ParameterResolver& pr, size_t shots,
+                                       const MST<size_t>& key_map, unsigned seed) const {
+    MQ_TRACE_SCOPE("StabilizerSampling", "simulator");
+    auto n_qubits = GetQubits();
+    // Reference sample from one run on the tableau.
+    StabilizerState reference(*this);
+    reference.rnd_eng_.seed(seed);
+    std::vector<uint8_t> ref_results;
+    for (auto& gate : circ) {
+        auto res = reference.ApplyGate(gate, pr);
+        if (gate->id_ == GateID::M) {
+            ref_results.push_back(static_cast<uint8_t>(res));
+        }
+    }
+    // Frames start as random products of the stabilizers, which leave the state unchanged but make the outcomes of
+    // measurements anticommuting with them random.
+    auto n_words = NWords(static_cast<qbit_t>(shots));
+    PauliFrames frames(n_qubits, n_words);
+    std::mt19937_64 rng(seed);
+    for (qbit_t i = 0; i < n_qubits; ++i) {
+        const auto* sx = tableau_.RowX(n_qubits + i);
+        const auto* sz = tableau_.RowZ(n_qubits + i);
+        for (index_t w = 0; w < n_words; ++w) {
+            auto pick = rng();
+            for (qbit_t q = 0; q < n_qubits; ++q) {
+                word_t bit = word_t(1) << (q % word_bits);
+                if (sx[q / word_bits] & bit) {
+                    frames.XBits(q)[w] ^= pick;
+                }
+                if (sz[q / word_bits] & bit) {
+                    frames.ZBits(q)[w] ^= pick;
+                }
+            }
+        }
+    }
+    auto key_size = key_map.size();
+    VT<unsigned> res(shots * key_size);
+    size_t m_idx = 0;
+    for (auto& gate : circ) {
+        if (gate->id_ != GateID::M) {
+            ApplyCliffordOn(&frames, gate);
+            continue;
+        }
+        auto q = gate->obj_qubits_[0];
+        auto key = key_map.at(static_cast<MeasureGate*>(gate.get())->name_);
+        word_t ref_word = ref_results[m_idx++] ? ~word_t(0) : 0;
+        for (size_t shot = 0; shot < shots; ++shot) {
+            auto word = frames.XBits(q)[shot / word_bits] ^ ref_word;
+            res[shot * key_size + key] = (word >> (shot % word_bits)) & 1;
+        }
+        // After the measurement Z_q stabilizes the state, a random Z_q makes later anticommuting outcomes random.
+        for (index_t w = 0; w < n_words; ++w) {
+            frames.ZBits(q)[w] ^= rng();
+        }
+    }
+    return res;
+}
+
+std::complex<double> StabilizerState::GetExpectation(const Hamiltonian<calc_type>& ham) const {
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("Stabilizer simulator needs a Hamiltonian given as Pauli terms.");
+    }
+    double out = 0;
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        PauliBits pauli(GetQubits());
+        for (const auto& [qubit, word] : pauli_string) {
+            if (static_cast<qbit_t>(qubit) >= GetQubits()) {
+                throw std::invalid_argument(fmt::format("Hamiltonian acts on qubit {} out of range.", qubit));
+            }
+            pauli.Set(static_cast<qbit_t>(qubit), word);
+        }
+        out += coeff * tableau_.Expectation(pauli);
+    }
+    return out;
+}
+
+VT<std::string> StabilizerState::GetStabilizers() const {
+    VT<std::string> out;
+    for (qbit_t i = 0; i < GetQubits(); ++i) {
+        out.push_back(tableau_.Stabilizer(i));
+    }
+    return out;
+}
+}  // namespace mindquantum::sim::stabilizer
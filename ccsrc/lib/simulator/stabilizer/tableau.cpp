@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/stabilizer/tableau.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "core/utils.h"
+
+namespace mindquantum::sim::stabilizer {
+void PauliBits::Set(qbit_t q, char pauli) {
+    word_t mask = word_t(1) << (q % word_bits);
+    auto w = static_cast<index_t>(q / word_bits);
+    x[w] &= ~mask;
+    z[w] &= ~mask;
+    switch (pauli) {
+        case 'X':
+            x[w] |= mask;
+            break;
+        case 'Y':
+            x[w] |= mask;
+            z[w] |= mask;
+            break;
+        case 'Z':
+            z[w] |= mask;
+            break;
+        case 'I':
+            break;
+        default:
+            throw std::invalid_argument(fmt::format("Unknown Pauli {}.", pauli));
+    }
+}
+
+int MultiplyPauli(word_t* xh, word_t* zh, const word_t* xi, const word_t* zi, index_t n_words) {
+    // Sum of the exponents of i picked up on each qubit, counted with bit masks of the +1 and -1 qubits.
+    int64_t phase = 0;
+    for (index_t w = 0; w < n_words; ++w) {
+        auto x1 = xi[w];
+        auto z1 = zi[w];
+        auto x2 = xh[w];
+        auto z2 = zh[w];
+        auto y1 = x1 & z1;
+        auto only_x1 = x1 & ~z1;
+        auto only_z1 = ~x1 & z1;
+        auto plus = (y1 & z2 & ~x2) | (only_x1 & z2 & x2) | (only_z1 & x2 & ~z2);
+        auto minus = (y1 & x2 & ~z2) | (only_x1 & z2 & ~x2) | (only_z1 & x2 & z2);
+        phase += static_cast<int64_t>(CountOne(plus)) - static_cast<int64_t>(CountOne(minus));
+        xh[w] = x1 ^ x2;
+        zh[w] = z1 ^ z2;
+    }
+    return static_cast<int>((phase % 4 + 4) % 4);
+}
+
+bool AntiCommute(const word_t* x1, const word_t* z1, const word_t* x2, const word_t* z2, index_t n_words) {
+    index_t count = 0;
+    for (index_t w = 0; w < n_words; ++w) {
+        count += CountOne((x1[w] & z2[w]) ^ (z1[w] & x2[w]));
+    }
+    return (count & 1) != 0;
+}
+
+Tableau::Tableau(qbit_t n_qubits)
+    : n_qubits_(n_qubits)
+    , n_words_(NWords(n_qubits))
+    , x_((2 * n_qubits + 1) * n_words_, 0)
+    , z_((2 * n_qubits + 1) * n_words_, 0)
+    , r_(2 * n_qubits + 1, 0) {
+    // |0...0>: destabilizer i is X_i, stabilizer i is Z_i.
+    for (qbit_t i = 0; i < n_qubits; ++i) {
+        x_[i * n_words_ + i / word_bits] |= word_t(1) << (i % word_bits);
+        z_[(n_qubits + i) * n_words_ + i / word_bits] |= word_t(1) << (i % word_bits);
+    }
+}
+
+template <typename F>
+void Tableau::ForColumn(qbit_t q, const F& f) {
+    auto w = static_cast<index_t>(q / word_bits);
+    word_t mask = word_t(1) << (q % word_bits);
+    for (index_t row = 0; row < 2 * static_cast<index_t>(n_qubits_); ++row) {
+        f(&x_[row * n_words_ + w], &z_[row * n_words_ + w], &r_[row], mask);
+    }
+}
+
+void Tableau::H(qbit_t q) {
+    ForColumn(q, [](word_t* x, word_t* z, uint8_t* r, word_t mask) {
+        *r ^= ((*x & *z & mask) != 0);
+        auto diff = (*x ^ *z) & mask;
+        *x ^= diff;
+        *z ^= diff;
+    });
+}
+
+void Tableau::S(qbit_t q) {
+    ForColumn(q, [](word_t* x, word_t* z, uint8_t* r, word_t mask) {
+        *r ^= ((*x & *z & mask) != 0);
+        *z ^= *x & mask;
+    });
+}
+
+void Tableau::Sdag(qbit_t q) {
+    ForColumn(q, [](word_t* x, word_t* z, uint8_t* r, word_t mask) {
+        *r ^= ((*x & ~*z & mask) != 0);
+        *z ^= *x & mask;
+    });
+}
+
+void Tableau::X(qbit_t q) {
+    ForColumn(q, [](word_t*, word_t* z, uint8_t* r, word_t mask) { *r ^= ((*z & mask) != 0); });
+}
+
+void Tableau::Y(qbit_t q) {
+    ForColumn(q, [](word_t* x, word_t* z, uint8_t* r, word_t mask) { *r ^= (((*x ^ *z) & mask) != 0); });
+}
+
+void Tableau::Z(qbit_t q) {
+    ForColumn(q, [](word_t* x, word_t*, uint8_t* r, word_t mask) { *r ^= ((*x & mask) != 0); });
+}
+
+void Tableau::CNOT(qbit_t ctrl, qbit_t obj) {
+    for (index_t row = 0; row < 2 * static_cast<index_t>(n_qubits_); ++row) {
+        bool xc = GetX(row, ctrl);
+        bool zc = GetZ(row, ctrl);
+        bool xt = GetX(row, obj);
+        bool zt = GetZ(row, obj);
+        r_[row] ^= xc && zt && (xt == zc);
+        if (xc) {
+            x_[row * n_words_ + obj / word_bits] ^= word_t(1) << (obj % word_bits);
+        }
+        if (zt) {
+            z_[row * n_words_ + ctrl / word_bits] ^= word_t(1) << (ctrl % word_bits);
+        }
+    }
+}
+
+void Tableau::CZ(qbit_t q0, qbit_t q1) {
+    H(q1);
+    CNOT(q0, q1);
+    H(q1);
+}
+
+void Tableau::SWAP(qbit_t q0, qbit_t q1) {
+    for (index_t row = 0; row < 2 * static_cast<index_t>(n_qubits_); ++row) {
+        for (auto* bits : {&x_, &z_}) {
+            auto& w0 = (*bits)[row * n_words_ + q0 / word_bits];
+            auto& w1 = (*bits)[row * n_words_ + q1 / word_bits];
+            bool b0 = (w0 >> (q0 % word_bits)) & 1;
+            bool b1 = (w1 >> (q1 % word_bits)) & 1;
+            if (b0 != b1) {
+                w0 ^= word_t(1) << (q0 % word_bits);
+                w1 ^= word_t(1) << (q1 % word_bits);
+            }
+        }
+    }
+}
+
+void Tableau::Multiply(word_t* xh, word_t* zh, uint8_t* rh, const word_t* xi, const word_t* zi, uint8_t ri) const {
+    auto phase = 2 * *rh + 2 * ri + MultiplyPauli(xh, zh, xi, zi, n_words_);
+    *rh = (phase % 4) == 2 ? 1 : 0;
+}
+
+void Tableau::RowCopy(index_t dst, index_t src) {
+    std::copy_n(&x_[src * n_words_], n_words_, &x_[dst * n_words_]);
+    std::copy_n(&z_[src * n_words_], n_words_, &z_[dst * n_words_]);
+    r_[dst] = r_[src];
+}
+
+void Tableau::RowClear(index_t row) {
+    std::fill_n(&x_[row * n_words_], n_words_, 0);
+    std::fill_n(&z_[row * n_words_], n_words_, 0);
+    r_[row] = 0;
+}
+
+bool Tableau::IsRandom(qbit_t q) const {
+    for (index_t p = n_qubits_; p < 2 * static_cast<index_t>(n_qubits_); ++p) {
+        if (GetX(p, q)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+index_t Tableau::Measure(qbit_t q, std::mt19937* rng) {
+    auto n = static_cast<index_t>(n_qubits_);
+    if (IsRandom(q)) {
+        index_t outcome = std::uniform_int_distribution<int>(0, 1)(*rng);
+        Collapse(q, outcome);
+        return outcome;
+    }
+    // Deterministic outcome: Z_q is the product of the stabilizers whose destabilizer anticommutes with it.
+    auto scratch = 2 * n;
+    RowClear(scratch);
+    for (index_t i = 0; i < n; ++i) {
+        if (GetX(i, q)) {
+            RowSum(scratch, i + n);
+        }
+    }
+    return r_[scratch];
+}
+
+index_t Tableau::Collapse(qbit_t q, index_t outcome) {
+    auto n = static_cast<index_t>(n_qubits_);
+    index_t p = n;
+    while (p < 2 * n && !GetX(p, q)) {
+        p += 1;
+    }
+    if (p == 2 * n) {
+        throw std::runtime_error(fmt::format("Measurement of qubit {} is deterministic, it can not be collapsed.", q));
+    }
+    // Stabilizer p anticommutes with Z_q, the other rows are made to commute with it.
+    for (index_t i = 0; i < 2 * n; ++i) {
+        if (i != p && GetX(i, q)) {
+            RowSum(i, p);
+        }
+    }
+    RowCopy(p - n, p);
+    RowClear(p);
+    z_[p * n_words_ + q / word_bits] |= word_t(1) << (q % word_bits);
+    r_[p] = static_cast<uint8_t>(outcome & 1);
+    return p - n;
+}
+
+int Tableau::Expectation(const PauliBits& pauli) const {
+    auto n = static_cast<index_t>(n_qubits_);
+    auto anticommute = [&](index_t row) {
+        return AntiCommute(RowX(row), RowZ(row), pauli.x.data(), pauli.z.data(), n_words_);
+    };
+    for (index_t p = n; p < 2 * n; ++p) {
+        if (anticommute(p)) {
+            return 0;
+        }
+    }
+    PauliBits product(n_qubits_);
+    uint8_t sign = 0;
+    for (index_t i = 0; i < n; ++i) {
+        if (anticommute(i)) {
+            Multiply(product.x.data(), product.z.data(), &sign, RowX(i + n), RowZ(i + n), r_[i + n]);
+        }
+    }
+    return sign ? -1 : 1;
+}
+
+std::string Tableau::Stabilizer(qbit_t i) const {
+    auto row = static_cast<index_t>(n_qubits_ + i);
+    std::string out(r_[row] ? "-" : "+");
+    for (qbit_t q = 0; q < n_qubits_; ++q) {
+        out += "IZXY"[GetX(row, q) * 2 + GetZ(row, q)];
+    }
+    return out;
+}
+}  // namespace mindquantum::sim::stabilizer
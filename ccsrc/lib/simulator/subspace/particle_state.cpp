@@ -0,0 +1,357 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/subspace/particle_state.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "config/openmp.h"
+#include "core/trace.h"
+#include "core/utils.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+#include "ops/gate_id.h"
+#include "simulator/mps/mps_state.h"
+#include "simulator/utils.h"
+
+namespace mindquantum::sim::subspace {
+namespace {
+using matrix_t = mps::MPSState::matrix_t;
+constexpr index_t chunk_size = index_t(1) << 12;
+
+uint64_t NextCombination(uint64_t x) {
+    auto c = x & (~x + 1);
+    auto r = x + c;
+    return (((r ^ x) >> 2) / c) | r;
+}
+
+//! Pauli term as masks, P|x> = i^n_y (-1)^popcount(x & sign) |x ^ flip>.
+struct PauliMasks {
+    uint64_t flip = 0;
+    uint64_t sign = 0;
+    std::complex<double> phase = 1;
+};
+
+PauliMasks GetMasks(const VT<PauliWord>& pauli_string, qbit_t n_qubits) {
+    PauliMasks masks;
+    for (const auto& [qubit, word] : pauli_string) {
+        if (static_cast<qbit_t>(qubit) >= n_qubits) {
+            throw std::invalid_argument(fmt::format("Hamiltonian acts on qubit {} out of range.", qubit));
+        }
+        auto bit = uint64_t(1) << qubit;
+        if (word == 'X' || word == 'Y') {
+            masks.flip |= bit;
+        }
+        if (word == 'Y' || word == 'Z') {
+            masks.sign |= bit;
+        }
+        if (word == 'Y') {
+            masks.phase *= std::complex<double>(0, 1);
+        }
+    }
+    return masks;
+}
+}  // namespace
+
+ParticleState::ParticleState(qbit_t n_qubits, qbit_t n_particles) : n_qubits_(n_qubits), n_particles_(n_particles) {
+    if (n_qubits < 1 || n_qubits > 63) {
+        throw std::invalid_argument(fmt::format("Number of qubits should be in [1, 63], but get {}.", n_qubits));
+    }
+    if (n_particles < 0 || n_particles > n_qubits) {
+        throw std::invalid_argument(
+            fmt::format("Number of particles should be in [0, {}], but get {}.", n_qubits, n_particles));
+    }
+    binom_.assign(n_qubits + 1, VT<index_t>(n_particles + 1, 0));
+    for (qbit_t p = 0; p <= n_qubits; ++p) {
+        binom_[p][0] = 1;
+        for (qbit_t k = 1; k <= std::min(p, n_particles); ++k) {
+            binom_[p][k] = binom_[p - 1][k - 1] + (k < p ? binom_[p - 1][k] : 0);
+        }
+    }
+    dim_ = binom_[n_qubits][n_particles];
+    Reset();
+}
+
+void ParticleState::Reset() {
+    qs_.assign(dim_, 0);
+    qs_[0] = 1;
+}
+
+index_t ParticleState::Rank(uint64_t state) const {
+    index_t rank = 0;
+    qbit_t k = 0;
+    while (state != 0) {
+        auto p = CountTrailingZero(state);
+        rank += binom_[p][++k];
+        state &= state - 1;
+    }
+    return rank;
+}
+
+uint64_t ParticleState::Unrank(index_t rank) const {
+    uint64_t state = 0;
+    qbit_t p = n_qubits_;
+    for (qbit_t k = n_particles_; k > 0; --k) {
+        do {
+            --p;
+        } while (binom_[p][k] > rank);
+        state |= uint64_t(1) << p;
+        rank -= binom_[p][k];
+    }
+    return state;
+}
+
+index_t ParticleState::NumChunks() const {
+    return (dim_ + chunk_size - 1) / chunk_size;
+}
+
+template <typename F>
+void ParticleState::ForRange(index_t begin, index_t end, F&& f) const {
+    auto state = Unrank(begin);
+    for (index_t rank = begin; rank < end; ++rank) {
+        f(rank, state);
+        if (rank + 1 < end) {
+            state = NextCombination(state);
+        }
+    }
+}
+
+template <typename F>
+void ParticleState::ForChunks(F&& f) const {
+    auto n_chunks = NumChunks();
+    THRESHOLD_OMP_FOR(
+        dim_, index_t(1) << nQubitTh, for (omp::idx_t chunk = 0; chunk < static_cast<omp::idx_t>(n_chunks); ++chunk) {
+            auto begin = static_cast<index_t>(chunk) * chunk_size;
+            f(static_cast<index_t>(chunk), begin, std::min(begin + chunk_size, dim_));
+        })
+}
+
+void ParticleState::ApplyGate(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("ParticleStateApplyGate", "simulator");
+    auto id = gate->id_;
+    if (id == GateID::I) {
+        return;
+    }
+    if (id == GateID::M) {
+        throw std::invalid_argument("Particle subspace simulator does not support measurement.");
+    }
+    qbits_t qubits = gate->obj_qubits_;
+    qubits.insert(qubits.end(), gate->ctrl_qubits_.begin(), gate->ctrl_qubits_.end());
+    for (auto q : qubits) {
+        if (q < 0 || q >= n_qubits_) {
+            throw std::invalid_argument(fmt::format("Qubit {} out of range of {} qubits.", q, n_qubits_));
+        }
+    }
+    if (id == GateID::SE || id == GateID::DE) {
+        ApplyExcitation(gate, pr);
+        return;
+    }
+    auto k = qubits.size();
+    auto local_dim = index_t(1) << k;
+    matrix_t m = mps::MPSState::GateMatrix(gate, pr, "particle subspace");
+    if (!gate->ctrl_qubits_.empty()) {
+        matrix_t full = matrix_t::Identity(local_dim, local_dim);
+        full.bottomRightCorner(m.rows(), m.cols()) = m;
+        m = std::move(full);
+    }
+    // Local indices grouped by popcount, the matrix must not mix two groups.
+    VT<VT<index_t>> locals(k + 1);
+    for (index_t l = 0; l < local_dim; ++l) {
+        locals[CountOne(l)].push_back(l);
+    }
+    for (index_t col = 0; col < local_dim; ++col) {
+        for (index_t row = 0; row < local_dim; ++row) {
+            if (CountOne(row) != CountOne(col) && std::abs(m(row, col)) > 1e-12) {
+                throw std::invalid_argument(
+                    fmt::format("Gate {} does not conserve the number of particles.", gate->id_));
+            }
+        }
+    }
+    VT<matrix_t> blocks(k + 1);
+    VT<VT<uint64_t>> deposits(k + 1);
+    for (size_t c = 0; c <= k; ++c) {
+        auto size = locals[c].size();
+        blocks[c].resize(size, size);
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = 0; j < size; ++j) {
+                blocks[c](i, j) = m(locals[c][i], locals[c][j]);
+            }
+            uint64_t bits = 0;
+            for (size_t b = 0; b < k; ++b) {
+                bits |= ((locals[c][i] >> b) & 1) << qubits[b];
+            }
+            deposits[c].push_back(bits);
+        }
+    }
+    uint64_t mask = 0;
+    for (auto q : qubits) {
+        mask |= uint64_t(1) << q;
+    }
+    // Each group of basis states equal outside the gate qubits is handled by its member of lowest local index.
+    ForChunks([&](index_t, index_t begin, index_t end) {
+        Eigen::VectorXcd amps(local_dim);
+        Eigen::VectorXcd res(local_dim);
+        VT<index_t> ranks(local_dim);
+        ForRange(begin, end, [&](index_t rank, uint64_t state) {
+            index_t l = 0;
+            for (size_t b = 0; b < k; ++b) {
+                l |= ((state >> qubits[b]) & 1) << b;
+            }
+            auto c = CountOne(l);
+            if (l != locals[c][0] || locals[c].size() == 1) {
+                if (locals[c].size() == 1) {
+                    qs_[rank] *= blocks[c](0, 0);
+                }
+                return;
+            }
+            auto rest = state & ~mask;
+            auto size = locals[c].size();
+            for (size_t i = 0; i < size; ++i) {
+                ranks[i] = i == 0 ? rank : Rank(rest | deposits[c][i]);
+                amps[i] = qs_[ranks[i]];
+            }
+            res.head(size).noalias() = blocks[c] * amps.head(size);
+            for (size_t i = 0; i < size; ++i) {
+                qs_[ranks[i]] = res[i];
+            }
+        });
+    });
+}
+
+void ParticleState::ApplyCircuit(const circuit_t& circ, const parameter::ParameterResolver& pr) {
+    for (const auto& gate : circ) {
+        ApplyGate(gate, pr);
+    }
+}
+
+void ParticleState::ApplyHamiltonian(const Hamiltonian<double>& ham) {
+    MQ_TRACE_SCOPE("ParticleStateApplyHamiltonian", "simulator");
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("Particle subspace simulator needs a Hamiltonian given as Pauli terms.");
+    }
+    VT<std::pair<PauliMasks, double>> terms;
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        terms.emplace_back(GetMasks(pauli_string, n_qubits_), coeff);
+    }
+    VT<py_qs_data_t> out(dim_, 0);
+    // Gather form, out[y] = sum_P c_P <y|P|x> psi[x] with x = y ^ flip, so that each rank is written once.
+    ForChunks([&](index_t, index_t begin, index_t end) {
+        ForRange(begin, end, [&](index_t rank, uint64_t state) {
+            py_qs_data_t value = 0;
+            for (const auto& [masks, coeff] : terms) {
+                auto source = state ^ masks.flip;
+                if (CountOne(source) != static_cast<uint64_t>(n_particles_)) {
+                    continue;
+                }
+                auto sign = CountOne(source & masks.sign) & 1 ? -1.0 : 1.0;
+                value += coeff * sign * masks.phase * qs_[Rank(source)];
+            }
+            out[rank] = value;
+        });
+    });
+    qs_ = std::move(out);
+}
+
+void ParticleState::ApplyExcitation(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr) {
+    ExcitationMask mask(gate->obj_qubits_, gate->ctrl_qubits_);
+    auto g = static_cast<Parameterizable*>(gate.get());
+    auto theta = tensor::ops::cpu::to_vector<double>(g->prs_[0].Combination(pr).const_value)[0];
+    auto c = std::cos(theta);
+    auto s = std::sin(theta);
+    // A state a with the annihilated modes occupied and the created ones empty is paired with b = a ^ obj_mask, which
+    // has the same number of particles. The pair is rotated from the rank of a only, so each rank is written once.
+    ForChunks([&](index_t, index_t begin, index_t end) {
+        ForRange(begin, end, [&](index_t rank_a, uint64_t a) {
+            if ((a & mask.obj_mask) != mask.annihilate_mask || (a & mask.ctrl_mask) != mask.ctrl_mask) {
+                return;
+            }
+            auto rank_b = Rank(a ^ mask.obj_mask);
+            auto sc = ((CountOne(a & mask.parity_mask) ^ mask.sign_bit) & 1) ? -s : s;
+            auto va = qs_[rank_a];
+            auto vb = qs_[rank_b];
+            qs_[rank_a] = c * va - sc * vb;
+            qs_[rank_b] = c * vb + sc * va;
+        });
+    });
+}
+
+auto ParticleState::GetExpectation(const Hamiltonian<double>& ham) const -> py_qs_data_t {
+    MQ_TRACE_SCOPE("ParticleStateExpectation", "simulator");
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("Particle subspace simulator needs a Hamiltonian given as Pauli terms.");
+    }
+    py_qs_data_t out = 0;
+    VT<py_qs_data_t> partial(NumChunks());
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        auto masks = GetMasks(pauli_string, n_qubits_);
+        std::fill(partial.begin(), partial.end(), 0);
+        ForChunks([&](index_t chunk, index_t begin, index_t end) {
+            py_qs_data_t sum = 0;
+            ForRange(begin, end, [&](index_t rank, uint64_t state) {
+                auto target = state ^ masks.flip;
+                if (CountOne(target) != static_cast<uint64_t>(n_particles_)) {
+                    return;
+                }
+                auto sign = CountOne(state & masks.sign) & 1 ? -1.0 : 1.0;
+                sum += std::conj(qs_[Rank(target)]) * sign * qs_[rank];
+            });
+            partial[chunk] = sum;
+        });
+        for (auto v : partial) {
+            out += coeff * masks.phase * v;
+        }
+    }
+    return out;
+}
+
+auto ParticleState::GetAmplitude(const VT<uint8_t>& bits) const -> py_qs_data_t {
+    if (bits.size() != static_cast<size_t>(n_qubits_)) {
+        throw std::invalid_argument(
+            fmt::format("Basis state should have {} bits, but get {}.", n_qubits_, bits.size()));
+    }
+    uint64_t state = 0;
+    for (qbit_t q = 0; q < n_qubits_; ++q) {
+        state |= static_cast<uint64_t>(bits[q] != 0) << q;
+    }
+    if (CountOne(state) != static_cast<uint64_t>(n_particles_)) {
+        return 0;
+    }
+    return qs_[Rank(state)];
+}
+
+void ParticleState::SetSubspaceQS(const VT<py_qs_data_t>& qs) {
+    if (qs.size() != dim_) {
+        throw std::invalid_argument(
+            fmt::format("Subspace state should have {} amplitudes, but get {}.", dim_, qs.size()));
+    }
+    qs_ = qs;
+}
+
+auto ParticleState::GetQS() const -> VT<py_qs_data_t> {
+    if (n_qubits_ > 30) {
+        throw std::runtime_error("Full state vector is only available for at most 30 qubits.");
+    }
+    VT<py_qs_data_t> out(index_t(1) << n_qubits_, 0);
+    ForChunks([&](index_t, index_t begin, index_t end) {
+        ForRange(begin, end, [&](index_t rank, uint64_t state) { out[state] = qs_[rank]; });
+    });
+    return out;
+}
+}  // namespace mindquantum::sim::subspace
@@ -0,0 +1,503 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/tensornet/tensor_network.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include "core/trace.h"
+#include "ops/gate_id.h"
+#include "simulator/mps/mps_state.h"
+
+namespace mindquantum::sim::tensornet {
+namespace {
+using matrix_t = mps::MPSState::matrix_t;
+using edge_set_t = std::vector<index_t>;
+
+//! Builds the tensors of a circuit, wire_[q] being the open edge of qubit q.
+class NetworkBuilder {
+ public:
+    explicit NetworkBuilder(qbit_t n_qubits) : wire_(n_qubits, 0) {
+    }
+
+    //! Start qubit q in |0>.
+    void Start(qbit_t q) {
+        wire_[q] = next_edge_++;
+        network_.push_back({{wire_[q]}, {1, 0}});
+    }
+
+    //! Apply a matrix, bit j of its local index being qubits[j].
+    void Apply(const qbits_t& qubits, const matrix_t& m) {
+        auto k = qubits.size();
+        auto dim = index_t(1) << k;
+        Tensor t;
+        for (size_t j = 0; j < k; ++j) {
+            t.edges.push_back(next_edge_++);
+        }
+        for (auto q : qubits) {
+            t.edges.push_back(wire_[q]);
+        }
+        for (size_t j = 0; j < k; ++j) {
+            wire_[qubits[j]] = t.edges[j];
+        }
+        t.data.resize(dim * dim);
+        for (index_t col = 0; col < dim; ++col) {
+            for (index_t row = 0; row < dim; ++row) {
+                t.data[row | (col << k)] = m(row, col);
+            }
+        }
+        network_.push_back(std::move(t));
+    }
+
+    //! Project qubit q on <bit|.
+    void Close(qbit_t q, uint8_t bit) {
+        network_.push_back({{wire_[q]}, bit ? std::vector<amp_t>{0, 1} : std::vector<amp_t>{1, 0}});
+    }
+
+    std::vector<Tensor>& Network() {
+        return network_;
+    }
+
+ private:
+    std::vector<index_t> wire_;
+    std::vector<Tensor> network_;
+    index_t next_edge_ = 0;
+};
+
+//! Qubits of a gate, controls last, and its matrix acting when all controls are set.
+std::pair<qbits_t, matrix_t> FullMatrix(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr) {
+    auto m = mps::MPSState::GateMatrix(gate, pr, "tensor network");
+    qbits_t qubits = gate->obj_qubits_;
+    if (!gate->ctrl_qubits_.empty()) {
+        qubits.insert(qubits.end(), gate->ctrl_qubits_.begin(), gate->ctrl_qubits_.end());
+        auto dim = index_t(1) << qubits.size();
+        matrix_t full = matrix_t::Identity(dim, dim);
+        full.bottomRightCorner(m.rows(), m.cols()) = m;
+        m = std::move(full);
+    }
+    return {qubits, m};
+}
+
+matrix_t PauliMatrix(char pauli) {
+    matrix_t m = matrix_t::Zero(2, 2);
+    switch (pauli) {
+        case 'X':
+            m(0, 1) = m(1, 0) = 1;
+            break;
+        case 'Y':
+            m(0, 1) = amp_t(0, -1);
+            m(1, 0) = amp_t(0, 1);
+            break;
+        case 'Z':
+            m(0, 0) = 1;
+            m(1, 1) = -1;
+            break;
+        default:
+            throw std::invalid_argument(fmt::format("Unknown Pauli {}.", pauli));
+    }
+    return m;
+}
+
+edge_set_t Union(const edge_set_t& a, const edge_set_t& b, size_t* n_shared) {
+    edge_set_t out;
+    std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    *n_shared = (a.size() + b.size() - out.size()) / 2;
+    return out;
+}
+
+//! Flops and largest rank of a path on the edge sets, without the sliced edges.
+void Evaluate(std::vector<edge_set_t> sets, ContractionPath* path, std::vector<edge_set_t>* intermediates) {
+    for (auto& set : sets) {
+        edge_set_t kept;
+        std::set_difference(set.begin(), set.end(), path->sliced.begin(), path->sliced.end(),
+                            std::back_inserter(kept));
+        set = std::move(kept);
+    }
+    path->flops = 0;
+    path->max_rank = 0;
+    for (const auto& set : sets) {
+        path->max_rank = std::max(path->max_rank, static_cast<qbit_t>(set.size()));
+    }
+    intermediates->clear();
+    for (auto [a, b] : path->steps) {
+        size_t n_shared = 0;
+        auto out = Union(sets[a], sets[b], &n_shared);
+        path->flops += std::ldexp(1.0, static_cast<int>(out.size() + n_shared));
+        path->max_rank = std::max(path->max_rank, static_cast<qbit_t>(out.size()));
+        sets.push_back(out);
+        intermediates->push_back(std::move(out));
+    }
+}
+
+//! Greedy path, merging the pair that shrinks the network most, with costs perturbed by a Gumbel noise.
+ContractionPath Greedy(std::vector<edge_set_t> sets, double temperature, std::mt19937* rng) {
+    ContractionPath path;
+    std::unordered_map<index_t, std::vector<size_t>> owners;
+    for (size_t i = 0; i < sets.size(); ++i) {
+        for (auto e : sets[i]) {
+            owners[e].push_back(i);
+        }
+    }
+    std::vector<bool> alive(sets.size(), true);
+    size_t n_alive = sets.size();
+    std::uniform_real_distribution<double> uniform(1e-12, 1 - 1e-12);
+    auto size = [](const edge_set_t& set) { return std::ldexp(1.0, static_cast<int>(set.size())); };
+    while (n_alive > 1) {
+        double best = std::numeric_limits<double>::infinity();
+        size_t best_a = 0;
+        size_t best_b = 0;
+        for (const auto& [edge, tensors] : owners) {
+            if (tensors.size() != 2) {
+                continue;
+            }
+            size_t n_shared = 0;
+            auto a = tensors[0];
+            auto b = tensors[1];
+            auto cost = size(Union(sets[a], sets[b], &n_shared)) - size(sets[a]) - size(sets[b]);
+            if (temperature > 0) {
+                cost -= temperature * (size(sets[a]) + size(sets[b])) * -std::log(-std::log(uniform(*rng)));
+            }
+            if (cost < best) {
+                best = cost;
+                best_a = std::min(a, b);
+                best_b = std::max(a, b);
+            }
+        }
+        if (best == std::numeric_limits<double>::infinity()) {
+            // Disconnected parts, take the outer product of the two smallest tensors.
+            std::vector<size_t> rest;
+            for (size_t i = 0; i < sets.size(); ++i) {
+                if (alive[i]) {
+                    rest.push_back(i);
+                }
+            }
+            std::partial_sort(rest.begin(), rest.begin() + 2, rest.end(),
+                              [&](size_t i, size_t j) { return sets[i].size() < sets[j].size(); });
+            best_a = std::min(rest[0], rest[1]);
+            best_b = std::max(rest[0], rest[1]);
+        }
+        size_t n_shared = 0;
+        auto out = Union(sets[best_a], sets[best_b], &n_shared);
+        auto c = sets.size();
+        for (auto t : {best_a, best_b}) {
+            for (auto e : sets[t]) {
+                auto& list = owners[e];
+                list.erase(std::remove(list.begin(), list.end(), t), list.end());
+                if (list.empty()) {
+                    owners.erase(e);
+                }
+            }
+            alive[t] = false;
+        }
+        for (auto e : out) {
+            owners[e].push_back(c);
+        }
+        sets.push_back(std::move(out));
+        alive.push_back(true);
+        path.steps.emplace_back(best_a, best_b);
+        n_alive -= 1;
+    }
+    return path;
+}
+
+//! Slice the edge found in most of the oversized intermediates, until all of them fit in max_rank.
+void Slice(const std::vector<edge_set_t>& sets, qbit_t max_rank, ContractionPath* path) {
+    std::vector<edge_set_t> intermediates;
+    Evaluate(sets, path, &intermediates);
+    while (path->max_rank > max_rank) {
+        std::unordered_map<index_t, index_t> count;
+        for (const auto& set : intermediates) {
+            if (static_cast<qbit_t>(set.size()) > max_rank) {
+                for (auto e : set) {
+                    count[e] += 1;
+                }
+            }
+        }
+        if (count.empty()) {
+            // Only an input tensor is too large, which does not happen for gates on a few qubits.
+            break;
+        }
+        auto edge = std::max_element(count.begin(), count.end(), [](const auto& a, const auto& b) {
+                        return a.second < b.second || (a.second == b.second && a.first > b.first);
+                    })->first;
+        path->sliced.insert(std::upper_bound(path->sliced.begin(), path->sliced.end(), edge), edge);
+        Evaluate(sets, path, &intermediates);
+    }
+}
+
+//! Keep the elements of t where edge is set to bit, dropping the edge.
+void Project(Tensor* t, index_t edge, index_t bit) {
+    auto pos = std::find(t->edges.begin(), t->edges.end(), edge) - t->edges.begin();
+    index_t low = (index_t(1) << pos) - 1;
+    std::vector<amp_t> data(t->data.size() / 2);
+    for (index_t i = 0; i < data.size(); ++i) {
+        data[i] = t->data[(i & low) | (bit << pos) | ((i & ~low) << 1)];
+    }
+    t->data = std::move(data);
+    t->edges.erase(t->edges.begin() + pos);
+}
+
+//! Data of t with its edges in the given order, t->data itself if they already are.
+const std::vector<amp_t>& Ordered(const Tensor& t, const edge_set_t& order, std::vector<amp_t>* buffer) {
+    if (t.edges == order) {
+        return t.data;
+    }
+    std::vector<index_t> pos(t.edges.size());
+    for (size_t j = 0; j < t.edges.size(); ++j) {
+        pos[j] = std::find(order.begin(), order.end(), t.edges[j]) - order.begin();
+    }
+    buffer->resize(t.data.size());
+    for (index_t i = 0; i < t.data.size(); ++i) {
+        index_t target = 0;
+        for (size_t j = 0; j < pos.size(); ++j) {
+            target |= ((i >> j) & 1) << pos[j];
+        }
+        (*buffer)[target] = t.data[i];
+    }
+    return *buffer;
+}
+}  // namespace
+
+TensorNetwork::TensorNetwork(qbit_t n_qubits, unsigned seed) : n_qubits_(n_qubits), rnd_eng_(seed) {
+    if (n_qubits < 1) {
+        throw std::invalid_argument(fmt::format("Number of qubits should be positive, but get {}.", n_qubits));
+    }
+}
+
+void TensorNetwork::SetMaxRank(qbit_t max_rank) {
+    if (max_rank < 4 || max_rank > 40) {
+        throw std::invalid_argument(fmt::format("Max rank should be in [4, 40], but get {}.", max_rank));
+    }
+    max_rank_ = max_rank;
+}
+
+void TensorNetwork::SetOrderTrials(index_t trials) {
+    if (trials < 1) {
+        throw std::invalid_argument("Number of order trials should be positive.");
+    }
+    trials_ = trials;
+}
+
+Tensor TensorNetwork::ContractPair(const Tensor& a, const Tensor& b) {
+    edge_set_t free_a;
+    edge_set_t shared;
+    for (auto e : a.edges) {
+        (std::find(b.edges.begin(), b.edges.end(), e) == b.edges.end() ? free_a : shared).push_back(e);
+    }
+    edge_set_t free_b;
+    for (auto e : b.edges) {
+        if (std::find(shared.begin(), shared.end(), e) == shared.end()) {
+            free_b.push_back(e);
+        }
+    }
+    // a as a (free_a x shared) and b as a (shared x free_b) column major matrix, the product is blocked by Eigen.
+    edge_set_t order_a = free_a;
+    order_a.insert(order_a.end(), shared.begin(), shared.end());
+    edge_set_t order_b = shared;
+    order_b.insert(order_b.end(), free_b.begin(), free_b.end());
+    std::vector<amp_t> buffer_a;
+    std::vector<amp_t> buffer_b;
+    const auto& data_a = Ordered(a, order_a, &buffer_a);
+    const auto& data_b = Ordered(b, order_b, &buffer_b);
+    auto rows = static_cast<Eigen::Index>(1) << free_a.size();
+    auto inner = static_cast<Eigen::Index>(1) << shared.size();
+    auto cols = static_cast<Eigen::Index>(1) << free_b.size();
+    Tensor out;
+    out.edges = free_a;
+    out.edges.insert(out.edges.end(), free_b.begin(), free_b.end());
+    out.data.resize(rows * cols);
+    Eigen::Map<const matrix_t> ma(data_a.data(), rows, inner);
+    Eigen::Map<const matrix_t> mb(data_b.data(), inner, cols);
+    Eigen::Map<matrix_t> mc(out.data.data(), rows, cols);
+    mc.noalias() = ma * mb;
+    return out;
+}
+
+ContractionPath TensorNetwork::FindPath(const std::vector<Tensor>& network) {
+    MQ_TRACE_SCOPE("TensorNetworkFindPath", "simulator");
+    std::vector<edge_set_t> sets;
+    for (const auto& t : network) {
+        sets.push_back(t.edges);
+        std::sort(sets.back().begin(), sets.back().end());
+    }
+    ContractionPath best;
+    double best_cost = std::numeric_limits<double>::infinity();
+    for (index_t trial = 0; trial < trials_; ++trial) {
+        auto path = Greedy(sets, trial == 0 ? 0.0 : 0.5, &rnd_eng_);
+        Slice(sets, max_rank_, &path);
+        auto cost = std::ldexp(path.flops, static_cast<int>(path.sliced.size()));
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = std::move(path);
+        }
+    }
+    return best;
+}
+
+amp_t TensorNetwork::Contract(const std::vector<Tensor>& network, const ContractionPath& path) {
+    MQ_TRACE_SCOPE("TensorNetworkContract", "simulator");
+    amp_t out = 0;
+    auto n_slices = index_t(1) << path.sliced.size();
+    for (index_t slice = 0; slice < n_slices; ++slice) {
+        std::vector<Tensor> tensors = network;
+        for (size_t s = 0; s < path.sliced.size(); ++s) {
+            auto edge = path.sliced[s];
+            for (auto& t : tensors) {
+                if (std::find(t.edges.begin(), t.edges.end(), edge) != t.edges.end()) {
+                    Project(&t, edge, (slice >> s) & 1);
+                }
+            }
+        }
+        for (auto [a, b] : path.steps) {
+            tensors.push_back(ContractPair(tensors[a], tensors[b]));
+            tensors[a] = Tensor();
+            tensors[b] = Tensor();
+        }
+        const auto& result = tensors.back();
+        if (!result.edges.empty()) {
+            throw std::runtime_error("Tensor network contracts to a tensor with open edges.");
+        }
+        out += result.data[0];
+    }
+    return out;
+}
+
+VT<amp_t> TensorNetwork::GetAmplitudes(const circuit_t& circ, const VT<VT<uint8_t>>& bits,
+                                       const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("TensorNetworkAmplitudes", "simulator");
+    for (const auto& b : bits) {
+        if (b.size() != static_cast<size_t>(n_qubits_)) {
+            throw std::invalid_argument(fmt::format("Basis state should have {} bits, but get {}.", n_qubits_, b.size()));
+        }
+    }
+    NetworkBuilder builder(n_qubits_);
+    for (qbit_t q = 0; q < n_qubits_; ++q) {
+        builder.Start(q);
+    }
+    for (const auto& gate : circ) {
+        for (const auto* qubits : {&gate->obj_qubits_, &gate->ctrl_qubits_}) {
+            for (auto q : *qubits) {
+                if (q >= n_qubits_) {
+                    throw std::invalid_argument(fmt::format("Qubit {} out of range of {} qubits.", q, n_qubits_));
+                }
+            }
+        }
+        if (gate->id_ == GateID::M) {
+            throw std::invalid_argument("Tensor network does not support measurement.");
+        }
+        if (gate->id_ != GateID::I) {
+            auto [qubits, m] = FullMatrix(gate, pr);
+            builder.Apply(qubits, m);
+        }
+    }
+    for (qbit_t q = 0; q < n_qubits_; ++q) {
+        builder.Close(q, 0);
+    }
+    auto& network = builder.Network();
+    // The path only depends on the edges, the bits change the n last tensors.
+    last_path_ = FindPath(network);
+    VT<amp_t> out;
+    for (const auto& b : bits) {
+        for (qbit_t q = 0; q < n_qubits_; ++q) {
+            auto& cap = network[network.size() - n_qubits_ + q].data;
+            cap = b[q] ? std::vector<amp_t>{0, 1} : std::vector<amp_t>{1, 0};
+        }
+        out.push_back(Contract(network, last_path_));
+    }
+    return out;
+}
+
+amp_t TensorNetwork::GetExpectation(const Hamiltonian<double>& ham, const circuit_t& circ,
+                                    const parameter::ParameterResolver& pr) {
+    MQ_TRACE_SCOPE("TensorNetworkExpectation", "simulator");
+    if (ham.how_to_ == FRONTEND) {
+        throw std::invalid_argument("Tensor network needs a Hamiltonian given as Pauli terms.");
+    }
+    for (const auto& gate : circ) {
+        for (const auto* qubits : {&gate->obj_qubits_, &gate->ctrl_qubits_}) {
+            for (auto q : *qubits) {
+                if (q >= n_qubits_) {
+                    throw std::invalid_argument(fmt::format("Qubit {} out of range of {} qubits.", q, n_qubits_));
+                }
+            }
+        }
+        if (gate->id_ == GateID::M) {
+            throw std::invalid_argument("Tensor network does not support measurement.");
+        }
+    }
+    amp_t out = 0;
+    for (const auto& [pauli_string, coeff] : ham.ham_) {
+        if (pauli_string.empty()) {
+            out += coeff;
+            continue;
+        }
+        // Backward light cone of the term, the other gates cancel in U^dagger P U.
+        std::vector<bool> in_cone(n_qubits_, false);
+        for (const auto& [qubit, word] : pauli_string) {
+            if (static_cast<qbit_t>(qubit) >= n_qubits_) {
+                throw std::invalid_argument(fmt::format("Hamiltonian acts on qubit {} out of range.", qubit));
+            }
+            in_cone[qubit] = true;
+        }
+        std::vector<std::pair<qbits_t, matrix_t>> kept;
+        for (auto it = circ.rbegin(); it != circ.rend(); ++it) {
+            const auto& gate = *it;
+            if (gate->id_ == GateID::I) {
+                continue;
+            }
+            qbits_t qubits = gate->obj_qubits_;
+            qubits.insert(qubits.end(), gate->ctrl_qubits_.begin(), gate->ctrl_qubits_.end());
+            if (std::none_of(qubits.begin(), qubits.end(), [&](qbit_t q) { return in_cone[q]; })) {
+                continue;
+            }
+            for (auto q : qubits) {
+                in_cone[q] = true;
+            }
+            kept.push_back(FullMatrix(gate, pr));
+        }
+        NetworkBuilder builder(n_qubits_);
+        for (qbit_t q = 0; q < n_qubits_; ++q) {
+            if (in_cone[q]) {
+                builder.Start(q);
+            }
+        }
+        for (auto it = kept.rbegin(); it != kept.rend(); ++it) {
+            builder.Apply(it->first, it->second);
+        }
+        for (const auto& [qubit, word] : pauli_string) {
+            builder.Apply({static_cast<qbit_t>(qubit)}, PauliMatrix(word));
+        }
+        for (const auto& [qubits, m] : kept) {
+            builder.Apply(qubits, m.adjoint());
+        }
+        for (qbit_t q = 0; q < n_qubits_; ++q) {
+            if (in_cone[q]) {
+                builder.Close(q, 0);
+            }
+        }
+        last_path_ = FindPath(builder.Network());
+        out += coeff * Contract(builder.Network(), last_path_);
+    }
+    return out;
+}
+}  // namespace mindquantum::sim::tensornet
@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/transport.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#if !defined(_WIN32)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+#ifdef ENABLE_MPI
+#    include <limits>
+
+#    include <mpi.h>
+#endif
+
+#include <fmt/format.h>
+
+namespace mindquantum::sim {
+namespace {
+// The header takes one cache line, mailboxes are aligned on cache lines.
+constexpr size_t header_bytes = 64;
+}  // namespace
+
+ShmTransport::ShmTransport(const std::string& name, int rank, int size, size_t buffer_bytes)
+    : rank_(rank), size_(size), buffer_bytes_(buffer_bytes / header_bytes * header_bytes) {
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared memory barrier needs lock free atomics.");
+    if (size <= 0 || rank < 0 || rank >= size) {
+        throw std::invalid_argument(fmt::format("Invalid rank {} for {} ranks.", rank, size));
+    }
+    if (buffer_bytes_ == 0) {
+        throw std::invalid_argument(fmt::format("Mailbox should have at least {} bytes.", header_bytes));
+    }
+#if defined(_WIN32)
+    throw std::runtime_error("Shared memory transport is not supported on Windows.");
+#else
+    segment_bytes_ = header_bytes + buffer_bytes_ * static_cast<size_t>(size);
+    auto shm_name = name.empty() || name[0] != '/' ? "/" + name : name;
+    int fd = shm_open(shm_name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Cannot open shared memory {}: {}", shm_name, std::strerror(errno)));
+    }
+    // A new segment reads as zeros, which is a valid state of the barrier. Every rank sets the same size.
+    if (ftruncate(fd, static_cast<off_t>(segment_bytes_)) != 0) {
+        auto err = errno;
+        close(fd);
+        throw std::runtime_error(fmt::format("Cannot resize shared memory {}: {}", shm_name, std::strerror(err)));
+    }
+    segment_ = mmap(nullptr, segment_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto err = errno;
+    close(fd);
+    if (segment_ == MAP_FAILED) {
+        segment_ = nullptr;
+        throw std::runtime_error(fmt::format("Cannot map shared memory {}: {}", shm_name, std::strerror(err)));
+    }
+    header_ = reinterpret_cast<Header*>(segment_);
+    Barrier();
+    if (rank_ == 0) {
+        shm_unlink(shm_name.c_str());
+    }
+#endif
+}
+
+ShmTransport::~ShmTransport() {
+#if !defined(_WIN32)
+    if (segment_ != nullptr) {
+        munmap(segment_, segment_bytes_);
+    }
+#endif
+}
+
+char* ShmTransport::Mailbox(int rank) const {
+    return reinterpret_cast<char*>(segment_) + header_bytes + buffer_bytes_ * static_cast<size_t>(rank);
+}
+
+void ShmTransport::Barrier() {
+    // Sense reversing barrier, the last rank to arrive flips the shared sense.
+    local_sense_ ^= 1U;
+    if (header_->count.fetch_add(1, std::memory_order_acq_rel) + 1 == static_cast<uint32_t>(size_)) {
+        header_->count.store(0, std::memory_order_relaxed);
+        header_->sense.store(local_sense_, std::memory_order_release);
+        return;
+    }
+    while (header_->sense.load(std::memory_order_acquire) != local_sense_) {
+        std::this_thread::yield();
+    }
+}
+
+void ShmTransport::SendRecv(const void* send, void* recv, size_t bytes, int peer) {
+    auto src = reinterpret_cast<const char*>(send);
+    auto des = reinterpret_cast<char*>(recv);
+    for (size_t offset = 0; offset < bytes; offset += buffer_bytes_) {
+        auto n = std::min(buffer_bytes_, bytes - offset);
+        std::memcpy(Mailbox(rank_), src + offset, n);
+        Barrier();
+        std::memcpy(des + offset, Mailbox(peer), n);
+        Barrier();
+    }
+}
+
+void ShmTransport::AllGather(const void* send, void* recv, size_t bytes) {
+    auto src = reinterpret_cast<const char*>(send);
+    auto des = reinterpret_cast<char*>(recv);
+    for (size_t offset = 0; offset < bytes; offset += buffer_bytes_) {
+        auto n = std::min(buffer_bytes_, bytes - offset);
+        std::memcpy(Mailbox(rank_), src + offset, n);
+        Barrier();
+        for (int rank = 0; rank < size_; ++rank) {
+            std::memcpy(des + bytes * static_cast<size_t>(rank) + offset, Mailbox(rank), n);
+        }
+        Barrier();
+    }
+}
+
+void ShmTransport::AllReduceSum(double* data, size_t n) {
+    auto block = buffer_bytes_ / sizeof(double);
+    for (size_t offset = 0; offset < n; offset += block) {
+        auto len = std::min(block, n - offset);
+        std::memcpy(Mailbox(rank_), data + offset, len * sizeof(double));
+        Barrier();
+        // Every rank sums in the same order, so all ranks get bitwise identical results.
+        std::fill(data + offset, data + offset + len, 0.0);
+        for (int rank = 0; rank < size_; ++rank) {
+            auto box = reinterpret_cast<const double*>(Mailbox(rank));
+            for (size_t i = 0; i < len; ++i) {
+                data[offset + i] += box[i];
+            }
+        }
+        Barrier();
+    }
+}
+
+#ifdef ENABLE_MPI
+namespace {
+// MPI counts are int, larger messages are split.
+constexpr size_t mpi_block_bytes = 1UL << 30;
+
+void CheckMpi(int code, const char* what) {
+    if (code != MPI_SUCCESS) {
+        throw std::runtime_error(fmt::format("{} failed with MPI error {}.", what, code));
+    }
+}
+}  // namespace
+
+MpiTransport::MpiTransport() {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized == 0) {
+        throw std::runtime_error("MPI should be initialized before creating an MpiTransport.");
+    }
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+    MPI_Comm_size(MPI_COMM_WORLD, &size_);
+}
+
+void MpiTransport::SendRecv(const void* send, void* recv, size_t bytes, int peer) {
+    auto src = reinterpret_cast<const char*>(send);
+    auto des = reinterpret_cast<char*>(recv);
+    for (size_t offset = 0; offset < bytes; offset += mpi_block_bytes) {
+        auto n = static_cast<int>(std::min(mpi_block_bytes, bytes - offset));
+        CheckMpi(MPI_Sendrecv(src + offset, n, MPI_BYTE, peer, 0, des + offset, n, MPI_BYTE, peer, 0, MPI_COMM_WORLD,
+                              MPI_STATUS_IGNORE),
+                 "MPI_Sendrecv");
+    }
+}
+
+void MpiTransport::AllGather(const void* send, void* recv, size_t bytes) {
+    if (bytes > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("MpiTransport::AllGather is limited to 2 GB per rank.");
+    }
+    CheckMpi(MPI_Allgather(send, static_cast<int>(bytes), MPI_BYTE, recv, static_cast<int>(bytes), MPI_BYTE,
+                           MPI_COMM_WORLD),
+             "MPI_Allgather");
+}
+
+void MpiTransport::AllReduceSum(double* data, size_t n) {
+    constexpr size_t block = mpi_block_bytes / sizeof(double);
+    for (size_t offset = 0; offset < n; offset += block) {
+        auto len = static_cast<int>(std::min(block, n - offset));
+        CheckMpi(MPI_Allreduce(MPI_IN_PLACE, data + offset, len, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD),
+                 "MPI_Allreduce");
+    }
+}
+
+void MpiTransport::Barrier() {
+    CheckMpi(MPI_Barrier(MPI_COMM_WORLD), "MPI_Barrier");
+}
+#endif  // ENABLE_MPI
+}  // namespace mindquantum::sim
@@ -16,8 +16,12 @@
 
 #include "simulator/utils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <numeric>
+#include <stdexcept>
+
+#include "core/utils.h"
 
 namespace mindquantum::sim {
 index_t QIndexToMask(qbits_t objs) {
@@ -37,6 +41,40 @@ PauliMask GenPauliMask(const std::vector<PauliWord> &pws) {
     return {out[0], out[1], out[2], out[3], out[4], out[5]};
 }
 
+PauliMask GenPauliMask(const qbits_t &objs, const std::string &paulis) {
+    std::vector<PauliWord> pws;
+    for (size_t i = 0; i < objs.size(); i++) {
+        pws.emplace_back(objs[i], paulis[i]);
+    }
+    return GenPauliMask(pws);
+}
+
+ExcitationMask::ExcitationMask(const qbits_t &obj_qubits, const qbits_t &ctrl_qubits) {
+    n_modes = obj_qubits.size();
+    if (n_modes != 2 && n_modes != 4) {
+        throw std::invalid_argument("Excitation gate should act on two or four modes.");
+    }
+    for (qbit_t i = 0; i < n_modes; i++) {
+        (i < n_modes / 2 ? create_mask : annihilate_mask) |= index_t(1) << obj_qubits[i];
+    }
+    obj_mask = create_mask | annihilate_mask;
+    if (static_cast<qbit_t>(CountOne(obj_mask)) != n_modes) {
+        throw std::invalid_argument("Modes of excitation gate should be different.");
+    }
+    ctrl_mask = QIndexToMask(ctrl_qubits);
+    std::copy(obj_qubits.begin(), obj_qubits.end(), sorted_qubits);
+    std::sort(sorted_qubits, sorted_qubits + n_modes);
+    // Apply the operators of T from the right, each one picking the parity of the occupied modes below it. The modes
+    // outside the excitation are left untouched, so their part of the parity is a single mask.
+    index_t occupied = annihilate_mask;
+    for (qbit_t i = n_modes - 1; i >= 0; i--) {
+        auto low = (index_t(1) << obj_qubits[i]) - 1;
+        sign_bit ^= CountOne(occupied & low & obj_mask) & 1;
+        parity_mask ^= low & ~obj_mask;
+        occupied ^= index_t(1) << obj_qubits[i];
+    }
+}
+
 SingleQubitGateMask::SingleQubitGateMask(const qbits_t &obj_qubits, const qbits_t &ctrl_qubits) {
     assert(obj_qubits.size() == 1);
     q0 = obj_qubits[0];
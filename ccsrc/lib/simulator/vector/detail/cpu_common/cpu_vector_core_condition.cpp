@@ -25,6 +25,8 @@
 #    include "simulator/vector/detail/cpu_vector_arm_double_policy.h"
 #    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
 #endif
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #include "simulator/vector/detail/cpu_vector_policy.h"
 namespace mindquantum::sim::vector::detail {
 template <typename derived_, typename calc_type_>
@@ -120,7 +122,7 @@ template <typename derived_, typename calc_type_>
 auto CPUVectorPolicyBase<derived_, calc_type_>::ConditionalCollect(const qs_data_p_t& qs, index_t mask, index_t condi,
                                                                    bool abs, index_t dim) -> qs_data_t {
     // collect amplitude with index mask satisfied condition.
-    calc_type res_real = 0, res_imag = 0;
+    acc_type res_real = 0, res_imag = 0;
     if (qs == nullptr) {
         if (abs) {
             if ((0 & mask) == condi) {
@@ -139,7 +141,8 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ConditionalCollect(const qs_data
             MQ_DO_PRAGMA(omp parallel for schedule(static) reduction(+: res_real)), dim, DimTh,
                          for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) {
                              if ((i & mask) == condi) {
-                                 res_real += qs[i].real() * qs[i].real() + qs[i].imag() * qs[i].imag();
+                                 acc_type re = qs[i].real(), im = qs[i].imag();
+                                 res_real += re * re + im * im;
                              }
                          });
     } else {
@@ -162,4 +165,6 @@ template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmDouble, double>;
 #endif
+template struct CPUVectorPolicyBase<CPUVectorPolicyMixed, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double>;
 }  // namespace mindquantum::sim::vector::detail
@@ -26,6 +26,8 @@
 #    include "simulator/vector/detail/cpu_vector_arm_double_policy.h"
 #    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
 #endif
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #include "simulator/vector/detail/cpu_vector_policy.h"
 
 namespace mindquantum::sim::vector::detail {
@@ -39,16 +41,16 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::Vdot(const qs_data_p_t& bra, con
     } else if (ket == nullptr) {
         return std::conj(bra[0]);
     }
-    calc_type res_real = 0, res_imag = 0;
+    acc_type res_real = 0, res_imag = 0;
     // clang-format off
     THRESHOLD_OMP(
         MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
             for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) {
-                res_real += bra[i].real() * ket[i].real() + bra[i].imag() * ket[i].imag();
-                res_imag += bra[i].real() * ket[i].imag() - bra[i].imag() * ket[i].real();
+                res_real += acc_type(bra[i].real()) * ket[i].real() + acc_type(bra[i].imag()) * ket[i].imag();
+                res_imag += acc_type(bra[i].real()) * ket[i].imag() - acc_type(bra[i].imag()) * ket[i].real();
             })
     // clang-format on
-    return {res_real, res_imag};
+    return py_qs_data_t(res_real, res_imag);
 }
 
 template <typename derived_, typename calc_type_>
@@ -71,18 +73,18 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ConditionVdot(const qs_data_p_t&
         }
         return 0.0;
     }
-    calc_type res_real = 0, res_imag = 0;
+    acc_type res_real = 0, res_imag = 0;
     // clang-format off
     THRESHOLD_OMP(
         MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
             for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) {
                 if ((i & mask) == condi) {
-                    res_real += bra[i].real() * ket[i].real() + bra[i].imag() * ket[i].imag();
-                    res_imag += bra[i].real() * ket[i].imag() - bra[i].imag() * ket[i].real();
+                    res_real += acc_type(bra[i].real()) * ket[i].real() + acc_type(bra[i].imag()) * ket[i].imag();
+                    res_imag += acc_type(bra[i].real()) * ket[i].imag() - acc_type(bra[i].imag()) * ket[i].real();
                 }
             })
     // clang-format on
-    return {res_real, res_imag};
+    return py_qs_data_t(res_real, res_imag);
 }
 
 template <typename derived_, typename calc_type_>
@@ -92,17 +94,17 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::OneStateVdot(const qs_data_p_t&
         return 0.0;
     }
     SingleQubitGateMask mask({obj_qubit}, {});
-    calc_type res_real = 0, res_imag = 0;
+    acc_type res_real = 0, res_imag = 0;
     // clang-format off
     THRESHOLD_OMP(
         MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
             for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
                 auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask) + mask.obj_mask;
-                res_real += bra[i].real() * ket[i].real() + bra[i].imag() * ket[i].imag();
-                res_imag += bra[i].real() * ket[i].imag() - bra[i].imag() * ket[i].real();
+                res_real += acc_type(bra[i].real()) * ket[i].real() + acc_type(bra[i].imag()) * ket[i].imag();
+                res_imag += acc_type(bra[i].real()) * ket[i].imag() - acc_type(bra[i].imag()) * ket[i].real();
             })
     // clang-format on
-    return {res_real, res_imag};
+    return py_qs_data_t(res_real, res_imag);
 }
 
 template <typename derived_, typename calc_type_>
@@ -116,17 +118,17 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ZeroStateVdot(const qs_data_p_t&
         return std::conj(bra[0]);
     }
     SingleQubitGateMask mask({obj_qubit}, {});
-    calc_type res_real = 0, res_imag = 0;
+    acc_type res_real = 0, res_imag = 0;
     // clang-format off
     THRESHOLD_OMP(
         MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
             for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
                 auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask);
-                res_real += bra[i].real() * ket[i].real() + bra[i].imag() * ket[i].imag();
-                res_imag += bra[i].real() * ket[i].imag() - bra[i].imag() * ket[i].real();
+                res_real += acc_type(bra[i].real()) * ket[i].real() + acc_type(bra[i].imag()) * ket[i].imag();
+                res_imag += acc_type(bra[i].real()) * ket[i].imag() - acc_type(bra[i].imag()) * ket[i].real();
             })
     // clang-format on
-    return {res_real, res_imag};
+    return py_qs_data_t(res_real, res_imag);
 }
 
 template <typename derived_, typename calc_type_>
@@ -159,6 +161,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<
     bool will_free = false;
     if (vec == nullptr) {
         vec = derived::InitState(dim);
+        will_free = true;
     }
     auto out = sparse::Csr_Dot_Vec<calc_type, calc_type>(a, b, reinterpret_cast<calc_type*>(vec));
     if (will_free) {
@@ -231,4 +234,6 @@ template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmDouble, double>;
 #endif
+template struct CPUVectorPolicyBase<CPUVectorPolicyMixed, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double>;
 }  // namespace mindquantum::sim::vector::detail
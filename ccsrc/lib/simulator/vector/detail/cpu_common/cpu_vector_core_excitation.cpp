@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "config/openmp.h"
+#include "core/utils.h"
+#include "simulator/utils.h"
+#ifdef __x86_64__
+#    include "simulator/vector/detail/cpu_vector_avx_double_policy.h"
+#    include "simulator/vector/detail/cpu_vector_avx_float_policy.h"
+#elif defined(__amd64)
+#    include "simulator/vector/detail/cpu_vector_arm_double_policy.h"
+#    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
+#endif
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
+#include "simulator/vector/detail/cpu_vector_policy.h"
+namespace mindquantum::sim::vector::detail {
+template <typename derived_, typename calc_type_>
+void CPUVectorPolicyBase<derived_, calc_type_>::ApplyExcitation(qs_data_p_t* qs_p, const qbits_t& objs,
+                                                                const qbits_t& ctrls, calc_type val, index_t dim,
+                                                                bool diff) {
+    auto& qs = *qs_p;
+    if (qs == nullptr) {
+        qs = derived::InitState(dim);
+    }
+    ExcitationMask mask(objs, ctrls);
+    auto theta = static_cast<acc_type>(val);
+    auto c = std::cos(theta);
+    auto s = std::sin(theta);
+    if (diff) {
+        c = -std::sin(theta);
+        s = std::cos(theta);
+    }
+    // Each block of 2^n_modes amplitudes sharing the other qubits holds one pair, a with the annihilated modes occupied
+    // and b = T|a> up to the Jordan-Wigner sign. The rest of the block is left unchanged by the gate.
+    index_t n_block = index_t(1) << mask.n_modes;
+    THRESHOLD_OMP_FOR(
+        dim, DimTh, for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim >> mask.n_modes); l++) {
+            index_t i;
+            SHIFT_BIT_N(mask.sorted_qubits, mask.n_modes, static_cast<index_t>(l), i);
+            if ((i & mask.ctrl_mask) == mask.ctrl_mask) {
+                auto a = i | mask.annihilate_mask;
+                auto b = i | mask.create_mask;
+                auto sc = ((CountOne(a & mask.parity_mask) ^ mask.sign_bit) & 1) ? -s : s;
+                acc_data_t va = qs[a];
+                acc_data_t vb = qs[b];
+                qs[a] = qs_data_t(c * va - sc * vb);
+                qs[b] = qs_data_t(c * vb + sc * va);
+                if (diff) {
+                    // The derivative vanishes outside of the rotated pair.
+                    for (index_t m = 0; m < n_block; m++) {
+                        auto j = i;
+                        for (qbit_t k = 0; k < mask.n_modes; k++) {
+                            j |= ((m >> k) & 1) << mask.sorted_qubits[k];
+                        }
+                        if (j != a && j != b) {
+                            qs[j] = 0;
+                        }
+                    }
+                }
+            }
+        })
+    if (diff && mask.ctrl_mask) {
+        derived::SetToZeroExcept(qs_p, mask.ctrl_mask, dim);
+    }
+}
+
+#ifdef __x86_64__
+template struct CPUVectorPolicyBase<CPUVectorPolicyAvxFloat, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
+#elif defined(__amd64)
+template struct CPUVectorPolicyBase<CPUVectorPolicyArmFloat, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyArmDouble, double>;
+#endif
+template struct CPUVectorPolicyBase<CPUVectorPolicyMixed, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double>;
+}  // namespace mindquantum::sim::vector::detail
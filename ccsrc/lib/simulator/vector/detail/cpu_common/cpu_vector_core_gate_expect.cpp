@@ -24,6 +24,8 @@
 #    include "simulator/vector/detail/cpu_vector_arm_double_policy.h"
 #    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
 #endif
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #include "simulator/vector/detail/cpu_vector_policy.h"
 namespace mindquantum::sim::vector::detail {
 template <typename derived_, typename calc_type_>
@@ -62,17 +64,18 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffNQubitsMatrix(const qs
         obj_masks.push_back(mask_j);
     }
     auto obj_mask = obj_masks.back();
-    calc_type res_real = 0, res_imag = 0;
+    acc_type res_real = 0, res_imag = 0;
     THRESHOLD_OMP(
         MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
                                                 for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim); l++) {
                                                     if (((l & ctrl_mask) == ctrl_mask) && ((l & obj_mask) == 0)) {
                                                         for (size_t i = 0; i < m_dim; i++) {
-                                                            qs_data_t tmp = 0;
+                                                            acc_data_t tmp = 0;
                                                             for (size_t j = 0; j < m_dim; j++) {
-                                                                tmp += gate[i][j] * ket[obj_masks[j] | l];
+                                                                tmp += acc_data_t(gate[i][j])
+                                                                       * acc_data_t(ket[obj_masks[j] | l]);
                                                             }
-                                                            tmp = std::conj(bra[obj_masks[i] | l]) * tmp;
+                                                            tmp = std::conj(acc_data_t(bra[obj_masks[i] | l])) * tmp;
                                                             res_real += tmp.real();
                                                             res_imag += tmp.imag();
                                                         }
@@ -84,7 +87,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffNQubitsMatrix(const qs
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 }
 
 template <typename derived_, typename calc_type_>
@@ -105,7 +108,13 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffTwoQubitsMatrix(const
         will_free_ket = true;
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    calc_type res_real = 0, res_imag = 0;
+    acc_data_t g[4][4];
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            g[r][c] = gate[r][c];
+        }
+    }
+    acc_type res_real = 0, res_imag = 0;
     // clang-format off
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP(
@@ -117,14 +126,15 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffTwoQubitsMatrix(const
             auto j = i + mask.obj_min_mask;
             auto k = i + mask.obj_max_mask;
             auto m = i + mask.obj_mask;
-            auto v00 = gate[0][0] * ket[i] + gate[0][1] * ket[j] + gate[0][2] * ket[k] + gate[0][3] * ket[m];
-            auto v01 = gate[1][0] * ket[i] + gate[1][1] * ket[j] + gate[1][2] * ket[k] + gate[1][3] * ket[m];
-            auto v10 = gate[2][0] * ket[i] + gate[2][1] * ket[j] + gate[2][2] * ket[k] + gate[2][3] * ket[m];
-            auto v11 = gate[3][0] * ket[i] + gate[3][1] * ket[j] + gate[3][2] * ket[k] + gate[3][3] * ket[m];
-            auto this_res = std::conj(bra[i]) * v00;
-            this_res += std::conj(bra[j]) * v01;
-            this_res += std::conj(bra[k]) * v10;
-            this_res += std::conj(bra[m]) * v11;
+            acc_data_t ki = ket[i], kj = ket[j], kk = ket[k], km = ket[m];
+            auto v00 = g[0][0] * ki + g[0][1] * kj + g[0][2] * kk + g[0][3] * km;
+            auto v01 = g[1][0] * ki + g[1][1] * kj + g[1][2] * kk + g[1][3] * km;
+            auto v10 = g[2][0] * ki + g[2][1] * kj + g[2][2] * kk + g[2][3] * km;
+            auto v11 = g[3][0] * ki + g[3][1] * kj + g[3][2] * kk + g[3][3] * km;
+            auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+            this_res += std::conj(acc_data_t(bra[j])) * v01;
+            this_res += std::conj(acc_data_t(bra[k])) * v10;
+            this_res += std::conj(acc_data_t(bra[m])) * v11;
             res_real += this_res.real();
             res_imag += this_res.imag();
         })
@@ -139,14 +149,15 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffTwoQubitsMatrix(const
                 auto m = i + mask.obj_mask;
                 auto j = i + mask.obj_min_mask;
                 auto k = i + mask.obj_max_mask;
-                auto v00 = gate[0][0] * ket[i] + gate[0][1] * ket[j] + gate[0][2] * ket[k] + gate[0][3] * ket[m];
-                auto v01 = gate[1][0] * ket[i] + gate[1][1] * ket[j] + gate[1][2] * ket[k] + gate[1][3] * ket[m];
-                auto v10 = gate[2][0] * ket[i] + gate[2][1] * ket[j] + gate[2][2] * ket[k] + gate[2][3] * ket[m];
-                auto v11 = gate[3][0] * ket[i] + gate[3][1] * ket[j] + gate[3][2] * ket[k] + gate[3][3] * ket[m];
-                auto this_res = std::conj(bra[i]) * v00;
-                this_res += std::conj(bra[j]) * v01;
-                this_res += std::conj(bra[k]) * v10;
-                this_res += std::conj(bra[m]) * v11;
+                acc_data_t ki = ket[i], kj = ket[j], kk = ket[k], km = ket[m];
+                auto v00 = g[0][0] * ki + g[0][1] * kj + g[0][2] * kk + g[0][3] * km;
+                auto v01 = g[1][0] * ki + g[1][1] * kj + g[1][2] * kk + g[1][3] * km;
+                auto v10 = g[2][0] * ki + g[2][1] * kj + g[2][2] * kk + g[2][3] * km;
+                auto v11 = g[3][0] * ki + g[3][1] * kj + g[3][2] * kk + g[3][3] * km;
+                auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                this_res += std::conj(acc_data_t(bra[j])) * v01;
+                this_res += std::conj(acc_data_t(bra[k])) * v10;
+                this_res += std::conj(acc_data_t(bra[m])) * v11;
                 res_real += this_res.real();
                 res_imag += this_res.imag();
             }
@@ -159,7 +170,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffTwoQubitsMatrix(const
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 };
 
 template <typename derived_, typename calc_type_>
@@ -180,7 +191,8 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffSingleQubitMatrix(cons
         will_free_ket = true;
     }
     SingleQubitGateMask mask(objs, ctrls);
-    calc_type res_real = 0, res_imag = 0;
+    acc_data_t g[2][2] = {{m[0][0], m[0][1]}, {m[1][0], m[1][1]}};
+    acc_type res_real = 0, res_imag = 0;
     if (!mask.ctrl_mask) {
         // clang-format off
         THRESHOLD_OMP(
@@ -188,9 +200,9 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffSingleQubitMatrix(cons
                 for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
                     auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask);
                     auto j = i + mask.obj_mask;
-                    auto t1 = m[0][0] * ket[i] + m[0][1] * ket[j];
-                    auto t2 = m[1][0] * ket[i] + m[1][1] * ket[j];
-                    auto this_res = std::conj(bra[i]) * t1 + std::conj(bra[j]) * t2;
+                    auto t1 = g[0][0] * acc_data_t(ket[i]) + g[0][1] * acc_data_t(ket[j]);
+                    auto t2 = g[1][0] * acc_data_t(ket[i]) + g[1][1] * acc_data_t(ket[j]);
+                    auto this_res = std::conj(acc_data_t(bra[i])) * t1 + std::conj(acc_data_t(bra[j])) * t2;
                     res_real += this_res.real();
                     res_imag += this_res.imag();
                 });
@@ -216,9 +228,9 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffSingleQubitMatrix(cons
                         auto i = ((l & first_high_mask) << 1) + (l & first_low_mask);
                         i = ((i & second_high_mask) << 1) + (i & second_low_mask) + mask.ctrl_mask;
                         auto j = i + mask.obj_mask;
-                        auto t1 = m[0][0] * ket[i] + m[0][1] * ket[j];
-                        auto t2 = m[1][0] * ket[i] + m[1][1] * ket[j];
-                        auto this_res = std::conj(bra[i]) * t1 + std::conj(bra[j]) * t2;
+                        auto t1 = g[0][0] * acc_data_t(ket[i]) + g[0][1] * acc_data_t(ket[j]);
+                        auto t2 = g[1][0] * acc_data_t(ket[i]) + g[1][1] * acc_data_t(ket[j]);
+                        auto this_res = std::conj(acc_data_t(bra[i])) * t1 + std::conj(acc_data_t(bra[j])) * t2;
                         res_real += this_res.real();
                         res_imag += this_res.imag();
                     });
@@ -231,9 +243,9 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffSingleQubitMatrix(cons
                         auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask);
                         if ((i & mask.ctrl_mask) == mask.ctrl_mask) {
                             auto j = i + mask.obj_mask;
-                            auto t1 = m[0][0] * ket[i] + m[0][1] * ket[j];
-                            auto t2 = m[1][0] * ket[i] + m[1][1] * ket[j];
-                            auto this_res = std::conj(bra[i]) * t1 + std::conj(bra[j]) * t2;
+                            auto t1 = g[0][0] * acc_data_t(ket[i]) + g[0][1] * acc_data_t(ket[j]);
+                            auto t2 = g[1][0] * acc_data_t(ket[i]) + g[1][1] * acc_data_t(ket[j]);
+                            auto this_res = std::conj(acc_data_t(bra[i])) * t1 + std::conj(acc_data_t(bra[j])) * t2;
                             res_real += this_res.real();
                             res_imag += this_res.imag();
                         }
@@ -247,7 +259,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffSingleQubitMatrix(cons
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 };
 
 template <typename derived_, typename calc_type_>
@@ -322,8 +334,9 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffPS(const qs_data_p_t&
         will_free_ket = true;
     }
     SingleQubitGateMask mask(objs, ctrls);
-    calc_type res_real = 0, res_imag = 0;
-    auto e = -std::sin(val) + IMAGE_I * std::cos(val);
+    acc_type res_real = 0, res_imag = 0;
+    auto theta = static_cast<acc_type>(val);
+    auto e = acc_data_t(-std::sin(theta), std::cos(theta));
 
     if (!mask.ctrl_mask) {
         // clang-format off
@@ -332,7 +345,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffPS(const qs_data_p_t&
                 for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
                     auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask);
                     auto j = i + mask.obj_mask;
-                    auto this_res = std::conj(bra[j]) * ket[j] * e;
+                    auto this_res = std::conj(acc_data_t(bra[j])) * acc_data_t(ket[j]) * e;
                     res_real += this_res.real();
                     res_imag += this_res.imag();
                 })
@@ -345,7 +358,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffPS(const qs_data_p_t&
                     auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask);
                     if ((i & mask.ctrl_mask) == mask.ctrl_mask) {
                         auto j = i + mask.obj_mask;
-                        auto this_res = std::conj(bra[j]) * ket[j] * e;
+                        auto this_res = std::conj(acc_data_t(bra[j])) * acc_data_t(ket[j]) * e;
                         res_real += this_res.real();
                         res_imag += this_res.imag();
                     }
@@ -358,7 +371,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffPS(const qs_data_p_t&
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 };
 
 template <typename derived_, typename calc_type_>
@@ -377,9 +390,10 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxx(const qs_data_p_t&
         will_free_ket = true;
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(-std::sin(val / 2) / 2);
-    auto s = static_cast<calc_type_>(std::cos(val / 2) / 2) * IMAGE_MI;
-    calc_type res_real = 0, res_imag = 0;
+    auto theta = static_cast<acc_type>(val);
+    auto c = -std::sin(theta / 2) / 2;
+    auto s = std::cos(theta / 2) / 2 * acc_data_t(IMAGE_MI);
+    acc_type res_real = 0, res_imag = 0;
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP(
             MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
@@ -390,14 +404,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxx(const qs_data_p_t&
                                                         auto m = i + mask.obj_mask;
                                                         auto j = i + mask.obj_min_mask;
                                                         auto k = i + mask.obj_max_mask;
-                                                        auto v00 = c * ket[i] + s * ket[m];
-                                                        auto v01 = c * ket[j] + s * ket[k];
-                                                        auto v10 = c * ket[k] + s * ket[j];
-                                                        auto v11 = c * ket[m] + s * ket[i];
-                                                        auto this_res = std::conj(bra[i]) * v00;
-                                                        this_res += std::conj(bra[j]) * v01;
-                                                        this_res += std::conj(bra[k]) * v10;
-                                                        this_res += std::conj(bra[m]) * v11;
+                                                        auto v00 = c * acc_data_t(ket[i]) + s * acc_data_t(ket[m]);
+                                                        auto v01 = c * acc_data_t(ket[j]) + s * acc_data_t(ket[k]);
+                                                        auto v10 = c * acc_data_t(ket[k]) + s * acc_data_t(ket[j]);
+                                                        auto v11 = c * acc_data_t(ket[m]) + s * acc_data_t(ket[i]);
+                                                        auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                        this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                        this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                        this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                         res_real += this_res.real();
                                                         res_imag += this_res.imag();
                                                     })
@@ -412,14 +426,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxx(const qs_data_p_t&
                                                             auto m = i + mask.obj_mask;
                                                             auto j = i + mask.obj_min_mask;
                                                             auto k = i + mask.obj_max_mask;
-                                                            auto v00 = c * ket[i] + s * ket[m];
-                                                            auto v01 = c * ket[j] + s * ket[k];
-                                                            auto v10 = c * ket[k] + s * ket[j];
-                                                            auto v11 = c * ket[m] + s * ket[i];
-                                                            auto this_res = std::conj(bra[i]) * v00;
-                                                            this_res += std::conj(bra[j]) * v01;
-                                                            this_res += std::conj(bra[k]) * v10;
-                                                            this_res += std::conj(bra[m]) * v11;
+                                                            auto v00 = c * acc_data_t(ket[i]) + s * acc_data_t(ket[m]);
+                                                            auto v01 = c * acc_data_t(ket[j]) + s * acc_data_t(ket[k]);
+                                                            auto v10 = c * acc_data_t(ket[k]) + s * acc_data_t(ket[j]);
+                                                            auto v11 = c * acc_data_t(ket[m]) + s * acc_data_t(ket[i]);
+                                                            auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                            this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                            this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                            this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                             res_real += this_res.real();
                                                             res_imag += this_res.imag();
                                                         }
@@ -431,7 +445,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxx(const qs_data_p_t&
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 };
 
 template <typename derived_, typename calc_type_>
@@ -450,9 +464,10 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxy(const qs_data_p_t&
         will_free_ket = true;
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(-std::sin(val / 2) / 2);
-    auto s = static_cast<calc_type_>(std::cos(val / 2) / 2);
-    calc_type res_real = 0, res_imag = 0;
+    auto theta = static_cast<acc_type>(val);
+    auto c = -std::sin(theta / 2) / 2;
+    auto s = std::cos(theta / 2) / 2;
+    acc_type res_real = 0, res_imag = 0;
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP(
             MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
@@ -463,14 +478,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxy(const qs_data_p_t&
                                                         auto m = i + mask.obj_mask;
                                                         auto j = i + mask.obj_min_mask;
                                                         auto k = i + mask.obj_max_mask;
-                                                        auto v00 = c * ket[i] - s * ket[m];
-                                                        auto v01 = c * ket[j] - s * ket[k];
-                                                        auto v10 = c * ket[k] + s * ket[j];
-                                                        auto v11 = c * ket[m] + s * ket[i];
-                                                        auto this_res = std::conj(bra[i]) * v00;
-                                                        this_res += std::conj(bra[j]) * v01;
-                                                        this_res += std::conj(bra[k]) * v10;
-                                                        this_res += std::conj(bra[m]) * v11;
+                                                        auto v00 = c * acc_data_t(ket[i]) - s * acc_data_t(ket[m]);
+                                                        auto v01 = c * acc_data_t(ket[j]) - s * acc_data_t(ket[k]);
+                                                        auto v10 = c * acc_data_t(ket[k]) + s * acc_data_t(ket[j]);
+                                                        auto v11 = c * acc_data_t(ket[m]) + s * acc_data_t(ket[i]);
+                                                        auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                        this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                        this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                        this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                         res_real += this_res.real();
                                                         res_imag += this_res.imag();
                                                     })
@@ -485,14 +500,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxy(const qs_data_p_t&
                                                             auto m = i + mask.obj_mask;
                                                             auto j = i + mask.obj_min_mask;
                                                             auto k = i + mask.obj_max_mask;
-                                                            auto v00 = c * ket[i] - s * ket[m];
-                                                            auto v01 = c * ket[j] - s * ket[k];
-                                                            auto v10 = c * ket[k] + s * ket[j];
-                                                            auto v11 = c * ket[m] + s * ket[i];
-                                                            auto this_res = std::conj(bra[i]) * v00;
-                                                            this_res += std::conj(bra[j]) * v01;
-                                                            this_res += std::conj(bra[k]) * v10;
-                                                            this_res += std::conj(bra[m]) * v11;
+                                                            auto v00 = c * acc_data_t(ket[i]) - s * acc_data_t(ket[m]);
+                                                            auto v01 = c * acc_data_t(ket[j]) - s * acc_data_t(ket[k]);
+                                                            auto v10 = c * acc_data_t(ket[k]) + s * acc_data_t(ket[j]);
+                                                            auto v11 = c * acc_data_t(ket[m]) + s * acc_data_t(ket[i]);
+                                                            auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                            this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                            this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                            this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                             res_real += this_res.real();
                                                             res_imag += this_res.imag();
                                                         }
@@ -504,7 +519,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxy(const qs_data_p_t&
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 };
 
 template <typename derived_, typename calc_type_>
@@ -523,9 +538,10 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxz(const qs_data_p_t&
         will_free_ket = true;
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(-std::sin(val / 2) / 2);
-    auto s = static_cast<calc_type_>(std::cos(val / 2) / 2) * IMAGE_MI;
-    calc_type res_real = 0, res_imag = 0;
+    auto theta = static_cast<acc_type>(val);
+    auto c = -std::sin(theta / 2) / 2;
+    auto s = std::cos(theta / 2) / 2 * acc_data_t(IMAGE_MI);
+    acc_type res_real = 0, res_imag = 0;
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP(
             MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
@@ -536,14 +552,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxz(const qs_data_p_t&
                                                         auto m = i + mask.obj_mask;
                                                         auto j = i + mask.obj_min_mask;
                                                         auto k = i + mask.obj_max_mask;
-                                                        auto v00 = c * ket[i] + s * ket[j];
-                                                        auto v01 = c * ket[j] + s * ket[i];
-                                                        auto v10 = c * ket[k] - s * ket[m];
-                                                        auto v11 = c * ket[m] - s * ket[k];
-                                                        auto this_res = std::conj(bra[i]) * v00;
-                                                        this_res += std::conj(bra[j]) * v01;
-                                                        this_res += std::conj(bra[k]) * v10;
-                                                        this_res += std::conj(bra[m]) * v11;
+                                                        auto v00 = c * acc_data_t(ket[i]) + s * acc_data_t(ket[j]);
+                                                        auto v01 = c * acc_data_t(ket[j]) + s * acc_data_t(ket[i]);
+                                                        auto v10 = c * acc_data_t(ket[k]) - s * acc_data_t(ket[m]);
+                                                        auto v11 = c * acc_data_t(ket[m]) - s * acc_data_t(ket[k]);
+                                                        auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                        this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                        this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                        this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                         res_real += this_res.real();
                                                         res_imag += this_res.imag();
                                                     })
@@ -558,14 +574,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxz(const qs_data_p_t&
                                                             auto m = i + mask.obj_mask;
                                                             auto j = i + mask.obj_min_mask;
                                                             auto k = i + mask.obj_max_mask;
-                                                            auto v00 = c * ket[i] + s * ket[j];
-                                                            auto v01 = c * ket[j] + s * ket[i];
-                                                            auto v10 = c * ket[k] - s * ket[m];
-                                                            auto v11 = c * ket[m] - s * ket[k];
-                                                            auto this_res = std::conj(bra[i]) * v00;
-                                                            this_res += std::conj(bra[j]) * v01;
-                                                            this_res += std::conj(bra[k]) * v10;
-                                                            this_res += std::conj(bra[m]) * v11;
+                                                            auto v00 = c * acc_data_t(ket[i]) + s * acc_data_t(ket[j]);
+                                                            auto v01 = c * acc_data_t(ket[j]) + s * acc_data_t(ket[i]);
+                                                            auto v10 = c * acc_data_t(ket[k]) - s * acc_data_t(ket[m]);
+                                                            auto v11 = c * acc_data_t(ket[m]) - s * acc_data_t(ket[k]);
+                                                            auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                            this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                            this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                            this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                             res_real += this_res.real();
                                                             res_imag += this_res.imag();
                                                         }
@@ -577,7 +593,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRxz(const qs_data_p_t&
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 };
 
 template <typename derived_, typename calc_type_>
@@ -596,9 +612,10 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRyz(const qs_data_p_t&
         will_free_ket = true;
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(-std::sin(val / 2) / 2);
-    auto s = static_cast<calc_type_>(std::cos(val / 2) / 2);
-    calc_type res_real = 0, res_imag = 0;
+    auto theta = static_cast<acc_type>(val);
+    auto c = -std::sin(theta / 2) / 2;
+    auto s = std::cos(theta / 2) / 2;
+    acc_type res_real = 0, res_imag = 0;
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP(
             MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
@@ -609,14 +626,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRyz(const qs_data_p_t&
                                                         auto m = i + mask.obj_mask;
                                                         auto j = i + mask.obj_min_mask;
                                                         auto k = i + mask.obj_max_mask;
-                                                        auto v00 = c * ket[i] - s * ket[j];
-                                                        auto v01 = c * ket[j] + s * ket[i];
-                                                        auto v10 = c * ket[k] + s * ket[m];
-                                                        auto v11 = c * ket[m] - s * ket[k];
-                                                        auto this_res = std::conj(bra[i]) * v00;
-                                                        this_res += std::conj(bra[j]) * v01;
-                                                        this_res += std::conj(bra[k]) * v10;
-                                                        this_res += std::conj(bra[m]) * v11;
+                                                        auto v00 = c * acc_data_t(ket[i]) - s * acc_data_t(ket[j]);
+                                                        auto v01 = c * acc_data_t(ket[j]) + s * acc_data_t(ket[i]);
+                                                        auto v10 = c * acc_data_t(ket[k]) + s * acc_data_t(ket[m]);
+                                                        auto v11 = c * acc_data_t(ket[m]) - s * acc_data_t(ket[k]);
+                                                        auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                        this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                        this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                        this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                         res_real += this_res.real();
                                                         res_imag += this_res.imag();
                                                     })
@@ -631,14 +648,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRyz(const qs_data_p_t&
                                                             auto m = i + mask.obj_mask;
                                                             auto j = i + mask.obj_min_mask;
                                                             auto k = i + mask.obj_max_mask;
-                                                            auto v00 = c * ket[i] - s * ket[j];
-                                                            auto v01 = c * ket[j] + s * ket[i];
-                                                            auto v10 = c * ket[k] + s * ket[m];
-                                                            auto v11 = c * ket[m] - s * ket[k];
-                                                            auto this_res = std::conj(bra[i]) * v00;
-                                                            this_res += std::conj(bra[j]) * v01;
-                                                            this_res += std::conj(bra[k]) * v10;
-                                                            this_res += std::conj(bra[m]) * v11;
+                                                            auto v00 = c * acc_data_t(ket[i]) - s * acc_data_t(ket[j]);
+                                                            auto v01 = c * acc_data_t(ket[j]) + s * acc_data_t(ket[i]);
+                                                            auto v10 = c * acc_data_t(ket[k]) + s * acc_data_t(ket[m]);
+                                                            auto v11 = c * acc_data_t(ket[m]) - s * acc_data_t(ket[k]);
+                                                            auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                            this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                            this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                            this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                             res_real += this_res.real();
                                                             res_imag += this_res.imag();
                                                         }
@@ -650,7 +667,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRyz(const qs_data_p_t&
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 };
 
 template <typename derived_, typename calc_type_>
@@ -669,9 +686,10 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRyy(const qs_data_p_t&
         will_free_ket = true;
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(-std::sin(val / 2) / 2);
-    auto s = static_cast<calc_type_>(std::cos(val / 2) / 2) * IMAGE_I;
-    calc_type res_real = 0, res_imag = 0;
+    auto theta = static_cast<acc_type>(val);
+    auto c = -std::sin(theta / 2) / 2;
+    auto s = std::cos(theta / 2) / 2 * acc_data_t(IMAGE_I);
+    acc_type res_real = 0, res_imag = 0;
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP(
             MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
@@ -682,14 +700,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRyy(const qs_data_p_t&
                                                         auto m = i + mask.obj_mask;
                                                         auto j = i + mask.obj_min_mask;
                                                         auto k = i + mask.obj_max_mask;
-                                                        auto v00 = c * ket[i] + s * ket[m];
-                                                        auto v01 = c * ket[j] - s * ket[k];
-                                                        auto v10 = c * ket[k] - s * ket[j];
-                                                        auto v11 = c * ket[m] + s * ket[i];
-                                                        auto this_res = std::conj(bra[i]) * v00;
-                                                        this_res += std::conj(bra[j]) * v01;
-                                                        this_res += std::conj(bra[k]) * v10;
-                                                        this_res += std::conj(bra[m]) * v11;
+                                                        auto v00 = c * acc_data_t(ket[i]) + s * acc_data_t(ket[m]);
+                                                        auto v01 = c * acc_data_t(ket[j]) - s * acc_data_t(ket[k]);
+                                                        auto v10 = c * acc_data_t(ket[k]) - s * acc_data_t(ket[j]);
+                                                        auto v11 = c * acc_data_t(ket[m]) + s * acc_data_t(ket[i]);
+                                                        auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                        this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                        this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                        this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                         res_real += this_res.real();
                                                         res_imag += this_res.imag();
                                                     })
@@ -704,14 +722,14 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRyy(const qs_data_p_t&
                                                             auto m = i + mask.obj_mask;
                                                             auto j = i + mask.obj_min_mask;
                                                             auto k = i + mask.obj_max_mask;
-                                                            auto v00 = c * ket[i] + s * ket[m];
-                                                            auto v01 = c * ket[j] - s * ket[k];
-                                                            auto v10 = c * ket[k] - s * ket[j];
-                                                            auto v11 = c * ket[m] + s * ket[i];
-                                                            auto this_res = std::conj(bra[i]) * v00;
-                                                            this_res += std::conj(bra[j]) * v01;
-                                                            this_res += std::conj(bra[k]) * v10;
-                                                            this_res += std::conj(bra[m]) * v11;
+                                                            auto v00 = c * acc_data_t(ket[i]) + s * acc_data_t(ket[m]);
+                                                            auto v01 = c * acc_data_t(ket[j]) - s * acc_data_t(ket[k]);
+                                                            auto v10 = c * acc_data_t(ket[k]) - s * acc_data_t(ket[j]);
+                                                            auto v11 = c * acc_data_t(ket[m]) + s * acc_data_t(ket[i]);
+                                                            auto this_res = std::conj(acc_data_t(bra[i])) * v00;
+                                                            this_res += std::conj(acc_data_t(bra[j])) * v01;
+                                                            this_res += std::conj(acc_data_t(bra[k])) * v10;
+                                                            this_res += std::conj(acc_data_t(bra[m])) * v11;
                                                             res_real += this_res.real();
                                                             res_imag += this_res.imag();
                                                         }
@@ -723,7 +741,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRyy(const qs_data_p_t&
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 };
 
 template <typename derived_, typename calc_type_>
@@ -743,11 +761,12 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRzz(const qs_data_p_t&
     }
     DoubleQubitGateMask mask(objs, ctrls);
 
-    auto c = static_cast<calc_type_>(-std::sin(val / 2) / 2);
-    auto s = static_cast<calc_type_>(std::cos(val / 2) / 2);
-    auto e = c + IMAGE_I * s;
-    auto me = c + IMAGE_MI * s;
-    calc_type res_real = 0, res_imag = 0;
+    auto theta = static_cast<acc_type>(val);
+    auto c = -std::sin(theta / 2) / 2;
+    auto s = std::cos(theta / 2) / 2;
+    auto e = c + acc_data_t(IMAGE_I) * s;
+    auto me = c + acc_data_t(IMAGE_MI) * s;
+    acc_type res_real = 0, res_imag = 0;
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP(
             MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
@@ -758,10 +777,11 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRzz(const qs_data_p_t&
                                                         auto m = i + mask.obj_mask;
                                                         auto j = i + mask.obj_min_mask;
                                                         auto k = i + mask.obj_max_mask;
-                                                        auto this_res = std::conj(bra[i]) * ket[i] * me;
-                                                        this_res += std::conj(bra[j]) * ket[j] * e;
-                                                        this_res += std::conj(bra[k]) * ket[k] * e;
-                                                        this_res += std::conj(bra[m]) * ket[m] * me;
+                                                        auto diag = std::conj(acc_data_t(bra[i])) * acc_data_t(ket[i]);
+                                                        diag += std::conj(acc_data_t(bra[m])) * acc_data_t(ket[m]);
+                                                        auto off = std::conj(acc_data_t(bra[j])) * acc_data_t(ket[j]);
+                                                        off += std::conj(acc_data_t(bra[k])) * acc_data_t(ket[k]);
+                                                        auto this_res = diag * me + off * e;
                                                         res_real += this_res.real();
                                                         res_imag += this_res.imag();
                                                     })
@@ -776,10 +796,13 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRzz(const qs_data_p_t&
                                                             auto m = i + mask.obj_mask;
                                                             auto j = i + mask.obj_min_mask;
                                                             auto k = i + mask.obj_max_mask;
-                                                            auto this_res = std::conj(bra[i]) * ket[i] * me;
-                                                            this_res += std::conj(bra[j]) * ket[j] * e;
-                                                            this_res += std::conj(bra[k]) * ket[k] * e;
-                                                            this_res += std::conj(bra[m]) * ket[m] * me;
+                                                            auto diag = std::conj(acc_data_t(bra[i]))
+                                                                        * acc_data_t(ket[i]);
+                                                            diag += std::conj(acc_data_t(bra[m])) * acc_data_t(ket[m]);
+                                                            auto off = std::conj(acc_data_t(bra[j]))
+                                                                       * acc_data_t(ket[j]);
+                                                            off += std::conj(acc_data_t(bra[k])) * acc_data_t(ket[k]);
+                                                            auto this_res = diag * me + off * e;
                                                             res_real += this_res.real();
                                                             res_imag += this_res.imag();
                                                         }
@@ -791,8 +814,139 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRzz(const qs_data_p_t&
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return {res_real, res_imag};
+    return qs_data_t(res_real, res_imag);
 };
+template <typename derived_, typename calc_type_>
+auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRPS(const qs_data_p_t& bra_out, const qs_data_p_t& ket_out,
+                                                              const qbits_t& objs, const std::string& paulis,
+                                                              const qbits_t& ctrls, calc_type val, index_t dim)
+    -> qs_data_t {
+    auto bra = bra_out;
+    auto ket = ket_out;
+    bool will_free_bra = false, will_free_ket = false;
+    if (bra == nullptr) {
+        bra = derived::InitState(dim);
+        will_free_bra = true;
+    }
+    if (ket == nullptr) {
+        ket = derived::InitState(dim);
+        will_free_ket = true;
+    }
+    auto mask = GenPauliMask(objs, paulis);
+    auto mask_f = mask.mask_x | mask.mask_y;
+    auto ctrl_mask = QIndexToMask(ctrls);
+    auto theta = static_cast<acc_type>(val);
+    auto c = -std::sin(theta / 2) / 2;
+    auto s = std::cos(theta / 2) / 2;
+    acc_type res_real = 0, res_imag = 0;
+    if (mask_f == 0) {
+        auto e_even = acc_data_t(c, -s);
+        auto e_odd = acc_data_t(c, s);
+        THRESHOLD_OMP(
+            MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
+                                                    for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) {
+                                                        if ((i & ctrl_mask) == ctrl_mask) {
+                                                            auto e = (CountOne(static_cast<index_t>(i) & mask.mask_z)
+                                                                      & 1)
+                                                                         ? e_odd
+                                                                         : e_even;
+                                                            auto this_res = std::conj(acc_data_t(bra[i])) * e
+                                                                            * acc_data_t(ket[i]);
+                                                            res_real += this_res.real();
+                                                            res_imag += this_res.imag();
+                                                        }
+                                                    })
+    } else {
+        const acc_data_t polar[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+        index_t low_mask = mask_f;
+        while (low_mask & (low_mask - 1)) {
+            low_mask &= low_mask - 1;
+        }
+        low_mask -= 1;
+        auto ms = acc_data_t(0, -s);
+        THRESHOLD_OMP(
+            MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
+                                                    for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
+                                                        index_t i = ((static_cast<index_t>(l) & ~low_mask) << 1)
+                                                                    | (static_cast<index_t>(l) & low_mask);
+                                                        if ((i & ctrl_mask) == ctrl_mask) {
+                                                            auto j = i ^ mask_f;
+                                                            auto p = polar[(mask.num_y + 2 * CountOne(i & mask.mask_y)
+                                                                            + 2 * CountOne(i & mask.mask_z))
+                                                                           & 3];
+                                                            auto vi = c * acc_data_t(ket[i])
+                                                                      + ms * std::conj(p) * acc_data_t(ket[j]);
+                                                            auto vj = c * acc_data_t(ket[j])
+                                                                      + ms * p * acc_data_t(ket[i]);
+                                                            auto this_res = std::conj(acc_data_t(bra[i])) * vi;
+                                                            this_res += std::conj(acc_data_t(bra[j])) * vj;
+                                                            res_real += this_res.real();
+                                                            res_imag += this_res.imag();
+                                                        }
+                                                    })
+    }
+    if (will_free_bra) {
+        derived::FreeState(&bra);
+    }
+    if (will_free_ket) {
+        derived::FreeState(&ket);
+    }
+    return qs_data_t(res_real, res_imag);
+};
+
+template <typename derived_, typename calc_type_>
+auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffExcitation(const qs_data_p_t& bra_out,
+                                                                     const qs_data_p_t& ket_out, const qbits_t& objs,
+                                                                     const qbits_t& ctrls, calc_type val, index_t dim)
+    -> qs_data_t {
+    auto bra = bra_out;
+    auto ket = ket_out;
+    bool will_free_bra = false, will_free_ket = false;
+    if (bra == nullptr) {
+        bra = derived::InitState(dim);
+        will_free_bra = true;
+    }
+    if (ket == nullptr) {
+        ket = derived::InitState(dim);
+        will_free_ket = true;
+    }
+    ExcitationMask mask(objs, ctrls);
+    auto theta = static_cast<acc_type>(val);
+    auto c = -std::sin(theta);
+    auto s = std::cos(theta);
+    acc_type res_real = 0, res_imag = 0;
+    THRESHOLD_OMP(
+        MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
+                                                for (omp::idx_t l = 0;
+                                                     l < static_cast<omp::idx_t>(dim >> mask.n_modes); l++) {
+                                                    index_t i;
+                                                    SHIFT_BIT_N(mask.sorted_qubits, mask.n_modes,
+                                                                static_cast<index_t>(l), i);
+                                                    if ((i & mask.ctrl_mask) == mask.ctrl_mask) {
+                                                        auto a = i | mask.annihilate_mask;
+                                                        auto b = i | mask.create_mask;
+                                                        auto sc = ((CountOne(a & mask.parity_mask) ^ mask.sign_bit)
+                                                                   & 1)
+                                                                      ? -s
+                                                                      : s;
+                                                        auto ka = acc_data_t(ket[a]);
+                                                        auto kb = acc_data_t(ket[b]);
+                                                        auto this_res = std::conj(acc_data_t(bra[a]))
+                                                                        * (c * ka - sc * kb);
+                                                        this_res += std::conj(acc_data_t(bra[b])) * (c * kb + sc * ka);
+                                                        res_real += this_res.real();
+                                                        res_imag += this_res.imag();
+                                                    }
+                                                })
+    if (will_free_bra) {
+        derived::FreeState(&bra);
+    }
+    if (will_free_ket) {
+        derived::FreeState(&ket);
+    }
+    return qs_data_t(res_real, res_imag);
+};
+
 #ifdef __x86_64__
 template struct CPUVectorPolicyBase<CPUVectorPolicyAvxFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
@@ -800,4 +954,6 @@ template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmDouble, double>;
 #endif
+template struct CPUVectorPolicyBase<CPUVectorPolicyMixed, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double>;
 }  // namespace mindquantum::sim::vector::detail
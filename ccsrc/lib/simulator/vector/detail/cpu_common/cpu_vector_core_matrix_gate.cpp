@@ -23,6 +23,8 @@
 #    include "simulator/vector/detail/cpu_vector_arm_double_policy.h"
 #    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
 #endif
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #include "simulator/vector/detail/cpu_vector_policy.h"
 namespace mindquantum::sim::vector::detail {
 template <typename derived_, typename calc_type_>
@@ -214,4 +216,6 @@ template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmDouble, double>;
 #endif
+template struct CPUVectorPolicyBase<CPUVectorPolicyMixed, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double>;
 }  // namespace mindquantum::sim::vector::detail
@@ -23,20 +23,22 @@
 #    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
 #endif
 #include "ops/gates.h"
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #include "simulator/vector/detail/cpu_vector_policy.h"
 namespace mindquantum::sim::vector::detail {
 template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ApplyH(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls,
                                                        index_t dim) {
-    std::vector<std::vector<py_qs_data_t>> m{{M_SQRT1_2, M_SQRT1_2}, {M_SQRT1_2, -M_SQRT1_2}};
+    std::vector<std::vector<acc_data_t>> m{{M_SQRT1_2, M_SQRT1_2}, {M_SQRT1_2, -M_SQRT1_2}};
     derived::ApplySingleQubitMatrix((*qs_p), qs_p, objs[0], ctrls, m, dim);
 }
 
 template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ApplyGP(qs_data_p_t* qs_p, qbit_t obj_qubit, const qbits_t& ctrls,
                                                         calc_type val, index_t dim, bool diff) {
-    auto c = std::exp(std::complex<calc_type>(0, -val));
-    std::vector<std::vector<py_qs_data_t>> m = {{c, 0}, {0, c}};
+    auto c = std::exp(acc_data_t(0, -static_cast<acc_type>(val)));
+    std::vector<std::vector<acc_data_t>> m = {{c, 0}, {0, c}};
     derived::ApplySingleQubitMatrix(*qs_p, qs_p, obj_qubit, ctrls, m, dim);
 }
 
@@ -47,4 +49,6 @@ template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmDouble, double>;
 #endif
+template struct CPUVectorPolicyBase<CPUVectorPolicyMixed, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double>;
 }  // namespace mindquantum::sim::vector::detail
@@ -20,6 +20,7 @@
 #include "config/details/macros.h"
 #include "config/openmp.h"
 #include "config/type_promotion.h"
+#include "core/memory_manager.h"
 #include "core/utils.h"
 #include "math/pr/parameter_resolver.h"
 #include "simulator/utils.h"
@@ -30,6 +31,8 @@
 #    include "simulator/vector/detail/cpu_vector_arm_double_policy.h"
 #    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
 #endif
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #include "simulator/vector/detail/cpu_vector_policy.h"
 namespace mindquantum::sim::vector::detail {
 template <typename derived_, typename calc_type_>
@@ -37,7 +40,8 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::InitState(index_t dim, bool zero
     if (dim == 0 || dim > (~0UL)) {
         throw std::runtime_error("Dimension too large.");
     }
-    auto qs = reinterpret_cast<qs_data_p_t>(calloc(dim, sizeof(qs_data_t)));
+    auto qs = reinterpret_cast<qs_data_p_t>(
+        memory::Allocate(dim * sizeof(qs_data_t), memory::Category::StateVector, true));
     if (zero_state) {
         qs[0] = 1;
     }
@@ -53,7 +57,7 @@ template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::FreeState(qs_data_p_t* qs_p) {
     auto& qs = (*qs_p);
     if (qs != nullptr) {
-        free(qs);
+        memory::Free(qs);
         qs = nullptr;
     }
 }
@@ -101,6 +105,19 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::Copy(const qs_data_p_t& qs, inde
     return out;
 };
 
+template <typename derived_, typename calc_type_>
+auto CPUVectorPolicyBase<derived_, calc_type_>::Share(const qs_data_p_t& qs, index_t dim) -> qs_data_p_t {
+    if (qs == nullptr || !memory::MemoryManager::Instance().Share(qs)) {
+        return derived::Copy(qs, dim);
+    }
+    return qs;
+}
+
+template <typename derived_, typename calc_type_>
+bool CPUVectorPolicyBase<derived_, calc_type_>::IsShared(const qs_data_p_t& qs) {
+    return qs != nullptr && memory::MemoryManager::Instance().IsShared(qs);
+}
+
 template <typename derived_, typename calc_type_>
 auto CPUVectorPolicyBase<derived_, calc_type_>::GetQS(const qs_data_p_t& qs, index_t dim) -> VT<py_qs_data_t> {
     VT<py_qs_data_t> out(dim);
@@ -126,6 +143,20 @@ void CPUVectorPolicyBase<derived_, calc_type_>::SetQS(qs_data_p_t* qs_p, const V
         dim, DimTh, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) { qs[i] = qs_out[i]; })
 }
 
+template <typename derived_, typename calc_type_>
+void CPUVectorPolicyBase<derived_, calc_type_>::SetQSFromBuffer(qs_data_p_t* qs_p, const py_qs_data_t* qs_out,
+                                                                index_t size, index_t dim) {
+    auto& qs = (*qs_p);
+    if (size != dim) {
+        throw std::invalid_argument("state size not match");
+    }
+    if (qs == nullptr) {
+        qs = derived::InitState(dim, false);
+    }
+    THRESHOLD_OMP_FOR(
+        dim, DimTh, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) { qs[i] = qs_out[i]; })
+}
+
 template <typename derived_, typename calc_type_>
 auto CPUVectorPolicyBase<derived_, calc_type_>::ApplyTerms(qs_data_p_t* qs_p,
                                                            const std::vector<PauliTerm<calc_type>>& ham, index_t dim)
@@ -173,12 +204,12 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectationOfTerms(const qs_data
         ket = derived::InitState(dim);
         will_free_ket = true;
     }
-    py_qs_data_t out = 0.0;
+    std::complex<acc_type> out = 0.0;
     for (const auto& [pauli_string, coeff_] : ham) {
         auto mask = GenPauliMask(pauli_string);
         auto mask_f = mask.mask_x | mask.mask_y;
         auto coeff = coeff_;
-        calc_type res_real = 0, res_imag = 0;
+        acc_type res_real = 0, res_imag = 0;
         // clang-format off
         THRESHOLD_OMP(
             MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
@@ -198,7 +229,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectationOfTerms(const qs_data
                     }
                 })
         // clang-format on
-        out += py_qs_data_t(res_real, res_imag);
+        out += std::complex<acc_type>(res_real, res_imag);
     }
     if (will_free_bra) {
         derived::FreeState(&bra);
@@ -206,7 +237,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectationOfTerms(const qs_data
     if (will_free_ket) {
         derived::FreeState(&ket);
     }
-    return out;
+    return py_qs_data_t(out.real(), out.imag());
 }
 
 template <typename derived_, typename calc_type>
@@ -237,4 +268,6 @@ template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmDouble, double>;
 #endif
+template struct CPUVectorPolicyBase<CPUVectorPolicyMixed, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double>;
 }  // namespace mindquantum::sim::vector::detail
@@ -23,6 +23,8 @@
 #    include "simulator/vector/detail/cpu_vector_arm_double_policy.h"
 #    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
 #endif
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #include "simulator/vector/detail/cpu_vector_policy.h"
 namespace mindquantum::sim::vector::detail {
 constexpr int ROT_PAULI_FACTOR = 2;
@@ -34,11 +36,12 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRxx(qs_data_p_t* qs_p, cons
         qs = derived::InitState(dim);
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR));
-    auto s = static_cast<calc_type_>(std::sin(val / ROT_PAULI_FACTOR)) * IMAGE_MI;
+    auto theta = static_cast<acc_type>(val);
+    auto c = std::cos(theta / ROT_PAULI_FACTOR);
+    auto s = std::sin(theta / ROT_PAULI_FACTOR) * acc_data_t(IMAGE_MI);
     if (diff) {
-        c = static_cast<calc_type_>(-std::sin(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR);
-        s = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR) * IMAGE_MI;
+        c = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        s = std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR * acc_data_t(IMAGE_MI);
     }
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP_FOR(
@@ -49,14 +52,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRxx(qs_data_p_t* qs_p, cons
                 auto m = i + mask.obj_mask;
                 auto j = i + mask.obj_min_mask;
                 auto k = i + mask.obj_max_mask;
-                auto v00 = c * qs[i] + s * qs[m];
-                auto v01 = c * qs[j] + s * qs[k];
-                auto v10 = c * qs[k] + s * qs[j];
-                auto v11 = c * qs[m] + s * qs[i];
-                qs[i] = v00;
-                qs[j] = v01;
-                qs[k] = v10;
-                qs[m] = v11;
+                auto v00 = c * acc_data_t(qs[i]) + s * acc_data_t(qs[m]);
+                auto v01 = c * acc_data_t(qs[j]) + s * acc_data_t(qs[k]);
+                auto v10 = c * acc_data_t(qs[k]) + s * acc_data_t(qs[j]);
+                auto v11 = c * acc_data_t(qs[m]) + s * acc_data_t(qs[i]);
+                qs[i] = qs_data_t(v00);
+                qs[j] = qs_data_t(v01);
+                qs[k] = qs_data_t(v10);
+                qs[m] = qs_data_t(v11);
             })
     } else {
         THRESHOLD_OMP_FOR(
@@ -68,14 +71,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRxx(qs_data_p_t* qs_p, cons
                     auto m = i + mask.obj_mask;
                     auto j = i + mask.obj_min_mask;
                     auto k = i + mask.obj_max_mask;
-                    auto v00 = c * qs[i] + s * qs[m];
-                    auto v01 = c * qs[j] + s * qs[k];
-                    auto v10 = c * qs[k] + s * qs[j];
-                    auto v11 = c * qs[m] + s * qs[i];
-                    qs[i] = v00;
-                    qs[j] = v01;
-                    qs[k] = v10;
-                    qs[m] = v11;
+                    auto v00 = c * acc_data_t(qs[i]) + s * acc_data_t(qs[m]);
+                    auto v01 = c * acc_data_t(qs[j]) + s * acc_data_t(qs[k]);
+                    auto v10 = c * acc_data_t(qs[k]) + s * acc_data_t(qs[j]);
+                    auto v11 = c * acc_data_t(qs[m]) + s * acc_data_t(qs[i]);
+                    qs[i] = qs_data_t(v00);
+                    qs[j] = qs_data_t(v01);
+                    qs[k] = qs_data_t(v10);
+                    qs[m] = qs_data_t(v11);
                 }
             })
         if (diff) {
@@ -92,11 +95,12 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRxy(qs_data_p_t* qs_p, cons
         qs = derived::InitState(dim);
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR));
-    auto s = static_cast<calc_type_>(std::sin(val / ROT_PAULI_FACTOR));
+    auto theta = static_cast<acc_type>(val);
+    auto c = std::cos(theta / ROT_PAULI_FACTOR);
+    auto s = std::sin(theta / ROT_PAULI_FACTOR);
     if (diff) {
-        c = static_cast<calc_type_>(-std::sin(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR);
-        s = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR);
+        c = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        s = std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
     }
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP_FOR(
@@ -107,14 +111,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRxy(qs_data_p_t* qs_p, cons
                 auto m = i + mask.obj_mask;
                 auto j = i + mask.obj_min_mask;
                 auto k = i + mask.obj_max_mask;
-                auto v00 = c * qs[i] - s * qs[m];
-                auto v01 = c * qs[j] - s * qs[k];
-                auto v10 = c * qs[k] + s * qs[j];
-                auto v11 = c * qs[m] + s * qs[i];
-                qs[i] = v00;
-                qs[j] = v01;
-                qs[k] = v10;
-                qs[m] = v11;
+                auto v00 = c * acc_data_t(qs[i]) - s * acc_data_t(qs[m]);
+                auto v01 = c * acc_data_t(qs[j]) - s * acc_data_t(qs[k]);
+                auto v10 = c * acc_data_t(qs[k]) + s * acc_data_t(qs[j]);
+                auto v11 = c * acc_data_t(qs[m]) + s * acc_data_t(qs[i]);
+                qs[i] = qs_data_t(v00);
+                qs[j] = qs_data_t(v01);
+                qs[k] = qs_data_t(v10);
+                qs[m] = qs_data_t(v11);
             })
     } else {
         THRESHOLD_OMP_FOR(
@@ -126,14 +130,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRxy(qs_data_p_t* qs_p, cons
                     auto m = i + mask.obj_mask;
                     auto j = i + mask.obj_min_mask;
                     auto k = i + mask.obj_max_mask;
-                    auto v00 = c * qs[i] - s * qs[m];
-                    auto v01 = c * qs[j] - s * qs[k];
-                    auto v10 = c * qs[k] + s * qs[j];
-                    auto v11 = c * qs[m] + s * qs[i];
-                    qs[i] = v00;
-                    qs[j] = v01;
-                    qs[k] = v10;
-                    qs[m] = v11;
+                    auto v00 = c * acc_data_t(qs[i]) - s * acc_data_t(qs[m]);
+                    auto v01 = c * acc_data_t(qs[j]) - s * acc_data_t(qs[k]);
+                    auto v10 = c * acc_data_t(qs[k]) + s * acc_data_t(qs[j]);
+                    auto v11 = c * acc_data_t(qs[m]) + s * acc_data_t(qs[i]);
+                    qs[i] = qs_data_t(v00);
+                    qs[j] = qs_data_t(v01);
+                    qs[k] = qs_data_t(v10);
+                    qs[m] = qs_data_t(v11);
                 }
             })
         if (diff) {
@@ -150,11 +154,12 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRxz(qs_data_p_t* qs_p, cons
         qs = derived::InitState(dim);
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR));
-    auto s = static_cast<calc_type_>(std::sin(val / ROT_PAULI_FACTOR)) * IMAGE_MI;
+    auto theta = static_cast<acc_type>(val);
+    auto c = std::cos(theta / ROT_PAULI_FACTOR);
+    auto s = std::sin(theta / ROT_PAULI_FACTOR) * acc_data_t(IMAGE_MI);
     if (diff) {
-        c = static_cast<calc_type_>(-std::sin(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR);
-        s = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR) * IMAGE_MI;
+        c = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        s = std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR * acc_data_t(IMAGE_MI);
     }
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP_FOR(
@@ -165,14 +170,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRxz(qs_data_p_t* qs_p, cons
                 auto m = i + mask.obj_mask;
                 auto j = i + mask.obj_min_mask;
                 auto k = i + mask.obj_max_mask;
-                auto v00 = c * qs[i] + s * qs[j];
-                auto v01 = c * qs[j] + s * qs[i];
-                auto v10 = c * qs[k] - s * qs[m];
-                auto v11 = c * qs[m] - s * qs[k];
-                qs[i] = v00;
-                qs[j] = v01;
-                qs[k] = v10;
-                qs[m] = v11;
+                auto v00 = c * acc_data_t(qs[i]) + s * acc_data_t(qs[j]);
+                auto v01 = c * acc_data_t(qs[j]) + s * acc_data_t(qs[i]);
+                auto v10 = c * acc_data_t(qs[k]) - s * acc_data_t(qs[m]);
+                auto v11 = c * acc_data_t(qs[m]) - s * acc_data_t(qs[k]);
+                qs[i] = qs_data_t(v00);
+                qs[j] = qs_data_t(v01);
+                qs[k] = qs_data_t(v10);
+                qs[m] = qs_data_t(v11);
             })
     } else {
         THRESHOLD_OMP_FOR(
@@ -184,14 +189,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRxz(qs_data_p_t* qs_p, cons
                     auto m = i + mask.obj_mask;
                     auto j = i + mask.obj_min_mask;
                     auto k = i + mask.obj_max_mask;
-                    auto v00 = c * qs[i] + s * qs[j];
-                    auto v01 = c * qs[j] + s * qs[i];
-                    auto v10 = c * qs[k] - s * qs[m];
-                    auto v11 = c * qs[m] - s * qs[k];
-                    qs[i] = v00;
-                    qs[j] = v01;
-                    qs[k] = v10;
-                    qs[m] = v11;
+                    auto v00 = c * acc_data_t(qs[i]) + s * acc_data_t(qs[j]);
+                    auto v01 = c * acc_data_t(qs[j]) + s * acc_data_t(qs[i]);
+                    auto v10 = c * acc_data_t(qs[k]) - s * acc_data_t(qs[m]);
+                    auto v11 = c * acc_data_t(qs[m]) - s * acc_data_t(qs[k]);
+                    qs[i] = qs_data_t(v00);
+                    qs[j] = qs_data_t(v01);
+                    qs[k] = qs_data_t(v10);
+                    qs[m] = qs_data_t(v11);
                 }
             })
         if (diff) {
@@ -208,11 +213,12 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRyz(qs_data_p_t* qs_p, cons
         qs = derived::InitState(dim);
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR));
-    auto s = static_cast<calc_type_>(std::sin(val / ROT_PAULI_FACTOR));
+    auto theta = static_cast<acc_type>(val);
+    auto c = std::cos(theta / ROT_PAULI_FACTOR);
+    auto s = std::sin(theta / ROT_PAULI_FACTOR);
     if (diff) {
-        c = static_cast<calc_type_>(-std::sin(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR);
-        s = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR);
+        c = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        s = std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
     }
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP_FOR(
@@ -223,14 +229,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRyz(qs_data_p_t* qs_p, cons
                 auto m = i + mask.obj_mask;
                 auto j = i + mask.obj_min_mask;
                 auto k = i + mask.obj_max_mask;
-                auto v00 = c * qs[i] - s * qs[j];
-                auto v01 = c * qs[j] + s * qs[i];
-                auto v10 = c * qs[k] + s * qs[m];
-                auto v11 = c * qs[m] - s * qs[k];
-                qs[i] = v00;
-                qs[j] = v01;
-                qs[k] = v10;
-                qs[m] = v11;
+                auto v00 = c * acc_data_t(qs[i]) - s * acc_data_t(qs[j]);
+                auto v01 = c * acc_data_t(qs[j]) + s * acc_data_t(qs[i]);
+                auto v10 = c * acc_data_t(qs[k]) + s * acc_data_t(qs[m]);
+                auto v11 = c * acc_data_t(qs[m]) - s * acc_data_t(qs[k]);
+                qs[i] = qs_data_t(v00);
+                qs[j] = qs_data_t(v01);
+                qs[k] = qs_data_t(v10);
+                qs[m] = qs_data_t(v11);
             })
     } else {
         THRESHOLD_OMP_FOR(
@@ -242,14 +248,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRyz(qs_data_p_t* qs_p, cons
                     auto m = i + mask.obj_mask;
                     auto j = i + mask.obj_min_mask;
                     auto k = i + mask.obj_max_mask;
-                    auto v00 = c * qs[i] - s * qs[j];
-                    auto v01 = c * qs[j] + s * qs[i];
-                    auto v10 = c * qs[k] + s * qs[m];
-                    auto v11 = c * qs[m] - s * qs[k];
-                    qs[i] = v00;
-                    qs[j] = v01;
-                    qs[k] = v10;
-                    qs[m] = v11;
+                    auto v00 = c * acc_data_t(qs[i]) - s * acc_data_t(qs[j]);
+                    auto v01 = c * acc_data_t(qs[j]) + s * acc_data_t(qs[i]);
+                    auto v10 = c * acc_data_t(qs[k]) + s * acc_data_t(qs[m]);
+                    auto v11 = c * acc_data_t(qs[m]) - s * acc_data_t(qs[k]);
+                    qs[i] = qs_data_t(v00);
+                    qs[j] = qs_data_t(v01);
+                    qs[k] = qs_data_t(v10);
+                    qs[m] = qs_data_t(v11);
                 }
             })
         if (diff) {
@@ -266,11 +272,12 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRyy(qs_data_p_t* qs_p, cons
         qs = derived::InitState(dim);
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR));
-    auto s = static_cast<calc_type_>(std::sin(val / ROT_PAULI_FACTOR)) * IMAGE_I;
+    auto theta = static_cast<acc_type>(val);
+    auto c = std::cos(theta / ROT_PAULI_FACTOR);
+    auto s = std::sin(theta / ROT_PAULI_FACTOR) * acc_data_t(IMAGE_I);
     if (diff) {
-        c = static_cast<calc_type_>(-std::sin(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR);
-        s = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR) * IMAGE_I;
+        c = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        s = std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR * acc_data_t(IMAGE_I);
     }
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP_FOR(
@@ -281,14 +288,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRyy(qs_data_p_t* qs_p, cons
                 auto m = i + mask.obj_mask;
                 auto j = i + mask.obj_min_mask;
                 auto k = i + mask.obj_max_mask;
-                auto v00 = c * qs[i] + s * qs[m];
-                auto v01 = c * qs[j] - s * qs[k];
-                auto v10 = c * qs[k] - s * qs[j];
-                auto v11 = c * qs[m] + s * qs[i];
-                qs[i] = v00;
-                qs[j] = v01;
-                qs[k] = v10;
-                qs[m] = v11;
+                auto v00 = c * acc_data_t(qs[i]) + s * acc_data_t(qs[m]);
+                auto v01 = c * acc_data_t(qs[j]) - s * acc_data_t(qs[k]);
+                auto v10 = c * acc_data_t(qs[k]) - s * acc_data_t(qs[j]);
+                auto v11 = c * acc_data_t(qs[m]) + s * acc_data_t(qs[i]);
+                qs[i] = qs_data_t(v00);
+                qs[j] = qs_data_t(v01);
+                qs[k] = qs_data_t(v10);
+                qs[m] = qs_data_t(v11);
             })
     } else {
         THRESHOLD_OMP_FOR(
@@ -300,14 +307,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRyy(qs_data_p_t* qs_p, cons
                     auto m = i + mask.obj_mask;
                     auto j = i + mask.obj_min_mask;
                     auto k = i + mask.obj_max_mask;
-                    auto v00 = c * qs[i] + s * qs[m];
-                    auto v01 = c * qs[j] - s * qs[k];
-                    auto v10 = c * qs[k] - s * qs[j];
-                    auto v11 = c * qs[m] + s * qs[i];
-                    qs[i] = v00;
-                    qs[j] = v01;
-                    qs[k] = v10;
-                    qs[m] = v11;
+                    auto v00 = c * acc_data_t(qs[i]) + s * acc_data_t(qs[m]);
+                    auto v01 = c * acc_data_t(qs[j]) - s * acc_data_t(qs[k]);
+                    auto v10 = c * acc_data_t(qs[k]) - s * acc_data_t(qs[j]);
+                    auto v11 = c * acc_data_t(qs[m]) + s * acc_data_t(qs[i]);
+                    qs[i] = qs_data_t(v00);
+                    qs[j] = qs_data_t(v01);
+                    qs[k] = qs_data_t(v10);
+                    qs[m] = qs_data_t(v11);
                 }
             })
         if (diff) {
@@ -324,14 +331,15 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRzz(qs_data_p_t* qs_p, cons
         qs = derived::InitState(dim);
     }
     DoubleQubitGateMask mask(objs, ctrls);
-    auto c = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR));
-    auto s = static_cast<calc_type_>(std::sin(val / ROT_PAULI_FACTOR));
+    auto theta = static_cast<acc_type>(val);
+    auto c = std::cos(theta / ROT_PAULI_FACTOR);
+    auto s = std::sin(theta / ROT_PAULI_FACTOR);
     if (diff) {
-        c = static_cast<calc_type_>(-std::sin(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR);
-        s = static_cast<calc_type_>(std::cos(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR);
+        c = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        s = std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
     }
-    auto e = c + IMAGE_I * s;
-    auto me = c + IMAGE_MI * s;
+    auto e = c + acc_data_t(IMAGE_I) * s;
+    auto me = c + acc_data_t(IMAGE_MI) * s;
     if (!mask.ctrl_mask) {
         THRESHOLD_OMP_FOR(
             dim, DimTh, for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 4); l++) {
@@ -341,10 +349,10 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRzz(qs_data_p_t* qs_p, cons
                 auto m = i + mask.obj_mask;
                 auto j = i + mask.obj_min_mask;
                 auto k = i + mask.obj_max_mask;
-                qs[i] *= me;
-                qs[j] *= e;
-                qs[k] *= e;
-                qs[m] *= me;
+                qs[i] = qs_data_t(acc_data_t(qs[i]) * (me));
+                qs[j] = qs_data_t(acc_data_t(qs[j]) * (e));
+                qs[k] = qs_data_t(acc_data_t(qs[k]) * (e));
+                qs[m] = qs_data_t(acc_data_t(qs[m]) * (me));
             })
     } else {
         THRESHOLD_OMP_FOR(
@@ -356,10 +364,10 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRzz(qs_data_p_t* qs_p, cons
                     auto m = i + mask.obj_mask;
                     auto j = i + mask.obj_min_mask;
                     auto k = i + mask.obj_max_mask;
-                    qs[i] *= me;
-                    qs[j] *= e;
-                    qs[k] *= e;
-                    qs[m] *= me;
+                    qs[i] = qs_data_t(acc_data_t(qs[i]) * (me));
+                    qs[j] = qs_data_t(acc_data_t(qs[j]) * (e));
+                    qs[k] = qs_data_t(acc_data_t(qs[k]) * (e));
+                    qs[m] = qs_data_t(acc_data_t(qs[m]) * (me));
                 }
             })
         if (diff) {
@@ -372,13 +380,14 @@ template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRX(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls,
                                                         calc_type val, index_t dim, bool diff) {
     SingleQubitGateMask mask(objs, ctrls);
-    auto a = std::cos(val / ROT_PAULI_FACTOR);
-    auto b = -std::sin(val / ROT_PAULI_FACTOR);
+    auto theta = static_cast<acc_type>(val);
+    auto a = std::cos(theta / ROT_PAULI_FACTOR);
+    auto b = -std::sin(theta / ROT_PAULI_FACTOR);
     if (diff) {
-        a = -std::sin(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
-        b = -std::cos(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        a = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        b = -std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
     }
-    std::vector<std::vector<py_qs_data_t>> m{{{a, 0}, {0, b}}, {{0, b}, {a, 0}}};
+    std::vector<std::vector<acc_data_t>> m{{{a, 0}, {0, b}}, {{0, b}, {a, 0}}};
     derived::ApplySingleQubitMatrix(*qs_p, qs_p, objs[0], ctrls, m, dim);
     if (diff && mask.ctrl_mask) {
         derived::SetToZeroExcept(qs_p, mask.ctrl_mask, dim);
@@ -389,13 +398,14 @@ template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRY(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls,
                                                         calc_type val, index_t dim, bool diff) {
     SingleQubitGateMask mask(objs, ctrls);
-    auto a = std::cos(val / ROT_PAULI_FACTOR);
-    auto b = std::sin(val / ROT_PAULI_FACTOR);
+    auto theta = static_cast<acc_type>(val);
+    auto a = std::cos(theta / ROT_PAULI_FACTOR);
+    auto b = std::sin(theta / ROT_PAULI_FACTOR);
     if (diff) {
-        a = -std::sin(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
-        b = std::cos(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        a = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        b = std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
     }
-    std::vector<std::vector<py_qs_data_t>> m{{{a, 0}, {-b, 0}}, {{b, 0}, {a, 0}}};
+    std::vector<std::vector<acc_data_t>> m{{{a, 0}, {-b, 0}}, {{b, 0}, {a, 0}}};
     derived::ApplySingleQubitMatrix(*qs_p, qs_p, objs[0], ctrls, m, dim);
     if (diff && mask.ctrl_mask) {
         derived::SetToZeroExcept(qs_p, mask.ctrl_mask, dim);
@@ -406,19 +416,76 @@ template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRZ(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls,
                                                         calc_type val, index_t dim, bool diff) {
     SingleQubitGateMask mask(objs, ctrls);
-    auto a = std::cos(val / ROT_PAULI_FACTOR);
-    auto b = std::sin(val / ROT_PAULI_FACTOR);
+    auto theta = static_cast<acc_type>(val);
+    auto a = std::cos(theta / ROT_PAULI_FACTOR);
+    auto b = std::sin(theta / ROT_PAULI_FACTOR);
     if (diff) {
-        a = -std::sin(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
-        b = std::cos(val / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        a = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        b = std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
     }
-    std::vector<std::vector<py_qs_data_t>> m{{{a, -b}, {0, 0}}, {{0, 0}, {a, b}}};
+    std::vector<std::vector<acc_data_t>> m{{{a, -b}, {0, 0}}, {{0, 0}, {a, b}}};
     derived::ApplySingleQubitMatrix(*qs_p, qs_p, objs[0], ctrls, m, dim);
     if (diff && mask.ctrl_mask) {
         derived::SetToZeroExcept(qs_p, mask.ctrl_mask, dim);
     }
 }
 
+template <typename derived_, typename calc_type_>
+void CPUVectorPolicyBase<derived_, calc_type_>::ApplyRPS(qs_data_p_t* qs_p, const qbits_t& objs,
+                                                         const std::string& paulis, const qbits_t& ctrls,
+                                                         calc_type val, index_t dim, bool diff) {
+    auto& qs = *qs_p;
+    if (qs == nullptr) {
+        qs = derived::InitState(dim);
+    }
+    auto mask = GenPauliMask(objs, paulis);
+    auto mask_f = mask.mask_x | mask.mask_y;
+    auto ctrl_mask = QIndexToMask(ctrls);
+    auto theta = static_cast<acc_type>(val);
+    auto c = std::cos(theta / ROT_PAULI_FACTOR);
+    auto s = std::sin(theta / ROT_PAULI_FACTOR);
+    if (diff) {
+        c = -std::sin(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+        s = std::cos(theta / ROT_PAULI_FACTOR) / ROT_PAULI_FACTOR;
+    }
+    if (mask_f == 0) {
+        // Diagonal string, the eigenvalue of P is the parity of the Z qubits.
+        auto e_even = acc_data_t(c, -s);
+        auto e_odd = acc_data_t(c, s);
+        THRESHOLD_OMP_FOR(
+            dim, DimTh, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) {
+                if ((i & ctrl_mask) == ctrl_mask) {
+                    auto e = (CountOne(static_cast<index_t>(i) & mask.mask_z) & 1) ? e_odd : e_even;
+                    qs[i] = qs_data_t(acc_data_t(qs[i]) * e);
+                }
+            })
+    } else {
+        // P|i> = p|j> and P|j> = conj(p)|i> with j = i ^ mask_f, i being the one with the highest flipped bit unset.
+        const acc_data_t polar[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+        index_t low_mask = mask_f;
+        while (low_mask & (low_mask - 1)) {
+            low_mask &= low_mask - 1;
+        }
+        low_mask -= 1;
+        auto ms = acc_data_t(0, -s);
+        THRESHOLD_OMP_FOR(
+            dim, DimTh, for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
+                index_t i = ((static_cast<index_t>(l) & ~low_mask) << 1) | (static_cast<index_t>(l) & low_mask);
+                if ((i & ctrl_mask) == ctrl_mask) {
+                    auto j = i ^ mask_f;
+                    auto p = polar[(mask.num_y + 2 * CountOne(i & mask.mask_y) + 2 * CountOne(i & mask.mask_z)) & 3];
+                    acc_data_t a = qs[i];
+                    acc_data_t b = qs[j];
+                    qs[i] = qs_data_t(c * a + ms * std::conj(p) * b);
+                    qs[j] = qs_data_t(c * b + ms * p * a);
+                }
+            })
+    }
+    if (diff && ctrl_mask) {
+        derived::SetToZeroExcept(qs_p, ctrl_mask, dim);
+    }
+}
+
 #ifdef __x86_64__
 template struct CPUVectorPolicyBase<CPUVectorPolicyAvxFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
@@ -426,4 +493,6 @@ template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmDouble, double>;
 #endif
+template struct CPUVectorPolicyBase<CPUVectorPolicyMixed, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double>;
 }  // namespace mindquantum::sim::vector::detail
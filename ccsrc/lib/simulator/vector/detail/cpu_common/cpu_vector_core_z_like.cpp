@@ -23,11 +23,13 @@
 #    include "simulator/vector/detail/cpu_vector_arm_double_policy.h"
 #    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
 #endif
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #include "simulator/vector/detail/cpu_vector_policy.h"
 namespace mindquantum::sim::vector::detail {
 template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ApplyZLike(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls,
-                                                           qs_data_t val, index_t dim) {
+                                                           acc_data_t val, index_t dim) {
     auto& qs = *qs_p;
     if (qs == nullptr) {
         qs = derived::InitState(dim);
@@ -37,14 +39,14 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyZLike(qs_data_p_t* qs_p, co
         THRESHOLD_OMP_FOR(
             dim, DimTh, for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
                 auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask) + mask.obj_mask;
-                qs[i] *= val;
+                qs[i] = qs_data_t(acc_data_t(qs[i]) * val);
             })
     } else {
         THRESHOLD_OMP_FOR(
             dim, DimTh, for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
                 auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask) + mask.obj_mask;
                 if ((i & mask.ctrl_mask) == mask.ctrl_mask) {
-                    qs[i] *= val;
+                    qs[i] = qs_data_t(acc_data_t(qs[i]) * val);
                 }
             })
     }
@@ -71,34 +73,35 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplySdag(qs_data_p_t* qs_p, con
 template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ApplyT(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls,
                                                        index_t dim) {
-    derived::ApplyZLike(qs_p, objs, ctrls, qs_data_t(1, 1) / static_cast<calc_type>(std::sqrt(2.0)), dim);
+    derived::ApplyZLike(qs_p, objs, ctrls, acc_data_t(M_SQRT1_2, M_SQRT1_2), dim);
 }
 
 template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ApplyTdag(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls,
                                                           index_t dim) {
-    derived::ApplyZLike(qs_p, objs, ctrls, qs_data_t(1, -1) / static_cast<calc_type>(std::sqrt(2.0)), dim);
+    derived::ApplyZLike(qs_p, objs, ctrls, acc_data_t(M_SQRT1_2, -M_SQRT1_2), dim);
 }
 
 template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ApplyPS(qs_data_p_t* qs_p, const qbits_t& objs, const qbits_t& ctrls,
                                                         calc_type val, index_t dim, bool diff) {
+    auto theta = static_cast<acc_type>(val);
     if (!diff) {
-        derived::ApplyZLike(qs_p, objs, ctrls, qs_data_t(std::cos(val), std::sin(val)), dim);
+        derived::ApplyZLike(qs_p, objs, ctrls, acc_data_t(std::cos(theta), std::sin(theta)), dim);
     } else {
         auto& qs = *qs_p;
         if (qs == nullptr) {
             qs = derived::InitState(dim);
         }
         SingleQubitGateMask mask(objs, ctrls);
-        auto e = -std::sin(val) + IMAGE_I * std::cos(val);
+        auto e = acc_data_t(-std::sin(theta), std::cos(theta));
         if (!mask.ctrl_mask) {
             THRESHOLD_OMP_FOR(
                 dim, DimTh, for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
                     auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask);
                     auto j = i + mask.obj_mask;
                     qs[i] = 0;
-                    qs[j] *= e;
+                    qs[j] = qs_data_t(acc_data_t(qs[j]) * e);
                 })
         } else {
             THRESHOLD_OMP_FOR(
@@ -107,7 +110,7 @@ void CPUVectorPolicyBase<derived_, calc_type_>::ApplyPS(qs_data_p_t* qs_p, const
                     if ((i & mask.ctrl_mask) == mask.ctrl_mask) {
                         auto j = i + mask.obj_mask;
                         qs[i] = 0;
-                        qs[j] *= e;
+                        qs[j] = qs_data_t(acc_data_t(qs[j]) * e);
                     }
                 })
             derived::SetToZeroExcept(qs_p, mask.ctrl_mask, dim);
@@ -122,4 +125,6 @@ template struct CPUVectorPolicyBase<CPUVectorPolicyAvxDouble, double>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmFloat, float>;
 template struct CPUVectorPolicyBase<CPUVectorPolicyArmDouble, double>;
 #endif
+template struct CPUVectorPolicyBase<CPUVectorPolicyMixed, float>;
+template struct CPUVectorPolicyBase<CPUVectorPolicyOutOfCore, double>;
 }  // namespace mindquantum::sim::vector::detail
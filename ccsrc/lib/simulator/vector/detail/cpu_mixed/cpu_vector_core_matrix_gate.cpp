@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "config/openmp.h"
+#include "core/utils.h"
+#include "simulator/utils.h"
+#include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+
+namespace mindquantum::sim::vector::detail {
+namespace {
+auto ToAccMatrix(const std::vector<std::vector<CPUVectorPolicyMixed::py_qs_data_t>>& m) {
+    std::vector<std::vector<CPUVectorPolicyMixed::acc_data_t>> out;
+    out.reserve(m.size());
+    for (auto& row : m) {
+        out.emplace_back(row.begin(), row.end());
+    }
+    return out;
+}
+}  // namespace
+
+void CPUVectorPolicyMixed::ApplySingleQubitMatrix(const qs_data_p_t& src_out, qs_data_p_t* des_p, qbit_t obj_qubit,
+                                                  const qbits_t& ctrls, const std::vector<std::vector<acc_data_t>>& m,
+                                                  index_t dim) {
+    auto& des = (*des_p);
+    if (des == nullptr) {
+        des = CPUVectorPolicyMixed::InitState(dim);
+    }
+    qs_data_p_t src;
+    bool will_free = false;
+    if (src_out == nullptr) {
+        src = CPUVectorPolicyMixed::InitState(dim);
+        will_free = true;
+    } else {
+        src = src_out;
+    }
+    SingleQubitGateMask mask({obj_qubit}, ctrls);
+    acc_data_t m00 = m[0][0], m01 = m[0][1], m10 = m[1][0], m11 = m[1][1];
+    THRESHOLD_OMP_FOR(
+        dim, DimTh, for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 2); l++) {
+            auto i = ((l & mask.obj_high_mask) << 1) + (l & mask.obj_low_mask);
+            if ((i & mask.ctrl_mask) == mask.ctrl_mask) {
+                auto j = i + mask.obj_mask;
+                acc_data_t a = src[i], b = src[j];
+                des[i] = qs_data_t(m00 * a + m01 * b);
+                des[j] = qs_data_t(m10 * a + m11 * b);
+            }
+        })
+    if (will_free) {
+        CPUVectorPolicyMixed::FreeState(&src);
+    }
+}
+
+void CPUVectorPolicyMixed::ApplyTwoQubitsMatrix(const qs_data_p_t& src_out, qs_data_p_t* des_p, const qbits_t& objs,
+                                                const qbits_t& ctrls, const std::vector<std::vector<acc_data_t>>& m,
+                                                index_t dim) {
+    auto& des = (*des_p);
+    if (des == nullptr) {
+        des = CPUVectorPolicyMixed::InitState(dim);
+    }
+    qs_data_p_t src;
+    bool will_free = false;
+    if (src_out == nullptr) {
+        src = CPUVectorPolicyMixed::InitState(dim);
+        will_free = true;
+    } else {
+        src = src_out;
+    }
+    DoubleQubitGateMask mask(objs, ctrls);
+    index_t offset[4] = {0, 1UL << objs[0], 1UL << objs[1], mask.obj_mask};
+    acc_data_t gate[4][4];
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            gate[r][c] = m[r][c];
+        }
+    }
+    THRESHOLD_OMP_FOR(
+        dim, DimTh, for (omp::idx_t l = 0; l < static_cast<omp::idx_t>(dim / 4); l++) {
+            omp::idx_t i;
+            SHIFT_BIT_TWO(mask.obj_low_mask, mask.obj_rev_low_mask, mask.obj_high_mask, mask.obj_rev_high_mask, l, i);
+            if ((i & mask.ctrl_mask) == mask.ctrl_mask) {
+                acc_data_t v[4];
+                for (int c = 0; c < 4; c++) {
+                    v[c] = src[i + offset[c]];
+                }
+                for (int r = 0; r < 4; r++) {
+                    des[i + offset[r]] = qs_data_t(gate[r][0] * v[0] + gate[r][1] * v[1] + gate[r][2] * v[2]
+                                                   + gate[r][3] * v[3]);
+                }
+            }
+        })
+    if (will_free) {
+        CPUVectorPolicyMixed::FreeState(&src);
+    }
+}
+
+void CPUVectorPolicyMixed::ApplySingleQubitMatrix(const qs_data_p_t& src, qs_data_p_t* des_p, qbit_t obj_qubit,
+                                                  const qbits_t& ctrls, const std::vector<std::vector<py_qs_data_t>>& m,
+                                                  index_t dim) {
+    ApplySingleQubitMatrix(src, des_p, obj_qubit, ctrls, ToAccMatrix(m), dim);
+}
+
+void CPUVectorPolicyMixed::ApplyTwoQubitsMatrix(const qs_data_p_t& src, qs_data_p_t* des_p, const qbits_t& objs,
+                                                const qbits_t& ctrls, const std::vector<std::vector<py_qs_data_t>>& m,
+                                                index_t dim) {
+    ApplyTwoQubitsMatrix(src, des_p, objs, ctrls, ToAccMatrix(m), dim);
+}
+}  // namespace mindquantum::sim::vector::detail
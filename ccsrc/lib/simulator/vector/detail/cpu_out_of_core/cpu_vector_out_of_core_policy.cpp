@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "core/memory_manager.h"
+
+namespace mindquantum::sim::vector::detail {
+namespace {
+std::mutex& StorageMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::string& StorageDirRef() {
+    static std::string dir = []() -> std::string {
+        for (const char* env : {"MQ_OUT_OF_CORE_DIR", "TMPDIR"}) {
+            if (const char* value = std::getenv(env); value != nullptr && value[0] != '\0') {
+                return value;
+            }
+        }
+        return "/tmp";
+    }();
+    return dir;
+}
+}  // namespace
+
+auto CPUVectorPolicyOutOfCore::InitState(index_t dim, bool zero_state) -> qs_data_p_t {
+    if (dim == 0 || dim > (~0UL) / sizeof(qs_data_t)) {
+        throw std::runtime_error("Dimension too large.");
+    }
+    // The file is sparse and reads as zeros, no need to touch the pages.
+    auto qs = reinterpret_cast<qs_data_p_t>(memory::MemoryManager::Instance().AllocateMapped(dim * sizeof(qs_data_t),
+                                                                                              StorageDir()));
+    if (zero_state) {
+        qs[0] = 1;
+    }
+    return qs;
+}
+
+void CPUVectorPolicyOutOfCore::SetStorageDir(const std::string& dir) {
+    if (dir.empty()) {
+        throw std::invalid_argument("Storage directory of out-of-core states cannot be empty.");
+    }
+    std::lock_guard<std::mutex> lock(StorageMutex());
+    StorageDirRef() = dir;
+}
+
+std::string CPUVectorPolicyOutOfCore::StorageDir() {
+    std::lock_guard<std::mutex> lock(StorageMutex());
+    return StorageDirRef();
+}
+}  // namespace mindquantum::sim::vector::detail
@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "simulator/vector/out_of_core_state.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "core/memory_manager.h"
+#include "core/trace.h"
+#include "ops/gate_id.h"
+#include "ops/gates.h"
+
+namespace mindquantum::sim::vector::detail {
+OutOfCoreVectorState::OutOfCoreVectorState(qbit_t n_qubits, unsigned seed) : base_t(n_qubits, seed) {
+}
+
+OutOfCoreVectorState::OutOfCoreVectorState(base_t&& sim) : base_t(std::move(sim)) {
+}
+
+OutOfCoreVectorState::OutOfCoreVectorState(qs_data_p_t chunk, qbit_t n_qubits)
+    : base_t(chunk, n_qubits), is_view_(true) {
+}
+
+OutOfCoreVectorState::~OutOfCoreVectorState() {
+    if (is_view_) {
+        qs = nullptr;
+    }
+}
+
+void OutOfCoreVectorState::SetChunkQubits(qbit_t chunk_qubits) {
+    if (chunk_qubits < 2) {
+        throw std::invalid_argument("A chunk of out-of-core state should have at least 2 qubits.");
+    }
+    chunk_qubits_ = chunk_qubits;
+}
+
+std::map<std::string, int> OutOfCoreVectorState::ApplyCircuit(const circuit_t& circ,
+                                                              const parameter::ParameterResolver& pr) {
+    if (n_qubits <= chunk_qubits_) {
+        return base_t::ApplyCircuit(circ, pr);
+    }
+    MQ_TRACE_SCOPE("OutOfCoreApplyCircuit", "simulator");
+    if (qs == nullptr) {
+        qs = qs_policy_t::InitState(dim);
+    }
+    // The chunks are written through views, which do not see whether the whole buffer is shared.
+    Unshare();
+    layout_.Reset(n_qubits);
+
+    std::map<std::string, int> result;
+    std::vector<PhysicalGate> run;
+    for (size_t pos = 0; pos < circ.size(); ++pos) {
+        auto& gate = circ[pos];
+        if (!IsPartitionable(gate->id_) || static_cast<qbit_t>(gate->obj_qubits_.size()) > chunk_qubits_) {
+            FlushRun(&run, pr);
+            RestoreLayout();
+            if (gate->id_ == GateID::M) {
+                result[static_cast<MeasureGate*>(gate.get())->name_] = ApplyMeasure(gate);
+            } else {
+                ApplyGate(gate, pr, false);
+            }
+            continue;
+        }
+        for (auto obj : gate->obj_qubits_) {
+            if (layout_.Physical(obj) >= chunk_qubits_) {
+                FlushRun(&run, pr);
+                SwapPhysical(layout_.Victim(circ, pos, chunk_qubits_, gate->obj_qubits_), layout_.Physical(obj));
+            }
+        }
+        run.push_back({gate, layout_.Physical(gate->obj_qubits_), layout_.Physical(gate->ctrl_qubits_)});
+    }
+    FlushRun(&run, pr);
+    RestoreLayout();
+    return result;
+}
+
+void OutOfCoreVectorState::FlushRun(std::vector<PhysicalGate>* run, const parameter::ParameterResolver& pr) {
+    if (run->empty()) {
+        return;
+    }
+    MQ_TRACE_SCOPE("OutOfCoreRun", "simulator");
+    auto chunk_dim = index_t(1) << chunk_qubits_;
+    auto n_chunk = dim >> chunk_qubits_;
+    qbits_t ctrls;
+    for (index_t chunk = 0; chunk < n_chunk; ++chunk) {
+        // Let the OS read the next chunk from the disk while this one is computed.
+        if (chunk + 1 < n_chunk) {
+            memory::Prefetch(qs + (chunk + 1) * chunk_dim, chunk_dim * sizeof(qs_data_t));
+        }
+        OutOfCoreVectorState view(qs + chunk * chunk_dim, chunk_qubits_);
+        for (auto& gate : *run) {
+            // Controls on global qubits are fixed for the whole chunk.
+            ctrls.clear();
+            bool active = true;
+            for (auto ctrl : gate.ctrls) {
+                if (ctrl < chunk_qubits_) {
+                    ctrls.push_back(ctrl);
+                } else if (((chunk >> (ctrl - chunk_qubits_)) & 1) == 0) {
+                    active = false;
+                    break;
+                }
+            }
+            if (active) {
+                view.ApplyGateOn(gate.gate, gate.objs, ctrls, pr, false);
+            }
+        }
+    }
+    for (size_t i = 0; i < run->size(); ++i) {
+        TrackNorm();
+    }
+    run->clear();
+}
+
+void OutOfCoreVectorState::SwapPhysical(qbit_t lhs, qbit_t rhs) {
+    MQ_TRACE_SCOPE("OutOfCoreSwap", "simulator");
+    qs_policy_t::ApplySWAP(&qs, {std::min(lhs, rhs), std::max(lhs, rhs)}, {}, dim);
+    layout_.Swap(lhs, rhs);
+}
+
+void OutOfCoreVectorState::RestoreLayout() {
+    for (qbit_t phys = 0; phys < n_qubits; ++phys) {
+        while (layout_.Logical(phys) != phys) {
+            SwapPhysical(phys, layout_.Logical(phys));
+        }
+    }
+}
+}  // namespace mindquantum::sim::vector::detail
@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "config/openmp.h"
+#include "simulator/utils.h"
+#include "simulator/vector/detail/gpu_vector_double_policy.cuh"
+#include "simulator/vector/detail/gpu_vector_float_policy.cuh"
+#include "simulator/vector/detail/gpu_vector_policy.cuh"
+#include "thrust/device_ptr.h"
+#include "thrust/functional.h"
+
+namespace mindquantum::sim::vector::detail {
+template <typename derived_, typename calc_type_>
+void GPUVectorPolicyBase<derived_, calc_type_>::ApplyExcitation(qs_data_p_t* qs_p, const qbits_t& objs,
+                                                                const qbits_t& ctrls, calc_type val, index_t dim,
+                                                                bool diff) {
+    auto& qs = *qs_p;
+    if (qs == nullptr) {
+        qs = derived::InitState(dim);
+    }
+    ExcitationMask mask(objs, ctrls);
+    auto c = static_cast<calc_type>(std::cos(val));
+    auto s = static_cast<calc_type>(std::sin(val));
+    if (diff) {
+        c = static_cast<calc_type>(-std::sin(val));
+        s = static_cast<calc_type>(std::cos(val));
+    }
+    thrust::counting_iterator<index_t> l(0);
+    thrust::for_each(l, l + (dim >> mask.n_modes), [=] __device__(index_t l) {
+        index_t i;
+        SHIFT_BIT_N(mask.sorted_qubits, mask.n_modes, l, i);
+        if ((i & mask.ctrl_mask) == mask.ctrl_mask) {
+            auto a = i | mask.annihilate_mask;
+            auto b = i | mask.create_mask;
+            auto sc = ((__popcll(a & mask.parity_mask) ^ mask.sign_bit) & 1) ? -s : s;
+            auto va = qs[a];
+            auto vb = qs[b];
+            qs[a] = c * va - sc * vb;
+            qs[b] = c * vb + sc * va;
+            if (diff) {
+                for (index_t m = 0; m < (index_t(1) << mask.n_modes); m++) {
+                    auto j = i;
+                    for (qbit_t k = 0; k < mask.n_modes; k++) {
+                        j |= ((m >> k) & 1) << mask.sorted_qubits[k];
+                    }
+                    if (j != a && j != b) {
+                        qs[j] = 0;
+                    }
+                }
+            }
+        }
+    });
+    if (diff && mask.ctrl_mask) {
+        derived::SetToZeroExcept(&qs, mask.ctrl_mask, dim);
+    }
+}
+
+template struct GPUVectorPolicyBase<GPUVectorPolicyFloat, float>;
+template struct GPUVectorPolicyBase<GPUVectorPolicyDouble, double>;
+
+}  // namespace mindquantum::sim::vector::detail
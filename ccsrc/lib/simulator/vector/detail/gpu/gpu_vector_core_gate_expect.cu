@@ -902,6 +902,129 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffPS(const qs_data_p_t&
     return res;
 }
 
+template <typename derived_, typename calc_type_>
+auto GPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffRPS(const qs_data_p_t& bra_out, const qs_data_p_t& ket_out,
+                                                              const qbits_t& objs, const std::string& paulis,
+                                                              const qbits_t& ctrls, calc_type val, index_t dim)
+    -> qs_data_t {
+    auto bra = bra_out;
+    auto ket = ket_out;
+    bool will_free_bra = false, will_free_ket = false;
+    if (bra == nullptr) {
+        bra = derived::InitState(dim);
+        will_free_bra = true;
+    }
+    if (ket == nullptr) {
+        ket = derived::InitState(dim);
+        will_free_ket = true;
+    }
+    auto mask = GenPauliMask(objs, paulis);
+    auto mask_f = mask.mask_x | mask.mask_y;
+    auto mask_y = mask.mask_y;
+    auto mask_z = mask.mask_z;
+    auto num_y = mask.num_y;
+    auto ctrl_mask = QIndexToMask(ctrls);
+    auto c = static_cast<calc_type>(-std::sin(val / 2) / 2);
+    auto s = static_cast<calc_type>(std::cos(val / 2) / 2);
+    qs_data_t res = 0.0;
+    if (mask_f == 0) {
+        auto e_even = qs_data_t(c, -s);
+        auto e_odd = qs_data_t(c, s);
+        thrust::counting_iterator<size_t> i(0);
+        res = thrust::transform_reduce(
+            i, i + dim,
+            [=] __device__(size_t i) {
+                if ((i & ctrl_mask) != ctrl_mask) {
+                    return qs_data_t(0, 0);
+                }
+                auto e = (__popcll(i & mask_z) & 1) ? e_odd : e_even;
+                return thrust::conj(bra[i]) * e * ket[i];
+            },
+            qs_data_t(0, 0), thrust::plus<qs_data_t>());
+    } else {
+        index_t low_mask = mask_f;
+        while (low_mask & (low_mask - 1)) {
+            low_mask &= low_mask - 1;
+        }
+        low_mask -= 1;
+        auto ms = qs_data_t(0, -s);
+        thrust::counting_iterator<size_t> l(0);
+        res = thrust::transform_reduce(
+            l, l + dim / 2,
+            [=] __device__(size_t l) {
+                index_t i = ((l & ~low_mask) << 1) | (l & low_mask);
+                if ((i & ctrl_mask) != ctrl_mask) {
+                    return qs_data_t(0, 0);
+                }
+                auto j = i ^ mask_f;
+                auto idx = (num_y + 2 * __popcll(i & mask_y) + 2 * __popcll(i & mask_z)) & 3;
+                auto p = qs_data_t(1, 0);
+                if (idx == 1) {
+                    p = qs_data_t(0, 1);
+                } else if (idx == 2) {
+                    p = qs_data_t(-1, 0);
+                } else if (idx == 3) {
+                    p = qs_data_t(0, -1);
+                }
+                auto vi = c * ket[i] + ms * thrust::conj(p) * ket[j];
+                auto vj = c * ket[j] + ms * p * ket[i];
+                return thrust::conj(bra[i]) * vi + thrust::conj(bra[j]) * vj;
+            },
+            qs_data_t(0, 0), thrust::plus<qs_data_t>());
+    }
+    if (will_free_bra) {
+        derived::FreeState(&bra);
+    }
+    if (will_free_ket) {
+        derived::FreeState(&ket);
+    }
+    return res;
+}
+
+template <typename derived_, typename calc_type_>
+auto GPUVectorPolicyBase<derived_, calc_type_>::ExpectDiffExcitation(const qs_data_p_t& bra_out,
+                                                                     const qs_data_p_t& ket_out, const qbits_t& objs,
+                                                                     const qbits_t& ctrls, calc_type val, index_t dim)
+    -> qs_data_t {
+    auto bra = bra_out;
+    auto ket = ket_out;
+    bool will_free_bra = false, will_free_ket = false;
+    if (bra == nullptr) {
+        bra = derived::InitState(dim);
+        will_free_bra = true;
+    }
+    if (ket == nullptr) {
+        ket = derived::InitState(dim);
+        will_free_ket = true;
+    }
+    ExcitationMask mask(objs, ctrls);
+    auto c = static_cast<calc_type>(-std::sin(val));
+    auto s = static_cast<calc_type>(std::cos(val));
+    thrust::counting_iterator<size_t> l(0);
+    qs_data_t res = thrust::transform_reduce(
+        l, l + (dim >> mask.n_modes),
+        [=] __device__(size_t l) {
+            index_t i;
+            SHIFT_BIT_N(mask.sorted_qubits, mask.n_modes, l, i);
+            if ((i & mask.ctrl_mask) != mask.ctrl_mask) {
+                return qs_data_t(0, 0);
+            }
+            auto a = i | mask.annihilate_mask;
+            auto b = i | mask.create_mask;
+            auto sc = ((__popcll(a & mask.parity_mask) ^ mask.sign_bit) & 1) ? -s : s;
+            return thrust::conj(bra[a]) * (c * ket[a] - sc * ket[b])
+                   + thrust::conj(bra[b]) * (c * ket[b] + sc * ket[a]);
+        },
+        qs_data_t(0, 0), thrust::plus<qs_data_t>());
+    if (will_free_bra) {
+        derived::FreeState(&bra);
+    }
+    if (will_free_ket) {
+        derived::FreeState(&ket);
+    }
+    return res;
+}
+
 template struct GPUVectorPolicyBase<GPUVectorPolicyFloat, float>;
 template struct GPUVectorPolicyBase<GPUVectorPolicyDouble, double>;
 
@@ -19,6 +19,7 @@
 #include <thrust/transform_reduce.h>
 
 #include "config/openmp.h"
+#include "core/memory_manager.h"
 #include "simulator/utils.h"
 #include "simulator/vector/detail/gpu_vector_double_policy.cuh"
 #include "simulator/vector/detail/gpu_vector_float_policy.cuh"
@@ -37,6 +38,7 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::InitState(index_t dim, bool zero
         throw std::runtime_error("Malloc GPU memory failed: " + std::string(cudaGetErrorName(state)) + ", "
                                  + cudaGetErrorString(state));
     }
+    memory::MemoryManager::Instance().Track(qs, sizeof(qs_data_t) * dim, memory::Category::Device);
     cudaMemset(qs, 0, sizeof(qs_data_t) * dim);
     if (zero_state) {
         qs_data_t one = qs_data_t(1.0, 0.0);
@@ -49,6 +51,7 @@ template <typename derived_, typename calc_type_>
 void GPUVectorPolicyBase<derived_, calc_type_>::FreeState(qs_data_p_t* qs_p) {
     auto& qs = (*qs_p);
     if (qs != nullptr) {
+        memory::MemoryManager::Instance().Untrack(qs);
         cudaFree(qs);
         qs = nullptr;
     }
@@ -263,11 +266,23 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::Copy(const qs_data_p_t& qs, inde
         if (state != cudaSuccess) {
             throw std::runtime_error("GPU out of memory for allocate quantum state.");
         }
+        memory::MemoryManager::Instance().Track(out, sizeof(qs_data_t) * dim, memory::Category::Device);
         cudaMemcpy(out, qs, sizeof(qs_data_t) * dim, cudaMemcpyDeviceToDevice);
     }
     return out;
 };
 
+// Device buffers are not reference counted, sharing falls back to a device to device copy.
+template <typename derived_, typename calc_type_>
+auto GPUVectorPolicyBase<derived_, calc_type_>::Share(const qs_data_p_t& qs, index_t dim) -> qs_data_p_t {
+    return derived::Copy(qs, dim);
+}
+
+template <typename derived_, typename calc_type_>
+bool GPUVectorPolicyBase<derived_, calc_type_>::IsShared(const qs_data_p_t& /*qs*/) {
+    return false;
+}
+
 template struct GPUVectorPolicyBase<GPUVectorPolicyFloat, float>;
 template struct GPUVectorPolicyBase<GPUVectorPolicyDouble, double>;
 
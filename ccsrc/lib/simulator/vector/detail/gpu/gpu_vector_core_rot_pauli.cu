@@ -447,6 +447,68 @@ void GPUVectorPolicyBase<derived_, calc_type_>::ApplyRyy(qs_data_p_t* qs_p, cons
     }
 }
 
+template <typename derived_, typename calc_type_>
+void GPUVectorPolicyBase<derived_, calc_type_>::ApplyRPS(qs_data_p_t* qs_p, const qbits_t& objs,
+                                                         const std::string& paulis, const qbits_t& ctrls,
+                                                         calc_type val, index_t dim, bool diff) {
+    auto& qs = *qs_p;
+    if (qs == nullptr) {
+        qs = derived::InitState(dim);
+    }
+    auto mask = GenPauliMask(objs, paulis);
+    auto mask_f = mask.mask_x | mask.mask_y;
+    auto mask_y = mask.mask_y;
+    auto mask_z = mask.mask_z;
+    auto num_y = mask.num_y;
+    auto ctrl_mask = QIndexToMask(ctrls);
+    auto c = static_cast<calc_type>(std::cos(val / 2));
+    auto s = static_cast<calc_type>(std::sin(val / 2));
+    if (diff) {
+        c = static_cast<calc_type>(-std::sin(val / 2) / 2);
+        s = static_cast<calc_type>(std::cos(val / 2) / 2);
+    }
+    if (mask_f == 0) {
+        auto e_even = qs_data_t(c, -s);
+        auto e_odd = qs_data_t(c, s);
+        thrust::counting_iterator<index_t> i(0);
+        thrust::for_each(i, i + dim, [=] __device__(index_t i) {
+            if ((i & ctrl_mask) == ctrl_mask) {
+                qs[i] *= (__popcll(i & mask_z) & 1) ? e_odd : e_even;
+            }
+        });
+    } else {
+        index_t low_mask = mask_f;
+        while (low_mask & (low_mask - 1)) {
+            low_mask &= low_mask - 1;
+        }
+        low_mask -= 1;
+        auto ms = qs_data_t(0, -s);
+        thrust::counting_iterator<index_t> l(0);
+        thrust::for_each(l, l + dim / 2, [=] __device__(index_t l) {
+            index_t i = ((l & ~low_mask) << 1) | (l & low_mask);
+            if ((i & ctrl_mask) == ctrl_mask) {
+                auto j = i ^ mask_f;
+                auto idx = (num_y + 2 * __popcll(i & mask_y) + 2 * __popcll(i & mask_z)) & 3;
+                auto p = qs_data_t(1, 0);
+                if (idx == 1) {
+                    p = qs_data_t(0, 1);
+                } else if (idx == 2) {
+                    p = qs_data_t(-1, 0);
+                } else if (idx == 3) {
+                    p = qs_data_t(0, -1);
+                }
+                auto a = qs[i];
+                auto b = qs[j];
+                qs[i] = c * a + ms * thrust::conj(p) * b;
+                qs[j] = c * b + ms * p * a;
+            }
+        });
+    }
+    if (diff && ctrl_mask) {
+        derived::SetToZeroExcept(&qs, ctrl_mask, dim);
+    }
+}
+
 template struct GPUVectorPolicyBase<GPUVectorPolicyFloat, float>;
 template struct GPUVectorPolicyBase<GPUVectorPolicyDouble, double>;
 
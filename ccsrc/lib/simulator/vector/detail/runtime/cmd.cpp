@@ -23,6 +23,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include "core/trace.h"
+#include "io/qasm/openqasm.h"
 #include "ops/basic_gate.h"
 #include "ops/gate_id.h"
 #include "ops/gates.h"
@@ -37,6 +39,7 @@ int cmd(const std::vector<std::string> &args) {
     if (args.size() < 4) {
         throw std::runtime_error("You should set n_qubits and random seed when running simulator.");
     }
+    MQ_TRACE_SCOPE("cmd", "mqrt");
 
     int n_qubits = std::get<1>(convert_int(args[2], MAX_QUBIT));
     int seed = std::get<1>(convert_int(args[3], MAX_SEED));
@@ -236,4 +239,41 @@ int cmd_file(const char *filename) {
     cmd(cmds);
     return 0;
 }
+
+int qasm(const std::vector<std::string> &args) {
+    if (args.size() < 5) {
+        throw std::runtime_error("Usage: mqrt qasm <file> <seed> <shots> [include_dir ...]");
+    }
+    MQ_TRACE_SCOPE("qasm", "mqrt");
+    int seed = std::get<1>(convert_int(args[3], MAX_SEED));
+    int shots = std::get<1>(convert_int(args[4], MAX_SHOTS));
+    VT<std::string> include_dirs(args.begin() + 5, args.end());
+    auto prog = [&]() {
+        MQ_TRACE_SCOPE("ParseOpenQASMFile", "mqrt");
+        return io::qasm::ParseOpenQASMFile(args[2], include_dirs);
+    }();
+    if (prog.n_qubits > MAX_QUBIT) {
+        throw std::runtime_error(fmt::format("Program requires {} qubits, but at most {} are supported.",
+                                             prog.n_qubits, MAX_QUBIT));
+    }
+    auto key_map = prog.KeyMap();
+    if (key_map.size() == 0) {
+        throw std::runtime_error("No measure gate implement.");
+    }
+    auto sim = vector::detail::VectorState<vector::detail::CPUVectorPolicyAvxDouble>(prog.n_qubits, seed);
+    if (shots < 0 || shots > MAX_SHOTS) {
+        throw std::runtime_error(fmt::format("You should set shots between 0 and {}", MAX_SHOTS));
+    }
+    auto res = sim.Sampling(prog.circuit, {}, shots, key_map, seed);
+    nlohmann::json result;
+    for (auto &[name, idx] : key_map) {
+        VT<int> samp;
+        for (size_t s = 0; s < static_cast<size_t>(shots); s++) {
+            samp.push_back(res[idx + s * key_map.size()]);
+        }
+        result[name] = samp;
+    }
+    std::cout << result.dump() << std::endl;
+    return 0;
+}
 }  // namespace mindquantum::sim::rt
@@ -13,8 +13,23 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdlib>
+
+#include "core/trace.h"
 #include "simulator/vector/runtime/cmd.h"
 
+namespace {
+int run(const std::vector<std::string> &args) {
+    if (args[1] == "cmd") {
+        return mindquantum::sim::rt::cmd(args);
+    }
+    if (args[1] == "qasm") {
+        return mindquantum::sim::rt::qasm(args);
+    }
+    throw std::runtime_error("First arg is runtime type, should be 'cmd' or 'qasm'.");
+}
+}  // namespace
+
 int main(int argc, char *argv[]) {
     std::vector<std::string> args;
     for (int i = 0; i < argc; i++) {
@@ -23,8 +38,26 @@ int main(int argc, char *argv[]) {
     if (argc == 1) {
         return 0;
     }
-    if (args[1] == "cmd") {
-        return mindquantum::sim::rt::cmd(args);
+    // Set MQ_TRACE_FILE to dump a Chrome trace of the job.
+    const char *trace_file = std::getenv("MQ_TRACE_FILE");
+    auto &recorder = mindquantum::trace::Recorder::Instance();
+    if (trace_file != nullptr) {
+        recorder.Start();
+    }
+    // The trace is also dumped when the job throws, it shows where the failing run spent its time.
+    auto dump_trace = [&]() {
+        if (trace_file != nullptr) {
+            recorder.Stop();
+            recorder.DumpChromeJson(trace_file);
+        }
+    };
+    int ret = 0;
+    try {
+        ret = run(args);
+    } catch (...) {
+        dump_trace();
+        throw;
     }
-    throw std::runtime_error("First arg is runtime type, should be 'cmd'.");
+    dump_trace();
+    return ret;
 }
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MQ_PYTHON_COMPILED_CIRCUIT_HPP
+#define MQ_PYTHON_COMPILED_CIRCUIT_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ops/basic_gate.h"
+
+namespace mindquantum::python {
+/**
+ * Gate list converted once from a python circuit.
+ *
+ * Passing a plain python list of gates to a simulator converts it into a std::vector on every call. A
+ * CompiledCircuit is a registered C++ object, so simulators receive it by reference without any conversion.
+ */
+struct CompiledCircuit {
+    using circuit_t = std::vector<std::shared_ptr<BasicGate>>;
+
+    explicit CompiledCircuit(circuit_t circ) : circ(std::move(circ)) {
+    }
+
+    circuit_t circ;
+};
+
+namespace detail {
+template <typename T>
+struct compiled_arg {
+    using type = T;
+    static T&& unwrap(type&& arg) {
+        return std::forward<T>(arg);
+    }
+};
+
+template <>
+struct compiled_arg<const CompiledCircuit::circuit_t&> {
+    using type = const CompiledCircuit&;
+    static const CompiledCircuit::circuit_t& unwrap(type arg) {
+        return arg.circ;
+    }
+};
+}  // namespace detail
+
+//! Adapt a simulator method so that every circuit argument is given as a CompiledCircuit.
+template <typename sim_t, typename R, typename C, typename... Args>
+auto WithCompiledCircuit(R (C::*method)(Args...) const) {
+    return [method](const sim_t& sim, typename detail::compiled_arg<Args>::type... args) -> R {
+        return (sim.*method)(detail::compiled_arg<Args>::unwrap(std::forward<decltype(args)>(args))...);
+    };
+}
+
+template <typename sim_t, typename R, typename C, typename... Args>
+auto WithCompiledCircuit(R (C::*method)(Args...)) {
+    return [method](sim_t& sim, typename detail::compiled_arg<Args>::type... args) -> R {
+        return (sim.*method)(detail::compiled_arg<Args>::unwrap(std::forward<decltype(args)>(args))...);
+    };
+}
+}  // namespace mindquantum::python
+
+#endif /* MQ_PYTHON_COMPILED_CIRCUIT_HPP */
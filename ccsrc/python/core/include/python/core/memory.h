@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MQ_PYTHON_MEMORY_HPP
+#define MQ_PYTHON_MEMORY_HPP
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "core/memory_manager.h"
+
+namespace mindquantum::python {
+/**
+ * Expose the memory manager of this module.
+ *
+ * Every extension module links its own copy of the manager, so the python side sets the budget of all of them and
+ * merges their usage. MemoryBudgetError is raised in python as a subclass of MemoryError.
+ */
+inline void BindMemory(pybind11::module& module) {  // NOLINT(runtime/references)
+    using memory::MemoryManager;
+    pybind11::register_exception<memory::MemoryBudgetError>(module, "MemoryBudgetError", PyExc_MemoryError);
+    module.def("memory_set_budget", [](size_t bytes) { MemoryManager::Instance().SetBudget(bytes); });
+    module.def("memory_budget", []() { return MemoryManager::Instance().Budget(); });
+    module.def("memory_reset_peak", []() { MemoryManager::Instance().ResetPeak(); });
+    module.def("memory_set_pool_limit", [](size_t bytes) { MemoryManager::Instance().SetPoolLimit(bytes); });
+    module.def("memory_pool_limit", []() { return MemoryManager::Instance().PoolLimit(); });
+    module.def("memory_release_pool", []() { MemoryManager::Instance().ReleasePool(); });
+    module.def("memory_usage", []() {
+        auto& manager = MemoryManager::Instance();
+        std::vector<std::tuple<std::string, size_t, size_t>> out;
+        for (size_t i = 0; i < memory::n_category; ++i) {
+            auto category = static_cast<memory::Category>(i);
+            auto usage = manager.Get(category);
+            out.emplace_back(std::string(memory::CategoryName(category)), usage.current, usage.peak);
+        }
+        auto total = manager.Total();
+        out.emplace_back("total", total.current, total.peak);
+        auto pooled = manager.Pooled();
+        out.emplace_back("pool", pooled.current, pooled.peak);
+        return out;
+    });
+}
+}  // namespace mindquantum::python
+#endif
@@ -21,6 +21,7 @@
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include "core/memory_manager.h"
 #include "core/sparse/csrhdmatrix.h"
 
 namespace mindquantum::python {
@@ -35,11 +36,15 @@ struct CsrHdMatrix : sparse::CsrHdMatrix<T> {
     using base_t::indptr_;
     using base_t::nnz_;
 
+    template <typename U>
+    static U *Allocate(size_t size) {
+        return reinterpret_cast<U *>(memory::Allocate(size * sizeof(U), memory::Category::Sparse));
+    }
+
     CsrHdMatrix(Index dim, Index nnz, pybind11::array_t<Index> indptr, pybind11::array_t<Index> indices,
                 pybind11::array_t<CT<T>> data)
-        : base_t(dim, nnz, reinterpret_cast<Index *>(malloc(indptr.size() * sizeof(Index))),
-                 reinterpret_cast<Index *>(malloc(indices.size() * sizeof(Index))),
-                 (CTP<T>) malloc(data.size() * sizeof(CT<T>))) {
+        : base_t(dim, nnz, Allocate<Index>(indptr.size()), Allocate<Index>(indices.size()),
+                 Allocate<CT<T>>(data.size())) {
         Index *indptr_py = static_cast<Index *>(indptr.request().ptr);
         Index *indices_py = static_cast<Index *>(indices.request().ptr);
         CTP<T> data_py = static_cast<CT<T> *>(data.request().ptr);
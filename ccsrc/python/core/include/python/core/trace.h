@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MQ_PYTHON_TRACE_HPP
+#define MQ_PYTHON_TRACE_HPP
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "core/trace.h"
+
+namespace mindquantum::python {
+/**
+ * Expose the trace recorder of this module.
+ *
+ * Every extension module links its own copy of the recorder, so the python side starts all of them and merges their
+ * events. An event is a (name, category, tid, start_ns, dur_ns) tuple.
+ */
+inline void BindTrace(pybind11::module& module) {  // NOLINT(runtime/references)
+    using trace::Recorder;
+    namespace py = pybind11;
+    module.def(
+        "trace_start", [](size_t capacity) { Recorder::Instance().Start(capacity); },
+        py::arg("capacity") = Recorder::default_capacity);
+    module.def("trace_stop", []() { Recorder::Instance().Stop(); });
+    module.def("trace_clear", []() { Recorder::Instance().Clear(); });
+    module.def("trace_events", []() {
+        std::vector<std::tuple<std::string, std::string, uint64_t, uint64_t, uint64_t>> out;
+        for (auto& event : Recorder::Instance().Events()) {
+            out.emplace_back(event.name, event.category, event.tid, event.start_ns, event.dur_ns);
+        }
+        return out;
+    });
+}
+}  // namespace mindquantum::python
+#endif
@@ -37,6 +37,7 @@
 #include "core/sparse/algo.h"
 #include "core/sparse/csrhdmatrix.h"
 #include "core/sparse/paulimat.h"
+#include "io/qasm/openqasm.h"
 #include "math/pr/parameter_resolver.h"
 #include "math/tensor/matrix.h"
 #include "ops/basic_gate.h"
@@ -44,7 +45,10 @@
 #include "ops/gates.h"
 #include "ops/hamiltonian.h"
 
+#include "python/core/compiled_circuit.h"
+#include "python/core/memory.h"
 #include "python/core/sparse/csrhdmatrix.h"
+#include "python/core/trace.h"
 #include "python/ops/basic_gate.h"
 #include "python/ops/build_env.h"
 
@@ -141,6 +145,18 @@ void BindTypeDependentGate(py::module &module) {  // NOLINT(runtime/references)
     py::class_<mindquantum::RyzGate, mindquantum::BasicGate, std::shared_ptr<mindquantum::RyzGate>>(module, "RyzGate")
         .def(py::init<const ParameterResolver &, const qbits_t &, const qbits_t &>(), "pr"_a, "obj_qubits"_a,
              "ctrl_qubits"_a = VT<Index>());
+    py::class_<mindquantum::RotPauliStringGate, mindquantum::BasicGate,
+               std::shared_ptr<mindquantum::RotPauliStringGate>>(module, "RotPauliStringGate")
+        .def(py::init<const std::string &, const ParameterResolver &, const qbits_t &, const qbits_t &>(), "paulis"_a,
+             "pr"_a, "obj_qubits"_a, "ctrl_qubits"_a = VT<Index>());
+    py::class_<mindquantum::SingleExcitationGate, mindquantum::BasicGate,
+               std::shared_ptr<mindquantum::SingleExcitationGate>>(module, "SingleExcitationGate")
+        .def(py::init<const ParameterResolver &, const qbits_t &, const qbits_t &>(), "pr"_a, "obj_qubits"_a,
+             "ctrl_qubits"_a = VT<Index>());
+    py::class_<mindquantum::DoubleExcitationGate, mindquantum::BasicGate,
+               std::shared_ptr<mindquantum::DoubleExcitationGate>>(module, "DoubleExcitationGate")
+        .def(py::init<const ParameterResolver &, const qbits_t &, const qbits_t &>(), "pr"_a, "obj_qubits"_a,
+             "ctrl_qubits"_a = VT<Index>());
     py::class_<mindquantum::GPGate, mindquantum::BasicGate, std::shared_ptr<mindquantum::GPGate>>(module, "GPGate")
         .def(py::init<const ParameterResolver &, const qbits_t &, const qbits_t &>(), "pr"_a, "obj_qubits"_a,
              "ctrl_qubits"_a = VT<Index>());
@@ -178,6 +194,7 @@ auto BindOther(py::module &module) {
     using mindquantum::VVT;
     using mindquantum::python::CsrHdMatrix;
     using parameter::ParameterResolver;
+    using release_gil = py::call_guard<py::gil_scoped_release>;
     // matrix
 
     // parameter resolver
@@ -196,16 +213,16 @@ auto BindOther(py::module &module) {
         .def_readwrite("coeff", &PauliMat<T>::p_)
         .def("PrintInfo", &PauliMat<T>::PrintInfo);
 
-    module.def("get_pauli_mat", &GetPauliMat<T>);
+    module.def("get_pauli_mat", &GetPauliMat<T>, release_gil());
 
     // // csr_hd_matrix
     py::class_<CsrHdMatrix<T>, std::shared_ptr<CsrHdMatrix<T>>>(module, "csr_hd_matrix")
         .def(py::init<>())
         .def(py::init<Index, Index, py::array_t<Index>, py::array_t<Index>, py::array_t<CT<T>>>())
         .def("PrintInfo", &CsrHdMatrix<T>::PrintInfo);
-    module.def("csr_plus_csr", &Csr_Plus_Csr<T>);
-    module.def("transpose_csr_hd_matrix", &TransposeCsrHdMatrix<T>);
-    module.def("pauli_mat_to_csr_hd_matrix", &PauliMatToCsrHdMatrix<T>);
+    module.def("csr_plus_csr", &Csr_Plus_Csr<T>, release_gil());
+    module.def("transpose_csr_hd_matrix", &TransposeCsrHdMatrix<T>, release_gil());
+    module.def("pauli_mat_to_csr_hd_matrix", &PauliMatToCsrHdMatrix<T>, release_gil());
 
     // hamiltonian
     py::class_<Hamiltonian<T>, std::shared_ptr<Hamiltonian<T>>>(module, "hamiltonian")
@@ -218,7 +235,24 @@ auto BindOther(py::module &module) {
         .def_readwrite("ham", &Hamiltonian<T>::ham_)
         .def_readwrite("ham_sparse_main", &Hamiltonian<T>::ham_sparse_main_)
         .def_readwrite("ham_sparse_second", &Hamiltonian<T>::ham_sparse_second_);
-    module.def("sparse_hamiltonian", &SparseHamiltonian<T>);
+    module.def("sparse_hamiltonian", &SparseHamiltonian<T>, release_gil());
+}
+
+void BindQasm(py::module &module) {  // NOLINT(runtime/references)
+    using namespace pybind11::literals;  // NOLINT(build/namespaces_literals)
+    using mindquantum::io::qasm::QasmProgram;
+    py::class_<QasmProgram>(module, "QasmProgram")
+        .def_readonly("version", &QasmProgram::version)
+        .def_readonly("n_qubits", &QasmProgram::n_qubits)
+        .def_readonly("clbit_keys", &QasmProgram::clbit_keys)
+        .def_readonly("parameters", &QasmProgram::parameters)
+        .def_readonly("circuit", &QasmProgram::circuit)
+        .def("key_map", &QasmProgram::KeyMap);
+    module.def("parse_openqasm", &mindquantum::io::qasm::ParseOpenQASM, "source"_a,
+               "include_dirs"_a = mindquantum::VT<std::string>(), "source_name"_a = "<string>",
+               "Parse an OpenQASM 2.0 or 3 program into a flattened circuit.");
+    module.def("parse_openqasm_file", &mindquantum::io::qasm::ParseOpenQASMFile, "file_name"_a,
+               "include_dirs"_a = mindquantum::VT<std::string>(), "Parse an OpenQASM file into a flattened circuit.");
 }
 }  // namespace mindquantum::python
 
@@ -273,6 +307,10 @@ PYBIND11_MODULE(mqbackend, m) {
     py::class_<mindquantum::BasicGate, std::shared_ptr<mindquantum::BasicGate>>(gate, "BasicGate").def(py::init<>());
     mindquantum::python::BindTypeIndependentGate(gate);
     mindquantum::python::BindTypeDependentGate(gate);
+    using mindquantum::python::CompiledCircuit;
+    py::class_<CompiledCircuit, std::shared_ptr<CompiledCircuit>>(gate, "CompiledCircuit")
+        .def(py::init<CompiledCircuit::circuit_t>(), "gates"_a)
+        .def("__len__", [](const CompiledCircuit &circ) { return circ.circ.size(); });
 
     py::module mqbackend_double = m.def_submodule("double", "MindQuantum-C++ double backend");
     mindquantum::python::BindOther<double>(mqbackend_double);
@@ -285,4 +323,13 @@ PYBIND11_MODULE(mqbackend, m) {
     py::module device = m.def_submodule("device", "Quantum device module");
     mindquantum::python::BindTopology(device);
     mindquantum::python::BindQubitMapping(device);
+
+    py::module qasm = m.def_submodule("qasm", "Native OpenQASM parser");
+    mindquantum::python::BindQasm(qasm);
+
+    py::module trace = m.def_submodule("trace", "Trace recorder of the C++ backend");
+    mindquantum::python::BindTrace(trace);
+
+    py::module memory = m.def_submodule("memory", "Memory accounting of the C++ backend");
+    mindquantum::python::BindMemory(memory);
 }
@@ -39,31 +39,52 @@
 #    include "simulator/densitymatrix/detail/cpu_densitymatrix_policy.h"
 #endif  // __CUDACC__
 
+#include "python/core/compiled_circuit.h"
 #include "simulator/densitymatrix/densitymatrix_state.h"
 
 template <typename sim_t>
 auto BindSim(pybind11::module& module, const std::string_view& name) {  // NOLINT
     using namespace pybind11::literals;                                 // NOLINT
     using qbit_t = mindquantum::qbit_t;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
 
-    return pybind11::class_<sim_t>(module, name.data())
+    auto sim_class = pybind11::class_<sim_t>(module, name.data())
         .def(pybind11::init<qbit_t, unsigned>(), "n_qubits"_a, "seed"_a = 42)
         .def("dtype", &sim_t::DType)
         .def("display", &sim_t::Display, "qubits_limit"_a = 10)
-        .def("apply_gate", &sim_t::ApplyGate, "gate"_a, "pr"_a = parameter::ParameterResolver(), "diff"_a = false)
-        .def("apply_circuit", &sim_t::ApplyCircuit, "gate"_a, "pr"_a = parameter::ParameterResolver())
-        .def("reset", &sim_t::Reset)
-        .def("get_qs", &sim_t::GetQS)
-        .def("set_qs", &sim_t::SetQS)
-        .def("set_dm", &sim_t::SetDM)
-        .def("is_pure", &sim_t::IsPure)
-        .def("pure_state_vector", &sim_t::PureStateVector)
-        .def("apply_hamiltonian", &sim_t::ApplyHamiltonian)
-        .def("copy", [](const sim_t& sim) { return sim; })
-        .def("sampling", &sim_t::Sampling)
-        .def("get_expectation", &sim_t::GetExpectation)
-        .def("get_expectation_with_grad_multi_multi", &sim_t::GetExpectationWithReversibleGradMultiMulti)
-        .def("get_expectation_with_noise_grad_multi_multi", &sim_t::GetExpectationWithNoiseGradMultiMulti);
+        .def("apply_gate", &sim_t::ApplyGate, "gate"_a, "pr"_a = parameter::ParameterResolver(), "diff"_a = false,
+             release_gil())
+        .def("apply_circuit", &sim_t::ApplyCircuit, "gate"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("reset", &sim_t::Reset, release_gil())
+        .def("get_qs", &sim_t::GetQS, release_gil())
+        .def("set_qs", &sim_t::SetQS, release_gil())
+        .def("set_dm", &sim_t::SetDM, release_gil())
+        .def("save_state", &sim_t::Save, "filename"_a, "drop_below"_a = 0.0, release_gil())
+        .def("load_state", &sim_t::Load, "filename"_a, release_gil())
+        .def("is_pure", &sim_t::IsPure, release_gil())
+        .def("pure_state_vector", &sim_t::PureStateVector, release_gil())
+        .def("apply_hamiltonian", &sim_t::ApplyHamiltonian, release_gil())
+        .def(
+            "copy", [](const sim_t& sim) { return sim; }, release_gil())
+        .def("sampling", &sim_t::Sampling, release_gil())
+        .def("get_expectation", &sim_t::GetExpectation, release_gil())
+        .def("get_expectation_with_grad_multi_multi", &sim_t::GetExpectationWithReversibleGradMultiMulti,
+             release_gil())
+        .def("get_expectation_with_noise_grad_multi_multi", &sim_t::GetExpectationWithNoiseGradMultiMulti,
+             release_gil());
+
+    // Same entry points with every circuit given as a CompiledCircuit.
+    using mindquantum::python::WithCompiledCircuit;
+    sim_class
+        .def("apply_circuit", WithCompiledCircuit<sim_t>(&sim_t::ApplyCircuit), "gate"_a,
+             "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("sampling", WithCompiledCircuit<sim_t>(&sim_t::Sampling), release_gil())
+        .def("get_expectation", WithCompiledCircuit<sim_t>(&sim_t::GetExpectation), release_gil())
+        .def("get_expectation_with_grad_multi_multi",
+             WithCompiledCircuit<sim_t>(&sim_t::GetExpectationWithReversibleGradMultiMulti), release_gil())
+        .def("get_expectation_with_noise_grad_multi_multi",
+             WithCompiledCircuit<sim_t>(&sim_t::GetExpectationWithNoiseGradMultiMulti), release_gil());
+    return sim_class;
 }
 
 #endif
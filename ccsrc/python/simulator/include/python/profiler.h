@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PYTHON_LIB_QUANTUM_STATE_PROFILER_HPP
+#define PYTHON_LIB_QUANTUM_STATE_PROFILER_HPP
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "simulator/profiler.h"
+
+namespace mindquantum::python {
+/**
+ * Expose the profiler of this module.
+ *
+ * Each simulator module links its own copy of the profiler, so the python side merges the reports of all modules.
+ * A report is a list of (phase, gate, n_qubits, calls, time_ns, bytes) tuples.
+ */
+inline void BindProfiler(pybind11::module& module) {  // NOLINT(runtime/references)
+    using profiler::Profiler;
+    module.def("profiler_enabled", []() { return Profiler::Enabled(); });
+    module.def("profiler_reset", []() { Profiler::Instance().Reset(); });
+    module.def("profiler_report", []() {
+        std::vector<std::tuple<std::string, std::string, qbit_t, uint64_t, uint64_t, uint64_t>> out;
+        for (auto& entry : Profiler::Instance().Report()) {
+            auto gate = entry.gate == GateID::null ? std::string() : fmt::format("{}", entry.gate);
+            out.emplace_back(std::string(profiler::PhaseName(entry.phase)), gate, entry.n_qubits, entry.stat.calls,
+                             entry.stat.time_ns, entry.stat.bytes);
+        }
+        return out;
+    });
+}
+}  // namespace mindquantum::python
+#endif
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PYTHON_LIB_QUANTUM_STATE_SIM_FUTURE_HPP
+#define PYTHON_LIB_QUANTUM_STATE_SIM_FUTURE_HPP
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "python/core/compiled_circuit.h"
+#include "simulator/executor.h"
+
+namespace mindquantum::python {
+/**
+ * Python handle on a simulator task running on the global executor.
+ *
+ * The future keeps every python object the task reads from alive. Dropping a future that has not started cancels it,
+ * dropping a running future waits for it to finish.
+ */
+class SimFuture {
+ public:
+    template <typename R>
+    SimFuture(const std::shared_ptr<sim::Task<R>>& task, std::vector<pybind11::object> keep_alive)
+        : task_(task), keep_alive_(std::move(keep_alive)), result_([task]() { return pybind11::cast(task->Result()); }) {
+    }
+    SimFuture(SimFuture&&) = default;
+    SimFuture& operator=(SimFuture&&) = default;
+
+    ~SimFuture() {
+        if (task_ && !task_->Cancel()) {
+            pybind11::gil_scoped_release release;
+            task_->Wait();
+        }
+    }
+
+    bool Done() const {
+        return task_->Done();
+    }
+    bool Running() const {
+        return task_->State() == sim::TaskState::Running;
+    }
+    bool Cancelled() const {
+        return task_->State() == sim::TaskState::Cancelled;
+    }
+    bool Cancel() {
+        return task_->Cancel();
+    }
+    void Wait() const {
+        pybind11::gil_scoped_release release;
+        task_->Wait();
+    }
+    pybind11::object Result() const {
+        Wait();
+        return result_();
+    }
+    //! Call fn without arguments once the task is done, from the thread that finishes it.
+    void AddDoneCallback(const pybind11::function& fn) {
+        // The python callable is referenced by hand, so that it is only touched with the GIL held.
+        auto handle = fn.inc_ref().ptr();
+        task_->AddDoneCallback([handle]() {
+            pybind11::gil_scoped_acquire acquire;
+            auto callable = pybind11::reinterpret_steal<pybind11::function>(handle);
+            try {
+                callable();
+            } catch (pybind11::error_already_set& err) {
+                err.discard_as_unraisable("SimFuture done callback");
+            }
+        });
+    }
+
+ private:
+    std::shared_ptr<sim::TaskBase> task_;
+    std::vector<pybind11::object> keep_alive_;
+    std::function<pybind11::object()> result_;
+};
+
+namespace detail {
+// How an argument of a simulator method is received from python and stored until the task runs.
+template <typename sim_t, typename T>
+struct submit_arg {
+    using py_t = std::decay_t<T>;
+    using store_t = std::decay_t<T>;
+    static store_t Store(py_t&& arg, std::vector<pybind11::object>*) {
+        return std::move(arg);
+    }
+    static const store_t& Load(const store_t& arg) {
+        return arg;
+    }
+};
+
+// Other simulators are referenced, not copied.
+template <typename sim_t>
+struct submit_arg<sim_t, const sim_t&> {
+    using py_t = pybind11::object;
+    using store_t = const sim_t*;
+    static store_t Store(py_t&& arg, std::vector<pybind11::object>* keep_alive) {
+        auto ptr = &arg.cast<const sim_t&>();
+        keep_alive->push_back(std::move(arg));
+        return ptr;
+    }
+    static const sim_t& Load(store_t arg) {
+        return *arg;
+    }
+};
+
+// Circuits are accepted as a list of gates or as a CompiledCircuit, the latter is shared instead of copied.
+template <typename sim_t>
+struct submit_arg<sim_t, const CompiledCircuit::circuit_t&> {
+    using py_t = pybind11::object;
+    using store_t = std::shared_ptr<CompiledCircuit>;
+    static store_t Store(py_t&& arg, std::vector<pybind11::object>*) {
+        if (pybind11::isinstance<CompiledCircuit>(arg)) {
+            return arg.cast<std::shared_ptr<CompiledCircuit>>();
+        }
+        return std::make_shared<CompiledCircuit>(arg.cast<CompiledCircuit::circuit_t>());
+    }
+    static const CompiledCircuit::circuit_t& Load(const store_t& arg) {
+        return arg->circ;
+    }
+};
+
+template <typename sim_t, typename R, typename... Args, typename invoke_t>
+auto SubmitImpl(invoke_t invoke) {
+    return [invoke](pybind11::object self, typename submit_arg<sim_t, Args>::py_t... args) {
+        auto& sim = self.cast<sim_t&>();
+        std::vector<pybind11::object> keep_alive;
+        auto stored = std::make_tuple(submit_arg<sim_t, Args>::Store(std::move(args), &keep_alive)...);
+        keep_alive.push_back(std::move(self));
+        auto fn = [invoke, &sim, stored = std::move(stored)]() -> R {
+            return std::apply([&](const auto&... arg) { return invoke(sim, submit_arg<sim_t, Args>::Load(arg)...); },
+                              stored);
+        };
+        std::shared_ptr<sim::Task<R>> task;
+        {
+            // Submit blocks while the executor queue is full.
+            pybind11::gil_scoped_release release;
+            task = sim::Executor::Global().Async(std::move(fn));
+        }
+        return SimFuture(task, std::move(keep_alive));
+    };
+}
+}  // namespace detail
+
+//! Turn a simulator method into a binding that runs it on the global executor and returns a SimFuture.
+template <typename sim_t, typename R, typename C, typename... Args>
+auto SubmitMethod(R (C::*method)(Args...) const) {
+    return detail::SubmitImpl<sim_t, R, Args...>(
+        [method](const sim_t& sim, const auto&... args) { return (sim.*method)(args...); });
+}
+
+template <typename sim_t, typename R, typename C, typename... Args>
+auto SubmitMethod(R (C::*method)(Args...)) {
+    return detail::SubmitImpl<sim_t, R, Args...>(
+        [method](sim_t& sim, const auto&... args) { return (sim.*method)(args...); });
+}
+
+//! Same as SubmitMethod, for a free function whose first argument is the simulator.
+template <typename sim_t, typename R, typename... Args>
+auto SubmitFunction(R (*fn)(const sim_t&, Args...)) {
+    return detail::SubmitImpl<sim_t, R, Args...>(fn);
+}
+
+inline void BindSimFuture(pybind11::module& module) {  // NOLINT(runtime/references)
+    pybind11::class_<SimFuture>(module, "SimFuture", pybind11::module_local())
+        .def("done", &SimFuture::Done)
+        .def("running", &SimFuture::Running)
+        .def("cancelled", &SimFuture::Cancelled)
+        .def("cancel", &SimFuture::Cancel)
+        .def("wait", &SimFuture::Wait)
+        .def("result", &SimFuture::Result)
+        .def("add_done_callback", &SimFuture::AddDoneCallback);
+}
+}  // namespace mindquantum::python
+#endif
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2022. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PYTHON_LIB_QUANTUM_STATE_BIND_DIST_STATE_HPP
+#define PYTHON_LIB_QUANTUM_STATE_BIND_DIST_STATE_HPP
+#include <memory>
+#include <string>
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "math/pr/parameter_resolver.h"
+#include "simulator/transport.h"
+#include "simulator/vector/distributed_state.h"
+
+//! Bind the transports and the distributed simulator of policy \c qs_policy_t.
+template <typename qs_policy_t>
+void BindDistributed(pybind11::module& module) {  // NOLINT
+    using namespace pybind11::literals;           // NOLINT
+    using mindquantum::sim::ShmTransport;
+    using mindquantum::sim::Transport;
+    using sim_t = mindquantum::sim::vector::detail::DistributedVectorState<qs_policy_t>;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    pybind11::class_<Transport, std::shared_ptr<Transport>>(module, "Transport")
+        .def("rank", &Transport::Rank)
+        .def("size", &Transport::Size)
+        .def("barrier", &Transport::Barrier, release_gil());
+    pybind11::class_<ShmTransport, Transport, std::shared_ptr<ShmTransport>>(module, "ShmTransport")
+        .def(pybind11::init<const std::string&, int, int, size_t>(), "name"_a, "rank"_a, "size"_a,
+             "buffer_bytes"_a = ShmTransport::default_buffer_bytes, release_gil());
+#ifdef ENABLE_MPI
+    pybind11::class_<mindquantum::sim::MpiTransport, Transport, std::shared_ptr<mindquantum::sim::MpiTransport>>(
+        module, "MpiTransport")
+        .def(pybind11::init<>());
+#endif  // ENABLE_MPI
+
+    pybind11::class_<sim_t>(module, "mqvector_dist")
+        .def(pybind11::init<mindquantum::qbit_t, std::shared_ptr<Transport>, unsigned>(), "n_qubits"_a, "transport"_a,
+             "seed"_a = 42)
+        .def("rank", &sim_t::Rank)
+        .def("size", &sim_t::Size)
+        .def("local_qubits", &sim_t::LocalQubits)
+        .def("reset", &sim_t::Reset, release_gil())
+        .def("apply_gate", &sim_t::ApplyGate, "gate"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("apply_circuit", &sim_t::ApplyCircuit, "circ"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("get_local_qs", &sim_t::GetLocalQS, release_gil())
+        .def("get_qs", &sim_t::GetQS, release_gil())
+        .def("get_expectation", &sim_t::GetExpectation, "ham"_a, release_gil());
+}
+#endif
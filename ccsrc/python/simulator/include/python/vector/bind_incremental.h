@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PYTHON_LIB_QUANTUM_STATE_BIND_INCREMENTAL_HPP
+#define PYTHON_LIB_QUANTUM_STATE_BIND_INCREMENTAL_HPP
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "math/pr/parameter_resolver.h"
+#include "simulator/vector/incremental_expectation.h"
+
+//! Bind the incremental expectation of a vector simulator.
+template <typename sim_t>
+void BindIncremental(pybind11::module& module) {  // NOLINT
+    using namespace pybind11::literals;           // NOLINT
+    using inc_t = mindquantum::sim::vector::detail::IncrementalExpectation<typename sim_t::qs_policy_t>;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    pybind11::class_<inc_t>(module, "mqincremental")
+        .def(pybind11::init<const sim_t&, const mindquantum::Hamiltonian<typename sim_t::calc_type>&,
+                            const typename inc_t::circuit_t&, const mindquantum::parameter::ParameterResolver&>(),
+             "sim"_a, "ham"_a, "circ"_a, "pr"_a)
+        .def("get_expectation", &inc_t::GetExpectation, release_gil())
+        .def("evaluate", &inc_t::Evaluate, "name"_a, "values"_a, release_gil())
+        .def("reconstruct", &inc_t::Reconstruct, "name"_a, release_gil())
+        .def("minimize", &inc_t::Minimize, "name"_a, release_gil())
+        .def("set_parameter", &inc_t::SetParameter, "name"_a, "value"_a)
+        .def("get_parameter", &inc_t::GetParameter, "name"_a)
+        .def("parameter_order", &inc_t::ParameterOrder)
+        .def("get_applied_gates", &inc_t::GetAppliedGates);
+}
+#endif
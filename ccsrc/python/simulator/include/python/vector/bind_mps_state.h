@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2022. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PYTHON_LIB_QUANTUM_STATE_BIND_MPS_STATE_HPP
+#define PYTHON_LIB_QUANTUM_STATE_BIND_MPS_STATE_HPP
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "math/pr/parameter_resolver.h"
+#include "simulator/mps/mps_state.h"
+
+//! Bind the matrix product state simulator.
+inline void BindMPS(pybind11::module& module) {  // NOLINT
+    using namespace pybind11::literals;          // NOLINT
+    using sim_t = mindquantum::sim::mps::MPSState;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    pybind11::class_<sim_t>(module, "mqmps")
+        .def(pybind11::init<mindquantum::qbit_t, unsigned>(), "n_qubits"_a, "seed"_a = 42)
+        .def(pybind11::init<const sim_t&>())
+        .def("n_qubits", &sim_t::GetQubits)
+        .def("reset", &sim_t::Reset, release_gil())
+        .def("apply_gate", &sim_t::ApplyGate, "gate"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("apply_circuit", &sim_t::ApplyCircuit, "circ"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("sampling", &sim_t::Sampling, "circ"_a, "pr"_a, "shots"_a, "key_map"_a, "seed"_a, release_gil())
+        .def("get_expectation", &sim_t::GetExpectation, "ham"_a, release_gil())
+        .def("get_amplitude", &sim_t::GetAmplitude, "bits"_a)
+        .def("get_qs", &sim_t::GetQS, release_gil())
+        .def("get_bond_dims", &sim_t::GetBondDims)
+        .def("get_truncation_error", &sim_t::GetTruncationError)
+        .def("set_max_bond", &sim_t::SetMaxBond, "max_bond"_a)
+        .def("get_max_bond", &sim_t::GetMaxBond)
+        .def("set_truncation_threshold", &sim_t::SetTruncationThreshold, "threshold"_a)
+        .def("get_truncation_threshold", &sim_t::GetTruncationThreshold);
+}
+#endif
@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PYTHON_LIB_QUANTUM_STATE_BIND_SHADOW_HPP
+#define PYTHON_LIB_QUANTUM_STATE_BIND_SHADOW_HPP
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "simulator/shadow/classical_shadow.h"
+
+//! Bind the classical shadow, which samples the state of the given vector simulators.
+template <typename... vec_sim_t>
+void BindClassicalShadow(pybind11::module& module) {  // NOLINT
+    using namespace pybind11::literals;               // NOLINT
+    using shadow_t = mindquantum::sim::shadow::ClassicalShadow;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    auto shadow_class = pybind11::class_<shadow_t>(module, "mqshadow")
+                            .def(pybind11::init<mindquantum::qbit_t, unsigned>(), "n_qubits"_a, "seed"_a = 42)
+                            .def("n_qubits", &shadow_t::GetQubits)
+                            .def("n_snapshots", &shadow_t::GetSnapshotCount)
+                            .def("sample", &shadow_t::Sample, "qs"_a, "n_snapshots"_a, release_gil())
+                            .def("clear", &shadow_t::Clear)
+                            .def("get_bases", &shadow_t::GetBases)
+                            .def("get_outcomes", &shadow_t::GetOutcomes)
+                            .def("estimate_terms", &shadow_t::EstimateTerms, "ham"_a, "n_groups"_a, release_gil())
+                            .def("estimate_expectation", &shadow_t::EstimateExpectation, "ham"_a, "n_groups"_a,
+                                 release_gil());
+    (shadow_class.def(
+         "sample",
+         [](shadow_t& shadow, const vec_sim_t& sim, mindquantum::index_t n_snapshots) {
+             auto qs = sim.GetQS();
+             shadow.Sample(mindquantum::VT<mindquantum::sim::shadow::amp_t>(qs.begin(), qs.end()), n_snapshots);
+         },
+         "sim"_a, "n_snapshots"_a, release_gil()),
+     ...);
+}
+#endif
@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2022. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PYTHON_LIB_QUANTUM_STATE_BIND_SPARSE_STATE_HPP
+#define PYTHON_LIB_QUANTUM_STATE_BIND_SPARSE_STATE_HPP
+#include <string>
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "math/pr/parameter_resolver.h"
+#include "simulator/vector/sparse_state.h"
+
+//! Bind the sparse simulator of policy \c qs_policy_t, which runs the state once it turns dense.
+template <typename qs_policy_t>
+void BindSparse(pybind11::module& module) {  // NOLINT
+    using namespace pybind11::literals;      // NOLINT
+    using sim_t = mindquantum::sim::vector::detail::SparseVectorState<qs_policy_t>;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    pybind11::class_<sim_t>(module, "mqvector_sparse")
+        .def(pybind11::init<mindquantum::qbit_t, unsigned>(), "n_qubits"_a, "seed"_a = 42)
+        .def(pybind11::init<const sim_t&>())
+        .def("n_qubits", &sim_t::GetQubits)
+        .def("reset", &sim_t::Reset, release_gil())
+        .def("apply_gate", &sim_t::ApplyGate, "gate"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("apply_circuit", &sim_t::ApplyCircuit, "circ"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("sampling", &sim_t::Sampling, "circ"_a, "pr"_a, "shots"_a, "key_map"_a, "seed"_a, release_gil())
+        .def("get_expectation", &sim_t::GetExpectation, "ham"_a, release_gil())
+        .def("get_amplitude", &sim_t::GetAmplitude, "index"_a)
+        .def("get_amplitudes", &sim_t::GetAmplitudes, release_gil())
+        .def("get_qs", &sim_t::GetQS, release_gil())
+        .def("size", &sim_t::Size)
+        .def("is_dense", &sim_t::IsDense)
+        .def("set_prune_threshold", &sim_t::SetPruneThreshold, "threshold"_a)
+        .def("get_prune_threshold", &sim_t::GetPruneThreshold)
+        .def("set_dense_threshold", &sim_t::SetDenseThreshold, "fraction"_a, "max_qubits"_a);
+}
+#endif
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PYTHON_LIB_QUANTUM_STATE_BIND_STABILIZER_STATE_HPP
+#define PYTHON_LIB_QUANTUM_STATE_BIND_STABILIZER_STATE_HPP
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "math/pr/parameter_resolver.h"
+#include "simulator/stabilizer/near_clifford_state.h"
+#include "simulator/stabilizer/pauli_propagator.h"
+#include "simulator/stabilizer/stabilizer_state.h"
+
+//! Bind the stabilizer simulator.
+inline void BindStabilizer(pybind11::module& module) {  // NOLINT
+    using namespace pybind11::literals;                 // NOLINT
+    using sim_t = mindquantum::sim::stabilizer::StabilizerState;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    pybind11::class_<sim_t>(module, "mqstabilizer")
+        .def(pybind11::init<mindquantum::qbit_t, unsigned>(), "n_qubits"_a, "seed"_a = 42)
+        .def(pybind11::init<const sim_t&>())
+        .def("n_qubits", &sim_t::GetQubits)
+        .def("reset", &sim_t::Reset)
+        .def("apply_gate", &sim_t::ApplyGate, "gate"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("apply_circuit", &sim_t::ApplyCircuit, "circ"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("sampling", &sim_t::Sampling, "circ"_a, "pr"_a, "shots"_a, "key_map"_a, "seed"_a, release_gil())
+        .def("get_expectation", &sim_t::GetExpectation, "ham"_a, release_gil())
+        .def("get_stabilizers", &sim_t::GetStabilizers);
+}
+
+//! Bind the near Clifford simulator.
+inline void BindNearClifford(pybind11::module& module) {  // NOLINT
+    using namespace pybind11::literals;                   // NOLINT
+    using sim_t = mindquantum::sim::stabilizer::NearCliffordState;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    pybind11::class_<sim_t>(module, "mqnearclifford")
+        .def(pybind11::init<mindquantum::qbit_t, unsigned>(), "n_qubits"_a, "seed"_a = 42)
+        .def(pybind11::init<const sim_t&>())
+        .def("n_qubits", &sim_t::GetQubits)
+        .def("reset", &sim_t::Reset)
+        .def("apply_gate", &sim_t::ApplyGate, "gate"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("apply_circuit", &sim_t::ApplyCircuit, "circ"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("sampling", &sim_t::Sampling, "circ"_a, "pr"_a, "shots"_a, "key_map"_a, "seed"_a, release_gil())
+        .def("get_expectation", &sim_t::GetExpectation, "ham"_a, release_gil())
+        .def("get_branch_count", &sim_t::GetBranchCount)
+        .def("get_truncation_error", &sim_t::GetTruncationError)
+        .def("set_truncation_threshold", &sim_t::SetTruncationThreshold, "threshold"_a)
+        .def("get_truncation_threshold", &sim_t::GetTruncationThreshold);
+}
+
+//! Bind the Heisenberg picture Pauli propagator.
+inline void BindPauliPropagator(pybind11::module& module) {  // NOLINT
+    using namespace pybind11::literals;                      // NOLINT
+    using sim_t = mindquantum::sim::stabilizer::PauliPropagator;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    pybind11::class_<sim_t>(module, "mqpaulipropagator")
+        .def(pybind11::init<mindquantum::qbit_t>(), "n_qubits"_a)
+        .def("n_qubits", &sim_t::GetQubits)
+        .def("set_coefficient_threshold", &sim_t::SetCoefficientThreshold, "threshold"_a)
+        .def("get_coefficient_threshold", &sim_t::GetCoefficientThreshold)
+        .def("set_max_weight", &sim_t::SetMaxWeight, "max_weight"_a)
+        .def("get_max_weight", &sim_t::GetMaxWeight)
+        .def("set_product_state", &sim_t::SetProductState, "bloch"_a)
+        .def("get_expectation", &sim_t::GetExpectation, "ham"_a, "circ"_a, "pr"_a = parameter::ParameterResolver(),
+             release_gil())
+        .def("get_max_term_count", &sim_t::GetMaxTermCount)
+        .def("get_truncated_weight", &sim_t::GetTruncatedWeight);
+}
+#endif
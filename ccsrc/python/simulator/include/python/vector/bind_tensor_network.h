@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2022. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PYTHON_LIB_QUANTUM_STATE_BIND_TENSOR_NETWORK_HPP
+#define PYTHON_LIB_QUANTUM_STATE_BIND_TENSOR_NETWORK_HPP
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "math/pr/parameter_resolver.h"
+#include "simulator/tensornet/tensor_network.h"
+
+//! Bind the tensor network contraction.
+inline void BindTensorNetwork(pybind11::module& module) {  // NOLINT
+    using namespace pybind11::literals;                    // NOLINT
+    using sim_t = mindquantum::sim::tensornet::TensorNetwork;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
+
+    pybind11::class_<sim_t>(module, "mqtensornet")
+        .def(pybind11::init<mindquantum::qbit_t, unsigned>(), "n_qubits"_a, "seed"_a = 42)
+        .def("n_qubits", &sim_t::GetQubits)
+        .def("set_max_rank", &sim_t::SetMaxRank, "max_rank"_a)
+        .def("get_max_rank", &sim_t::GetMaxRank)
+        .def("set_order_trials", &sim_t::SetOrderTrials, "trials"_a)
+        .def("get_order_trials", &sim_t::GetOrderTrials)
+        .def("get_amplitudes", &sim_t::GetAmplitudes, "circ"_a, "bits"_a, "pr"_a = parameter::ParameterResolver(),
+             release_gil())
+        .def("get_expectation", &sim_t::GetExpectation, "ham"_a, "circ"_a, "pr"_a = parameter::ParameterResolver(),
+             release_gil())
+        .def("get_last_path", [](const sim_t& sim) {
+            const auto& path = sim.GetLastPath();
+            return pybind11::dict("steps"_a = path.steps, "sliced"_a = path.sliced, "flops"_a = path.flops,
+                                  "max_rank"_a = path.max_rank);
+        });
+}
+#endif
@@ -19,6 +19,7 @@
 #include <string_view>
 
 #include <pybind11/complex.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -40,53 +41,162 @@
 #endif  // __CUDACC__
 
 #include "ops/hamiltonian.h"
+#include "python/core/compiled_circuit.h"
+#include "python/sim_future.h"
 #include "simulator/vector/blas.h"
 #include "simulator/vector/vector_state.h"
 
+//! Sample on a copy of the simulator that first evolved with a measurement free prefix circuit.
 template <typename sim_t>
+mindquantum::VT<unsigned> SampleAfterPrefix(const sim_t& sim, const typename sim_t::circuit_t& prefix,
+                                            const typename sim_t::circuit_t& circ,
+                                            const parameter::ParameterResolver& pr, size_t shots,
+                                            const mindquantum::MST<size_t>& key_map, unsigned seed) {
+    if (prefix.empty()) {
+        return sim.Sampling(circ, pr, shots, key_map, seed);
+    }
+    auto evolved = sim;
+    evolved.ApplyCircuit(prefix, pr);
+    return evolved.Sampling(circ, pr, shots, key_map, seed);
+}
+
+template <typename sim_t, typename... options_t>
 auto BindSim(pybind11::module& module, const std::string_view& name) {  // NOLINT
     using namespace pybind11::literals;                                 // NOLINT
     using qbit_t = mindquantum::qbit_t;
     using calc_type = typename sim_t::calc_type;
     using circuit_t = typename sim_t::circuit_t;
+    using py_qs_data_t = typename sim_t::py_qs_data_t;
+    using release_gil = pybind11::call_guard<pybind11::gil_scoped_release>;
 
-    return pybind11::class_<sim_t>(module, name.data())
+    auto sim_class = pybind11::class_<sim_t, options_t...>(module, name.data())
         .def(pybind11::init<qbit_t, unsigned>(), "n_qubits"_a, "seed"_a = 42)
         .def("dtype", &sim_t::DType)
         .def("display", &sim_t::Display, "qubits_limit"_a = 10)
-        .def("apply_gate", &sim_t::ApplyGate, "gate"_a, "pr"_a = parameter::ParameterResolver(), "diff"_a = false)
-        .def("apply_circuit", &sim_t::ApplyCircuit, "gate"_a, "pr"_a = parameter::ParameterResolver())
-        .def("reset", &sim_t::Reset)
-        .def("get_qs", &sim_t::GetQS)
-        .def("set_qs", &sim_t::SetQS)
-        .def("apply_hamiltonian", &sim_t::ApplyHamiltonian)
-        .def("copy", [](const sim_t& sim) { return sim; })
-        .def("sampling", &sim_t::Sampling)
-        .def("get_circuit_matrix", &sim_t::GetCircuitMatrix)
+        .def("apply_gate", &sim_t::ApplyGate, "gate"_a, "pr"_a = parameter::ParameterResolver(), "diff"_a = false,
+             release_gil())
+        .def("apply_circuit", &sim_t::ApplyCircuit, "gate"_a, "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("reset", &sim_t::Reset, release_gil())
+        .def("get_qs", &sim_t::GetQS, release_gil())
+        .def("is_zero_state", &sim_t::IsZeroState)
+        .def("set_qs", &sim_t::SetQS, release_gil())
+        .def("apply_hamiltonian", &sim_t::ApplyHamiltonian, release_gil())
+        .def("set_renormalization", &sim_t::SetRenormalization, "interval"_a)
+        .def("get_renormalization", &sim_t::GetRenormalization)
+        .def(
+            "copy", [](const sim_t& sim) { return sim; }, release_gil())
+        .def("sampling", &sim_t::Sampling, release_gil())
+        .def("get_circuit_matrix", &sim_t::GetCircuitMatrix, release_gil())
         .def("get_expectation",
              pybind11::overload_cast<const mindquantum::Hamiltonian<calc_type>&, const circuit_t&, const circuit_t&,
                                      const typename sim_t::derived_t&, const parameter::ParameterResolver&>(
-                 &sim_t::GetExpectation, pybind11::const_))
+                 &sim_t::GetExpectation, pybind11::const_),
+             release_gil())
         .def("get_expectation",
              pybind11::overload_cast<const mindquantum::Hamiltonian<calc_type>&, const circuit_t&, const circuit_t&,
-                                     const parameter::ParameterResolver&>(&sim_t::GetExpectation, pybind11::const_))
+                                     const parameter::ParameterResolver&>(&sim_t::GetExpectation, pybind11::const_),
+             release_gil())
         .def("get_expectation",
              pybind11::overload_cast<const mindquantum::Hamiltonian<calc_type>&, const circuit_t&,
-                                     const parameter::ParameterResolver&>(&sim_t::GetExpectation, pybind11::const_))
-        .def("qram_expectation_with_grad", &sim_t::QramExpectationWithGrad)
-        .def("get_expectation_with_grad_one_one", &sim_t::GetExpectationWithGradOneOne)
-        .def("get_expectation_with_grad_one_multi", &sim_t::GetExpectationWithGradOneMulti)
-        .def("get_expectation_with_grad_multi_multi", &sim_t::GetExpectationWithGradMultiMulti)
+                                     const parameter::ParameterResolver&>(&sim_t::GetExpectation, pybind11::const_),
+             release_gil())
+        .def("qram_expectation_with_grad", &sim_t::QramExpectationWithGrad, release_gil())
+        .def("get_expectation_with_grad_one_one", &sim_t::GetExpectationWithGradOneOne, release_gil())
+        .def("get_expectation_with_grad_one_multi", &sim_t::GetExpectationWithGradOneMulti, release_gil())
+        .def("get_expectation_with_grad_multi_multi", &sim_t::GetExpectationWithGradMultiMulti, release_gil())
         .def("get_expectation_with_grad_non_hermitian_multi_multi",
-             &sim_t::GetExpectationNonHermitianWithGradMultiMulti)
+             &sim_t::GetExpectationNonHermitianWithGradMultiMulti, release_gil())
         .def("get_expectation_with_grad_parameter_shift_multi_multi",
-             &sim_t::GetExpectationWithGradParameterShiftMultiMulti);
+             &sim_t::GetExpectationWithGradParameterShiftMultiMulti, release_gil());
+
+    // Same entry points with every circuit given as a CompiledCircuit.
+    using mindquantum::python::WithCompiledCircuit;
+    using get_exp_t = py_qs_data_t (sim_t::*)(const mindquantum::Hamiltonian<calc_type>&, const circuit_t&,
+                                              const parameter::ParameterResolver&) const;
+    using get_exp_lr_t = py_qs_data_t (sim_t::*)(const mindquantum::Hamiltonian<calc_type>&, const circuit_t&,
+                                                 const circuit_t&, const parameter::ParameterResolver&) const;
+    using get_exp_sim_t = py_qs_data_t (sim_t::*)(const mindquantum::Hamiltonian<calc_type>&, const circuit_t&,
+                                                  const circuit_t&, const typename sim_t::derived_t&,
+                                                  const parameter::ParameterResolver&) const;
+    sim_class
+        .def("apply_circuit", WithCompiledCircuit<sim_t>(&sim_t::ApplyCircuit), "gate"_a,
+             "pr"_a = parameter::ParameterResolver(), release_gil())
+        .def("sampling", WithCompiledCircuit<sim_t>(&sim_t::Sampling), release_gil())
+        .def("get_circuit_matrix", WithCompiledCircuit<sim_t>(&sim_t::GetCircuitMatrix), release_gil())
+        .def("get_expectation", WithCompiledCircuit<sim_t>(static_cast<get_exp_sim_t>(&sim_t::GetExpectation)),
+             release_gil())
+        .def("get_expectation", WithCompiledCircuit<sim_t>(static_cast<get_exp_lr_t>(&sim_t::GetExpectation)),
+             release_gil())
+        .def("get_expectation", WithCompiledCircuit<sim_t>(static_cast<get_exp_t>(&sim_t::GetExpectation)),
+             release_gil())
+        .def("qram_expectation_with_grad", WithCompiledCircuit<sim_t>(&sim_t::QramExpectationWithGrad), release_gil())
+        .def("get_expectation_with_grad_one_one", WithCompiledCircuit<sim_t>(&sim_t::GetExpectationWithGradOneOne),
+             release_gil())
+        .def("get_expectation_with_grad_one_multi",
+             WithCompiledCircuit<sim_t>(&sim_t::GetExpectationWithGradOneMulti), release_gil())
+        .def("get_expectation_with_grad_multi_multi",
+             WithCompiledCircuit<sim_t>(&sim_t::GetExpectationWithGradMultiMulti), release_gil())
+        .def("get_expectation_with_grad_non_hermitian_multi_multi",
+             WithCompiledCircuit<sim_t>(&sim_t::GetExpectationNonHermitianWithGradMultiMulti), release_gil())
+        .def("get_expectation_with_grad_parameter_shift_multi_multi",
+             WithCompiledCircuit<sim_t>(&sim_t::GetExpectationWithGradParameterShiftMultiMulti), release_gil());
+
+    // Asynchronous versions, the work runs on the global executor and a SimFuture is returned.
+    using mindquantum::python::SubmitFunction;
+    using mindquantum::python::SubmitMethod;
+    sim_class.def("submit_get_expectation", SubmitMethod<sim_t>(static_cast<get_exp_t>(&sim_t::GetExpectation)))
+        .def("submit_get_expectation_with_grad_multi_multi",
+             SubmitMethod<sim_t>(&sim_t::GetExpectationWithGradMultiMulti))
+        .def("submit_get_expectation_with_grad_non_hermitian_multi_multi",
+             SubmitMethod<sim_t>(&sim_t::GetExpectationNonHermitianWithGradMultiMulti))
+        .def("submit_get_expectation_with_grad_parameter_shift_multi_multi",
+             SubmitMethod<sim_t>(&sim_t::GetExpectationWithGradParameterShiftMultiMulti))
+        .def("submit_sampling", SubmitFunction<sim_t>(&SampleAfterPrefix<sim_t>));
+#ifndef __CUDACC__
+    using qs_array_t = pybind11::array_t<py_qs_data_t, pybind11::array::c_style | pybind11::array::forcecast>;
+    sim_class
+        .def(
+            "get_qs_view",
+            [](pybind11::object self, bool writable) {
+                auto& sim = self.cast<sim_t&>();
+                auto data = reinterpret_cast<py_qs_data_t*>(sim.AcquireQSView());
+                // The capsule keeps the simulator alive and releases the view when numpy drops the array.
+                auto owner = new pybind11::object(self);
+                pybind11::capsule base(owner, [](void* ptr) {
+                    auto obj = reinterpret_cast<pybind11::object*>(ptr);
+                    obj->cast<sim_t&>().ReleaseQSView();
+                    delete obj;
+                });
+                pybind11::array_t<py_qs_data_t> out({static_cast<pybind11::ssize_t>(sim.GetDim())}, data, base);
+                if (!writable) {
+                    out.attr("setflags")("write"_a = false);
+                }
+                return out;
+            },
+            "writable"_a = false, "Get a numpy array that aliases the quantum state buffer.")
+        .def(
+            "set_qs_from_array",
+            [](sim_t& sim, const qs_array_t& qs_out) {
+                if (qs_out.ndim() != 1) {
+                    throw std::invalid_argument("quantum state should be a 1-D array.");
+                }
+                auto data = qs_out.data();
+                auto size = static_cast<mindquantum::index_t>(qs_out.size());
+                pybind11::gil_scoped_release release;
+                sim.SetQSFromBuffer(data, size);
+            },
+            "qs"_a, "Set the quantum state from a contiguous complex array.")
+        .def("save_state", &sim_t::Save, "filename"_a, "drop_below"_a = 0.0, release_gil())
+        .def("load_state", &sim_t::Load, "filename"_a, release_gil());
+#endif  // __CUDACC__
+    return sim_class;
 }
 
 template <typename sim_t>
 auto BindBlas(pybind11::module& module) {  // NOLINT
     using qs_policy_t = typename sim_t::qs_policy_t;
-    module.def("inner_product", mindquantum::sim::vector::detail::BLAS<qs_policy_t>::InnerProduct);
+    module.def("inner_product", mindquantum::sim::vector::detail::BLAS<qs_policy_t>::InnerProduct,
+               pybind11::call_guard<pybind11::gil_scoped_release>());
 }
 
 #endif
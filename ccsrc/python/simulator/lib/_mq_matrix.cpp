@@ -31,6 +31,9 @@
 #endif
 
 #include "python/densitymatrix/bind_mat_state.h"
+#include "python/core/memory.h"
+#include "python/core/trace.h"
+#include "python/profiler.h"
 
 PYBIND11_MODULE(_mq_matrix, module) {
 #ifdef __CUDACC__
@@ -48,6 +51,9 @@ PYBIND11_MODULE(_mq_matrix, module) {
     using double_mat_sim = mindquantum::sim::densitymatrix::detail::DensityMatrixState<double_policy_t>;
 
     module.doc() = "MindQuantum c++ density matrix state simulator.";
+    mindquantum::python::BindProfiler(module);
+    mindquantum::python::BindTrace(module);
+    mindquantum::python::BindMemory(module);
     pybind11::module float_sim = module.def_submodule("float", "float simulator");
     pybind11::module double_sim = module.def_submodule("double", "double simulator");
 
@@ -23,13 +23,31 @@
 #elif defined(__x86_64__)
 #    include "simulator/vector/detail/cpu_vector_avx_double_policy.h"
 #    include "simulator/vector/detail/cpu_vector_avx_float_policy.h"
+#    include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#    include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #    include "simulator/vector/detail/cpu_vector_policy.h"
 #elif defined(__amd64)
 #    include "simulator/vector/detail/cpu_vector_arm_double_policy.h"
 #    include "simulator/vector/detail/cpu_vector_arm_float_policy.h"
+#    include "simulator/vector/detail/cpu_vector_mixed_policy.h"
+#    include "simulator/vector/detail/cpu_vector_out_of_core_policy.h"
 #    include "simulator/vector/detail/cpu_vector_policy.h"
 #endif
+#ifndef __CUDACC__
+#    include "simulator/vector/out_of_core_state.h"
+#endif
 
+#include "python/core/memory.h"
+#include "python/core/trace.h"
+#include "python/profiler.h"
+#include "python/vector/bind_dist_state.h"
+#include "python/vector/bind_incremental.h"
+#include "python/vector/bind_mps_state.h"
+#include "python/vector/bind_particle_state.h"
+#include "python/vector/bind_shadow.h"
+#include "python/vector/bind_sparse_state.h"
+#include "python/vector/bind_stabilizer_state.h"
+#include "python/vector/bind_tensor_network.h"
 #include "python/vector/bind_vec_state.h"
 
 PYBIND11_MODULE(_mq_vector, module) {
@@ -51,6 +69,10 @@ PYBIND11_MODULE(_mq_vector, module) {
     using double_vec_sim = mindquantum::sim::vector::detail::VectorState<double_policy_t>;
 
     module.doc() = "MindQuantum c++ vector state simulator.";
+    mindquantum::python::BindSimFuture(module);
+    mindquantum::python::BindProfiler(module);
+    mindquantum::python::BindTrace(module);
+    mindquantum::python::BindMemory(module);
     pybind11::module float_sim = module.def_submodule("float", "float simulator");
     pybind11::module double_sim = module.def_submodule("double", "double simulator");
 
@@ -81,5 +103,77 @@ PYBIND11_MODULE(_mq_vector, module) {
     BindBlas<float_vec_sim>(float_blas);
     BindBlas<double_vec_sim>(double_blas);
 
+    // Expectation under one parameter updates, see mindquantum.simulator.IncrementalExpectation.
+    BindIncremental<float_vec_sim>(float_sim);
+    BindIncremental<double_vec_sim>(double_sim);
+
+#ifndef __CUDACC__
+    // Mixed precision simulator, complex64 storage with double arithmetic, exposed as mqvector_mixed.
+    using mixed_policy_t = mindquantum::sim::vector::detail::CPUVectorPolicyMixed;
+    using mixed_vec_sim = mindquantum::sim::vector::detail::VectorState<mixed_policy_t>;
+    pybind11::module mixed_sim = module.def_submodule("mixed", "mixed precision simulator");
+    BindSim<mixed_vec_sim>(mixed_sim, "mqvector_mixed")
+        .def("complex128", &mixed_vec_sim::astype<double_policy_t, mindquantum::sim::vector::detail::CastTo>)
+        .def("complex64", &mixed_vec_sim::astype<mixed_policy_t, mindquantum::sim::vector::detail::CastTo>)
+        .def("sim_name", [](const mixed_vec_sim& sim) { return "mqvector_mixed"; });
+    pybind11::module mixed_blas = mixed_sim.def_submodule("blas", "MindQuantum simulator algebra module.");
+    BindBlas<mixed_vec_sim>(mixed_blas);
+
+    // Hash map of the nonzero amplitudes, see mindquantum.simulator.SparseSimulator.
+    pybind11::module sparse_sim = module.def_submodule("sparse", "sparse simulator");
+    BindSparse<double_policy_t>(sparse_sim);
+
+    // Matrix product state, see mindquantum.simulator.MPSSimulator.
+    pybind11::module mps_sim = module.def_submodule("mps", "matrix product state simulator");
+    BindMPS(mps_sim);
+
+    // Clifford tableau and Pauli strings, see mindquantum.simulator.StabilizerSimulator, NearCliffordSimulator and
+    // PauliPropagator.
+    pybind11::module stabilizer_sim = module.def_submodule("stabilizer", "stabilizer simulator");
+    BindStabilizer(stabilizer_sim);
+    BindNearClifford(stabilizer_sim);
+    BindPauliPropagator(stabilizer_sim);
+
+    // Contraction of the circuit as a tensor network, see mindquantum.simulator.TensorNetworkSimulator.
+    pybind11::module tensornet_sim = module.def_submodule("tensornet", "tensor network simulator");
+    BindTensorNetwork(tensornet_sim);
+
+    // Fixed number of set qubits, see mindquantum.simulator.ParticleSubspaceSimulator.
+    pybind11::module subspace_sim = module.def_submodule("subspace", "particle number subspace simulator");
+    BindParticleState(subspace_sim);
+
+    // Random local Pauli snapshots of a vector state, see mindquantum.simulator.ClassicalShadow.
+    pybind11::module shadow_sim = module.def_submodule("shadow", "classical shadow");
+    BindClassicalShadow<double_vec_sim, float_vec_sim>(shadow_sim);
+
+#    ifndef _WIN32
+    // State in a memory mapped file, exposed as mqvector_ooc. The base class is registered so that the methods taking
+    // another simulator of the same policy accept it.
+    using ooc_policy_t = mindquantum::sim::vector::detail::CPUVectorPolicyOutOfCore;
+    using ooc_vec_sim = mindquantum::sim::vector::detail::OutOfCoreVectorState;
+    pybind11::module ooc_sim = module.def_submodule("out_of_core", "out-of-core simulator");
+    pybind11::class_<ooc_vec_sim::base_t>(ooc_sim, "mqvector_ooc_base");
+    BindSim<ooc_vec_sim, ooc_vec_sim::base_t>(ooc_sim, "mqvector_ooc")
+        .def("complex128",
+             [](const ooc_vec_sim& sim, unsigned seed) {
+                 ooc_vec_sim out(sim.astype<ooc_policy_t, mindquantum::sim::vector::detail::CastTo>(seed));
+                 out.SetChunkQubits(sim.GetChunkQubits());
+                 return out;
+             })
+        .def("complex64", &ooc_vec_sim::astype<float_policy_t, mindquantum::sim::vector::detail::CastTo>)
+        .def("sim_name", [](const ooc_vec_sim& sim) { return "mqvector_ooc"; })
+        .def("set_chunk_qubits", &ooc_vec_sim::SetChunkQubits, "chunk_qubits"_a)
+        .def("get_chunk_qubits", &ooc_vec_sim::GetChunkQubits);
+    ooc_sim.def("set_storage_dir", &ooc_policy_t::SetStorageDir, "dir"_a);
+    ooc_sim.def("get_storage_dir", &ooc_policy_t::StorageDir);
+    pybind11::module ooc_blas = ooc_sim.def_submodule("blas", "MindQuantum simulator algebra module.");
+    BindBlas<ooc_vec_sim>(ooc_blas);
+
+    // State partitioned over processes, see mindquantum.simulator.DistributedSimulator.
+    pybind11::module dist_sim = module.def_submodule("distributed", "distributed simulator");
+    BindDistributed<double_policy_t>(dist_sim);
+#    endif  // _WIN32
+#endif  // __CUDACC__
+
     module.def("ground_state_of_zs", &double_policy_t::GroundStateOfZZs, "masks_value"_a, "n_qubits"_a);
 }
@@ -335,6 +335,7 @@ mq_add_compile_definitions(
   "$<$<BOOL:${ENABLE_LOGGING_DEBUG_LEVEL}>:MQ_LOG_ACTIVE_LEVEL=SPDLOG_LEVEL_DEBUG>"
   "$<$<BOOL:${ENABLE_LOGGING_TRACE_LEVEL}>:MQ_LOG_ACTIVE_LEVEL=SPDLOG_LEVEL_TRACE>"
   "$<$<BOOL:${ENABLE_LOGGING}>:ENABLE_LOGGING>"
+  "$<$<BOOL:${ENABLE_PROFILING}>:ENABLE_PROFILING>"
   "$<$<AND:$<BOOL:${ENABLE_GCC_DEBUG_MODE}>,$<BOOL:${CMAKE_COMPILER_IS_GNUCXX}>>:_GLIBCXX_DEBUG>"
   "$<$<AND:$<CONFIG:RELEASE>,$<COMPILE_LANGUAGE:CXX>>:_FORTIFY_SOURCE=2>")
 
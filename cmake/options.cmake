@@ -95,7 +95,8 @@ endif()
 
 # ------------------------------------------------------------------------------
 
-option(ENABLE_PROFILING "Enable compilation with profiling flags." OFF)
+option(ENABLE_PROFILING "Enable compilation with profiling flags and the simulator profiler." OFF)
+option(ENABLE_MPI "Enable the MPI transport of the distributed vector simulator" OFF)
 option(ENABLE_STACK_PROTECTION "Enable the use of -fstack-protector during compilation" ON)
 
 option(ENABLE_GCC_DEBUG_MODE "Enable the debug mode for GCC and libstdc++" OFF)
@@ -140,6 +141,7 @@ option(ENABLE_ABSEIL_CPP "Enable the use of the abseil-cpp library" _enable_abse
 
 option(BUILD_SHARED_LIBS "Build shared libs" OFF)
 option(BUILD_TESTING "Build the test suite?" OFF)
+option(BUILD_BENCHMARK "Build the mqbench micro-benchmark of the simulator kernels" OFF)
 option(CLEAN_3RDPARTY_INSTALL_DIR "Clean third-party installation directory" OFF)
 option(ENABLE_CMAKE_DEBUG "Enable verbose output to debug CMake issues" OFF)
 option(USE_VERBOSE_MAKEFILE "Use verbose Makefiles" ON)
@@ -175,6 +175,19 @@ if("${CMAKE_PROJECT_NAME}" STREQUAL "MindQuantum")
   find_package(Patch REQUIRED)
 endif()
 
+# ==============================================================================
+# MPI
+
+if(ENABLE_MPI)
+  find_package(MPI COMPONENTS CXX)
+  if(NOT MPI_CXX_FOUND)
+    message(STATUS "Disabling the MPI transport since unable to locate MPI")
+    set(ENABLE_MPI
+        OFF
+        CACHE INTERNAL "Enable the MPI transport of the distributed vector simulator")
+  endif()
+endif()
+
 # ==============================================================================
 # CUDA
 
@@ -25,6 +25,7 @@ from typing import List
 import numpy as np
 from rich.console import Console
 
+from mindquantum import mqbackend as mb
 from mindquantum.utils.type_value_check import (
     _check_and_generate_pr_type,
     _check_gate_has_obj,
@@ -286,6 +287,7 @@ class Circuit(list):  # pylint: disable=too-many-instance-attributes,too-many-pu
         self.has_cpp_obj = False
         self.cpp_obj = None
         self.herm_cpp_obj = None
+        self.compiled_cpp_obj = None
 
     def _collect_parameterized_gate(self, gate: ParameterGate):
         """Collect parameterized gate information."""
@@ -877,6 +879,25 @@ class Circuit(list):  # pylint: disable=too-many-instance-attributes,too-many-pu
             return self.cpp_obj
         raise ValueError("Circuit does not generate cpp obj yet.")
 
+    def get_compiled_cpp_obj(self, hermitian=False):
+        """
+        Get compiled cpp obj of circuit.
+
+        The compiled object is passed to simulators without converting every gate again, and is rebuilt after
+        the circuit is modified.
+
+        Args:
+            hermitian (bool): Whether to get cpp object of this circuit in hermitian version. Default: ``False``.
+        """
+        cpp_obj = self.get_cpp_obj()
+        compiled = getattr(self, 'compiled_cpp_obj', None)
+        if compiled is None or compiled[0] is not cpp_obj:
+            compiled = (cpp_obj, mb.gate.CompiledCircuit(cpp_obj), mb.gate.CompiledCircuit(self.herm_cpp_obj))
+            self.compiled_cpp_obj = compiled
+        if hermitian:
+            return compiled[2]
+        return compiled[1]
+
     def h(self, obj_qubits, ctrl_qubits=None):
         """
         Add a hadamard gate.
@@ -36,6 +36,7 @@ from .basicgate import (
     ZZ,
     BarrierGate,
     CNOTGate,
+    DoubleExcitation,
     FSim,
     GlobalPhase,
     H,
@@ -45,6 +46,7 @@ from .basicgate import (
     ISWAPGate,
     PhaseShift,
     Power,
+    RotPauliString,
     Rxx,
     Rxy,
     Rxz,
@@ -53,6 +55,7 @@ from .basicgate import (
     Rzz,
     S,
     SGate,
+    SingleExcitation,
     SWAPGate,
     T,
     TGate,
@@ -110,6 +113,9 @@ __all__ = [
     "Rxy",
     "Rxz",
     "Ryz",
+    "RotPauliString",
+    "SingleExcitation",
+    "DoubleExcitation",
     "Power",
     "I",
     "X",
@@ -1357,6 +1357,120 @@ class Ryz(RotSelfHermMat):
         return mb.gate.RyzGate(self.coeff, self.obj_qubits, self.ctrl_qubits)
 
 
+class RotPauliString(RotSelfHermMat):
+    r"""
+    Rotation gate of an arbitrary pauli string.
+
+    .. math::
+
+        RPS(\theta) = \exp{-i\frac{\theta}{2} P},\quad P = \sigma_{n-1}\otimes\cdots\otimes\sigma_0
+
+    where the i-th pauli operator of the string acts on the i-th object qubit. The simulator applies it in a single
+    sweep over the quantum state, whatever the length of the string, instead of decomposing it into a ladder of CNOT
+    gates. Rxy, Rxz and Ryz are the special cases 'XY', 'XZ' and 'YZ'.
+
+    Args:
+        pauli_string (str): the pauli string, made of 'X', 'Y' and 'Z'.
+        pr (Union[int, float, str, dict, ParameterResolver]): the parameters of
+            parameterized gate, see above for detail explanation.
+
+    Examples:
+        >>> from mindquantum.core.gates import RotPauliString
+        >>> RotPauliString('XYZ', 'a').on([0, 1, 2])
+        RPS(XYZ, a|0 1 2)
+    """
+
+    def __init__(self, pauli_string: str, pr):
+        """Initialize a RotPauliString object."""
+        _check_input_type('pauli_string', str, pauli_string)
+        pauli_string = pauli_string.upper()
+        if not pauli_string or set(pauli_string) - set('XYZ'):
+            raise ValueError(f"pauli_string should be a non empty string of X, Y and Z, but get '{pauli_string}'.")
+        # The core matrix has 4^n elements, it is only built when the matrix is asked for.
+        super().__init__(
+            pr=ParameterResolver(pr),
+            name='RPS',
+            n_qubits=len(pauli_string),
+            core=None,
+        )
+        self.pauli_string = pauli_string
+
+    def __type_specific_str__(self):
+        """Return a string representation of the object."""
+        return f'{self.pauli_string}, {super().__type_specific_str__()}'
+
+    def __eq__(self, other):
+        """Equality comparison operator."""
+        return super().__eq__(other) and self.pauli_string == other.pauli_string
+
+    def __merge__(self, other: BasicGate) -> Tuple[bool, List[BasicGate], "GlobalPhase"]:
+        """Merge with other gate."""
+        if isinstance(other, self.__class__) and self.pauli_string != other.pauli_string:
+            return (False, [self, other], None)
+        return super().__merge__(other)
+
+    def __decompose__(self):
+        """Gate decomposition method."""
+        from ..circuit import Circuit  # pylint: disable=cyclic-import
+
+        ctrls = [*self.ctrl_qubits]
+        basis = Circuit()
+        for pauli, qubit in zip(self.pauli_string, self.obj_qubits):
+            if pauli == 'X':
+                basis += H.on(qubit, ctrls)
+            elif pauli == 'Y':
+                basis += RX(np.pi / 2).on(qubit, ctrls)
+        ladder = Circuit()
+        for low, high in zip(self.obj_qubits[:-1], self.obj_qubits[1:]):
+            ladder += X.on(high, [low, *ctrls])
+        out = Circuit()
+        out += basis
+        out += ladder
+        out += RZ(self.coeff).on(self.obj_qubits[-1], ctrls)
+        out += ladder[::-1]
+        for pauli, qubit in zip(self.pauli_string, self.obj_qubits):
+            if pauli == 'X':
+                out += H.on(qubit, ctrls)
+            elif pauli == 'Y':
+                out += RX(7 * np.pi / 2).on(qubit, ctrls)
+        return [out]
+
+    def matrix(self, pr=None, frac=0.5):
+        """
+        Get the matrix of this parameterized gate.
+
+        Args:
+            pr (Union[ParameterResolver, dict]): The parameter value for parameterized gate. Default: None.
+            frac (numbers.Number): The multiple of the coefficient. Default: 0.5.
+
+        Returns:
+            numpy.ndarray, the matrix of this gate.
+        """
+        if self.core is None:
+            self.core = PauliStringGate([{'X': X, 'Y': Y, 'Z': Z}[i] for i in self.pauli_string])
+        return super().matrix(pr, frac)
+
+    def diff_matrix(self, pr=None, about_what=None, frac=0.5):
+        """
+        Differential form of this parameterized gate.
+
+        Args:
+            pr (Union[ParameterResolver, dict]): The parameter value for parameterized gate. Default: None.
+            about_what (str): calculate the gradient w.r.t which parameter. Default: None.
+            frac (numbers.Number): The multiple of the coefficient. Default: 0.5.
+
+        Returns:
+            numpy.ndarray, the differential form matrix.
+        """
+        if self.core is None:
+            self.core = PauliStringGate([{'X': X, 'Y': Y, 'Z': Z}[i] for i in self.pauli_string])
+        return super().diff_matrix(pr, about_what, frac)
+
+    def get_cpp_obj(self):
+        """Construct cpp obj."""
+        return mb.gate.RotPauliStringGate(self.pauli_string, self.coeff, self.obj_qubits, self.ctrl_qubits)
+
+
 class BarrierGate(FunctionalGate):
     """
     Barrier gate will separate two gate in two different layer.
@@ -1545,6 +1659,164 @@ class PhaseShift(ParameterOppsGate):
         return mb.gate.PSGate(self.coeff, self.obj_qubits, self.ctrl_qubits)
 
 
+class FermionExcitation(ParameterOppsGate):
+    r"""
+    Base class of fermionic excitation gates :math:`\exp{\theta(T - T^\dagger)}` on Jordan-Wigner encoded modes.
+
+    The first half of the object qubits are created and the second half annihilated by :math:`T`. The gate rotates each
+    pair of basis states connected by :math:`T` in a single sweep, the Jordan-Wigner sign coming from the parity of the
+    occupied modes between the object qubits.
+
+    Args:
+        pr (Union[int, float, str, dict, ParameterResolver]): the parameters of
+            parameterized gate, see above for detail explanation.
+        name (str): the name of this gate.
+        n_qubits (int): the number of modes this gate acts on.
+    """
+
+    def __init__(self, pr, name, n_qubits):
+        """Initialize a FermionExcitation object."""
+        super().__init__(
+            pr=ParameterResolver(pr),
+            name=name,
+            n_qubits=n_qubits,
+        )
+
+    def _generator(self):
+        """
+        Matrix of T - T^dagger on the object qubits, bit j of the index being obj_qubits[j].
+
+        The sign only counts the object qubits, it is the full Jordan-Wigner sign when no other mode lies between them.
+        """
+        n_modes = self.n_qubits
+        order = self.obj_qubits if self.obj_qubits else list(range(n_modes))
+        gen = np.zeros((1 << n_modes, 1 << n_modes))
+        for i in range(1 << n_modes):
+            out, sign = i, 1
+            for j in reversed(range(n_modes)):
+                if ((out >> j) & 1) == (j < n_modes // 2):
+                    break
+                below = sum((out >> k) & 1 for k in range(n_modes) if order[k] < order[j])
+                sign *= (-1) ** below
+                out ^= 1 << j
+            else:
+                gen[out, i] = sign
+        return gen - gen.T
+
+    def _value(self, pr):
+        """Get the value of the parameter."""
+        if self.coeff.is_const():
+            return self.coeff.const
+        new_pr = self.coeff.combination(pr)
+        if not new_pr.is_const():
+            raise ValueError("The parameter is not set completed.")
+        return new_pr.const
+
+    # pylint: disable=arguments-differ
+    def matrix(self, pr=None):
+        """
+        Get the matrix of this parameterized gate.
+
+        Args:
+            pr (Union[ParameterResolver, dict]): The parameter value for parameterized gate. Default: ``None``.
+
+        Returns:
+            numpy.ndarray, the matrix of this gate.
+        """
+        val = self._value(pr)
+        gen = self._generator()
+        # G^3 = -G, so exp(val G) = I + sin(val) G + (1 - cos(val)) G^2.
+        return np.identity(len(gen)) + np.sin(val) * gen + (1 - np.cos(val)) * gen @ gen
+
+    def diff_matrix(self, pr=None, about_what=None):
+        """
+        Differential form of this parameterized gate.
+
+        Args:
+            pr (Union[ParameterResolver, dict]): The parameter value for parameterized gate. Default: ``None``.
+            about_what (str): calculate the gradient w.r.t which parameter.
+
+        Returns:
+            numpy.ndarray, the differential form matrix.
+        """
+        gen = self._generator()
+        if self.coeff.is_const():
+            return np.zeros_like(gen)
+        val = self._value(pr)
+        if about_what is None:
+            if len(self.coeff) != 1:
+                raise ValueError("Should specific which parameter are going to do derivation.")
+            for i in self.coeff:
+                about_what = i
+        return (np.cos(val) * gen + np.sin(val) * gen @ gen) * self.coeff[about_what]
+
+
+class SingleExcitation(FermionExcitation):
+    r"""
+    Fermionic single excitation gate.
+
+    .. math::
+
+        {\rm SE}(\theta) = \exp{\theta(a_p^\dagger a_q - a_q^\dagger a_p)}
+
+    with the Jordan-Wigner encoded modes :math:`p` and :math:`q` given as object qubits ``[p, q]``. It rotates
+    :math:`|1_q\rangle` into :math:`|1_p\rangle` with one sweep over the quantum state, instead of the two Pauli
+    exponentials of its Jordan-Wigner form.
+    The ``mqmatrix`` simulator does not support this gate.
+
+    Args:
+        pr (Union[int, float, str, dict, ParameterResolver]): the parameters of
+            parameterized gate, see above for detail explanation.
+
+    Examples:
+        >>> import numpy as np
+        >>> from mindquantum.core.gates import SingleExcitation, X
+        >>> from mindquantum.core.circuit import Circuit
+        >>> circ = Circuit([X.on(0), SingleExcitation(np.pi / 2).on([2, 0])])
+        >>> np.round(circ.get_qs(), 3)
+        array([0.+0.j, 0.+0.j, 0.+0.j, 0.+0.j, 1.+0.j, 0.+0.j, 0.+0.j, 0.+0.j])
+    """
+
+    def __init__(self, pr):
+        """Initialize a SingleExcitation object."""
+        super().__init__(pr, name='SE', n_qubits=2)
+
+    def get_cpp_obj(self):
+        """Construct cpp obj."""
+        return mb.gate.SingleExcitationGate(self.coeff, self.obj_qubits, self.ctrl_qubits)
+
+
+class DoubleExcitation(FermionExcitation):
+    r"""
+    Fermionic double excitation gate.
+
+    .. math::
+
+        {\rm DE}(\theta) = \exp{\theta(a_p^\dagger a_q^\dagger a_r a_s - a_s^\dagger a_r^\dagger a_q a_p)}
+
+    with the Jordan-Wigner encoded modes given as object qubits ``[p, q, r, s]``. It replaces the eight Pauli
+    exponentials of its Jordan-Wigner form by one sweep over the quantum state, as used by UCCSD ansatz.
+    The ``mqmatrix`` simulator does not support this gate.
+
+    Args:
+        pr (Union[int, float, str, dict, ParameterResolver]): the parameters of
+            parameterized gate, see above for detail explanation.
+
+    Examples:
+        >>> from mindquantum.core.gates import DoubleExcitation
+        >>> DoubleExcitation('t').on([3, 2, 1, 0])
+        DE(t|3 2 1 0)
+    """
+
+    def __init__(self, pr):
+        """Initialize a DoubleExcitation object."""
+        super().__init__(pr, name='DE', n_qubits=4)
+
+    def get_cpp_obj(self):
+        """Construct cpp obj."""
+        return mb.gate.DoubleExcitationGate(self.coeff, self.obj_qubits, self.ctrl_qubits)
+
+
 class Power(NoneParamNonHermMat):
     r"""
     Power operator on a non parameterized gate.
@@ -643,8 +643,8 @@ class QRamVecOps(nn.Cell):
         enc_data = qs_r.asnumpy() + qs_i.asnumpy() * 1j
         f = self.sim.backend.sim.qram_expectation_with_grad(
             [i.get_cpp_obj() for i in self.hams],
-            self.circ.get_cpp_obj(),
-            self.circ.get_cpp_obj(True),
+            self.circ.get_compiled_cpp_obj(),
+            self.circ.get_compiled_cpp_obj(True),
             enc_data,
             ans_data.asnumpy(),
             self.circ.params_name,
@@ -16,7 +16,14 @@
 
 from .available_simulator import SUPPORTED_SIMULATOR
 from .simulator import Simulator, get_supported_simulator, inner_product
-from .utils import GradOpsWrapper
+from .utils import GradOpsWrapper, SimulatorFuture
 
-__all__ = ['Simulator', 'GradOpsWrapper', 'get_supported_simulator', 'inner_product', 'SUPPORTED_SIMULATOR']
+__all__ = [
+    'Simulator',
+    'GradOpsWrapper',
+    'SimulatorFuture',
+    'get_supported_simulator',
+    'inner_product',
+    'SUPPORTED_SIMULATOR',
+]
 __all__.sort()
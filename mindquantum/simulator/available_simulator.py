@@ -53,6 +53,18 @@ class _AvailableSimulator:
                 complex128: _mq_matrix.double,
             },
         }
+        if hasattr(_mq_vector, 'mixed'):
+            # complex64 storage with double arithmetic, shares the c module of mqvector.
+            self.base_module['mqvector_mixed'] = _mq_vector
+            self.sims['mqvector_mixed'] = {
+                complex64: _mq_vector.mixed,
+            }
+        if hasattr(_mq_vector, 'out_of_core'):
+            # State in a memory mapped file, for states larger than the RAM.
+            self.base_module['mqvector_ooc'] = _mq_vector
+            self.sims['mqvector_ooc'] = {
+                complex128: _mq_vector.out_of_core,
+            }
         if MQVECTOR_GPU_SUPPORTED:
             self.base_module['mqvector_gpu'] = _mq_vector_gpu
             self.sims['mqvector_gpu'] = {
@@ -68,6 +80,20 @@ class _AvailableSimulator:
             return True
         return False
 
+    def unique_modules(self) -> typing.Dict[str, typing.Any]:
+        """Get the c modules of the simulators, a module shared by several simulators is listed once."""
+        out = {}
+        for name, module in self.base_module.items():
+            if all(module is not other for other in out.values()):
+                out[name] = module
+        return out
+
+    def default_dtype(self, sim: str):
+        """Get the default data type of a simulator, complex128 if available."""
+        if sim in self.sims and complex128 not in self.sims[sim]:
+            return next(iter(self.sims[sim]))
+        return complex128
+
     def c_module(self, sim: str, dtype=None):
         """Get available simulator c module."""
         if dtype is None:
@@ -81,7 +107,7 @@ class _AvailableSimulator:
     def py_class(self, sim: str):
         """Get python base class of simulator."""
         if sim in self.sims:
-            if sim in ['mqvector', 'mqvector_gpu', 'mqmatrix']:
+            if sim in ['mqvector', 'mqvector_gpu', 'mqvector_mixed', 'mqvector_ooc', 'mqmatrix']:
                 # pylint: disable=import-outside-toplevel
                 from mindquantum.simulator.mqsim import MQSim
 
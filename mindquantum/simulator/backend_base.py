@@ -101,6 +101,18 @@ class BackendBase:
         """Get quantum state."""
         raise NotImplementedError(f"get_qs not implemented for {self.device_name()}")
 
+    def get_qs_view(self, writable=False) -> np.ndarray:
+        """Get a numpy array that shares memory with the quantum state."""
+        raise NotImplementedError(f"get_qs_view not implemented for {self.device_name()}")
+
+    def save_state(self, filename: str, drop_below: float = 0.0):
+        """Save the quantum state to a checkpoint file."""
+        raise NotImplementedError(f"save_state not implemented for {self.device_name()}")
+
+    def load_state(self, filename: str):
+        """Restore the quantum state from a checkpoint file."""
+        raise NotImplementedError(f"load_state not implemented for {self.device_name()}")
+
     def reset(self):
         """Reset backend to quantum zero state."""
         raise NotImplementedError(f"reset not implemented for {self.device_name()}")
@@ -115,6 +127,20 @@ class BackendBase:
         """Sample a quantum state based on this backend."""
         raise NotImplementedError(f"sampling not implemented for {self.device_name()}")
 
+    def submit_get_expectation(self, hamiltonian, circ_right=None, pr=None):
+        """Get expectation of a hamiltonian in background."""
+        raise NotImplementedError(f"submit_get_expectation not implemented for {self.device_name()}")
+
+    def submit_sampling(
+        self,
+        circuit: Circuit,
+        pr: Union[Dict, ParameterResolver] = None,
+        shots: int = 1,
+        seed: int = None,
+    ):
+        """Sample a quantum state in background."""
+        raise NotImplementedError(f"submit_sampling not implemented for {self.device_name()}")
+
     def set_qs(self, quantum_state: np.ndarray):
         """Set quantum state of this backend."""
         raise NotImplementedError(f"set_qs not implemented for {self.device_name()}")
@@ -0,0 +1,186 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""State vector simulator distributed over several processes."""
+from typing import Dict, Union
+
+import numpy as np
+
+import mindquantum as mq
+from mindquantum import _mq_vector
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import BasicGate, Measure, MeasureResult
+from mindquantum.core.operators import Hamiltonian
+from mindquantum.core.parameterresolver import ParameterResolver
+from mindquantum.utils.type_value_check import (
+    _check_and_generate_pr_type,
+    _check_input_type,
+    _check_int_type,
+    _check_seed,
+    _check_value_should_not_less,
+)
+
+DISTRIBUTED_SUPPORTED = hasattr(_mq_vector, 'distributed')
+
+
+class DistributedSimulator:
+    """
+    Double precision state vector simulator whose state is split over several processes (ranks).
+
+    With :math:`2^g` ranks, the :math:`g` highest qubits select the rank and every rank holds :math:`2^{n-g}`
+    amplitudes. Gates on the other qubits run on every rank without communication. A gate on a high qubit first swaps
+    it with a local qubit, which exchanges half of the local amplitudes with one peer rank; the qubit is chosen so
+    that the following gates need as few exchanges as possible. Every rank runs the same program and all methods must
+    be called by all ranks in the same order.
+
+    Ranks of one machine communicate through POSIX shared memory, pin them to NUMA nodes with the launcher (e.g.
+    ``numactl``) to keep the memory traffic local. When MindQuantum is built with ``ENABLE_MPI``, ranks can also
+    communicate with MPI, see :meth:`with_mpi`.
+
+    Args:
+        n_qubits (int): Number of qubits.
+        rank (int): Rank of this process, from ``0`` to ``size - 1``.
+        size (int): Number of ranks, a power of two.
+        name (str): Name of the shared memory segment, the same on all ranks and unique for each run.
+        seed (int): Random seed of the measurements, the same on all ranks. Default: ``42``.
+
+    Examples:
+        >>> from mindquantum.simulator.distributed import DistributedSimulator
+        >>> from mindquantum.algorithm.library import qft
+        >>> sim = DistributedSimulator(3, 0, 1, 'mq_example')
+        >>> sim.apply_circuit(qft(range(3)))
+        >>> sim.get_qs().round(3)[:2]
+        array([0.354+0.j, 0.354+0.j])
+    """
+
+    def __init__(self, n_qubits: int, rank: int, size: int, name: str, seed: int = 42):
+        """Initialize a distributed simulator over shared memory."""
+        if not DISTRIBUTED_SUPPORTED:
+            raise RuntimeError("Distributed simulator is not available on this platform.")
+        _check_int_type('rank', rank)
+        _check_int_type('size', size)
+        _check_value_should_not_less('size', 1, size)
+        _check_input_type('name', str, name)
+        transport = _mq_vector.distributed.ShmTransport(name, rank, size)
+        self._init(n_qubits, transport, seed)
+
+    @classmethod
+    def with_mpi(cls, n_qubits: int, seed: int = 42) -> "DistributedSimulator":
+        """
+        Create a simulator distributed over the ranks of ``MPI_COMM_WORLD``, MPI should be initialized (e.g. by mpi4py).
+
+        Args:
+            n_qubits (int): Number of qubits.
+            seed (int): Random seed of the measurements, the same on all ranks. Default: ``42``.
+        """
+        if not DISTRIBUTED_SUPPORTED or not hasattr(_mq_vector.distributed, 'MpiTransport'):
+            raise RuntimeError("MindQuantum is not built with MPI support.")
+        sim = cls.__new__(cls)
+        sim._init(n_qubits, _mq_vector.distributed.MpiTransport(), seed)  # pylint: disable=protected-access
+        return sim
+
+    def _init(self, n_qubits, transport, seed):
+        """Create the c++ simulator."""
+        _check_int_type('n_qubits', n_qubits)
+        _check_seed(seed)
+        self.n_qubits = n_qubits
+        self.seed = seed
+        self.transport = transport
+        self.sim = _mq_vector.distributed.mqvector_dist(n_qubits, transport, seed)
+
+    @property
+    def rank(self) -> int:
+        """Get the rank of this process."""
+        return self.sim.rank()
+
+    @property
+    def size(self) -> int:
+        """Get the number of ranks."""
+        return self.sim.size()
+
+    def reset(self):
+        """Reset to the zero state."""
+        self.sim.reset()
+
+    def apply_gate(self, gate: BasicGate, pr: Union[Dict, ParameterResolver] = None):
+        """
+        Apply a gate or a measurement.
+
+        Args:
+            gate (BasicGate): The gate, noise channels are not supported.
+            pr (Union[Dict, ParameterResolver]): Parameters of a parameterized gate. Default: ``None``.
+
+        Returns:
+            int, the result of a measurement, ``None`` for other gates.
+        """
+        _check_input_type('gate', BasicGate, gate)
+        if gate.parameterized:
+            if pr is None:
+                raise ValueError("apply a parameterized gate needs a parameter_resolver")
+            pr = _check_and_generate_pr_type(pr, gate.coeff.params_name)
+        else:
+            pr = ParameterResolver()
+        res = self.sim.apply_gate(gate.get_cpp_obj(), pr.get_cpp_obj())
+        return res if isinstance(gate, Measure) else None
+
+    def apply_circuit(self, circuit: Circuit, pr: Union[Dict, ParameterResolver] = None):
+        """
+        Apply a circuit.
+
+        Args:
+            circuit (Circuit): The circuit, noise channels are not supported.
+            pr (Union[Dict, ParameterResolver]): Parameters of a parameterized circuit. Default: ``None``.
+
+        Returns:
+            MeasureResult, the measurement results if the circuit has measurements, else ``None``.
+        """
+        _check_input_type('circuit', Circuit, circuit)
+        if self.n_qubits < circuit.n_qubits:
+            raise ValueError(f"Circuit has {circuit.n_qubits} qubits, which is more than simulator qubits.")
+        if circuit.params_name:
+            if pr is None:
+                raise ValueError("Applying a parameterized circuit needs a parameter_resolver.")
+            pr = _check_and_generate_pr_type(pr, circuit.params_name)
+        else:
+            pr = ParameterResolver()
+        res = self.sim.apply_circuit(circuit.get_cpp_obj(), pr)
+        if res:
+            out = MeasureResult()
+            out.add_measure(circuit.all_measures.keys())
+            out.collect_data([[res[i] for i in out.keys_map]])
+            return out
+        return None
+
+    def get_local_qs(self) -> np.ndarray:
+        """Get the amplitudes held by this rank, starting at index ``rank * 2**(n_qubits - log2(size))``."""
+        return np.array(self.sim.get_local_qs())
+
+    def get_qs(self) -> np.ndarray:
+        """Gather the full quantum state on every rank."""
+        return np.array(self.sim.get_qs())
+
+    def get_expectation(self, hamiltonian: Hamiltonian) -> complex:
+        """
+        Get the expectation of a hamiltonian.
+
+        Args:
+            hamiltonian (Hamiltonian): A complex128 hamiltonian, not in sparse mode.
+
+        Returns:
+            complex, the expectation, the same on all ranks.
+        """
+        _check_input_type('hamiltonian', Hamiltonian, hamiltonian)
+        if hamiltonian.dtype != mq.complex128:
+            raise TypeError(f"hamiltonian should be complex128, but get {hamiltonian.dtype}.")
+        return self.sim.get_expectation(hamiltonian.get_cpp_obj())
@@ -0,0 +1,180 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Expectation under one parameter updates, for coordinate wise optimizers."""
+from typing import Dict, List, Tuple, Union
+
+import numpy as np
+
+import mindquantum as mq
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.operators import Hamiltonian
+from mindquantum.core.parameterresolver import ParameterResolver
+from mindquantum.simulator.available_simulator import SUPPORTED_SIMULATOR
+from mindquantum.simulator.simulator import Simulator
+from mindquantum.utils.type_value_check import (
+    _check_and_generate_pr_type,
+    _check_input_type,
+    _check_int_type,
+    _check_value_should_not_less,
+)
+
+
+class IncrementalExpectation:
+    r"""
+    Expectation of a hamiltonian while one parameter changes at a time, as in Rotosolve.
+
+    The state before the first gate depending on a parameter is cached, so a new value of this parameter only
+    simulates the gates from there to the end of the circuit. The cached state is advanced gate by gate and is kept as
+    long as the updated parameters act after it, so a sweep over the parameters in circuit order simulates every
+    prefix gate once.
+
+    When a parameter :math:`x` enters a single gate :math:`\exp(-i(ax+b)P/2)` with :math:`P^2=I` (an uncontrolled
+    rotation or Pauli string rotation) or a phase shift, the expectation is
+    :math:`A\cos(\omega x-B)+C` with :math:`\omega=|a|`. The coefficients are reconstructed from the current
+    expectation and two evaluations, which gives the exact minimum along :math:`x`.
+
+    Args:
+        simulator (Simulator): A ``mqvector`` or ``mqvector_gpu`` simulator, its current state is the initial state.
+        hamiltonian (Hamiltonian): The hamiltonian, with the same precision as the simulator.
+        circuit (Circuit): The circuit, without measurements and noise channels.
+        pr (Union[Dict, ParameterResolver]): Initial value of all parameters of the circuit.
+
+    Examples:
+        >>> from mindquantum.core.circuit import Circuit
+        >>> from mindquantum.core.gates import RX, RY, X
+        >>> from mindquantum.core.operators import Hamiltonian, QubitOperator
+        >>> from mindquantum.simulator import Simulator
+        >>> from mindquantum.simulator.incremental import IncrementalExpectation
+        >>> circ = Circuit([RX('a').on(0), RY('b').on(1), X.on(1, 0), RY('c').on(0)])
+        >>> ham = Hamiltonian(QubitOperator('Z0 Z1') + QubitOperator('X0', 0.5))
+        >>> inc = IncrementalExpectation(Simulator('mqvector', 2), ham, circ, {'a': 0.1, 'b': 0.2, 'c': 0.3})
+        >>> round(inc.sweep(3), 6)
+        -1.118034
+    """
+
+    def __init__(
+        self,
+        simulator: Simulator,
+        hamiltonian: Hamiltonian,
+        circuit: Circuit,
+        pr: Union[Dict, ParameterResolver],
+    ):
+        """Initialize an incremental expectation."""
+        _check_input_type('simulator', Simulator, simulator)
+        _check_input_type('hamiltonian', Hamiltonian, hamiltonian)
+        _check_input_type('circuit', Circuit, circuit)
+        if simulator.backend.name not in ['mqvector', 'mqvector_gpu']:
+            raise ValueError(f"IncrementalExpectation requires a mqvector simulator, but get {simulator.backend.name}.")
+        if not mq.is_same_precision(simulator.dtype, hamiltonian.dtype):
+            raise TypeError(
+                f"Data type of simulator is {simulator.dtype}, but hamiltonian is {hamiltonian.dtype}, "
+                "they should have the same precision."
+            )
+        if circuit.has_measure_gate or circuit.is_noise_circuit:
+            raise ValueError("IncrementalExpectation does not support measurements and noise channels.")
+        if simulator.n_qubits < circuit.n_qubits:
+            raise ValueError(f"Circuit has {circuit.n_qubits} qubits, which is more than simulator qubits.")
+        pr = _check_and_generate_pr_type(pr, circuit.params_name)
+        c_module = SUPPORTED_SIMULATOR.c_module(simulator.backend.name, simulator.dtype)
+        self.sim = c_module.mqincremental(simulator.backend.sim, hamiltonian.get_cpp_obj(), circuit.get_cpp_obj(), pr)
+
+    @property
+    def applied_gates(self) -> int:
+        """Get the number of gates simulated so far, cached prefix and evaluated segments included."""
+        return self.sim.get_applied_gates()
+
+    @property
+    def parameter_order(self) -> List[str]:
+        """Get the parameters sorted by their first gate, the cheapest order of a sweep."""
+        return self.sim.parameter_order()
+
+    def get_expectation(self) -> float:
+        """Get the expectation at the current parameters."""
+        return self.sim.get_expectation()
+
+    def get_parameter(self, name: str) -> float:
+        """Get the current value of a parameter."""
+        return self.sim.get_parameter(name)
+
+    def set_parameter(self, name: str, value: float):
+        """
+        Set the current value of a parameter.
+
+        Args:
+            name (str): The parameter name.
+            value (float): The new value.
+        """
+        self.sim.set_parameter(name, float(value))
+
+    def evaluate(self, name: str, values: Union[float, List[float], np.ndarray]) -> np.ndarray:
+        """
+        Get the expectations with a parameter set to each of the given values, the other parameters unchanged.
+
+        Args:
+            name (str): The parameter name.
+            values (Union[float, List[float], numpy.ndarray]): Values of the parameter.
+
+        Returns:
+            numpy.ndarray, the expectation for each value.
+        """
+        values = np.atleast_1d(np.asarray(values, dtype=float))
+        return np.array(self.sim.evaluate(name, values.tolist()))
+
+    def reconstruct(self, name: str) -> Tuple[float, float, float, float]:
+        r"""
+        Reconstruct the expectation along a parameter as :math:`A\cos(\omega x-B)+C`.
+
+        Args:
+            name (str): The parameter name, which should enter a single rotation or phase shift gate.
+
+        Returns:
+            Tuple[float, float, float, float], the coefficients :math:`A\ge0`, :math:`B`, :math:`C` and
+            :math:`\omega`.
+        """
+        return tuple(self.sim.reconstruct(name))
+
+    def minimize(self, name: str) -> float:
+        """
+        Set a parameter to the minimum of its reconstruction.
+
+        Args:
+            name (str): The parameter name, which should enter a single rotation or phase shift gate.
+
+        Returns:
+            float, the new expectation.
+        """
+        return self.sim.minimize(name)
+
+    def sweep(self, n_sweeps: int = 1) -> float:
+        """
+        Minimize every parameter in turn in circuit order, the Rotosolve algorithm.
+
+        Args:
+            n_sweeps (int): Number of sweeps over all parameters. Default: ``1``.
+
+        Returns:
+            float, the expectation after the last sweep.
+        """
+        _check_int_type('n_sweeps', n_sweeps)
+        _check_value_should_not_less('n_sweeps', 1, n_sweeps)
+        order = self.parameter_order
+        for _ in range(n_sweeps):
+            for name in order:
+                self.minimize(name)
+        return self.get_expectation()
+
+    def get_pr(self) -> ParameterResolver:
+        """Get the current value of all parameters."""
+        return ParameterResolver({name: self.get_parameter(name) for name in self.parameter_order})
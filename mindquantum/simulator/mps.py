@@ -0,0 +1,132 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Matrix product state simulator for circuits with bounded entanglement."""
+from typing import List
+
+import numpy as np
+
+from mindquantum import _mq_vector
+from mindquantum.simulator.native_base import SamplingSimulatorBase
+from mindquantum.utils.type_value_check import (
+    _check_input_type,
+    _check_int_type,
+    _check_seed,
+    _check_value_should_not_less,
+)
+
+MPS_SUPPORTED = hasattr(_mq_vector, 'mps')
+
+
+class MPSSimulator(SamplingSimulatorBase):
+    """
+    Matrix product state (MPS) simulator, whose cost grows with the entanglement of the state instead of :math:`2^n`.
+
+    Qubit :math:`i` is site :math:`i` of a chain. Single qubit gates act on one site. A gate on several qubits
+    (controls included) brings its qubits next to each other with SWAP gates, contracts their sites, applies the gate
+    and splits the block back with singular value decompositions. At each split at most ``max_bond`` singular values
+    are kept, and the smallest ones are dropped while their squared sum stays within ``truncation_threshold`` of the
+    block norm. Circuits whose gates act on neighbouring qubits of a 1D layout, like hardware efficient or
+    UCC ansatz on a chain, run in time linear in the number of qubits.
+
+    Args:
+        n_qubits (int): Number of qubits.
+        seed (int): Random seed of the measurements. Default: ``42``.
+        max_bond (int): Maximum bond dimension. Default: ``256``.
+        truncation_threshold (float): Relative squared weight of the singular values that may be dropped at each
+            split. Default: ``1e-14``.
+
+    Examples:
+        >>> from mindquantum.core.circuit import Circuit
+        >>> from mindquantum.core.operators import Hamiltonian, QubitOperator
+        >>> from mindquantum.simulator.mps import MPSSimulator
+        >>> sim = MPSSimulator(100)
+        >>> sim.apply_circuit(Circuit().h(0).x(99, 0))
+        >>> sim.bond_dims[:3]
+        [2, 2, 2]
+        >>> round(sim.get_expectation(Hamiltonian(QubitOperator('Z0 Z99'))).real, 6)
+        1.0
+    """
+
+    def __init__(self, n_qubits: int, seed: int = 42, max_bond: int = 256, truncation_threshold: float = 1e-14):
+        """Initialize a matrix product state simulator."""
+        if not MPS_SUPPORTED:
+            raise RuntimeError("MPS simulator is not available on this platform.")
+        _check_int_type('n_qubits', n_qubits)
+        _check_value_should_not_less('n_qubits', 1, n_qubits)
+        _check_seed(seed)
+        self.n_qubits = n_qubits
+        self.seed = seed
+        self.sim = _mq_vector.mps.mqmps(n_qubits, seed)
+        self.set_max_bond(max_bond)
+        self.set_truncation_threshold(truncation_threshold)
+
+    def copy(self) -> "MPSSimulator":
+        """Copy this simulator."""
+        sim = MPSSimulator.__new__(MPSSimulator)
+        sim.n_qubits = self.n_qubits
+        sim.seed = self.seed
+        sim.sim = _mq_vector.mps.mqmps(self.sim)
+        return sim
+
+    def set_max_bond(self, max_bond: int):
+        """
+        Set the maximum bond dimension.
+
+        Args:
+            max_bond (int): Maximum number of singular values kept at each split.
+        """
+        _check_int_type('max_bond', max_bond)
+        _check_value_should_not_less('max_bond', 1, max_bond)
+        self.sim.set_max_bond(max_bond)
+
+    def set_truncation_threshold(self, threshold: float):
+        """
+        Set the truncation threshold.
+
+        Args:
+            threshold (float): Relative squared weight of the singular values that may be dropped at each split,
+                in :math:`[0, 1)`.
+        """
+        self.sim.set_truncation_threshold(float(threshold))
+
+    @property
+    def bond_dims(self) -> List[int]:
+        """Get the dimension of the bonds, bond :math:`i` links qubit :math:`i` and :math:`i + 1`."""
+        return self.sim.get_bond_dims()
+
+    @property
+    def truncation_error(self) -> float:
+        """
+        Get the sum of the relative squared weights dropped so far.
+
+        One minus it estimates the fidelity of the state with the untruncated one.
+        """
+        return self.sim.get_truncation_error()
+
+    def amplitude(self, bits: str) -> complex:
+        """
+        Get the amplitude of a basis state.
+
+        Args:
+            bits (str): The basis state as a bit string, the highest qubit first like in ``get_qs``.
+        """
+        _check_input_type('bits', str, bits)
+        if len(bits) != self.n_qubits or set(bits) - {'0', '1'}:
+            raise ValueError(f"bits should be a string of {self.n_qubits} bits, but get {bits}.")
+        return self.sim.get_amplitude([int(b) for b in reversed(bits)])
+
+    def get_qs(self) -> np.ndarray:
+        """Get the full quantum state, for states of at most 30 qubits."""
+        return np.array(self.sim.get_qs())
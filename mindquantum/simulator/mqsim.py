@@ -13,6 +13,8 @@
 # limitations under the License.
 # ============================================================================
 """Mindquantum simulator."""
+import numbers
+import os
 from typing import Dict, List, Union
 
 import numpy as np
@@ -22,7 +24,7 @@ from mindquantum.core.circuit import Circuit
 from mindquantum.core.gates import BarrierGate, BasicGate, Measure, MeasureResult
 from mindquantum.core.operators import Hamiltonian
 from mindquantum.core.parameterresolver import ParameterResolver
-from mindquantum.dtype import complex128, mq_complex_number_type, to_mq_type
+from mindquantum.dtype import complex128, mq_complex_number_type, to_mq_type, to_np_type
 from mindquantum.simulator.available_simulator import SUPPORTED_SIMULATOR
 from mindquantum.utils.type_value_check import (
     _check_and_generate_pr_type,
@@ -37,8 +39,16 @@ from mindquantum.utils.type_value_check import (
 
 # This import is required to register some of the C++ types (e.g. ParameterResolver)
 from ..utils.string_utils import ket_string
+from ..utils.trace import trace_scope
 from .backend_base import BackendBase
-from .utils import GradOpsWrapper, _thread_balance
+from .utils import GradOpsWrapper, SimulatorFuture, _thread_balance
+
+
+# Simulators whose quantum state lives in host memory and can be viewed by numpy.
+_CPU_VECTOR_SIMULATORS = ('mqvector', 'mqvector_mixed', 'mqvector_ooc')
+
+# Simulators that save and restore their quantum state natively.
+_CHECKPOINT_SIMULATORS = _CPU_VECTOR_SIMULATORS + ('mqmatrix',)
 
 
 # pylint: disable=abstract-method,too-many-arguments
@@ -52,7 +62,7 @@ class MQSim(BackendBase):
             self.sim = name
         else:
             if dtype is None:
-                dtype = complex128
+                dtype = SUPPORTED_SIMULATOR.default_dtype(name)
             dtype = to_mq_type(dtype)
             self.sim = getattr(SUPPORTED_SIMULATOR.c_module(name, dtype), name)(n_qubits, seed)
 
@@ -88,7 +98,7 @@ class MQSim(BackendBase):
             pr = _check_and_generate_pr_type(pr, circuit.params_name)
         else:
             pr = ParameterResolver()
-        res = self.sim.apply_circuit(circuit.get_cpp_obj(), pr)
+        res = self.sim.apply_circuit(circuit.get_compiled_cpp_obj(), pr)
         if res:
             out = MeasureResult()
             out.add_measure(circuit.all_measures.keys())
@@ -148,7 +158,7 @@ class MQSim(BackendBase):
 
     def copy(self) -> "BackendBase":
         """Copy a simulator."""
-        sim = MQSim(self.name, self.n_qubits, self.seed)
+        sim = MQSim(self.name, self.n_qubits, self.seed, None)
         sim.sim = self.sim.copy()
         return sim
 
@@ -158,13 +168,10 @@ class MQSim(BackendBase):
 
     def get_circuit_matrix(self, circuit: Circuit, pr: ParameterResolver) -> np.ndarray:
         """Get the matrix of given circuit."""
-        return np.array(self.sim.get_circuit_matrix(circuit.get_cpp_obj(), pr)).T
+        return np.array(self.sim.get_circuit_matrix(circuit.get_compiled_cpp_obj(), pr)).T
 
-    # pylint: disable=too-many-branches
-    def get_expectation(
-        self, hamiltonian: Hamiltonian, circ_right=None, circ_left=None, simulator_left=None, pr=None
-    ) -> np.ndarray:
-        """Get expectation of a hamiltonian."""
+    def _check_hamiltonian(self, hamiltonian: Hamiltonian):
+        """Check hamiltonian matches the qubit number and precision of this simulator."""
         if not isinstance(hamiltonian, Hamiltonian):
             raise TypeError(f"hamiltonian requires a Hamiltonian, but got {type(hamiltonian)}")
         _check_hamiltonian_qubits_number(hamiltonian, self.n_qubits)
@@ -175,6 +182,18 @@ class MQSim(BackendBase):
                 f"Please convert given hamiltonian to {mq.precision_str(self.dtype)} "
                 f"({mq.precision_like(hamiltonian.dtype, self.dtype)})."
             )
+
+    def _check_submit(self, method: str):
+        """Check this simulator supports asynchronous method."""
+        if not hasattr(self.sim, method):
+            raise NotImplementedError(f"{method} not implemented for {self.device_name()}")
+
+    # pylint: disable=too-many-branches
+    def get_expectation(
+        self, hamiltonian: Hamiltonian, circ_right=None, circ_left=None, simulator_left=None, pr=None
+    ) -> np.ndarray:
+        """Get expectation of a hamiltonian."""
+        self._check_hamiltonian(hamiltonian)
         hermitian = True
         if circ_right is None:
             circ_right = Circuit()
@@ -201,15 +220,19 @@ class MQSim(BackendBase):
         else:
             pr = ParameterResolver(pr)
         if hermitian:
-            return self.sim.get_expectation(hamiltonian.get_cpp_obj(), circ_right.get_cpp_obj(), pr)
+            return self.sim.get_expectation(hamiltonian.get_cpp_obj(), circ_right.get_compiled_cpp_obj(), pr)
         if self.name == 'mqmatrix':
             raise NotImplementedError("Non hermitian case for get_expectation not implement for mqmatrix yet.")
         if simulator_left is None:
             return self.sim.get_expectation(
-                hamiltonian.get_cpp_obj(), circ_right.get_cpp_obj(), circ_left.get_cpp_obj(), pr
+                hamiltonian.get_cpp_obj(), circ_right.get_compiled_cpp_obj(), circ_left.get_compiled_cpp_obj(), pr
             )
         return self.sim.get_expectation(
-            hamiltonian.get_cpp_obj(), circ_right.get_cpp_obj(), circ_left.get_cpp_obj(), simulator_left.backend.sim, pr
+            hamiltonian.get_cpp_obj(),
+            circ_right.get_compiled_cpp_obj(),
+            circ_left.get_compiled_cpp_obj(),
+            simulator_left.backend.sim,
+            pr,
         )
 
     def get_expectation_with_grad(  # pylint: disable=R0912,R0913,R0914,R0915
@@ -301,7 +324,12 @@ class MQSim(BackendBase):
         if self.n_qubits < circ_n_qubits:
             raise ValueError(f"Simulator has {self.n_qubits} qubits, but circuit has {circ_n_qubits} qubits.")
 
-        def grad_ops(*inputs_):
+        @trace_scope('grad_ops')
+        def grad_ops(*inputs_, asynchronous=False):
+            prefix = ''
+            if asynchronous:
+                self._check_submit('submit_get_expectation_with_grad_multi_multi')
+                prefix = 'submit_'
             inputs = list(inputs_)
             for i, item in enumerate(inputs):
                 if isinstance(item, list):
@@ -331,13 +359,13 @@ class MQSim(BackendBase):
                 inputs0 = np.array([[]])
                 inputs1 = inputs[0]
             if non_hermitian:
-                f_g1_g2 = self.sim.get_expectation_with_grad_non_hermitian_multi_multi(
+                f_g1_g2 = getattr(self.sim, prefix + 'get_expectation_with_grad_non_hermitian_multi_multi')(
                     [i.get_cpp_obj() for i in hams],
                     [i.get_cpp_obj(hermitian=True) for i in hams],
-                    circ_left.get_cpp_obj(),
-                    circ_left.get_cpp_obj(hermitian=True),
-                    circ_right.get_cpp_obj(),
-                    circ_right.get_cpp_obj(hermitian=True),
+                    circ_left.get_compiled_cpp_obj(),
+                    circ_left.get_compiled_cpp_obj(hermitian=True),
+                    circ_right.get_compiled_cpp_obj(),
+                    circ_right.get_compiled_cpp_obj(hermitian=True),
                     inputs0,
                     inputs1,
                     encoder_params_name,
@@ -347,10 +375,10 @@ class MQSim(BackendBase):
                     mea_threads,
                 )
             elif circ_right.is_noise_circuit and "mqmatrix" in self.name:
-                f_g1_g2 = self.sim.get_expectation_with_noise_grad_multi_multi(
+                f_g1_g2 = getattr(self.sim, prefix + 'get_expectation_with_noise_grad_multi_multi')(
                     [i.get_cpp_obj() for i in hams],
-                    circ_right.get_cpp_obj(),
-                    circ_right.get_cpp_obj(hermitian=True),
+                    circ_right.get_compiled_cpp_obj(),
+                    circ_right.get_compiled_cpp_obj(hermitian=True),
                     inputs0,
                     inputs1,
                     encoder_params_name,
@@ -359,9 +387,9 @@ class MQSim(BackendBase):
                     mea_threads,
                 )
             elif pr_shift:
-                f_g1_g2 = self.sim.get_expectation_with_grad_parameter_shift_multi_multi(
+                f_g1_g2 = getattr(self.sim, prefix + 'get_expectation_with_grad_parameter_shift_multi_multi')(
                     [i.get_cpp_obj() for i in hams],
-                    circ_right.get_cpp_obj(),
+                    circ_right.get_compiled_cpp_obj(),
                     inputs0,
                     inputs1,
                     encoder_params_name,
@@ -370,10 +398,10 @@ class MQSim(BackendBase):
                     mea_threads,
                 )
             else:
-                f_g1_g2 = self.sim.get_expectation_with_grad_multi_multi(
+                f_g1_g2 = getattr(self.sim, prefix + 'get_expectation_with_grad_multi_multi')(
                     [i.get_cpp_obj() for i in hams],
-                    circ_right.get_cpp_obj(),
-                    circ_right.get_cpp_obj(hermitian=True),
+                    circ_right.get_compiled_cpp_obj(),
+                    circ_right.get_compiled_cpp_obj(hermitian=True),
                     inputs0,
                     inputs1,
                     encoder_params_name,
@@ -381,6 +409,11 @@ class MQSim(BackendBase):
                     batch_threads,
                     mea_threads,
                 )
+            if asynchronous:
+                return SimulatorFuture(f_g1_g2, split_result)
+            return split_result(f_g1_g2)
+
+        def split_result(f_g1_g2):
             res = np.array(f_g1_g2)
             if version == 'both':
                 return (
@@ -402,23 +435,80 @@ class MQSim(BackendBase):
         """Get quantum state of mqvector simulator."""
         if not isinstance(ket, bool):
             raise TypeError(f"ket requires a bool, but get {type(ket)}")
-        state = np.array(self.sim.get_qs())
+        if self.name in _CPU_VECTOR_SIMULATORS and self.sim.is_zero_state():
+            # Do not allocate the state buffer of a fresh simulator just to read it.
+            state = np.zeros(1 << self.n_qubits, dtype=to_np_type(self.dtype))
+            state[0] = 1
+        elif self.name in _CPU_VECTOR_SIMULATORS:
+            state = np.array(self.sim.get_qs_view())
+        else:
+            state = np.array(self.sim.get_qs())
         if ket:
             return '\n'.join(ket_string(state))
         return state
 
+    def get_qs_view(self, writable=False) -> np.ndarray:
+        """Get a numpy array that shares memory with the quantum state of mqvector simulator."""
+        if self.name not in _CPU_VECTOR_SIMULATORS:
+            raise NotImplementedError(f"get_qs_view not implemented for {self.device_name()}")
+        return self.sim.get_qs_view(writable)
+
+    def save_state(self, filename: str, drop_below: float = 0.0):
+        """Save the quantum state of mqvector or mqmatrix simulator to a checkpoint file."""
+        if self.name not in _CHECKPOINT_SIMULATORS:
+            raise NotImplementedError(f"save_state not implemented for {self.device_name()}")
+        _check_input_type('drop_below', numbers.Real, drop_below)
+        with trace_scope('save_state'):
+            self.sim.save_state(os.fspath(filename), float(drop_below))
+
+    def load_state(self, filename: str):
+        """Restore the quantum state of mqvector or mqmatrix simulator from a checkpoint file."""
+        if self.name not in _CHECKPOINT_SIMULATORS:
+            raise NotImplementedError(f"load_state not implemented for {self.device_name()}")
+        with trace_scope('load_state'):
+            self.sim.load_state(os.fspath(filename))
+
+    def set_renormalization(self, interval: int):
+        """
+        Restore the norm of the quantum state every `interval` gates, ``0`` to disable.
+
+        The norm is measured, with double precision accumulation, after the first gate that follows a non unitary
+        operation such as a measurement, and is restored every `interval` gates after, so the rounding errors of
+        ``'mqvector_mixed'`` and complex64 states do not accumulate in the norm of deep circuits. Simulators copied
+        from this one, as in the gradient calculation, inherit the interval.
+
+        Args:
+            interval (int): Number of gates between two renormalizations.
+        """
+        if not self.name.startswith('mqvector'):
+            raise NotImplementedError(f"set_renormalization not implemented for {self.device_name()}")
+        _check_int_type('interval', interval)
+        _check_value_should_not_less('interval', 0, interval)
+        self.sim.set_renormalization(interval)
+
+    def set_chunk_qubits(self, chunk_qubits: int):
+        """
+        Set the number of qubits of a chunk of the ``'mqvector_ooc'`` simulator.
+
+        The state of ``'mqvector_ooc'`` lives in a memory mapped file in the directory given by the
+        ``MQ_OUT_OF_CORE_DIR`` environment variable, or the temporary directory, and is processed in chunks of
+        ``2**chunk_qubits`` amplitudes. A chunk should fit comfortably in the RAM, the default is ``24`` (256 MB).
+
+        Args:
+            chunk_qubits (int): Number of qubits of a chunk, at least ``2``.
+        """
+        if self.name != 'mqvector_ooc':
+            raise NotImplementedError(f"set_chunk_qubits not implemented for {self.device_name()}")
+        _check_int_type('chunk_qubits', chunk_qubits)
+        _check_value_should_not_less('chunk_qubits', 2, chunk_qubits)
+        self.sim.set_chunk_qubits(chunk_qubits)
+
     def reset(self):
         """Reset mindquantum simulator to quantum zero state."""
         return self.sim.reset()
 
-    def sampling(
-        self,
-        circuit: Circuit,
-        pr: Union[Dict, ParameterResolver] = None,
-        shots: int = 1,
-        seed: int = None,
-    ):
-        """Sample the quantum state."""
+    def _prepare_sampling(self, circuit: Circuit, pr, shots: int, seed: int):
+        """Check sampling arguments, return parameter resolver, seed and an empty measure result."""
         if not circuit.all_measures.map:
             raise ValueError("circuit must have at least one measurement gate.")
         _check_input_type("circuit", Circuit, circuit)
@@ -440,15 +530,69 @@ class MQSim(BackendBase):
             _check_seed(seed)
         res = MeasureResult()
         res.add_measure(circuit.all_measures.keys())
+        return pr, seed, res
+
+    def sampling(
+        self,
+        circuit: Circuit,
+        pr: Union[Dict, ParameterResolver] = None,
+        shots: int = 1,
+        seed: int = None,
+    ):
+        """Sample the quantum state."""
+        pr, seed, res = self._prepare_sampling(circuit, pr, shots, seed)
         sim = self
         if circuit.is_measure_end and not circuit.is_noise_circuit:
             sim = self.copy()
             sim.apply_circuit(circuit.remove_measure(), pr)
             circuit = Circuit(circuit.all_measures.keys())
-        samples = np.array(sim.sim.sampling(circuit.get_cpp_obj(), pr, shots, res.keys_map, seed)).reshape((shots, -1))
+        with trace_scope('sampling'):
+            samples = np.array(sim.sim.sampling(circuit.get_compiled_cpp_obj(), pr, shots, res.keys_map, seed))
+        samples = samples.reshape((shots, -1))
         res.collect_data(samples)
         return res
 
+    def submit_get_expectation(
+        self, hamiltonian: Hamiltonian, circ_right: Circuit = None, pr=None
+    ) -> SimulatorFuture:
+        """Get expectation of a hamiltonian in background."""
+        self._check_submit('submit_get_expectation')
+        self._check_hamiltonian(hamiltonian)
+        if circ_right is None:
+            circ_right = Circuit()
+        _check_input_type('circ_right', Circuit, circ_right)
+        if pr is None:
+            pr = ParameterResolver()
+        else:
+            pr = ParameterResolver(pr)
+        return SimulatorFuture(
+            self.sim.submit_get_expectation(hamiltonian.get_cpp_obj(), circ_right.get_compiled_cpp_obj(), pr)
+        )
+
+    def submit_sampling(
+        self,
+        circuit: Circuit,
+        pr: Union[Dict, ParameterResolver] = None,
+        shots: int = 1,
+        seed: int = None,
+    ) -> SimulatorFuture:
+        """Sample the quantum state in background."""
+        self._check_submit('submit_sampling')
+        pr, seed, res = self._prepare_sampling(circuit, pr, shots, seed)
+        prefix = Circuit()
+        if circuit.is_measure_end and not circuit.is_noise_circuit:
+            prefix = circuit.remove_measure()
+            circuit = Circuit(circuit.all_measures.keys())
+
+        def collect(samples):
+            res.collect_data(np.array(samples).reshape((shots, -1)))
+            return res
+
+        future = self.sim.submit_sampling(
+            prefix.get_compiled_cpp_obj(), circuit.get_compiled_cpp_obj(), pr, shots, res.keys_map, seed
+        )
+        return SimulatorFuture(future, collect)
+
     def set_qs(self, quantum_state: np.ndarray):
         """Set quantum state of mqvector simulator."""
         if not isinstance(quantum_state, np.ndarray):
@@ -485,4 +629,7 @@ class MQSim(BackendBase):
             norm_factor = np.sqrt(np.sum(np.abs(quantum_state) ** 2))
             if norm_factor == 0.0:
                 raise ValueError("Wrong quantum state.")
-            self.sim.set_qs(quantum_state / norm_factor)
+            if self.name in _CPU_VECTOR_SIMULATORS:
+                self.sim.set_qs_from_array(quantum_state / norm_factor)
+            else:
+                self.sim.set_qs(quantum_state / norm_factor)
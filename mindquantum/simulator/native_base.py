@@ -0,0 +1,153 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Common interface of the standalone simulators wrapping a native state."""
+from typing import Dict, Union
+
+import numpy as np
+
+import mindquantum as mq
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import BasicGate, Measure, MeasureResult
+from mindquantum.core.operators import Hamiltonian
+from mindquantum.core.parameterresolver import ParameterResolver
+from mindquantum.utils.type_value_check import (
+    _check_and_generate_pr_type,
+    _check_input_type,
+    _check_int_type,
+    _check_seed,
+    _check_value_should_not_less,
+)
+
+
+def _check_native_circuit(circuit: Circuit, n_qubits: int, pr) -> ParameterResolver:
+    """Check a circuit run by a native simulator of `n_qubits` qubits and get its parameter resolver."""
+    _check_input_type('circuit', Circuit, circuit)
+    if n_qubits < circuit.n_qubits:
+        raise ValueError(f"Circuit has {circuit.n_qubits} qubits, which is more than simulator qubits.")
+    if circuit.params_name:
+        if pr is None:
+            raise ValueError("Applying a parameterized circuit needs a parameter_resolver.")
+        return _check_and_generate_pr_type(pr, circuit.params_name)
+    return ParameterResolver()
+
+
+def _check_native_hamiltonian(hamiltonian: Hamiltonian) -> Hamiltonian:
+    """Check a hamiltonian taken by a native simulator."""
+    _check_input_type('hamiltonian', Hamiltonian, hamiltonian)
+    if hamiltonian.dtype != mq.complex128:
+        raise TypeError(f"hamiltonian should be complex128, but get {hamiltonian.dtype}.")
+    return hamiltonian
+
+
+class NativeSimulatorBase:
+    """
+    Gate, circuit and expectation methods shared by the simulators whose state is a native object ``self.sim``.
+
+    Subclasses set ``n_qubits`` and ``sim``, the native state taking the C++ gates, circuits and hamiltonians.
+    """
+
+    n_qubits: int
+
+    def reset(self):
+        """Reset to the initial state."""
+        self.sim.reset()
+
+    def apply_gate(self, gate: BasicGate, pr: Union[Dict, ParameterResolver] = None):
+        """
+        Apply a gate or a measurement.
+
+        Args:
+            gate (BasicGate): The gate, noise channels are not supported.
+            pr (Union[Dict, ParameterResolver]): Parameters of a parameterized gate. Default: ``None``.
+
+        Returns:
+            int, the result of a measurement, ``None`` for other gates.
+        """
+        _check_input_type('gate', BasicGate, gate)
+        if gate.parameterized:
+            if pr is None:
+                raise ValueError("apply a parameterized gate needs a parameter_resolver")
+            pr = _check_and_generate_pr_type(pr, gate.coeff.params_name)
+        else:
+            pr = ParameterResolver()
+        res = self.sim.apply_gate(gate.get_cpp_obj(), pr.get_cpp_obj())
+        return res if isinstance(gate, Measure) else None
+
+    def _check_circuit(self, circuit: Circuit, pr):
+        """Check a circuit and get its parameter resolver."""
+        return _check_native_circuit(circuit, self.n_qubits, pr)
+
+    def apply_circuit(self, circuit: Circuit, pr: Union[Dict, ParameterResolver] = None):
+        """
+        Apply a circuit.
+
+        Args:
+            circuit (Circuit): The circuit, noise channels are not supported.
+            pr (Union[Dict, ParameterResolver]): Parameters of a parameterized circuit. Default: ``None``.
+
+        Returns:
+            MeasureResult, the measurement results if the circuit has measurements, else ``None``.
+        """
+        pr = self._check_circuit(circuit, pr)
+        res = self.sim.apply_circuit(circuit.get_cpp_obj(), pr)
+        if res:
+            out = MeasureResult()
+            out.add_measure(circuit.all_measures.keys())
+            out.collect_data([[res[i] for i in out.keys_map]])
+            return out
+        return None
+
+    def get_expectation(self, hamiltonian: Hamiltonian) -> complex:
+        """
+        Get the expectation of a hamiltonian.
+
+        Args:
+            hamiltonian (Hamiltonian): A complex128 hamiltonian, not in sparse mode.
+
+        Returns:
+            complex, the expectation.
+        """
+        return self.sim.get_expectation(_check_native_hamiltonian(hamiltonian).get_cpp_obj())
+
+
+class SamplingSimulatorBase(NativeSimulatorBase):
+    """Native simulator whose state also samples the measurements of a circuit."""
+
+    def sampling(
+        self, circuit: Circuit, pr: Union[Dict, ParameterResolver] = None, shots: int = 1, seed: int = None
+    ) -> MeasureResult:
+        """
+        Sample the measurements of a circuit applied on the current state, which is left unchanged.
+
+        Args:
+            circuit (Circuit): The circuit with measurements.
+            pr (Union[Dict, ParameterResolver]): Parameters of a parameterized circuit. Default: ``None``.
+            shots (int): Number of samples. Default: ``1``.
+            seed (int): Random seed of the sampling. Default: ``None``.
+        """
+        if not circuit.all_measures.map:
+            raise ValueError("circuit must have at least one measurement gate.")
+        pr = self._check_circuit(circuit, pr)
+        _check_int_type("sampling shots", shots)
+        _check_value_should_not_less("sampling shots", 1, shots)
+        if seed is None:
+            seed = int(np.random.randint(1, 2 << 20))
+        else:
+            _check_seed(seed)
+        res = MeasureResult()
+        res.add_measure(circuit.all_measures.keys())
+        samples = np.array(self.sim.sampling(circuit.get_cpp_obj(), pr, shots, res.keys_map, seed))
+        res.collect_data(samples.reshape((shots, -1)))
+        return res
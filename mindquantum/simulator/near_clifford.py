@@ -0,0 +1,98 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Near Clifford simulator for Clifford circuits with a few non-Clifford rotations."""
+from mindquantum import _mq_vector
+from mindquantum.simulator.native_base import SamplingSimulatorBase
+from mindquantum.utils.type_value_check import (
+    _check_int_type,
+    _check_seed,
+    _check_value_should_not_less,
+)
+
+NEAR_CLIFFORD_SUPPORTED = hasattr(_mq_vector, 'stabilizer') and hasattr(_mq_vector.stabilizer, 'mqnearclifford')
+
+
+class NearCliffordSimulator(SamplingSimulatorBase):
+    r"""
+    Simulator of Clifford circuits with a modest number of non-Clifford Pauli rotations.
+
+    The state is a weighted sum of stabilizer states :math:`\sum_b a_b D_b\left|\phi\right>` sharing one stabilizer
+    tableau :math:`\left|\phi\right>`, with :math:`D_b` products of its destabilizers. Clifford gates (see
+    :class:`~.simulator.stabilizer.StabilizerSimulator`) only update the tableau. T, T dagger, PS, RX, RY, RZ, Rxx,
+    Ryy, Rzz, Rxy, Rxz and Ryz gates, which are rotations :math:`\exp(-i\theta P/2)` of a Pauli string :math:`P`
+    up to a global phase, split every term in at most two, and terms that land on the same :math:`b` merge. The
+    number of terms is at most :math:`2^t` after :math:`t` rotations, whatever the number of qubits. Terms whose
+    weight falls below ``truncation_threshold`` are dropped, and the dropped weight estimates the infidelity.
+
+    Args:
+        n_qubits (int): Number of qubits.
+        seed (int): Random seed of the measurements. Default: ``42``.
+        truncation_threshold (float): Weight below which a term is dropped. Default: ``1e-14``.
+
+    Examples:
+        >>> from mindquantum.core.circuit import Circuit
+        >>> from mindquantum.core.gates import H, T, X
+        >>> from mindquantum.core.operators import Hamiltonian, QubitOperator
+        >>> from mindquantum.simulator.near_clifford import NearCliffordSimulator
+        >>> sim = NearCliffordSimulator(60)
+        >>> sim.apply_circuit(Circuit([H.on(0), T.on(0), X.on(59, 0)]))
+        >>> sim.branch_count
+        2
+        >>> round(sim.get_expectation(Hamiltonian(QubitOperator('X0 X59'))).real, 6)
+        0.707107
+    """
+
+    def __init__(self, n_qubits: int, seed: int = 42, truncation_threshold: float = 1e-14):
+        """Initialize a near Clifford simulator."""
+        if not NEAR_CLIFFORD_SUPPORTED:
+            raise RuntimeError("Near Clifford simulator is not available on this platform.")
+        _check_int_type('n_qubits', n_qubits)
+        _check_value_should_not_less('n_qubits', 1, n_qubits)
+        _check_seed(seed)
+        self.n_qubits = n_qubits
+        self.seed = seed
+        self.sim = _mq_vector.stabilizer.mqnearclifford(n_qubits, seed)
+        self.set_truncation_threshold(truncation_threshold)
+
+    def copy(self) -> "NearCliffordSimulator":
+        """Copy this simulator."""
+        sim = NearCliffordSimulator.__new__(NearCliffordSimulator)
+        sim.n_qubits = self.n_qubits
+        sim.seed = self.seed
+        sim.sim = _mq_vector.stabilizer.mqnearclifford(self.sim)
+        return sim
+
+    def set_truncation_threshold(self, threshold: float):
+        """
+        Set the truncation threshold.
+
+        Args:
+            threshold (float): Weight below which a term is dropped, in :math:`[0, 1)`.
+        """
+        self.sim.set_truncation_threshold(float(threshold))
+
+    @property
+    def branch_count(self) -> int:
+        """Get the number of stabilizer states in the sum."""
+        return self.sim.get_branch_count()
+
+    @property
+    def truncation_error(self) -> float:
+        """
+        Get the sum of the weights dropped so far.
+
+        One minus it estimates the fidelity of the state with the untruncated one.
+        """
+        return self.sim.get_truncation_error()
@@ -0,0 +1,146 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Simulator restricted to a fixed number of particles, for particle conserving ansatz."""
+import numpy as np
+
+from mindquantum import _mq_vector
+from mindquantum.core.operators import Hamiltonian
+from mindquantum.simulator.native_base import (
+    NativeSimulatorBase,
+    _check_native_hamiltonian,
+)
+from mindquantum.utils.type_value_check import (
+    _check_input_type,
+    _check_int_type,
+    _check_value_should_between_close_set,
+)
+
+PARTICLE_SUBSPACE_SUPPORTED = hasattr(_mq_vector, 'subspace')
+
+
+class ParticleSubspaceSimulator(NativeSimulatorBase):
+    r"""
+    Simulator keeping only the basis states with ``n_particles`` qubits in :math:`\left|1\right>`.
+
+    Circuits that conserve the number of particles, like UCC or particle conserving ansatz of a Jordan-Wigner encoded
+    molecule, keep the state in a subspace of dimension :math:`\binom{n}{N}` instead of :math:`2^n`, about six times
+    smaller for 24 spin orbitals at half filling. The basis states are indexed by their combinatorial rank, and a gate
+    mixes the basis states that only differ on its qubits without leaving the subspace.
+
+    Supported gates are the gates conserving the number of :math:`\left|1\right>`, possibly controlled: diagonal
+    gates (Z, S, T, PS, RZ, Rzz, GlobalPhase...), SWAP, ISWAP, FSim and number conserving matrix gates such as Givens
+    rotations and fermionic excitations. Other gates raise an error. The initial state has the ``n_particles`` lowest
+    qubits set, the Hartree-Fock state.
+
+    Args:
+        n_qubits (int): Number of qubits.
+        n_particles (int): Number of qubits in :math:`\left|1\right>`.
+
+    Examples:
+        >>> from mindquantum.core.circuit import Circuit
+        >>> from mindquantum.core.gates import FSim
+        >>> from mindquantum.core.operators import Hamiltonian, QubitOperator
+        >>> from mindquantum.simulator.particle_subspace import ParticleSubspaceSimulator
+        >>> sim = ParticleSubspaceSimulator(24, 12)
+        >>> sim.dim
+        2704156
+        >>> sim.apply_circuit(Circuit([FSim(0.3, 0.2).on([11, 12])]))
+        >>> round(sim.get_expectation(Hamiltonian(QubitOperator('Z12'))).real, 6)
+        0.825336
+    """
+
+    def __init__(self, n_qubits: int, n_particles: int):
+        """Initialize a particle subspace simulator."""
+        if not PARTICLE_SUBSPACE_SUPPORTED:
+            raise RuntimeError("Particle subspace simulator is not available on this platform.")
+        _check_int_type('n_qubits', n_qubits)
+        _check_value_should_between_close_set('n_qubits', 1, 63, n_qubits)
+        _check_int_type('n_particles', n_particles)
+        _check_value_should_between_close_set('n_particles', 0, n_qubits, n_particles)
+        self.n_qubits = n_qubits
+        self.n_particles = n_particles
+        self.sim = _mq_vector.subspace.mqparticle(n_qubits, n_particles)
+
+    def copy(self) -> "ParticleSubspaceSimulator":
+        """Copy this simulator."""
+        sim = ParticleSubspaceSimulator.__new__(ParticleSubspaceSimulator)
+        sim.n_qubits = self.n_qubits
+        sim.n_particles = self.n_particles
+        sim.sim = _mq_vector.subspace.mqparticle(self.sim)
+        return sim
+
+    def reset(self):
+        """Reset to the state with the ``n_particles`` lowest qubits set."""
+        self.sim.reset()
+
+    @property
+    def dim(self) -> int:
+        """Get the dimension of the subspace."""
+        return self.sim.dim()
+
+    def apply_hamiltonian(self, hamiltonian: Hamiltonian):
+        """
+        Apply a hamiltonian on the state and project the result on the subspace.
+
+        Args:
+            hamiltonian (Hamiltonian): A complex128 hamiltonian, not in sparse mode.
+        """
+        self.sim.apply_hamiltonian(_check_native_hamiltonian(hamiltonian).get_cpp_obj())
+
+    def amplitude(self, bits: str) -> complex:
+        """
+        Get the amplitude of a basis state, zero outside of the subspace.
+
+        Args:
+            bits (str): The basis state as a bit string, the highest qubit first like in ``get_qs``.
+        """
+        _check_input_type('bits', str, bits)
+        if len(bits) != self.n_qubits or set(bits) - {'0', '1'}:
+            raise ValueError(f"bits should be a string of {self.n_qubits} bits, but get {bits}.")
+        return self.sim.get_amplitude([int(b) for b in reversed(bits)])
+
+    def basis_state(self, rank: int) -> int:
+        """
+        Get the basis state at a position of the subspace state.
+
+        Args:
+            rank (int): Position in ``get_subspace_qs``.
+
+        Returns:
+            int, the basis state, bit :math:`i` being qubit :math:`i`.
+        """
+        _check_int_type('rank', rank)
+        _check_value_should_between_close_set('rank', 0, self.dim - 1, rank)
+        return self.sim.unrank(rank)
+
+    def get_subspace_qs(self) -> np.ndarray:
+        """Get the amplitudes of the subspace, the basis states in increasing order."""
+        return np.array(self.sim.get_subspace_qs())
+
+    def set_subspace_qs(self, quantum_state: np.ndarray):
+        """
+        Set the amplitudes of the subspace.
+
+        Args:
+            quantum_state (numpy.ndarray): The amplitudes, the basis states in increasing order.
+        """
+        quantum_state = np.asarray(quantum_state, dtype=np.complex128)
+        if quantum_state.shape != (self.dim,):
+            raise ValueError(f"quantum_state should have {self.dim} amplitudes, but get shape {quantum_state.shape}.")
+        self.sim.set_subspace_qs(quantum_state / np.sqrt(np.vdot(quantum_state, quantum_state).real))
+
+    def get_qs(self) -> np.ndarray:
+        """Get the full quantum state, for states of at most 30 qubits."""
+        return np.array(self.sim.get_qs())
@@ -0,0 +1,123 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Heisenberg picture expectation of local observables by Pauli propagation."""
+from typing import Dict, List, Union
+
+from mindquantum import _mq_vector
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.operators import Hamiltonian
+from mindquantum.core.parameterresolver import ParameterResolver
+from mindquantum.simulator.native_base import (
+    _check_native_circuit,
+    _check_native_hamiltonian,
+)
+from mindquantum.utils.type_value_check import (
+    _check_int_type,
+    _check_value_should_not_less,
+)
+
+PAULI_PROPAGATOR_SUPPORTED = hasattr(_mq_vector, 'stabilizer') and hasattr(
+    _mq_vector.stabilizer, 'mqpaulipropagator'
+)
+
+
+class PauliPropagator:
+    r"""
+    Expectation of a hamiltonian after a circuit, computed in the Heisenberg picture.
+
+    Every Pauli term of the hamiltonian is propagated backwards through the circuit as a weighted sum of bit packed
+    Pauli strings, :math:`O\leftarrow G^\dagger O G`. Clifford gates map a string to one string, a rotation
+    :math:`\exp(-i\theta Q/2)` splits the strings anticommuting with :math:`Q` in two, and gates outside the
+    support of a string leave it unchanged, so only the backward light cone of the observable costs time. The result
+    is evaluated on :math:`\left|0\cdots0\right>` or on a product state. For shallow circuits and local
+    observables, like QAOA or Trotter steps, it handles hundreds of qubits.
+
+    Strings whose absolute coefficient is not above ``coefficient_threshold`` or acting on more than ``max_weight``
+    qubits are dropped, the sum of the dropped absolute coefficients bounds the error.
+
+    Supported gates are the Clifford gates (I, X, Y, Z, H, S, S dagger, SWAP, ISWAP, CNOT, CY, CZ), and T, T dagger,
+    PS, RX, RY, RZ, Rxx, Ryy, Rzz, Rxy, Rxz, Ryz with at most one control qubit.
+
+    Args:
+        n_qubits (int): Number of qubits.
+        coefficient_threshold (float): Strings with a smaller absolute coefficient are dropped. Default: ``1e-12``.
+        max_weight (int): Strings acting on more qubits are dropped, ``None`` to keep all. Default: ``None``.
+
+    Examples:
+        >>> from mindquantum.core.circuit import Circuit
+        >>> from mindquantum.core.gates import RX, Rzz, H
+        >>> from mindquantum.core.operators import Hamiltonian, QubitOperator
+        >>> from mindquantum.simulator.pauli_propagation import PauliPropagator
+        >>> n = 100
+        >>> circ = Circuit([H.on(i) for i in range(n)])
+        >>> circ += Circuit([Rzz(0.4).on([i, (i + 1) % n]) for i in range(n)])
+        >>> circ += Circuit([RX(0.7).on(i) for i in range(n)])
+        >>> round(PauliPropagator(n).get_expectation(Hamiltonian(QubitOperator('Z10 Z11')), circ), 6)
+        0.353459
+    """
+
+    def __init__(self, n_qubits: int, coefficient_threshold: float = 1e-12, max_weight: int = None):
+        """Initialize a Pauli propagator."""
+        if not PAULI_PROPAGATOR_SUPPORTED:
+            raise RuntimeError("Pauli propagator is not available on this platform.")
+        _check_int_type('n_qubits', n_qubits)
+        _check_value_should_not_less('n_qubits', 1, n_qubits)
+        self.n_qubits = n_qubits
+        self.sim = _mq_vector.stabilizer.mqpaulipropagator(n_qubits)
+        self.sim.set_coefficient_threshold(float(coefficient_threshold))
+        if max_weight is not None:
+            _check_int_type('max_weight', max_weight)
+            _check_value_should_not_less('max_weight', 1, max_weight)
+            self.sim.set_max_weight(max_weight)
+
+    def set_product_state(self, bloch: List[List[float]]):
+        """
+        Set the initial product state.
+
+        Args:
+            bloch (List[List[float]]): The Bloch vector :math:`(x, y, z)` of every qubit, ``[0, 0, 1]`` for
+                :math:`\left|0\right>`.
+        """
+        if len(bloch) != self.n_qubits:
+            raise ValueError(f"bloch should have {self.n_qubits} vectors, but get {len(bloch)}.")
+        self.sim.set_product_state([[float(i) for i in vec] for vec in bloch])
+
+    @property
+    def max_term_count(self) -> int:
+        """Get the largest number of Pauli strings during the last propagation."""
+        return self.sim.get_max_term_count()
+
+    @property
+    def truncated_weight(self) -> float:
+        """Get the sum of the absolute coefficients dropped during the last propagation, a bound of its error."""
+        return self.sim.get_truncated_weight()
+
+    def get_expectation(
+        self, hamiltonian: Hamiltonian, circuit: Circuit, pr: Union[Dict, ParameterResolver] = None
+    ) -> float:
+        """
+        Get the expectation of a hamiltonian on the state prepared by a circuit.
+
+        Args:
+            hamiltonian (Hamiltonian): A complex128 hamiltonian, not in sparse mode.
+            circuit (Circuit): The circuit, without measurements and noise channels.
+            pr (Union[Dict, ParameterResolver]): Parameters of a parameterized circuit. Default: ``None``.
+
+        Returns:
+            float, the expectation.
+        """
+        hamiltonian = _check_native_hamiltonian(hamiltonian)
+        pr = _check_native_circuit(circuit, self.n_qubits, pr)
+        return self.sim.get_expectation(hamiltonian.get_cpp_obj(), circuit.get_cpp_obj(), pr)
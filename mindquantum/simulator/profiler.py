@@ -0,0 +1,91 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Profiler of the c++ simulator backends."""
+
+import typing
+
+from .available_simulator import SUPPORTED_SIMULATOR
+
+
+def _modules(sim: typing.Optional[str] = None):
+    """Get the c++ modules to query."""
+    if sim is not None:
+        return {sim: SUPPORTED_SIMULATOR.c_module(sim)}
+    return SUPPORTED_SIMULATOR.unique_modules()
+
+
+def profiler_enabled() -> bool:
+    """
+    Whether the c++ simulators are compiled with the profiler.
+
+    The profiler is enabled by building MindQuantum with the cmake option `ENABLE_PROFILING`.
+
+    Returns:
+        bool, whether the simulators record profiling data.
+    """
+    return any(module.profiler_enabled() for module in _modules().values())
+
+
+def reset_profile(sim: typing.Optional[str] = None):
+    """
+    Clear the profiling data of the c++ simulators.
+
+    Args:
+        sim (str): Only reset the given simulator backend. If ``None``, reset all backends. Default: ``None``.
+    """
+    for module in _modules(sim).values():
+        module.profiler_reset()
+
+
+def get_profile(sim: typing.Optional[str] = None) -> typing.List[typing.Dict]:
+    """
+    Get the profiling data of the c++ simulators.
+
+    The data is accumulated per simulator backend, phase, gate and qubit number over all threads. Phases are
+    ``'apply_gate'``, ``'apply_channel'``, ``'expectation'``, ``'gradient'``, ``'parameter_resolve'`` and
+    ``'jacobian'``. Phases nest, for example the time of ``'parameter_resolve'`` is also counted in
+    ``'apply_gate'``. The list is empty if the simulators are not compiled with the profiler.
+
+    Args:
+        sim (str): Only report the given simulator backend. If ``None``, report all backends. Default: ``None``.
+
+    Returns:
+        List[Dict], records with keys ``'sim'``, ``'phase'``, ``'gate'``, ``'n_qubits'``, ``'calls'``, ``'time'``
+        (in seconds) and ``'bytes'`` (bytes of quantum state touched), sorted by decreasing time.
+
+    Examples:
+        >>> from mindquantum.simulator import Simulator
+        >>> from mindquantum.simulator.profiler import get_profile, reset_profile
+        >>> from mindquantum.algorithm.library import qft
+        >>> reset_profile()
+        >>> sim = Simulator('mqvector', 3)
+        >>> _ = sim.apply_circuit(qft(range(3)))
+        >>> records = get_profile('mqvector')
+    """
+    out = []
+    for name, module in _modules(sim).items():
+        for phase, gate, n_qubits, calls, time_ns, n_bytes in module.profiler_report():
+            out.append(
+                {
+                    'sim': name,
+                    'phase': phase,
+                    'gate': gate,
+                    'n_qubits': n_qubits,
+                    'calls': calls,
+                    'time': time_ns * 1e-9,
+                    'bytes': n_bytes,
+                }
+            )
+    return sorted(out, key=lambda record: record['time'], reverse=True)
@@ -0,0 +1,172 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Classical shadow of a simulated state from random local Pauli measurements."""
+from typing import Dict, Tuple, Union
+
+import numpy as np
+
+import mindquantum as mq
+from mindquantum import _mq_vector
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.core.parameterresolver import ParameterResolver
+from mindquantum.simulator.simulator import Simulator
+from mindquantum.utils.type_value_check import (
+    _check_input_type,
+    _check_int_type,
+    _check_seed,
+    _check_value_should_not_less,
+)
+
+CLASSICAL_SHADOW_SUPPORTED = hasattr(_mq_vector, 'shadow')
+
+
+class ClassicalShadow:
+    r"""
+    Classical shadow of a state, from random local Pauli measurements sampled by the simulator.
+
+    Every snapshot measures each qubit in a uniformly random basis :math:`X`, :math:`Y` or :math:`Z`. Random local
+    Clifford measurements give the same outcomes up to a relabeling and share the estimator. The state is prepared
+    once, then the outcomes of a whole batch of snapshots are sampled qubit by qubit: snapshots with the same bases
+    and outcomes so far share the projected state. So :math:`10^5` to :math:`10^6` snapshots cost about as much as a
+    few thousand passes over the state. The snapshots are stored bit packed.
+
+    A Pauli string :math:`P` of weight :math:`w` is estimated by :math:`3^w` times the product of the outcomes
+    :math:`\pm1` on its support, on the snapshots whose bases match :math:`P`, and by 0 on the others. The snapshots
+    are split in ``n_groups`` consecutive groups, and the median of the group means is robust to outliers.
+
+    Args:
+        n_qubits (int): Number of qubits.
+        seed (int): Random seed of the bases and outcomes. Default: ``42``.
+
+    Examples:
+        >>> from mindquantum.core.circuit import Circuit
+        >>> from mindquantum.core.gates import H, X
+        >>> from mindquantum.core.operators import QubitOperator
+        >>> from mindquantum.simulator.shadow import ClassicalShadow
+        >>> shadow = ClassicalShadow(2)
+        >>> shadow.sample(Circuit([H.on(0), X.on(1, 0)]), 10000)
+        >>> est = shadow.estimate_terms(QubitOperator('Z0 Z1') + QubitOperator('X0 X1'))
+        >>> [round(i) for i in est.values()]
+        [1, 1]
+    """
+
+    def __init__(self, n_qubits: int, seed: int = 42):
+        """Initialize a classical shadow."""
+        if not CLASSICAL_SHADOW_SUPPORTED:
+            raise RuntimeError("Classical shadow is not available on this platform.")
+        _check_int_type('n_qubits', n_qubits)
+        _check_value_should_not_less('n_qubits', 1, n_qubits)
+        _check_seed(seed)
+        self.n_qubits = n_qubits
+        self.shadow = _mq_vector.shadow.mqshadow(n_qubits, seed)
+
+    @property
+    def n_snapshots(self) -> int:
+        """Get the number of snapshots."""
+        return self.shadow.n_snapshots()
+
+    @property
+    def bases(self) -> np.ndarray:
+        """Get the basis of every snapshot on each qubit, ``0``, ``1`` and ``2`` for X, Y and Z."""
+        return np.array(self.shadow.get_bases(), dtype=np.uint8).reshape(-1, self.n_qubits)
+
+    @property
+    def outcomes(self) -> np.ndarray:
+        """Get the outcome of every snapshot on each qubit, ``0`` for eigenvalue 1 and ``1`` for -1."""
+        return np.array(self.shadow.get_outcomes(), dtype=np.uint8).reshape(-1, self.n_qubits)
+
+    def clear(self):
+        """Remove all snapshots."""
+        self.shadow.clear()
+
+    def sample(
+        self,
+        source: Union[Simulator, Circuit, np.ndarray],
+        n_snapshots: int,
+        pr: Union[Dict, ParameterResolver] = None,
+    ):
+        r"""
+        Add snapshots of a state.
+
+        Args:
+            source (Union[Simulator, Circuit, numpy.ndarray]): The current state of a ``mqvector`` simulator, the
+                state prepared by a circuit from :math:`\left|0\right>`, or the amplitudes of a state.
+            n_snapshots (int): Number of snapshots to add.
+            pr (Union[Dict, ParameterResolver]): Parameters of a parameterized circuit. Default: ``None``.
+        """
+        _check_int_type('n_snapshots', n_snapshots)
+        _check_value_should_not_less('n_snapshots', 0, n_snapshots)
+        if isinstance(source, Circuit):
+            if source.has_measure_gate or source.is_noise_circuit:
+                raise ValueError("Classical shadow needs a circuit without measurements and noise channels.")
+            sim = Simulator('mqvector', self.n_qubits)
+            sim.apply_circuit(source, pr)
+            source = sim
+        if isinstance(source, Simulator):
+            if source.backend.name != 'mqvector':
+                raise ValueError(f"Classical shadow samples a mqvector simulator, but get {source.backend.name}.")
+            if source.n_qubits != self.n_qubits:
+                raise ValueError(f"Require a {self.n_qubits} qubits simulator, but get {source.n_qubits}.")
+            self.shadow.sample(source.backend.sim, n_snapshots)
+            return
+        _check_input_type('source', np.ndarray, source)
+        if source.shape != (1 << self.n_qubits,):
+            raise ValueError(f"State should have shape {(1 << self.n_qubits,)}, but get {source.shape}.")
+        self.shadow.sample(source.astype(np.complex128), n_snapshots)
+
+    def _get_cpp_ham(self, hamiltonian: Union[Hamiltonian, QubitOperator]) -> Hamiltonian:
+        """Check the hamiltonian and get it as complex128 Pauli terms."""
+        if isinstance(hamiltonian, QubitOperator):
+            hamiltonian = Hamiltonian(hamiltonian)
+        _check_input_type('hamiltonian', Hamiltonian, hamiltonian)
+        if hamiltonian.dtype != mq.complex128:
+            raise TypeError(f"hamiltonian should be complex128, but get {hamiltonian.dtype}.")
+        if self.n_snapshots == 0:
+            raise ValueError("Classical shadow has no snapshot, sample some first.")
+        return hamiltonian
+
+    def estimate_terms(
+        self, hamiltonian: Union[Hamiltonian, QubitOperator], n_groups: int = 10
+    ) -> Dict[Tuple[Tuple[int, str], ...], float]:
+        """
+        Estimate each term of a hamiltonian, its coefficient times the expectation of its Pauli string.
+
+        Args:
+            hamiltonian (Union[Hamiltonian, QubitOperator]): The hamiltonian, not in sparse mode.
+            n_groups (int): Number of groups of the median of means. Default: ``10``.
+
+        Returns:
+            Dict[Tuple[Tuple[int, str], ...], float], the estimate of each term, keyed like ``QubitOperator.terms``.
+        """
+        hamiltonian = self._get_cpp_ham(hamiltonian)
+        _check_int_type('n_groups', n_groups)
+        values = self.shadow.estimate_terms(hamiltonian.get_cpp_obj(), n_groups)
+        return {term: value for (term, _), value in zip(hamiltonian.ham_termlist, values)}
+
+    def estimate_expectation(self, hamiltonian: Union[Hamiltonian, QubitOperator], n_groups: int = 10) -> float:
+        """
+        Estimate the expectation of a hamiltonian, the terms summed per snapshot before the median of means.
+
+        Args:
+            hamiltonian (Union[Hamiltonian, QubitOperator]): The hamiltonian, not in sparse mode.
+            n_groups (int): Number of groups of the median of means. Default: ``10``.
+
+        Returns:
+            float, the estimated expectation.
+        """
+        hamiltonian = self._get_cpp_ham(hamiltonian)
+        _check_int_type('n_groups', n_groups)
+        return self.shadow.estimate_expectation(hamiltonian.get_cpp_obj(), n_groups)
@@ -400,6 +400,74 @@ class Simulator:
         """
         return self.backend.get_qs(ket)
 
+    def get_qs_view(self, writable=False):
+        """
+        Get a numpy array that shares memory with the current quantum state.
+
+        Unlike :meth:`get_qs`, no copy is made, so the array reflects later evolution of this simulator. The
+        simulator is kept alive as long as the array is alive. Only supported by ``'mqvector'`` backend.
+
+        Args:
+            writable (bool): Whether the returned array can be modified in place. Default: ``False``.
+
+        Returns:
+            numpy.ndarray, a view of the current quantum state.
+
+        Examples:
+            >>> from mindquantum.core.gates import H
+            >>> from mindquantum.simulator import Simulator
+            >>> sim = Simulator('mqvector', 1)
+            >>> view = sim.get_qs_view()
+            >>> sim.apply_gate(H.on(0))
+            >>> view
+            array([0.70710678+0.j, 0.70710678+0.j])
+        """
+        _check_input_type('writable', bool, writable)
+        return self.backend.get_qs_view(writable)
+
+    def save_state(self, filename, drop_below=0.0):
+        """
+        Save the quantum state and the random state of this simulator to a checkpoint file.
+
+        The raw state buffer is written with large sequential writes, without going through numpy. The file is
+        written under a temporary name, renamed when complete and its directory synced, so a crash while saving
+        leaves the previous checkpoint intact. Amplitudes with a modulus not larger than `drop_below` are left out when that makes the
+        file smaller. Only supported by ``'mqvector'``, ``'mqvector_mixed'``, ``'mqvector_ooc'`` and
+        ``'mqmatrix'`` backends.
+
+        Args:
+            filename (Union[str, os.PathLike]): Path of the checkpoint file.
+            drop_below (float): Largest modulus of the dropped amplitudes. ``0`` only drops exact zeros, which is
+                lossless, and a negative value always writes the full state. Default: ``0.0``.
+
+        Examples:
+            >>> import os
+            >>> import tempfile
+            >>> from mindquantum.core.gates import H
+            >>> from mindquantum.simulator import Simulator
+            >>> sim = Simulator('mqvector', 2)
+            >>> sim.apply_gate(H.on(0))
+            >>> path = os.path.join(tempfile.mkdtemp(), 'state.mq')
+            >>> sim.save_state(path)
+            >>> sim2 = Simulator('mqvector', 2)
+            >>> sim2.load_state(path)
+            >>> sim2.get_qs()
+            array([0.70710678+0.j, 0.70710678+0.j, 0.        +0.j, 0.        +0.j])
+        """
+        self.backend.save_state(filename, drop_below)
+
+    def load_state(self, filename):
+        """
+        Restore the quantum state and the random state saved by :meth:`save_state`.
+
+        The checkpoint is read straight into a new state buffer. It should come from a simulator with the same
+        backend, dtype and number of qubits.
+
+        Args:
+            filename (Union[str, os.PathLike]): Path of the checkpoint file.
+        """
+        self.backend.load_state(filename)
+
     def reset(self):
         """
         Reset simulator to zero state.
@@ -459,6 +527,52 @@ class Simulator:
         """
         return self.backend.sampling(circuit, pr, shots, seed)
 
+    def submit_get_expectation(self, hamiltonian, circ_right=None, pr=None):
+        """
+        Get expectation of the given hermitian hamiltonian in background.
+
+        The expectation is calculated by a thread pool in the C++ backend, so that python code can keep running
+        in the mean time. The quantum state of this simulator should not be changed until the task is done.
+
+        Args:
+            hamiltonian (Hamiltonian): The hamiltonian you want to get expectation.
+            circ_right (Circuit): The circuit that evolves the quantum state before measuring the hamiltonian.
+                If it is ``None``, we will use empty circuit. Default: ``None``.
+            pr (Union[Dict[str, numbers.Number], ParameterResolver]): the
+                variable value of circuit. Default: ``None``.
+
+        Returns:
+            SimulatorFuture, whose result is the expectation value. It can also be awaited in an asyncio event loop.
+
+        Examples:
+            >>> from mindquantum.core.circuit import Circuit
+            >>> from mindquantum.core.operators import QubitOperator, Hamiltonian
+            >>> from mindquantum.simulator import Simulator
+            >>> sim = Simulator('mqvector', 1)
+            >>> future = sim.submit_get_expectation(Hamiltonian(QubitOperator('Z0')), Circuit().ry(1.2, 0))
+            >>> future.result()
+            (0.36235775447667357+0j)
+        """
+        return self.backend.submit_get_expectation(hamiltonian, circ_right, pr)
+
+    def submit_sampling(self, circuit, pr=None, shots=1, seed=None):
+        """
+        Sample the measure qubit in circuit in background.
+
+        Args:
+            circuit (Circuit): The circuit that you want to evolution and do sampling.
+            pr (Union[None, dict, ParameterResolver]): The parameter
+                resolver for this circuit, if this circuit is a parameterized circuit.
+                Default: ``None``.
+            shots (int): How many shots you want to sampling this circuit. Default: ``1``.
+            seed (int): Random seed for random sampling. If ``None``, seed will be a random
+                int number. Default: ``None``.
+
+        Returns:
+            SimulatorFuture, whose result is the same MeasureResult as :meth:`sampling`.
+        """
+        return self.backend.submit_sampling(circuit, pr, shots, seed)
+
     def set_qs(self, quantum_state):
         """
         Set quantum state for this simulation.
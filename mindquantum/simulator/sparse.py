@@ -0,0 +1,117 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""State vector simulator that only stores the nonzero amplitudes."""
+from typing import List, Tuple
+
+import numpy as np
+
+from mindquantum import _mq_vector
+from mindquantum.simulator.native_base import SamplingSimulatorBase
+from mindquantum.utils.type_value_check import (
+    _check_int_type,
+    _check_seed,
+    _check_value_should_not_less,
+)
+
+SPARSE_SUPPORTED = hasattr(_mq_vector, 'sparse')
+
+
+class SparseSimulator(SamplingSimulatorBase):
+    """
+    Double precision state vector simulator that keeps the nonzero amplitudes in a hash map.
+
+    Circuits that keep the state on few basis states, like reversible arithmetic, oracles or QRAM loading, run in
+    memory proportional to the number of nonzero amplitudes, on up to 63 qubits. Permutation gates (X, CNOT, Toffoli,
+    SWAP) move the amplitudes, diagonal gates scale them, and gates that create superpositions split each amplitude
+    in two. Amplitudes with a modulus not larger than the prune threshold are dropped after each gate.
+
+    Once the stored amplitudes reach ``dense_fraction`` of :math:`2^n`, and the state has at most ``max_dense_qubits``
+    qubits, the state is converted to a dense ``mqvector`` state, which runs the rest of the gates.
+
+    Args:
+        n_qubits (int): Number of qubits, at most 63.
+        seed (int): Random seed of the measurements. Default: ``42``.
+
+    Examples:
+        >>> from mindquantum.core.circuit import Circuit
+        >>> from mindquantum.simulator.sparse import SparseSimulator
+        >>> sim = SparseSimulator(60)
+        >>> sim.apply_circuit(Circuit().h(0).x(59, 0))
+        >>> sim.amplitudes()
+        [(0, (0.7071067811865475+0j)), (576460752303423489, (0.7071067811865475+0j))]
+    """
+
+    def __init__(self, n_qubits: int, seed: int = 42):
+        """Initialize a sparse simulator."""
+        if not SPARSE_SUPPORTED:
+            raise RuntimeError("Sparse simulator is not available on this platform.")
+        _check_int_type('n_qubits', n_qubits)
+        _check_value_should_not_less('n_qubits', 1, n_qubits)
+        _check_seed(seed)
+        self.n_qubits = n_qubits
+        self.seed = seed
+        self.sim = _mq_vector.sparse.mqvector_sparse(n_qubits, seed)
+
+    def copy(self) -> "SparseSimulator":
+        """Copy this simulator."""
+        sim = SparseSimulator.__new__(SparseSimulator)
+        sim.n_qubits = self.n_qubits
+        sim.seed = self.seed
+        sim.sim = _mq_vector.sparse.mqvector_sparse(self.sim)
+        return sim
+
+    @property
+    def size(self) -> int:
+        """Get the number of stored amplitudes, :math:`2^n` once the state is dense."""
+        return self.sim.size()
+
+    @property
+    def is_dense(self) -> bool:
+        """Whether the state has been converted to a dense state vector."""
+        return self.sim.is_dense()
+
+    def set_prune_threshold(self, threshold: float):
+        """
+        Set the modulus below which amplitudes are dropped.
+
+        Args:
+            threshold (float): Amplitudes with a modulus not larger than it are dropped. Default: ``1e-12``.
+        """
+        self.sim.set_prune_threshold(float(threshold))
+
+    def set_dense_threshold(self, fraction: float, max_qubits: int = 28):
+        """
+        Set when the state is converted to a dense state vector.
+
+        Args:
+            fraction (float): Convert once the stored amplitudes reach this fraction of :math:`2^n`. Default:
+                ``1/32``.
+            max_qubits (int): Never convert states of more qubits. Default: ``28``.
+        """
+        _check_int_type('max_qubits', max_qubits)
+        self.sim.set_dense_threshold(float(fraction), max_qubits)
+
+    def amplitude(self, index: int) -> complex:
+        """Get the amplitude of a basis state."""
+        _check_int_type('index', index)
+        return self.sim.get_amplitude(index)
+
+    def amplitudes(self) -> List[Tuple[int, complex]]:
+        """Get the stored amplitudes as ``(index, amplitude)`` pairs sorted by index."""
+        return self.sim.get_amplitudes()
+
+    def get_qs(self) -> np.ndarray:
+        """Get the full quantum state, for states of at most 30 qubits."""
+        return np.array(self.sim.get_qs())
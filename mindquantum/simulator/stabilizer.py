@@ -0,0 +1,124 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Stabilizer simulator for Clifford circuits on many qubits."""
+from typing import List
+
+from mindquantum import _mq_vector
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import BasicGate, MeasureResult
+from mindquantum.simulator.native_base import SamplingSimulatorBase
+from mindquantum.utils.type_value_check import (
+    _check_input_type,
+    _check_int_type,
+    _check_seed,
+    _check_value_should_not_less,
+)
+
+STABILIZER_SUPPORTED = hasattr(_mq_vector, 'stabilizer')
+
+
+class StabilizerSimulator(SamplingSimulatorBase):
+    """
+    Stabilizer simulator of Clifford circuits, in polynomial time and memory.
+
+    The state is an Aaronson-Gottesman tableau of :math:`2n` bit packed Pauli strings, so a gate costs :math:`O(n)`
+    and a measurement :math:`O(n^2)` word operations, and thousands of qubits are cheap. Only I, X, Y, Z, H, S,
+    S dagger, SWAP, CNOT, CY, CZ and measurements are supported, other gates raise a ``ValueError``.
+    Sampling runs the circuit once on the tableau for a reference sample, then propagates Pauli frames of all shots
+    together, 64 shots per word operation.
+
+    Args:
+        n_qubits (int): Number of qubits.
+        seed (int): Random seed of the measurements. Default: ``42``.
+
+    Examples:
+        >>> from mindquantum.core.circuit import Circuit
+        >>> from mindquantum.core.operators import Hamiltonian, QubitOperator
+        >>> from mindquantum.simulator.stabilizer import StabilizerSimulator
+        >>> sim = StabilizerSimulator(3)
+        >>> sim.apply_circuit(Circuit().h(0).x(1, 0))
+        >>> sim.stabilizers
+        ['+XXI', '+ZZI', '+IIZ']
+        >>> sim.get_expectation(Hamiltonian(QubitOperator('Z0 Z1')))
+        (1+0j)
+    """
+
+    def __init__(self, n_qubits: int, seed: int = 42):
+        """Initialize a stabilizer simulator."""
+        if not STABILIZER_SUPPORTED:
+            raise RuntimeError("Stabilizer simulator is not available on this platform.")
+        _check_int_type('n_qubits', n_qubits)
+        _check_value_should_not_less('n_qubits', 1, n_qubits)
+        _check_seed(seed)
+        self.n_qubits = n_qubits
+        self.seed = seed
+        self.sim = _mq_vector.stabilizer.mqstabilizer(n_qubits, seed)
+
+    def copy(self) -> "StabilizerSimulator":
+        """Copy this simulator."""
+        sim = StabilizerSimulator.__new__(StabilizerSimulator)
+        sim.n_qubits = self.n_qubits
+        sim.seed = self.seed
+        sim.sim = _mq_vector.stabilizer.mqstabilizer(self.sim)
+        return sim
+
+    @property
+    def stabilizers(self) -> List[str]:
+        """Get the stabilizer generators with their sign, like ``'+XZI'``, qubit 0 first."""
+        return self.sim.get_stabilizers()
+
+    def apply_gate(self, gate: BasicGate):  # pylint: disable=arguments-differ
+        """
+        Apply a Clifford gate or a measurement.
+
+        Args:
+            gate (BasicGate): The gate.
+
+        Returns:
+            int, the result of a measurement, ``None`` for other gates.
+        """
+        return super().apply_gate(gate)
+
+    def _check_circuit(self, circuit: Circuit, pr=None):
+        """Check a circuit."""
+        _check_input_type('circuit', Circuit, circuit)
+        if circuit.params_name:
+            raise ValueError("Stabilizer simulator does not support parameterized circuit.")
+        return super()._check_circuit(circuit, pr)
+
+    def apply_circuit(self, circuit: Circuit):  # pylint: disable=arguments-differ
+        """
+        Apply a Clifford circuit.
+
+        Args:
+            circuit (Circuit): The circuit.
+
+        Returns:
+            MeasureResult, the measurement results if the circuit has measurements, else ``None``.
+        """
+        return super().apply_circuit(circuit)
+
+    def sampling(  # pylint: disable=arguments-differ
+        self, circuit: Circuit, shots: int = 1, seed: int = None
+    ) -> MeasureResult:
+        """
+        Sample the measurements of a circuit applied on the current state, which is left unchanged.
+
+        Args:
+            circuit (Circuit): The Clifford circuit with measurements.
+            shots (int): Number of samples. Default: ``1``.
+            seed (int): Random seed of the sampling. Default: ``None``.
+        """
+        return super().sampling(circuit, shots=shots, seed=seed)
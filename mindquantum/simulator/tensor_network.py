@@ -0,0 +1,143 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Amplitudes and expectations of shallow circuits by tensor network contraction."""
+from typing import Dict, List, Union
+
+import numpy as np
+
+from mindquantum import _mq_vector
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.operators import Hamiltonian
+from mindquantum.core.parameterresolver import ParameterResolver
+from mindquantum.simulator.native_base import (
+    _check_native_circuit,
+    _check_native_hamiltonian,
+)
+from mindquantum.utils.type_value_check import (
+    _check_input_type,
+    _check_int_type,
+    _check_value_should_between_close_set,
+    _check_value_should_not_less,
+)
+
+TENSOR_NETWORK_SUPPORTED = hasattr(_mq_vector, 'tensornet')
+
+
+class TensorNetworkSimulator:
+    r"""
+    Amplitudes and expectations of a circuit computed by contracting it as a tensor network.
+
+    Every gate becomes a tensor with an input and an output index per qubit, and the network is contracted pairwise
+    in an order found by a greedy search repeated with randomly perturbed costs. Indices are sliced, and the slices
+    summed, until every intermediate tensor holds at most :math:`2^{\text{max_rank}}` elements. The cost grows with
+    the treewidth of the circuit rather than with the number of qubits, so shallow circuits on many qubits are cheap.
+
+    Amplitudes :math:`\left<x\right|U\left|0\cdots0\right>` of a batch of basis states share one contraction order.
+    Expectations are computed term by term on :math:`U^\dagger P U`, keeping only the gates in the backward light cone
+    of the Pauli term :math:`P`.
+
+    The circuit should not have measurements or noise channels.
+
+    Args:
+        n_qubits (int): Number of qubits.
+        max_rank (int): Largest log2 size of an intermediate tensor, between 4 and 40. Default: ``26``.
+        order_trials (int): Number of greedy searches of the contraction order. Default: ``16``.
+        seed (int): Random seed of the order search. Default: ``42``.
+
+    Examples:
+        >>> from mindquantum.core.circuit import Circuit
+        >>> from mindquantum.core.gates import RX, Rzz, H
+        >>> from mindquantum.core.operators import Hamiltonian, QubitOperator
+        >>> from mindquantum.simulator.tensor_network import TensorNetworkSimulator
+        >>> n = 50
+        >>> circ = Circuit([H.on(i) for i in range(n)])
+        >>> circ += Circuit([Rzz(0.4).on([i, (i + 1) % n]) for i in range(n)])
+        >>> circ += Circuit([RX(0.7).on(i) for i in range(n)])
+        >>> sim = TensorNetworkSimulator(n)
+        >>> round(sim.get_expectation(Hamiltonian(QubitOperator('Z10 Z11')), circ).real, 6)
+        0.353459
+    """
+
+    def __init__(self, n_qubits: int, max_rank: int = 26, order_trials: int = 16, seed: int = 42):
+        """Initialize a tensor network simulator."""
+        if not TENSOR_NETWORK_SUPPORTED:
+            raise RuntimeError("Tensor network simulator is not available on this platform.")
+        _check_int_type('n_qubits', n_qubits)
+        _check_value_should_not_less('n_qubits', 1, n_qubits)
+        _check_int_type('max_rank', max_rank)
+        _check_value_should_between_close_set('max_rank', 4, 40, max_rank)
+        _check_int_type('order_trials', order_trials)
+        _check_value_should_not_less('order_trials', 1, order_trials)
+        _check_int_type('seed', seed)
+        self.n_qubits = n_qubits
+        self.sim = _mq_vector.tensornet.mqtensornet(n_qubits, seed)
+        self.sim.set_max_rank(max_rank)
+        self.sim.set_order_trials(order_trials)
+
+    @property
+    def last_path(self) -> Dict:
+        """
+        Get the contraction path of the last network.
+
+        Returns:
+            dict, with the merged pairs ``steps``, the ``sliced`` indices, the ``flops`` of one slice and the
+            ``max_rank`` of its intermediate tensors.
+        """
+        return self.sim.get_last_path()
+
+    def get_amplitudes(
+        self, circuit: Circuit, bits: Union[str, List[str]], pr: Union[Dict, ParameterResolver] = None
+    ) -> np.ndarray:
+        """
+        Get the amplitudes of basis states after a circuit applied on the zero state.
+
+        Args:
+            circuit (Circuit): The circuit.
+            bits (Union[str, List[str]]): A basis state or a batch of them, as bit strings with the highest qubit
+                first like in ``get_qs``.
+            pr (Union[Dict, ParameterResolver]): Parameters of a parameterized circuit. Default: ``None``.
+
+        Returns:
+            numpy.ndarray, the amplitude of each basis state.
+        """
+        pr = _check_native_circuit(circuit, self.n_qubits, pr)
+        if isinstance(bits, str):
+            bits = [bits]
+        _check_input_type('bits', list, bits)
+        states = []
+        for state in bits:
+            _check_input_type('bits', str, state)
+            if len(state) != self.n_qubits or set(state) - {'0', '1'}:
+                raise ValueError(f"bits should be strings of {self.n_qubits} bits, but get {state}.")
+            states.append([int(b) for b in reversed(state)])
+        return np.array(self.sim.get_amplitudes(circuit.get_cpp_obj(), states, pr))
+
+    def get_expectation(
+        self, hamiltonian: Hamiltonian, circuit: Circuit, pr: Union[Dict, ParameterResolver] = None
+    ) -> complex:
+        """
+        Get the expectation of a hamiltonian on the state prepared by a circuit.
+
+        Args:
+            hamiltonian (Hamiltonian): A complex128 hamiltonian, not in sparse mode.
+            circuit (Circuit): The circuit.
+            pr (Union[Dict, ParameterResolver]): Parameters of a parameterized circuit. Default: ``None``.
+
+        Returns:
+            complex, the expectation.
+        """
+        hamiltonian = _check_native_hamiltonian(hamiltonian)
+        pr = _check_native_circuit(circuit, self.n_qubits, pr)
+        return self.sim.get_expectation(hamiltonian.get_cpp_obj(), circuit.get_cpp_obj(), pr)
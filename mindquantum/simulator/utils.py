@@ -14,6 +14,8 @@
 # ============================================================================
 """Simulator utils."""
 
+import asyncio
+
 
 def _thread_balance(n_prs, n_meas, parallel_worker):
     """Thread balance."""
@@ -66,6 +68,18 @@ class GradOpsWrapper:  # pylint: disable=too-many-instance-attributes
         """Definition of a function call operator."""
         return self.grad_ops(*args)
 
+    def submit(self, *args):
+        """
+        Run the gradient operator in background.
+
+        Args:
+            args (numpy.ndarray): Same inputs as calling this gradient operator.
+
+        Returns:
+            SimulatorFuture, whose result is the same as calling this gradient operator.
+        """
+        return self.grad_ops(*args, asynchronous=True)
+
     def set_str(self, grad_str):
         """
         Set expression for gradient operator.
@@ -74,3 +88,59 @@ class GradOpsWrapper:  # pylint: disable=too-many-instance-attributes
             grad_str (str): The string of QNN operator.
         """
         self.str = grad_str
+
+
+class SimulatorFuture:
+    """
+    A simulator task running in background.
+
+    The task runs on a thread pool in the C++ backend without holding the python GIL. It reads the simulator
+    while running, so the simulator should not be modified until the task is done.
+
+    Args:
+        future: The future returned by a ``submit_*`` method of the C++ simulator.
+        post (Callable): Function to convert the raw result of the task. Default: ``None``.
+    """
+
+    def __init__(self, future, post=None):
+        """Initialize a SimulatorFuture object."""
+        self._future = future
+        self._post = post
+
+    def done(self):
+        """Return whether the task is finished or cancelled."""
+        return self._future.done()
+
+    def running(self):
+        """Return whether the task is running."""
+        return self._future.running()
+
+    def cancelled(self):
+        """Return whether the task is cancelled."""
+        return self._future.cancelled()
+
+    def cancel(self):
+        """Cancel the task if it has not started yet, return whether the task is cancelled."""
+        return self._future.cancel()
+
+    def result(self):
+        """Wait until the task is done and return its result."""
+        res = self._future.result()
+        if self._post is not None:
+            return self._post(res)
+        return res
+
+    def __await__(self):
+        """Wait for the task in an asyncio event loop."""
+        if not self._future.done():
+            loop = asyncio.get_running_loop()
+            waiter = loop.create_future()
+
+            def _wake():
+                if not waiter.done():
+                    waiter.set_result(None)
+
+            # The callback runs on the backend thread that finishes the task, it only schedules the wake up.
+            self._future.add_done_callback(lambda: loop.call_soon_threadsafe(_wake))
+            yield from waiter.__await__()
+        return self.result()
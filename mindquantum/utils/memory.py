@@ -0,0 +1,130 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Memory accounting and budget of the c++ backends."""
+
+import typing
+
+
+def _modules():
+    """Get the c++ modules that account for their memory."""
+    # pylint: disable=import-outside-toplevel
+    from mindquantum import mqbackend
+    from mindquantum.simulator.available_simulator import SUPPORTED_SIMULATOR
+
+    out = {'mqbackend': mqbackend.memory}
+    out.update(SUPPORTED_SIMULATOR.unique_modules())
+    return out
+
+
+def set_memory_budget(budget: typing.Optional[int]):
+    """
+    Set the budget of host memory used by quantum states and sparse matrices.
+
+    An allocation that would exceed the budget raises a ``MemoryError`` before allocating. The gradient functions of
+    the simulators run fewer Hamiltonians or batches at once to stay within the budget. The budget applies to each
+    c++ backend module separately.
+
+    Args:
+        budget (int): Budget in bytes. If ``None`` or ``0``, no budget is applied.
+
+    Examples:
+        >>> from mindquantum.utils.memory import set_memory_budget
+        >>> from mindquantum.simulator import Simulator
+        >>> set_memory_budget(1 << 20)
+        >>> try:
+        ...     Simulator('mqvector', 20).set_qs([1] + [0] * ((1 << 20) - 1))
+        ... except MemoryError:
+        ...     pass
+        >>> set_memory_budget(None)
+    """
+    if budget is None:
+        budget = 0
+    if not isinstance(budget, int) or budget < 0:
+        raise ValueError(f"budget should be a non-negative int or None, but get {budget}.")
+    for module in _modules().values():
+        module.memory_set_budget(budget)
+
+
+def get_memory_budget() -> typing.Optional[int]:
+    """
+    Get the memory budget set by :func:`set_memory_budget`.
+
+    Returns:
+        Union[int, None], the budget in bytes, ``None`` if no budget is applied.
+    """
+    budget = _modules()['mqbackend'].memory_budget()
+    return budget if budget else None
+
+
+def set_memory_pool_limit(limit: int):
+    """
+    Set the largest number of bytes of released states kept for reuse.
+
+    Released state vectors and density matrices are kept in a pool and handed out again to the next state of the same
+    size, which avoids the cost of fresh memory when states are created repeatedly. The pool is emptied first when an
+    allocation would exceed the memory budget. The limit applies to each c++ backend module separately.
+
+    Args:
+        limit (int): Limit in bytes, ``0`` disables the pool. Default: ``268435456`` (256 MiB).
+    """
+    if not isinstance(limit, int) or limit < 0:
+        raise ValueError(f"limit should be a non-negative int, but get {limit}.")
+    for module in _modules().values():
+        module.memory_set_pool_limit(limit)
+
+
+def get_memory_pool_limit() -> int:
+    """
+    Get the limit set by :func:`set_memory_pool_limit`.
+
+    Returns:
+        int, the limit in bytes.
+    """
+    return _modules()['mqbackend'].memory_pool_limit()
+
+
+def release_memory_pool():
+    """Return the states kept in the pool of all c++ backends to the OS."""
+    for module in _modules().values():
+        module.memory_release_pool()
+
+
+def reset_peak_memory():
+    """Set the peak memory usage of all c++ backends to their current usage."""
+    for module in _modules().values():
+        module.memory_reset_peak()
+
+
+def get_memory_usage() -> typing.Dict[str, typing.Dict[str, int]]:
+    """
+    Get the current and peak memory usage of the c++ backends.
+
+    Categories are ``'state_vector'``, ``'density_matrix'``, ``'sparse'`` (sparse Hamiltonians), ``'device'`` (GPU
+    memory), ``'mapped'`` (memory mapped files of out-of-core states), ``'total'`` (all host categories) and
+    ``'pool'`` (released states kept for reuse, see :func:`set_memory_pool_limit`). The device and mapped memory are
+    not counted in the total or the budget, nor is the pool. A copy of a simulator shares the state of the original
+    until one of them changes it, so the copy is only accounted for from then on.
+
+    Returns:
+        Dict[str, Dict[str, int]], for every category, the ``'current'`` and ``'peak'`` usage in bytes summed over
+        the backend modules. The summed peak is an upper bound when the modules peak at different times.
+    """
+    out = {}
+    for module in _modules().values():
+        for category, current, peak in module.memory_usage():
+            usage = out.setdefault(category, {'current': 0, 'peak': 0})
+            usage['current'] += current
+            usage['peak'] += peak
+    return out
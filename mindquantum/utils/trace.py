@@ -0,0 +1,135 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Chrome trace of the python and c++ phases of MindQuantum."""
+
+import collections
+import contextlib
+import json
+import os
+import threading
+import time
+import typing
+
+_get_tid = getattr(threading, 'get_native_id', threading.get_ident)
+_DEFAULT_CAPACITY = 1 << 16
+_python_events = collections.deque(maxlen=_DEFAULT_CAPACITY)
+_recording = False
+
+
+def _modules():
+    """Get the c++ modules that record trace events."""
+    # pylint: disable=import-outside-toplevel
+    from mindquantum import mqbackend
+    from mindquantum.simulator.available_simulator import SUPPORTED_SIMULATOR
+
+    out = {'mqbackend': mqbackend.trace}
+    out.update(SUPPORTED_SIMULATOR.unique_modules())
+    return out
+
+
+def start_trace(capacity: int = _DEFAULT_CAPACITY):
+    """
+    Clear the recorded events and start tracing.
+
+    Args:
+        capacity (int): Maximum number of events kept per thread. When exceeded, the oldest events are dropped.
+            Default: ``65536``.
+    """
+    global _python_events, _recording  # pylint: disable=global-statement
+    if capacity <= 0:
+        raise ValueError(f"capacity should be positive, but get {capacity}.")
+    for module in _modules().values():
+        module.trace_start(capacity)
+    _python_events = collections.deque(maxlen=capacity)
+    _recording = True
+
+
+def stop_trace():
+    """Stop tracing, the recorded events are kept."""
+    global _recording  # pylint: disable=global-statement
+    _recording = False
+    for module in _modules().values():
+        module.trace_stop()
+
+
+@contextlib.contextmanager
+def trace_scope(name: str, category: str = 'python'):
+    """
+    Record the enclosed python code as a trace event.
+
+    Can also be used as a function decorator.
+
+    Args:
+        name (str): Name of the event.
+        category (str): Category of the event. Default: ``'python'``.
+    """
+    if not _recording:
+        yield
+        return
+    start = time.monotonic_ns()
+    try:
+        yield
+    finally:
+        _python_events.append((name, category, _get_tid(), start, time.monotonic_ns() - start))
+
+
+def get_trace_events() -> typing.List[typing.Dict]:
+    """
+    Get the events recorded by python and all c++ modules, sorted by start time.
+
+    Returns:
+        List[Dict], events with keys ``'name'``, ``'cat'``, ``'tid'``, ``'start'`` and ``'dur'``. Times are in
+        nanoseconds of the monotonic clock.
+    """
+    raw = list(_python_events)
+    for module in _modules().values():
+        raw.extend(module.trace_events())
+    out = [{'name': n, 'cat': c, 'tid': t, 'start': s, 'dur': d} for n, c, t, s, d in raw]
+    return sorted(out, key=lambda event: event['start'])
+
+
+def dump_trace(filename: str):
+    """
+    Write the recorded events in the Chrome trace event format.
+
+    The file can be opened with ``chrome://tracing`` or https://ui.perfetto.dev.
+
+    Args:
+        filename (str): Path of the json file.
+
+    Examples:
+        >>> from mindquantum.utils.trace import start_trace, stop_trace, dump_trace
+        >>> from mindquantum.simulator import Simulator
+        >>> from mindquantum.algorithm.library import qft
+        >>> start_trace()
+        >>> _ = Simulator('mqvector', 3).apply_circuit(qft(range(3)))
+        >>> stop_trace()
+        >>> dump_trace('mindquantum_trace.json')
+    """
+    pid = os.getpid()
+    events = [
+        {
+            'name': event['name'],
+            'cat': event['cat'],
+            'ph': 'X',
+            'ts': event['start'] / 1e3,
+            'dur': event['dur'] / 1e3,
+            'pid': pid,
+            'tid': event['tid'],
+        }
+        for event in get_trace_events()
+    ]
+    with open(filename, 'w', encoding='utf-8') as file:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ns'}, file)
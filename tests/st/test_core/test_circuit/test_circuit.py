@@ -145,3 +145,18 @@ def test_circuit_operator():
         circ_exp += G.RX(f'l{i}_a').on(i + 1)
         circ_exp += G.X.on(i + 1, i)
     assert circ == circ_exp
+
+
+def test_compiled_cpp_obj():
+    """
+    Description: test compiled cpp object is cached and rebuilt after circuit modification.
+    Expectation: success.
+    """
+    circ = Circuit().h(0).rx('a', 1)
+    compiled = circ.get_compiled_cpp_obj()
+    assert len(compiled) == 2
+    assert circ.get_compiled_cpp_obj() is compiled
+    assert len(circ.get_compiled_cpp_obj(hermitian=True)) == 2
+    circ.x(1, 0)
+    assert circ.get_compiled_cpp_obj() is not compiled
+    assert len(circ.get_compiled_cpp_obj()) == 3
@@ -261,3 +261,44 @@ def test_fsim():
         ]
     )
     assert np.allclose(fsim.matrix({'a': 1.0}), m_exp)
+
+
+def test_rot_pauli_string():
+    """
+    Description: Test rotation gate of pauli string
+    Expectation: success
+    """
+    gate = G.RotPauliString('xyz', 'a').on([0, 1, 2])
+    assert str(gate) == "RPS(XYZ, a|0 1 2)"
+    assert gate != G.RotPauliString('XZY', 'a').on([0, 1, 2])
+    assert gate.hermitian() == G.RotPauliString('XYZ', {'a': -1}).on([0, 1, 2])
+    pauli = np.kron(G.Z.matrix(), np.kron(G.Y.matrix(), G.X.matrix()))
+    assert np.allclose(gate.matrix({'a': 0.8}), expm(-0.4j * pauli))
+    assert np.allclose(G.RotPauliString('XY', 0.8).matrix(), G.Rxy(0.8).matrix())
+    with pytest.raises(ValueError):
+        G.RotPauliString('XA', 1.0)
+
+
+def test_fermion_excitation():
+    """
+    Description: Test fermionic excitation gates
+    Expectation: success
+    """
+    single = G.SingleExcitation('a').on([0, 1])
+    assert str(single) == "SE(a|0 1)"
+    assert single.hermitian() == G.SingleExcitation({'a': -1}).on([0, 1])
+    m_exp = np.array(
+        [
+            [1, 0, 0, 0],
+            [0, np.cos(0.3), np.sin(0.3), 0],
+            [0, -np.sin(0.3), np.cos(0.3), 0],
+            [0, 0, 0, 1],
+        ]
+    )
+    assert np.allclose(single.matrix({'a': 0.3}), m_exp)
+    diff_exp = (single.matrix({'a': 0.3 + 1e-6}) - single.matrix({'a': 0.3 - 1e-6})) / 2e-6
+    assert np.allclose(single.diff_matrix({'a': 0.3}), diff_exp, atol=1e-6)
+    double = G.DoubleExcitation(0.5).on([3, 2, 1, 0])
+    mat = double.matrix()
+    assert np.allclose(mat @ mat.conj().T, np.identity(16))
+    assert np.allclose(mat[15, 15], 1) and np.allclose(abs(mat[12, 3]), np.sin(0.5))
@@ -0,0 +1,98 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# wITHOUT wARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test native OpenQASM parser."""
+
+import numpy as np
+import pytest
+
+from mindquantum import _mq_vector, mqbackend
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.parameterresolver import ParameterResolver as PR
+from mindquantum.io import OpenQASM
+
+
+def test_native_openqasm_match_python_parser():
+    """
+    Description: Test native parser gives the same state as the python parser.
+    Expectation: success.
+    """
+    circ = Circuit().h(0).x(1, 0).rx(0.3, 1).rz(1.2, 0).ry(0.4, 1).z(0, 1)
+    string = OpenQASM().to_string(circ) + '\ncreg c[2];\nmeasure q -> c;'
+    prog = mqbackend.qasm.parse_openqasm(string)
+    assert prog.n_qubits == 2
+    assert prog.clbit_keys == ['c[0]', 'c[1]']
+    assert len(prog.circuit) == len(circ) + 2
+    sim = _mq_vector.double.mqvector(2)
+    sim.apply_circuit(prog.circuit[:-2])
+    expect = circ.get_qs()
+    assert np.allclose(sim.get_qs(), expect, atol=1e-8)
+
+
+def test_native_openqasm_gate_definition():
+    """
+    Description: Test user defined gates, modifiers and input parameters.
+    Expectation: success.
+    """
+    string = """OPENQASM 3;
+include "stdgates.inc";
+input float theta;
+qubit[3] q;
+gate foo(a) x0, x1 { rx(a / 2) x0; cp(2 * a) x0, x1; sx x1; }
+h q;
+ctrl @ foo(theta) q[0], q[1], q[2];
+ctrl @ inv @ foo(theta) q[0], q[1], q[2];
+"""
+    prog = mqbackend.qasm.parse_openqasm(string)
+    assert prog.parameters == ['theta']
+    sim = _mq_vector.double.mqvector(3)
+    sim.apply_circuit(prog.circuit, PR({'theta': 0.7}))
+    assert np.allclose(sim.get_qs(), np.ones(8) / np.sqrt(8), atol=1e-8)
+
+
+def test_native_openqasm_error_line():
+    """
+    Description: Test parse error reports line number.
+    Expectation: raise RuntimeError.
+    """
+    with pytest.raises(RuntimeError, match='<string>:3:'):
+        mqbackend.qasm.parse_openqasm('OPENQASM 2.0;\nqreg q[2];\nfoo q[0];\n')
+
+
+def test_native_openqasm_gphase_in_gate():
+    """
+    Description: Test gphase inside a gate definition acts on the qubits of the gate.
+    Expectation: success.
+    """
+    string = """OPENQASM 3;
+include "stdgates.inc";
+qubit[3] q;
+gate g a { gphase(0.5); x a; }
+g q[2];
+"""
+    prog = mqbackend.qasm.parse_openqasm(string)
+    sim = _mq_vector.double.mqvector(3)
+    sim.apply_circuit(prog.circuit)
+    expect = np.zeros(8, dtype=np.complex128)
+    expect[4] = np.exp(0.5j)
+    assert np.allclose(sim.get_qs(), expect, atol=1e-8)
+
+
+def test_native_openqasm_unterminated_barrier():
+    """
+    Description: Test a barrier in a gate body without ';' at the end of the input.
+    Expectation: raise RuntimeError.
+    """
+    with pytest.raises(RuntimeError, match="expected ';' after barrier"):
+        mqbackend.qasm.parse_openqasm('OPENQASM 3;\nqubit[1] q;\ngate g a { barrier a\n')
@@ -0,0 +1,90 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Circuit generators shared by the simulator tests, given as fixtures."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import RX, RZ, SWAP, H, Rzz, S, T, X, Y, Z
+
+
+def _random_clifford_circuit(n_qubits, n_gates, seed, qubit_map=None):
+    """Generate a random circuit of H, S, S dagger, Pauli, SWAP and singly controlled Pauli gates."""
+    rng = np.random.default_rng(seed)
+    if qubit_map is None:
+        qubit_map = list(range(n_qubits))
+    circ = Circuit()
+    for _ in range(n_gates):
+        qubits = [qubit_map[i] for i in rng.choice(n_qubits, 2, replace=False)]
+        kind = rng.integers(8)
+        if kind < 3:
+            circ += [X, Y, Z][kind].on(qubits[0], qubits[1])
+        elif kind < 6:
+            circ += [H, S, S.hermitian()][kind - 3].on(qubits[0])
+        elif kind == 6:
+            circ += SWAP.on(qubits)
+        else:
+            circ += [X, Y, Z][rng.integers(3)].on(qubits[0])
+    return circ
+
+
+@pytest.fixture(name='random_clifford_circuit')
+def fixture_random_clifford_circuit():
+    """Generator of random Clifford circuits, see _random_clifford_circuit."""
+    return _random_clifford_circuit
+
+
+def _random_near_clifford_circuit(n_qubits, n_gates, n_rotations, seed):
+    """Generate a random Clifford circuit with a few T, RX, RZ and Rzz gates."""
+    rng = np.random.default_rng(seed)
+    circ = Circuit()
+    step = n_gates // n_rotations
+    for i in range(n_gates):
+        qubits = [int(q) for q in rng.choice(n_qubits, 2, replace=False)]
+        if i % step == 0:
+            angle = float(rng.uniform(0, 2 * np.pi))
+            rotations = [T.on(qubits[0]), RX(angle).on(qubits[0]), RZ(angle).on(qubits[0]), Rzz(angle).on(qubits)]
+            circ += rotations[(i // step) % 4]
+            continue
+        kind = rng.integers(6)
+        if kind < 3:
+            circ += [X, Y, Z][kind].on(qubits[0], qubits[1])
+        elif kind < 5:
+            circ += [H, S][kind - 3].on(qubits[0])
+        else:
+            circ += SWAP.on(qubits)
+    return circ
+
+
+@pytest.fixture(name='random_near_clifford_circuit')
+def fixture_random_near_clifford_circuit():
+    """Generator of random Clifford circuits with a few rotations, see _random_near_clifford_circuit."""
+    return _random_near_clifford_circuit
+
+
+def _qaoa_ring(n_qubits, depth):
+    """Generate a QAOA circuit on a ring."""
+    circ = Circuit([H.on(i) for i in range(n_qubits)])
+    for layer in range(depth):
+        circ += Circuit([Rzz(0.4 + 0.1 * layer).on([i, (i + 1) % n_qubits]) for i in range(n_qubits)])
+        circ += Circuit([RX(0.7 - 0.1 * layer).on(i) for i in range(n_qubits)])
+    return circ
+
+
+@pytest.fixture(name='qaoa_ring')
+def fixture_qaoa_ring():
+    """Generator of QAOA circuits on a ring, see _qaoa_ring."""
+    return _qaoa_ring
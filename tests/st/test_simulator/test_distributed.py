@@ -0,0 +1,80 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test distributed simulator."""
+
+import multiprocessing
+import uuid
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.simulator.distributed import DISTRIBUTED_SUPPORTED, DistributedSimulator
+from mindquantum.utils import random_circuit
+
+N_QUBITS = 6
+
+
+def _circuit():
+    """Get the circuit of the test."""
+    circ = random_circuit(N_QUBITS, 200, seed=42)
+    return circ.apply_value({name: 0.1 * i for i, name in enumerate(circ.params_name)})
+
+
+def _hamiltonian():
+    """Get the hamiltonian of the test, with flips of local and global qubits."""
+    return Hamiltonian(QubitOperator('X0 Y5 Z2', 0.7) + QubitOperator('X4') + QubitOperator('Z1 Z3', 1.1))
+
+
+def _run_rank(rank, size, name, queue):
+    """Run the distributed simulator on one rank."""
+    sim = DistributedSimulator(N_QUBITS, rank, size, name)
+    sim.apply_circuit(_circuit())
+    state = sim.get_qs()
+    expectation = sim.get_expectation(_hamiltonian())
+    res = sim.apply_circuit(Circuit().measure(N_QUBITS - 1))
+    queue.put((rank, state, expectation, res.data, np.linalg.norm(sim.get_qs())))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not DISTRIBUTED_SUPPORTED, reason='distributed simulator not available.')
+@pytest.mark.parametrize('size', [1, 2, 4])
+def test_distributed_simulator(size):
+    """
+    Description: Test distributed simulator over shared memory matches mqvector.
+    Expectation: succeed.
+    """
+    ref = Simulator('mqvector', N_QUBITS)
+    ref.apply_circuit(_circuit())
+    exact = ref.get_expectation(_hamiltonian())
+
+    ctx = multiprocessing.get_context('spawn')
+    queue = ctx.Queue()
+    name = f'mq_test_{uuid.uuid4().hex}'
+    procs = [ctx.Process(target=_run_rank, args=(rank, size, name, queue)) for rank in range(size)]
+    for proc in procs:
+        proc.start()
+    results = [queue.get(timeout=120) for _ in range(size)]
+    for proc in procs:
+        proc.join()
+    for _, state, expectation, data, norm in results:
+        assert np.allclose(state, ref.get_qs(), atol=1e-10)
+        assert np.isclose(expectation, exact, atol=1e-10)
+        assert data == results[0][3]
+        assert np.isclose(norm, 1)
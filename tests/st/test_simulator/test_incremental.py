@@ -0,0 +1,61 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test incremental expectation."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import PhaseShift, RotPauliString, RX, RY, Rzz, X
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.simulator.incremental import IncrementalExpectation
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_incremental_expectation():
+    """
+    Description: Test evaluation, reconstruction and Rotosolve sweep of incremental expectation.
+    Expectation: succeed.
+    """
+    circ = Circuit([RX('a').on(0), RY({'b': -2}).on(1), X.on(2, 1), Rzz('c').on([0, 2])])
+    circ += Circuit([RotPauliString('XYZ', 'd').on([1, 2, 3]), PhaseShift('e').on(3, 0), RY('f').on(2)])
+    ham = Hamiltonian(QubitOperator('Z0 Z1') + QubitOperator('X2 Y3', 0.6) + QubitOperator('Z3', -0.3))
+    pr = {'a': 0.1, 'b': 0.7, 'c': -1.2, 'd': 0.4, 'e': 2.0, 'f': 0.3}
+    init = Simulator('mqvector', 4)
+    init.apply_circuit(Circuit([RY(0.5).on(i) for i in range(4)]))
+
+    def full(values):
+        sim = init.copy()
+        sim.apply_circuit(circ, values)
+        return sim.get_expectation(ham).real
+
+    inc = IncrementalExpectation(init, ham, circ, pr)
+    assert np.isclose(inc.get_expectation(), full(pr))
+    for name in inc.parameter_order:
+        amp, phase, const, omega = inc.reconstruct(name)
+        for value in [-1.3, 0.4, 2.9]:
+            ref = full({**pr, name: value})
+            assert np.isclose(inc.evaluate(name, value)[0], ref)
+            assert np.isclose(amp * np.cos(omega * value - phase) + const, ref)
+
+    applied = inc.applied_gates
+    energy = inc.sweep(3)
+    assert energy < full(pr)
+    assert np.isclose(energy, full(inc.get_pr()))
+    # Rotosolve from scratch runs the full circuit three times per parameter.
+    assert inc.applied_gates - applied < 3 * 3 * len(circ) * len(pr) / 2
@@ -0,0 +1,49 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test matrix product state simulator."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator.mps import MPS_SUPPORTED, MPSSimulator
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not MPS_SUPPORTED, reason='mps simulator not available.')
+def test_mps_simulator_many_qubits():
+    """
+    Description: Test mps simulator on a 100 qubits GHZ state and bond truncation.
+    Expectation: succeed.
+    """
+    n_qubits = 100
+    circ = Circuit().h(0)
+    for i in range(n_qubits - 1):
+        circ.x(i + 1, i)
+    sim = MPSSimulator(n_qubits)
+    sim.apply_circuit(circ)
+    assert sim.bond_dims == [2] * (n_qubits - 1)
+    assert np.isclose(sim.amplitude('1' * n_qubits), np.sqrt(0.5))
+    assert np.isclose(sim.get_expectation(Hamiltonian(QubitOperator('Z0 Z99'))), 1)
+    res = sim.sampling(Circuit().measure(0).measure(99), shots=50, seed=1)
+    assert set(res.data.keys()) <= {'00', '11'}
+
+    sim = MPSSimulator(n_qubits, max_bond=1)
+    sim.apply_circuit(circ)
+    assert sim.bond_dims == [1] * (n_qubits - 1)
+    assert np.isclose(sim.truncation_error, 0.5)
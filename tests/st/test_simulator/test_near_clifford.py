@@ -0,0 +1,68 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test near Clifford simulator."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import CNOT, H, Measure, T
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator.near_clifford import (
+    NEAR_CLIFFORD_SUPPORTED,
+    NearCliffordSimulator,
+)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not NEAR_CLIFFORD_SUPPORTED, reason='near clifford simulator not available.')
+def test_near_clifford_simulator_many_qubits():
+    """
+    Description: Test near clifford simulator on 60 qubits and sampling.
+    Expectation: succeed.
+    """
+    n_qubits = 60
+    circ = Circuit([H.on(0), T.on(0)] + [CNOT.on(i + 1, i) for i in range(n_qubits - 1)])
+    sim = NearCliffordSimulator(n_qubits)
+    sim.apply_circuit(circ)
+    assert sim.branch_count == 2
+    all_x = QubitOperator(' '.join(f'X{i}' for i in range(n_qubits)))
+    assert np.isclose(sim.get_expectation(Hamiltonian(all_x)), np.sqrt(0.5))
+    assert np.isclose(sim.get_expectation(Hamiltonian(QubitOperator('Z0 Z59'))), 1)
+    res = sim.sampling(Circuit().measure(0).measure(59), shots=50, seed=1)
+    assert set(res.data.keys()) <= {'00', '11'}
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not NEAR_CLIFFORD_SUPPORTED, reason='near clifford simulator not available.')
+def test_near_clifford_simulator_measure_collapse():
+    """
+    Description: Test random measurements collapse the tableau instead of doubling the branches.
+    Expectation: succeed.
+    """
+    n_qubits = 20
+    sim = NearCliffordSimulator(n_qubits)
+    sim.apply_circuit(Circuit([H.on(i) for i in range(n_qubits)] + [T.on(i) for i in range(3)]))
+    assert sim.branch_count <= 2**3
+    for _ in range(3):
+        for i in range(n_qubits):
+            sim.apply_gate(Measure(f'q{i}').on(i))
+            sim.apply_gate(H.on(i))
+            assert sim.branch_count <= 2**3
+    assert sim.branch_count == 1
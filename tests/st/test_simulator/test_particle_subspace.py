@@ -0,0 +1,107 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test particle subspace simulator."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import ISWAP, RZ, SWAP, DoubleExcitation, FSim, PhaseShift, Rzz, SingleExcitation, T, X
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.simulator.particle_subspace import (
+    PARTICLE_SUBSPACE_SUPPORTED,
+    ParticleSubspaceSimulator,
+)
+
+N_QUBITS = 6
+N_PARTICLES = 3
+
+
+def conserving_circuit():
+    """Generate a parameterized circuit conserving the number of particles."""
+    circ = Circuit()
+    for layer in range(2):
+        for i in range(N_QUBITS - 1):
+            circ += FSim(f'a{layer}{i}', 0.2 * i).on([i, i + 1])
+        circ += Rzz(f'b{layer}').on([0, N_QUBITS - 1])
+    circ += ISWAP.on([1, 4]) + SWAP.on([0, 3], 5) + PhaseShift(0.7).on(2, 1) + T.on(4) + RZ(0.3).on(5)
+    return circ
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not PARTICLE_SUBSPACE_SUPPORTED, reason='particle subspace simulator not available.')
+def test_particle_subspace():
+    """
+    Description: Test state, expectation and hamiltonian application match mqvector.
+    Expectation: succeed.
+    """
+    circ = conserving_circuit()
+    pr = dict(zip(circ.params_name, np.linspace(0.1, 2.0, len(circ.params_name))))
+    ham = Hamiltonian(QubitOperator('X0 Y5 Z2', 0.7) + QubitOperator('X1 X4') + QubitOperator('Z1 Z3', 1.1))
+    ref = Simulator('mqvector', N_QUBITS)
+    ref.apply_circuit(Circuit([X.on(i) for i in range(N_PARTICLES)]) + circ, pr)
+    sim = ParticleSubspaceSimulator(N_QUBITS, N_PARTICLES)
+    assert sim.dim == 20
+    sim.apply_circuit(circ, pr)
+    assert np.allclose(sim.get_qs(), ref.get_qs(), atol=1e-10)
+    assert np.isclose(sim.get_expectation(ham), ref.get_expectation(ham), atol=1e-10)
+
+    full = ham.hamiltonian.matrix(N_QUBITS).toarray() @ ref.get_qs()
+    mask = np.array([bin(i).count('1') == N_PARTICLES for i in range(2**N_QUBITS)])
+    sim.apply_hamiltonian(ham)
+    assert np.allclose(sim.get_qs(), np.where(mask, full, 0), atol=1e-10)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not PARTICLE_SUBSPACE_SUPPORTED, reason='particle subspace simulator not available.')
+def test_particle_subspace_basis():
+    """
+    Description: Test the ranking of the basis states and the rejection of non conserving gates.
+    Expectation: succeed.
+    """
+    sim = ParticleSubspaceSimulator(N_QUBITS, N_PARTICLES)
+    states = [sim.basis_state(i) for i in range(sim.dim)]
+    assert states == sorted(i for i in range(2**N_QUBITS) if bin(i).count('1') == N_PARTICLES)
+    assert np.isclose(sim.amplitude('000111'), 1)
+    assert sim.amplitude('000011') == 0
+    with pytest.raises(ValueError):
+        sim.apply_gate(X.on(0))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not PARTICLE_SUBSPACE_SUPPORTED, reason='particle subspace simulator not available.')
+def test_particle_subspace_excitation():
+    """
+    Description: Test fermionic single and double excitations, with their Jordan-Wigner sign, match mqvector.
+    Expectation: succeed.
+    """
+    circ = Circuit()
+    circ += SingleExcitation('a').on([4, 1])
+    circ += DoubleExcitation('b').on([5, 3, 0, 2])
+    circ += SingleExcitation(0.4).on([0, 5], 3)
+    circ += DoubleExcitation(-0.6).on([2, 4, 5, 1])
+    pr = {'a': 0.7, 'b': 1.1}
+    ref = Simulator('mqvector', N_QUBITS)
+    ref.apply_circuit(Circuit([X.on(i) for i in range(N_PARTICLES)]) + circ, pr)
+    sim = ParticleSubspaceSimulator(N_QUBITS, N_PARTICLES)
+    sim.apply_circuit(circ, pr)
+    assert np.allclose(sim.get_qs(), ref.get_qs(), atol=1e-10)
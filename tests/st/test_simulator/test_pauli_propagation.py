@@ -0,0 +1,76 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test Pauli propagation."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import RY, RZ, T, X
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.simulator.pauli_propagation import (
+    PAULI_PROPAGATOR_SUPPORTED,
+    PauliPropagator,
+)
+
+N_QUBITS = 6
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not PAULI_PROPAGATOR_SUPPORTED, reason='pauli propagator not available.')
+def test_pauli_propagator(qaoa_ring):
+    """
+    Description: Test Pauli propagation matches mqvector, also on a product state.
+    Expectation: succeed.
+    """
+    circ = qaoa_ring(N_QUBITS, 2) + T.on(2) + X.on(4, 1) + RY('a').on(3, 0)
+    pr = {'a': 1.2}
+    ham = Hamiltonian(QubitOperator('X0 Y5 Z2', 0.7) + QubitOperator('X4') + QubitOperator('Z1 Z3', 1.1))
+    ref = Simulator('mqvector', N_QUBITS)
+    ref.apply_circuit(circ, pr)
+    propagator = PauliPropagator(N_QUBITS)
+    assert np.isclose(propagator.get_expectation(ham, circ, pr), ref.get_expectation(ham).real, atol=1e-10)
+
+    angles = np.linspace(0.3, 2.5, N_QUBITS)
+    prepare = Circuit([RY(float(a)).on(i) for i, a in enumerate(angles)])
+    prepare += Circuit([RZ(float(a) / 2).on(i) for i, a in enumerate(angles)])
+    ref.reset()
+    ref.apply_circuit(prepare + circ, pr)
+    propagator.set_product_state([[np.sin(a) * np.cos(a / 2), np.sin(a) * np.sin(a / 2), np.cos(a)] for a in angles])
+    assert np.isclose(propagator.get_expectation(ham, circ, pr), ref.get_expectation(ham).real, atol=1e-10)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not PAULI_PROPAGATOR_SUPPORTED, reason='pauli propagator not available.')
+def test_pauli_propagator_many_qubits(qaoa_ring):
+    """
+    Description: Test a local observable after a 100 qubits QAOA, whose light cone fits in 12 qubits.
+    Expectation: succeed.
+    """
+    ham = Hamiltonian(QubitOperator('Z5 Z6'))
+    ref = Simulator('mqvector', 12)
+    ref.apply_circuit(qaoa_ring(12, 2))
+    propagator = PauliPropagator(100)
+    assert np.isclose(propagator.get_expectation(ham, qaoa_ring(100, 2)), ref.get_expectation(ham).real, atol=1e-10)
+    assert propagator.truncated_weight < 1e-10
+
+    propagator = PauliPropagator(100, coefficient_threshold=1e-3, max_weight=4)
+    value = propagator.get_expectation(ham, qaoa_ring(100, 2))
+    assert abs(value - ref.get_expectation(ham).real) <= propagator.truncated_weight + 1e-10
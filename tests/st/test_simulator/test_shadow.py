@@ -0,0 +1,62 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test classical shadow."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import RX, RY, RZ, X
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.simulator.shadow import CLASSICAL_SHADOW_SUPPORTED, ClassicalShadow
+
+N_QUBITS = 5
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not CLASSICAL_SHADOW_SUPPORTED, reason='classical shadow not available.')
+def test_classical_shadow():
+    """
+    Description: Test classical shadow estimates match the exact expectations within the statistical error.
+    Expectation: succeed.
+    """
+    circ = Circuit([RY(0.3 + 0.4 * i).on(i) for i in range(N_QUBITS)])
+    circ += Circuit([X.on(i + 1, i) for i in range(N_QUBITS - 1)])
+    circ += Circuit([RX(1.1).on(0), RZ(0.6).on(2), RY(-0.8).on(4)])
+    sim = Simulator('mqvector', N_QUBITS)
+    sim.apply_circuit(circ)
+    ops = [QubitOperator('Z0'), QubitOperator('X1 Y2', 0.5), QubitOperator('Z3 Z4'), QubitOperator('', 0.2)]
+    ham = Hamiltonian(sum(ops, QubitOperator()))
+
+    n_snapshots = 40000
+    shadow = ClassicalShadow(N_QUBITS, seed=1)
+    shadow.sample(circ, n_snapshots // 2)
+    shadow.sample(sim, n_snapshots // 4)
+    shadow.sample(sim.get_qs(), n_snapshots // 4)
+    assert shadow.n_snapshots == n_snapshots
+    assert shadow.bases.shape == (n_snapshots, N_QUBITS)
+    assert np.allclose(np.bincount(shadow.bases.ravel(), minlength=3) / (n_snapshots * N_QUBITS), 1 / 3, atol=0.01)
+
+    estimates = shadow.estimate_terms(ham)
+    for op in ops:
+        ((term, coeff),) = op.terms.items()
+        exact = sim.get_expectation(Hamiltonian(op)).real
+        assert abs(estimates[term] - exact) < 5 * abs(coeff.const.real) * 3 ** len(term) / np.sqrt(n_snapshots)
+    assert np.isclose(shadow.estimate_expectation(ham), sim.get_expectation(ham).real, atol=0.1)
+    shadow.clear()
+    assert shadow.n_snapshots == 0
@@ -20,17 +20,23 @@ import subprocess
 
 import numpy as np
 import pytest
+from scipy.linalg import expm
 from scipy.sparse import csr_matrix
 
 import mindquantum as mq
 import mindquantum.core.operators as ops
 from mindquantum.algorithm.library import qft
+from mindquantum.algorithm.nisq import Transform
 from mindquantum.core import gates as G
 from mindquantum.core.circuit import UN, Circuit
 from mindquantum.core.operators import Hamiltonian, QubitOperator
 from mindquantum.core.parameterresolver import ParameterResolver as PR
 from mindquantum.simulator import Simulator, inner_product
 from mindquantum.simulator.available_simulator import SUPPORTED_SIMULATOR
+from mindquantum.simulator.mps import MPS_SUPPORTED, MPSSimulator
+from mindquantum.simulator.near_clifford import NEAR_CLIFFORD_SUPPORTED, NearCliffordSimulator
+from mindquantum.simulator.sparse import SPARSE_SUPPORTED, SparseSimulator
+from mindquantum.simulator.stabilizer import STABILIZER_SUPPORTED, StabilizerSimulator
 from mindquantum.utils import random_circuit
 
 _HAS_MINDSPORE = True
@@ -603,6 +609,95 @@ def test_cd_term(config):
         assert np.allclose(m, np.zeros_like(m), atol=1e-6)
 
 
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("config", list(SUPPORTED_SIMULATOR))
+def test_rot_pauli_string(config):
+    """
+    Description: test the native pauli string rotation against its matrix, decomposition and gradient.
+    Expectation: success.
+    """
+    virtual_qc, dtype = config
+    if virtual_qc == 'mqmatrix':
+        return
+    atol = 1e-6 if dtype == mq.complex64 else 1e-10
+    init = Circuit([G.RY(0.3 * i + 0.1).on(i) for i in range(5)]) + G.X.on(1, 4) + G.RX(0.7).on(2)
+    for paulis, objs, ctrls in [('XYZ', [3, 0, 2], []), ('YYXZ', [1, 4, 0, 3], [2]), ('ZZ', [4, 1], [0, 3])]:
+        gate = G.RotPauliString(paulis, 1.3).on(objs, ctrls)
+        sim = Simulator(virtual_qc, 5, dtype=dtype)
+        sim.apply_circuit(init + gate)
+        ref = Simulator(virtual_qc, 5, dtype=dtype)
+        ref.apply_circuit(init + gate.__decompose__()[0])
+        assert np.allclose(sim.get_qs(), ref.get_qs(), atol=atol)
+        qs = init.get_qs()
+        assert np.allclose(sim.get_qs(), (Circuit() + gate).matrix() @ qs, atol=atol)
+
+    ham = Hamiltonian((QubitOperator('X0 Y1 Z3') + QubitOperator('Z2 X4', 0.5)).astype(dtype))
+    circ = init + G.RotPauliString('XYZY', 'a').on([3, 0, 2, 1], 4) + G.RotPauliString('ZX', 'b').on([2, 4])
+    sim = Simulator(virtual_qc, 5, dtype=dtype)
+    grad_ops = sim.get_expectation_with_grad(ham, circ)
+    p0 = np.array([0.4, -1.1])
+    f, g = grad_ops(p0)
+    eps = 1e-4
+    for i in range(2):
+        shift = np.zeros(2)
+        shift[i] = eps
+        f_p, _ = grad_ops(p0 + shift)
+        f_m, _ = grad_ops(p0 - shift)
+        assert np.allclose(g[0, 0, i], (f_p[0, 0] - f_m[0, 0]) / 2 / eps, atol=1e-3 if dtype == mq.complex64 else 1e-6)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("config", list(SUPPORTED_SIMULATOR))
+def test_fermion_excitation(config):
+    """
+    Description: test fermionic excitation gates against the Jordan-Wigner form and their gradient.
+    Expectation: success.
+    """
+    virtual_qc, dtype = config
+    if virtual_qc == 'mqmatrix':
+        sim = Simulator(virtual_qc, 6, dtype=dtype)
+        for gate in [G.SingleExcitation(0.7).on([4, 1]), G.DoubleExcitation('a').on([5, 1, 4, 0])]:
+            with pytest.raises(ValueError, match='not supported by the density matrix simulator'):
+                sim.apply_circuit(Circuit([gate]), pr={'a': 0.3})
+        return
+    atol = 1e-6 if dtype == mq.complex64 else 1e-10
+    init = Circuit([G.RY(0.4 * i + 0.2).on(i) for i in range(6)]) + G.X.on(2, 5) + G.RX(0.3).on(4)
+    for gate, term in [
+        (G.SingleExcitation(0.7).on([4, 1]), '4^ 1'),
+        (G.SingleExcitation(0.7).on([0, 5], 3), '0^ 5'),
+        (G.DoubleExcitation(1.1).on([5, 1, 4, 0]), '5^ 1^ 4 0'),
+        (G.DoubleExcitation(-0.6).on([2, 3, 0, 5]), '2^ 3^ 0 5'),
+    ]:
+        sim = Simulator(virtual_qc, 6, dtype=dtype)
+        sim.apply_circuit(init + gate)
+        generator = ops.FermionOperator(term)
+        generator = Transform(generator - generator.hermitian()).jordan_wigner()
+        unitary = expm(gate.coeff.const * generator.matrix(6).toarray())
+        if gate.ctrl_qubits:
+            mask = np.array([(i >> gate.ctrl_qubits[0]) & 1 for i in range(64)])
+            unitary = np.diag(1 - mask) + unitary * np.outer(mask, mask)
+        assert np.allclose(sim.get_qs(), unitary @ init.get_qs(), atol=atol)
+
+    ham = Hamiltonian((QubitOperator('Z0 Z3') + QubitOperator('X1 Y2', 0.5)).astype(dtype))
+    circ = init + G.DoubleExcitation('a').on([1, 3, 0, 5]) + G.SingleExcitation('b').on([2, 4], 0)
+    grad_ops = Simulator(virtual_qc, 6, dtype=dtype).get_expectation_with_grad(ham, circ)
+    p0 = np.array([0.9, -0.4])
+    _, g = grad_ops(p0)
+    eps = 1e-4
+    for i in range(2):
+        shift = np.zeros(2)
+        shift[i] = eps
+        f_p, _ = grad_ops(p0 + shift)
+        f_m, _ = grad_ops(p0 - shift)
+        assert np.allclose(g[0, 0, i], (f_p[0, 0] - f_m[0, 0]) / 2 / eps, atol=1e-3 if dtype == mq.complex64 else 1e-6)
+
+
 def custom_matrix(x):
     """Define matrix."""
     return np.array(
@@ -692,3 +787,335 @@ def test_non_hermitian_expectation(virtual_qc, dtype):
     sim1.apply_hamiltonian(ham)
     e2 = inner_product(sim2, sim1)
     assert np.allclose(e1, e2)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("dtype", [mq.complex64, mq.complex128])
+def test_qs_view(dtype):
+    """
+    Description: Test numpy view of quantum state shares memory with simulator.
+    Expectation: succeed.
+    """
+    sim = Simulator('mqvector', 2, dtype=dtype)
+    qs = sim.get_qs()
+    assert qs.dtype == mq.to_np_type(dtype)
+    assert np.allclose(qs, [1, 0, 0, 0])
+    assert sim.backend.sim.is_zero_state()
+    view = sim.get_qs_view()
+    assert not view.flags.writeable
+    sim.apply_circuit(Circuit().h(0).x(1, 0))
+    assert np.allclose(view, sim.get_qs())
+    sim.apply_hamiltonian(Hamiltonian(QubitOperator('Z0'), dtype=dtype))
+    assert np.allclose(view, np.array([1, 0, 0, -1]) / np.sqrt(2))
+    w_view = sim.get_qs_view(writable=True)
+    w_view[:] = np.array([0, 1, 0, 0])
+    assert np.allclose(sim.get_qs(), [0, 1, 0, 0])
+    sim.reset()
+    assert np.allclose(view, [1, 0, 0, 0])
+    del sim
+    assert np.allclose(view, [1, 0, 0, 0])
+    sim = Simulator('mqvector', 2, dtype=dtype)
+    sim.set_qs(np.array([1, 1j, 0, 0]))
+    assert np.allclose(sim.get_qs(), np.array([1, 1j, 0, 0]) / np.sqrt(2))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("config", list(SUPPORTED_SIMULATOR))
+def test_simulator_in_threads(config):
+    """
+    Description: Test independent simulators give the same result when driven from several python threads.
+    Expectation: succeed.
+    """
+    # pylint: disable=import-outside-toplevel
+    from concurrent.futures import ThreadPoolExecutor
+
+    virtual_qc, dtype = config
+    circ = random_circuit(6, 40, seed=42)
+    ham = Hamiltonian(QubitOperator('Z0 Y3') + QubitOperator('X5'), dtype=dtype)
+
+    def run(seed):
+        sim = Simulator(virtual_qc, circ.n_qubits, dtype=dtype, seed=seed)
+        sim.apply_circuit(circ)
+        return sim.get_expectation(ham)
+
+    expect = run(0)
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        results = list(executor.map(run, range(8)))
+    assert np.allclose(results, expect, atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("dtype", [mq.complex64, mq.complex128])
+def test_submit(dtype):
+    """
+    Description: Test asynchronous expectation, gradient and sampling give the same result as synchronous ones.
+    Expectation: succeed.
+    """
+    # pylint: disable=import-outside-toplevel
+    import asyncio
+
+    sim = Simulator('mqvector', 3, dtype=dtype, seed=1)
+    sim.apply_circuit(Circuit().h(0).x(1, 0))
+    ham = Hamiltonian(QubitOperator('Z0 Z1') + QubitOperator('X2'), dtype=dtype)
+    circ = Circuit().rx('a', 2).ry('b', 0)
+    pr = {'a': 0.4, 'b': 1.3}
+    future = sim.submit_get_expectation(ham, circ, pr)
+    assert np.allclose(future.result(), sim.get_expectation(ham, circ, pr=pr), atol=1e-5)
+    assert future.done() and not future.cancelled()
+
+    grad_ops = sim.get_expectation_with_grad(ham, circ)
+    f, g = grad_ops.submit(np.array([0.4, 1.3])).result()
+    f_exp, g_exp = grad_ops(np.array([0.4, 1.3]))
+    assert np.allclose(f, f_exp, atol=1e-5)
+    assert np.allclose(g, g_exp, atol=1e-5)
+
+    m_circ = circ + G.Measure('q0').on(0) + G.Measure('q2').on(2)
+    res = sim.submit_sampling(m_circ, pr, shots=50, seed=42).result()
+    assert res.data == sim.sampling(m_circ, pr, shots=50, seed=42).data
+
+    async def gather():
+        return await asyncio.gather(*[sim.submit_get_expectation(ham, circ, pr) for _ in range(4)])
+
+    assert np.allclose(asyncio.run(gather()), sim.get_expectation(ham, circ, pr=pr), atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_profiler():
+    """
+    Description: Test the simulator profiler records gate application and gradient phases when it is enabled.
+    Expectation: succeed.
+    """
+    # pylint: disable=import-outside-toplevel
+    from mindquantum.simulator.profiler import get_profile, profiler_enabled, reset_profile
+
+    reset_profile()
+    sim = Simulator('mqvector', 2)
+    circ = Circuit().h(0).rx('a', 1)
+    grad_ops = sim.get_expectation_with_grad(Hamiltonian(QubitOperator('Z1')), circ)
+    grad_ops(np.array([0.3]))
+    records = get_profile('mqvector')
+    if not profiler_enabled():
+        assert not records
+        return
+    phases = {(r['phase'], r['gate']) for r in records if r['n_qubits'] == 2}
+    assert ('apply_gate', 'H') in phases
+    assert ('apply_gate', 'RX') in phases
+    assert ('gradient', 'RX') in phases
+    assert ('jacobian', 'RX') in phases
+    assert all(r['calls'] > 0 for r in records)
+    reset_profile()
+    assert not get_profile('mqvector')
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif('mqvector_mixed' not in SUPPORTED_SIMULATOR.sims, reason='mqvector_mixed not available.')
+def test_mixed_precision():
+    """
+    Description: Test mixed precision simulator matches double precision, with and without renormalization.
+    Expectation: succeed.
+    """
+    circ = random_circuit(8, 600, seed=42)
+    circ = circ.apply_value({name: 0.1 * i for i, name in enumerate(circ.params_name)})
+    ham = QubitOperator('Z0 Z3') + QubitOperator('X5', 0.5)
+    exact = Simulator('mqvector', 8).get_expectation(Hamiltonian(ham), circ)
+
+    sim = Simulator('mqvector_mixed', 8)
+    assert sim.dtype == mq.complex64
+    sim.backend.set_renormalization(50)
+    sim.apply_circuit(circ)
+    assert np.isclose(np.linalg.norm(sim.get_qs()), 1, atol=1e-6)
+    assert np.isclose(sim.get_expectation(Hamiltonian(ham, dtype=mq.complex64)), exact, atol=1e-5)
+    assert sim.astype(mq.complex128).backend.name == 'mqvector'
+    assert sim.copy().backend.sim.get_renormalization() == 50
+
+    circ = Circuit().rx('a', 0).ry('b', 1).x(1, 0)
+    ham = QubitOperator('Z0 X1')
+    pr = np.array([0.3, 1.2])
+    grad_ops = Simulator('mqvector_mixed', 2).get_expectation_with_grad(Hamiltonian(ham, dtype=mq.complex64), circ)
+    f_mixed, g_mixed = grad_ops(pr)
+    f_exact, g_exact = Simulator('mqvector', 2).get_expectation_with_grad(Hamiltonian(ham), circ)(pr)
+    assert np.allclose(f_mixed, f_exact, atol=1e-6)
+    assert np.allclose(g_mixed, g_exact, atol=1e-6)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif('mqvector_mixed' not in SUPPORTED_SIMULATOR.sims, reason='mqvector_mixed not available.')
+def test_mixed_precision_deep_pauli_rotation():
+    """
+    Description: Test a deep Rxx, Ryy, Rzz circuit drifts in complex64 but not in the mixed precision simulator.
+    Expectation: succeed.
+    """
+    n_qubits = 10
+    circ = UN(G.H, n_qubits)
+    for layer in range(400):
+        gate = [G.Rxx, G.Ryy, G.Rzz][layer % 3]
+        for i in range(n_qubits):
+            circ += gate(0.0123456789).on([i, (i + 1) % n_qubits])
+    exact = Simulator('mqvector', n_qubits)
+    exact.apply_circuit(circ)
+    single = Simulator('mqvector', n_qubits, dtype=mq.complex64)
+    single.apply_circuit(circ)
+    mixed = Simulator('mqvector_mixed', n_qubits)
+    mixed.apply_circuit(circ)
+
+    drift_single = abs(np.linalg.norm(single.get_qs()) - 1)
+    drift_mixed = abs(np.linalg.norm(mixed.get_qs()) - 1)
+    assert drift_single > 1e-5
+    assert drift_mixed < 1e-6
+    assert np.allclose(mixed.get_qs(), exact.get_qs(), atol=1e-5)
+    assert not np.allclose(single.get_qs(), exact.get_qs(), atol=1e-5)
+
+    circ += G.Rzz('a').on([0, 1])
+    circ += G.Rxx('b').on([3, 4])
+    ham = QubitOperator('Z0 Z1') + QubitOperator('X3 Y4', 0.5)
+    pr = np.array([0.7, -0.4])
+    grad_ops = Simulator('mqvector_mixed', n_qubits).get_expectation_with_grad(
+        Hamiltonian(ham, dtype=mq.complex64), circ
+    )
+    f_mixed, g_mixed = grad_ops(pr)
+    f_exact, g_exact = Simulator('mqvector', n_qubits).get_expectation_with_grad(Hamiltonian(ham), circ)(pr)
+    assert np.allclose(f_mixed, f_exact, atol=1e-5)
+    assert np.allclose(g_mixed, g_exact, atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif('mqvector_ooc' not in SUPPORTED_SIMULATOR.sims, reason='mqvector_ooc not available.')
+def test_out_of_core():
+    """
+    Description: Test out-of-core simulator with small chunks matches mqvector.
+    Expectation: succeed.
+    """
+    circ = random_circuit(8, 300, seed=42)
+    circ = circ.apply_value({name: 0.1 * i for i, name in enumerate(circ.params_name)})
+    ham = Hamiltonian(QubitOperator('Z0 Z7') + QubitOperator('X5', 0.5))
+    ref = Simulator('mqvector', 8)
+    ref.apply_circuit(circ)
+
+    sim = Simulator('mqvector_ooc', 8)
+    sim.backend.set_chunk_qubits(3)
+    sim.apply_circuit(circ)
+    assert np.allclose(sim.get_qs(), ref.get_qs(), atol=1e-10)
+    assert np.isclose(sim.get_expectation(ham), ref.get_expectation(ham), atol=1e-10)
+    assert np.allclose(sim.copy().get_qs(), ref.get_qs(), atol=1e-10)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("config", list(SUPPORTED_SIMULATOR))
+def test_save_load_state(config, tmp_path):
+    """
+    Description: Test a checkpoint restores the quantum state and the random state.
+    Expectation: succeed.
+    """
+    virtual_qc, dtype = config
+    if virtual_qc == 'mqvector_gpu':
+        return
+    circ = Circuit().h(0).x(1, 0).rx(0.3, 2).measure(2)
+    sim = Simulator(virtual_qc, 3, dtype=dtype, seed=7)
+    sim.apply_circuit(circ)
+    filename = tmp_path / 'state.mq'
+    sim.save_state(filename)
+    other = Simulator(virtual_qc, 3, dtype=dtype, seed=1)
+    other.load_state(filename)
+    assert np.allclose(other.get_qs(), sim.get_qs())
+    measure = Circuit().measure(0).measure(1)
+    assert sim.apply_circuit(measure).data == other.apply_circuit(measure).data
+    with pytest.raises(ValueError):
+        Simulator(virtual_qc, 2, dtype=dtype).load_state(filename)
+
+
+_NATIVE_BACKENDS = [
+    pytest.param('sparse', marks=pytest.mark.skipif(not SPARSE_SUPPORTED, reason='sparse simulator not available.')),
+]
+
+
+_NATIVE_BACKENDS = [
+    pytest.param('sparse', marks=pytest.mark.skipif(not SPARSE_SUPPORTED, reason='sparse simulator not available.')),
+    pytest.param('mps', marks=pytest.mark.skipif(not MPS_SUPPORTED, reason='mps simulator not available.')),
+]
+
+
+_NATIVE_BACKENDS = [
+    pytest.param('sparse', marks=pytest.mark.skipif(not SPARSE_SUPPORTED, reason='sparse simulator not available.')),
+    pytest.param('mps', marks=pytest.mark.skipif(not MPS_SUPPORTED, reason='mps simulator not available.')),
+    pytest.param(
+        'stabilizer',
+        marks=pytest.mark.skipif(not STABILIZER_SUPPORTED, reason='stabilizer simulator not available.'),
+    ),
+]
+
+
+_NATIVE_BACKENDS = [
+    pytest.param('sparse', marks=pytest.mark.skipif(not SPARSE_SUPPORTED, reason='sparse simulator not available.')),
+    pytest.param('mps', marks=pytest.mark.skipif(not MPS_SUPPORTED, reason='mps simulator not available.')),
+    pytest.param(
+        'stabilizer',
+        marks=pytest.mark.skipif(not STABILIZER_SUPPORTED, reason='stabilizer simulator not available.'),
+    ),
+    pytest.param(
+        'near_clifford',
+        marks=pytest.mark.skipif(not NEAR_CLIFFORD_SUPPORTED, reason='near clifford simulator not available.'),
+    ),
+]
+
+
+def _native_backend_case(backend, random_clifford_circuit, random_near_clifford_circuit):
+    """Get the simulator class, circuit and parameters to check a standalone backend against mqvector."""
+    if backend == 'stabilizer':
+        return StabilizerSimulator, random_clifford_circuit(6, 100, seed=42), None
+    if backend == 'near_clifford':
+        return NearCliffordSimulator, random_near_clifford_circuit(6, 100, 10, seed=42), None
+    circ = random_circuit(6, 100, seed=42)
+    sim_cls = {'sparse': SparseSimulator, 'mps': MPSSimulator}[backend]
+    return sim_cls, circ, {name: 0.1 * i for i, name in enumerate(circ.params_name)}
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("backend", _NATIVE_BACKENDS)
+def test_native_backend_equivalence(backend, random_clifford_circuit, random_near_clifford_circuit):
+    """
+    Description: Test the standalone simulators match mqvector on the same random circuit.
+    Expectation: succeed.
+    """
+    sim_cls, circ, pr = _native_backend_case(backend, random_clifford_circuit, random_near_clifford_circuit)
+    ham = Hamiltonian(QubitOperator('X0 Y5 Z2', 0.7) + QubitOperator('X4') + QubitOperator('Z1 Z3', 1.1))
+    ref = Simulator('mqvector', 6)
+    ref.apply_circuit(circ, pr)
+    ref_qs = ref.get_qs()
+    expect = ref.get_expectation(ham)
+
+    sim = sim_cls(6)
+    if pr is None:
+        sim.apply_circuit(circ)
+    else:
+        sim.apply_circuit(circ, pr)
+    assert np.isclose(sim.get_expectation(ham), expect, atol=1e-10)
+    assert np.isclose(sim.copy().get_expectation(ham), expect, atol=1e-10)
+    if hasattr(sim, 'get_qs'):
+        assert np.allclose(sim.get_qs(), ref_qs, atol=1e-10)
+    if backend == 'mps':
+        assert max(sim.bond_dims) <= 2**3
+    if backend == 'near_clifford':
+        assert sim.branch_count <= 2**10
+
+    res = sim.sampling(UN(G.Measure(), range(6)), shots=50, seed=1)
+    assert all(abs(ref_qs[int(key, 2)]) > 1e-8 for key in res.data)
+    sim.reset()
+    assert np.isclose(sim.get_expectation(Hamiltonian(QubitOperator('Z0'))), 1, atol=1e-10)
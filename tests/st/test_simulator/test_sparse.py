@@ -0,0 +1,102 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test sparse simulator."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.simulator.sparse import SPARSE_SUPPORTED, SparseSimulator
+from mindquantum.utils import random_circuit
+
+N_QUBITS = 6
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not SPARSE_SUPPORTED, reason='sparse simulator not available.')
+def test_sparse_simulator_dense():
+    """
+    Description: Test sparse simulator matches mqvector after the conversion to a dense state.
+    Expectation: succeed.
+    """
+    circ = random_circuit(N_QUBITS, 100, seed=42)
+    circ = circ.apply_value({name: 0.1 * i for i, name in enumerate(circ.params_name)})
+    ham = Hamiltonian(QubitOperator('X0 Y5 Z2', 0.7) + QubitOperator('X4') + QubitOperator('Z1 Z3', 1.1))
+    ref = Simulator('mqvector', N_QUBITS)
+    ref.apply_circuit(circ)
+    sim = SparseSimulator(N_QUBITS)
+    sim.set_dense_threshold(0.25)
+    sim.apply_circuit(circ)
+    assert sim.is_dense
+    assert np.allclose(sim.get_qs(), ref.get_qs(), atol=1e-10)
+    assert np.isclose(sim.get_expectation(ham), ref.get_expectation(ham), atol=1e-10)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not SPARSE_SUPPORTED, reason='sparse simulator not available.')
+def test_sparse_simulator_many_qubits():
+    """
+    Description: Test sparse simulator on a 60 qubits reversible circuit with one superposition.
+    Expectation: succeed.
+    """
+    circ = Circuit().h(59)
+    for i in range(30):
+        circ.x(i)
+        circ.x(30 + i, [i, 59])
+    sim = SparseSimulator(60)
+    sim.apply_circuit(circ)
+    amps = sim.amplitudes()
+    assert sim.size == 2 and not sim.is_dense
+    assert [i for i, _ in amps] == [(1 << 30) - 1, (1 << 60) - 1]
+    assert np.allclose([a for _, a in amps], np.sqrt(0.5))
+    res = sim.sampling(Circuit().measure(59).measure(45), shots=100, seed=1)
+    assert set(res.data.keys()) <= {'00', '11'}
+    assert sim.size == 2
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not SPARSE_SUPPORTED, reason='sparse simulator not available.')
+def test_sparse_simulator_high_qubits():
+    """
+    Description: Test Y and Z phases of Pauli terms and rotations on qubits above 32.
+    Expectation: succeed.
+    """
+
+    def build(q):
+        circ = Circuit().h(q[0]).rx(0.3, q[1]).ry(1.1, q[2]).x(q[3], q[0]).s(q[3])
+        circ.ryy(0.7, [q[1], q[4]]).ry(0.5, q[5]).x(q[4], q[2]).rz(0.9, q[3]).rxx(0.4, [q[5], q[0]])
+        return circ
+
+    qubit_map = [33, 40, 47, 55, 60, 62]
+    ref = Simulator('mqvector', N_QUBITS)
+    ref.apply_circuit(build(list(range(N_QUBITS))))
+    sim = SparseSimulator(63)
+    sim.apply_circuit(build(qubit_map))
+    ref_qs = ref.get_qs()
+    for index, amp in sim.amplitudes():
+        compact = sum(1 << i for i, q in enumerate(qubit_map) if index >> q & 1)
+        assert np.isclose(amp, ref_qs[compact], atol=1e-10)
+    for term in ['Y0 Y1 Z2', 'Z3 Y4', 'Y0 Y2 Y3 Y5', 'X1 Z2 Y3 Z4 X5']:
+        high_term = ' '.join(f'{p[0]}{qubit_map[int(p[1:])]}' for p in term.split())
+        expect = sim.get_expectation(Hamiltonian(QubitOperator(high_term)))
+        assert np.isclose(expect, ref.get_expectation(Hamiltonian(QubitOperator(term))), atol=1e-10)
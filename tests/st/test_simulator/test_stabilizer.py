@@ -0,0 +1,97 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test stabilizer simulator."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import T
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.simulator.stabilizer import STABILIZER_SUPPORTED, StabilizerSimulator
+
+N_QUBITS = 6
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not STABILIZER_SUPPORTED, reason='stabilizer simulator not available.')
+def test_stabilizer_simulator_generators(random_clifford_circuit):
+    """
+    Description: Test the stabilizer generators of a random Clifford circuit and the rejection of T.
+    Expectation: succeed.
+    """
+    circ = random_clifford_circuit(N_QUBITS, 100, seed=42)
+    ref = Simulator('mqvector', N_QUBITS)
+    ref.apply_circuit(circ)
+    sim = StabilizerSimulator(N_QUBITS)
+    sim.apply_circuit(circ)
+    for stabilizer in sim.stabilizers:
+        term = ' '.join(f'{p}{i}' for i, p in enumerate(stabilizer[1:]) if p != 'I')
+        sign = -1 if stabilizer[0] == '-' else 1
+        assert np.isclose(ref.get_expectation(Hamiltonian(QubitOperator(term, sign))), 1, atol=1e-10)
+    with pytest.raises(ValueError):
+        sim.apply_gate(T.on(0))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not STABILIZER_SUPPORTED, reason='stabilizer simulator not available.')
+def test_stabilizer_simulator_sampling():
+    """
+    Description: Test Pauli frame sampling of a 500 qubits GHZ state.
+    Expectation: succeed.
+    """
+    n_qubits = 500
+    circ = Circuit().h(0)
+    for i in range(n_qubits - 1):
+        circ.x(i + 1, i)
+    sim = StabilizerSimulator(n_qubits)
+    sim.apply_circuit(circ)
+    assert np.isclose(sim.get_expectation(Hamiltonian(QubitOperator('Z0 Z499'))), 1)
+    res = sim.sampling(Circuit().measure(0).measure(250).measure(499), shots=1000, seed=1)
+    assert set(res.data.keys()) == {'000', '111'}
+    assert 400 < res.data['000'] < 600
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not STABILIZER_SUPPORTED, reason='stabilizer simulator not available.')
+def test_stabilizer_simulator_high_qubits(random_clifford_circuit):
+    """
+    Description: Test Y and Z phases on qubits above 32 and across the 64 bits word boundary.
+    Expectation: succeed.
+    """
+    qubit_map = [33, 40, 47, 63, 64, 70]
+    circ = random_clifford_circuit(N_QUBITS, 100, seed=7)
+    high_circ = random_clifford_circuit(N_QUBITS, 100, seed=7, qubit_map=qubit_map)
+    ref = Simulator('mqvector', N_QUBITS)
+    ref.apply_circuit(circ)
+    sim = StabilizerSimulator(72)
+    sim.apply_circuit(high_circ)
+    for stabilizer in sim.stabilizers:
+        paulis = stabilizer[1:]
+        if all(paulis[i] == 'I' for i in qubit_map):
+            continue
+        assert all(p == 'I' for i, p in enumerate(paulis) if i not in qubit_map)
+        term = ' '.join(f'{paulis[q]}{i}' for i, q in enumerate(qubit_map) if paulis[q] != 'I')
+        high_term = ' '.join(f'{paulis[q]}{q}' for q in qubit_map if paulis[q] != 'I')
+        sign = -1 if stabilizer[0] == '-' else 1
+        assert np.isclose(ref.get_expectation(Hamiltonian(QubitOperator(term, sign))), 1, atol=1e-10)
+        assert np.isclose(sim.get_expectation(Hamiltonian(QubitOperator(high_term, sign))), 1, atol=1e-10)
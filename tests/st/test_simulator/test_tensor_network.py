@@ -0,0 +1,72 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test tensor network simulator."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import RY, SWAP, H, T, X
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.simulator.tensor_network import (
+    TENSOR_NETWORK_SUPPORTED,
+    TensorNetworkSimulator,
+)
+
+N_QUBITS = 6
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not TENSOR_NETWORK_SUPPORTED, reason='tensor network simulator not available.')
+@pytest.mark.parametrize("max_rank", [6, 26])
+def test_tensor_network(max_rank, qaoa_ring):
+    """
+    Description: Test amplitudes and expectations match mqvector, with and without slicing.
+    Expectation: succeed.
+    """
+    circ = qaoa_ring(N_QUBITS, 2) + T.on(2) + X.on(4, [1, 3]) + RY('a').on(3, 0) + SWAP.on([0, 5])
+    pr = {'a': 1.2}
+    ham = Hamiltonian(QubitOperator('X0 Y5 Z2', 0.7) + QubitOperator('X4') + QubitOperator('Z1 Z3', 1.1))
+    ref = Simulator('mqvector', N_QUBITS)
+    ref.apply_circuit(circ, pr)
+    qs = ref.get_qs()
+    sim = TensorNetworkSimulator(N_QUBITS, max_rank=max_rank)
+    bits = [format(i, f'0{N_QUBITS}b') for i in (0, 5, 37, 63)]
+    assert np.allclose(sim.get_amplitudes(circ, bits, pr), [qs[int(b, 2)] for b in bits], atol=1e-10)
+    assert np.isclose(sim.get_expectation(ham, circ, pr), ref.get_expectation(ham), atol=1e-10)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not TENSOR_NETWORK_SUPPORTED, reason='tensor network simulator not available.')
+def test_tensor_network_many_qubits(qaoa_ring):
+    """
+    Description: Test a local observable and an amplitude after a 60 qubits QAOA.
+    Expectation: succeed.
+    """
+    ham = Hamiltonian(QubitOperator('Z5 Z6'))
+    ref = Simulator('mqvector', 12)
+    ref.apply_circuit(qaoa_ring(12, 2))
+    sim = TensorNetworkSimulator(60)
+    assert np.isclose(sim.get_expectation(ham, qaoa_ring(60, 2)), ref.get_expectation(ham), atol=1e-10)
+
+    # Amplitude of the all zero state of a product of H, |<0|+>|^2 = 1 / 2 per qubit.
+    amp = sim.get_amplitudes(Circuit([H.on(i) for i in range(60)]), '0' * 60)
+    assert np.isclose(amp[0], 2 ** -30, atol=1e-20)
+    assert sim.last_path['max_rank'] <= 26
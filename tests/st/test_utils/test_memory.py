@@ -0,0 +1,97 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test memory accounting and budget."""
+
+import numpy as np
+import pytest
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.utils.memory import (
+    get_memory_budget,
+    get_memory_pool_limit,
+    get_memory_usage,
+    release_memory_pool,
+    reset_peak_memory,
+    set_memory_budget,
+    set_memory_pool_limit,
+)
+
+
+def test_memory_usage():
+    """
+    Description: Test state memory is accounted and released.
+    Expectation: succeed.
+    """
+    reset_peak_memory()
+    before = get_memory_usage()['state_vector']['current']
+    sim = Simulator('mqvector', 10)
+    sim.apply_circuit(Circuit().h(0))
+    usage = get_memory_usage()['state_vector']
+    assert usage['current'] - before == 16 * 2**10
+    assert usage['peak'] >= usage['current']
+    del sim
+    assert get_memory_usage()['state_vector']['current'] == before
+
+
+def test_memory_budget():
+    """
+    Description: Test gradients shrink to the budget and allocations beyond it fail cleanly.
+    Expectation: succeed.
+    """
+    circ = Circuit().h(0).rx('a', 1).ry('b', 0)
+    hams = [Hamiltonian(QubitOperator(f'Z{i % 2}')) for i in range(6)]
+    sim = Simulator('mqvector', 8)
+    sim.apply_circuit(Circuit().h(0))
+    expect = sim.get_expectation_with_grad(hams, circ)(np.array([0.3, 0.5]))
+    try:
+        # Room for the gradient with a single Hamiltonian state alive at a time.
+        set_memory_budget(get_memory_usage()['total']['current'] + 4 * 16 * 2**8)
+        assert get_memory_budget() is not None
+        grad = sim.get_expectation_with_grad(hams, circ)(np.array([0.3, 0.5]))
+        assert np.allclose(grad[0], expect[0])
+        assert np.allclose(grad[1], expect[1])
+        with pytest.raises(MemoryError):
+            Simulator('mqvector', 12).set_qs(np.ones(2**12) / 2**6)
+    finally:
+        set_memory_budget(None)
+    assert get_memory_budget() is None
+
+
+def test_copy_on_write_and_pool():
+    """
+    Description: Test a copy shares the state until written and released states are pooled.
+    Expectation: succeed.
+    """
+    release_memory_pool()
+    sim = Simulator('mqvector', 10)
+    sim.apply_circuit(Circuit().h(0))
+    before = get_memory_usage()['state_vector']['current']
+    other = sim.copy()
+    assert get_memory_usage()['state_vector']['current'] == before
+    other.apply_circuit(Circuit().x(1))
+    assert get_memory_usage()['state_vector']['current'] == before + 16 * 2**10
+    expect = np.zeros(2**10)
+    expect[:2] = 1 / np.sqrt(2)
+    assert np.allclose(sim.get_qs(), expect)
+    del other
+    assert get_memory_usage()['pool']['current'] >= 16 * 2**10
+    limit = get_memory_pool_limit()
+    try:
+        set_memory_pool_limit(0)
+        assert get_memory_usage()['pool']['current'] == 0
+    finally:
+        set_memory_pool_limit(limit)
@@ -0,0 +1,55 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test chrome trace."""
+
+import json
+
+import numpy as np
+
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.simulator import Simulator
+from mindquantum.utils.trace import dump_trace, get_trace_events, start_trace, stop_trace
+
+
+def test_trace(tmp_path):
+    """
+    Description: Test python and c++ phases are recorded in a chrome trace.
+    Expectation: succeed.
+    """
+    start_trace()
+    sim = Simulator('mqvector', 2)
+    circ = Circuit().h(0).rx('a', 1)
+    sim.apply_circuit(circ, {'a': 0.1})
+    grad_ops = sim.get_expectation_with_grad(Hamiltonian(QubitOperator('Z1')), circ)
+    grad_ops(np.array([0.3]))
+    stop_trace()
+    sim.apply_circuit(circ, {'a': 0.1})
+
+    events = get_trace_events()
+    names = [event['name'] for event in events]
+    assert names.count('ApplyCircuit') >= 2
+    assert 'grad_ops' in names
+    assert 'GetExpectationWithGradMultiMulti' in names
+    grad = next(event for event in events if event['name'] == 'grad_ops')
+    inner = next(event for event in events if event['name'] == 'GetExpectationWithGradMultiMulti')
+    assert grad['start'] <= inner['start'] <= inner['start'] + inner['dur'] <= grad['start'] + grad['dur']
+
+    filename = tmp_path / 'trace.json'
+    dump_trace(str(filename))
+    with open(filename, encoding='utf-8') as file:
+        trace = json.load(file)
+    assert len(trace['traceEvents']) == len(events)
+    assert all(event['ph'] == 'X' for event in trace['traceEvents'])